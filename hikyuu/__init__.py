@@ -266,7 +266,7 @@ def load_hikyuu(**kwargs):
     preload_param = Parameter()
     preload_config = ini.options('preload')
     for p in preload_config:
-        if p in ('day', 'week', 'month', 'quarter', 'halfyear', 'year', 'min', 'min5', 'min15', 'min30', 'min60', 'hour2'):
+        if p in ('day', 'week', 'month', 'quarter', 'halfyear', 'year', 'min', 'min5', 'min15', 'min30', 'min60', 'hour2', 'columnar'):
             preload_param[p] = ini.getboolean('preload', p)
         else:
             preload_param[p] = ini.getint('preload', p)
@@ -274,7 +274,7 @@ def load_hikyuu(**kwargs):
     kdata_param = Parameter()
     kdata_config = ini.options('kdata')
     for p in kdata_config:
-        if p == "convert":
+        if p in ("convert", "mmap"):
             kdata_param[p] = ini.getboolean('kdata', p)
             continue
         kdata_param[p] = ini.get('kdata', p)
@@ -72,6 +72,7 @@ db = {dir}/stock.db
 [kdata]
 ;type = tdx
 ;dir = D:\\TdxW_HuaTai\\vipdoc
+;mmap = True
 type = hdf5
 sh_day = {dir}/sh_day.h5
 sh_min = {dir}/sh_1min.h5
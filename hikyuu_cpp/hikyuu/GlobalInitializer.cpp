@@ -26,10 +26,12 @@
 
 #include "utilities/Log.h"
 #include "utilities/os.h"
+#include "utilities/thread/algorithm.h"
 #include "hikyuu.h"
 #include "GlobalInitializer.h"
 #include "StockManager.h"
 #include "global/GlobalSpotAgent.h"
+#include "global/KDataLoader.h"
 #include "global/schedule/scheduler.h"
 #include "indicator/IndicatorImp.h"
 #include "global/sysinfo.h"
@@ -105,8 +107,10 @@ void GlobalInitializer::clean() {
 
     nng_fini();
     releaseGlobalSpotAgent();
+    stopKDataLoader();
 
     IndicatorImp::releaseDynEngine();
+    releaseParallelThreadPool();
 
 #if !HKU_OS_OSX
     // 主动停止异步数据加载任务组，否则 hdf5 在 linux 下会报关闭异常
@@ -0,0 +1,97 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-16
+ *      Author: fasiondog
+ */
+
+#include "HistoryFinanceColumns.h"
+
+namespace hku {
+
+HistoryFinanceColumns::HistoryFinanceColumns(const vector<HistoryFinanceInfo>& finances) {
+    size_t field_count = 0;
+    for (const auto& finance : finances) {
+        field_count = std::max(field_count, finance.values.size());
+    }
+
+    size_t total = finances.size();
+    m_file_dates.resize(total);
+    m_report_dates.resize(total);
+    m_fields.resize(field_count);
+    for (auto& values : m_fields) {
+        values.resize(total, Null<float>());
+    }
+
+    for (size_t i = 0; i < total; i++) {
+        const auto& finance = finances[i];
+        m_file_dates[i] = CompactDatetime(finance.fileDate);
+        m_report_dates[i] = CompactDatetime(finance.reportDate);
+        for (size_t f = 0, count = finance.values.size(); f < count; f++) {
+            m_fields[f][i] = finance.values[f];
+        }
+    }
+}
+
+void HistoryFinanceColumns::reserve(size_t n) {
+    m_file_dates.reserve(n);
+    m_report_dates.reserve(n);
+    for (auto& values : m_fields) {
+        values.reserve(n);
+    }
+}
+
+void HistoryFinanceColumns::push_back(const Datetime& fileDate, const Datetime& reportDate,
+                                      const float* values, size_t count) {
+    size_t total = size();
+    if (count > m_fields.size()) {
+        // 新增字段，之前各期报告以 Null 填充
+        size_t capacity = m_report_dates.capacity();
+        m_fields.resize(count);
+        for (auto& field_values : m_fields) {
+            if (field_values.size() < total) {
+                field_values.reserve(capacity);
+                field_values.resize(total, Null<float>());
+            }
+        }
+    }
+
+    m_file_dates.emplace_back(fileDate);
+    m_report_dates.emplace_back(reportDate);
+    for (size_t f = 0; f < count; f++) {
+        m_fields[f].push_back(values[f]);
+    }
+    for (size_t f = count, field_count = m_fields.size(); f < field_count; f++) {
+        m_fields[f].push_back(Null<float>());
+    }
+}
+
+size_t HistoryFinanceColumns::getPos(const Datetime& datetime) const {
+    auto iter =
+      std::upper_bound(m_report_dates.begin(), m_report_dates.end(), CompactDatetime(datetime));
+    return iter == m_report_dates.begin() ? Null<size_t>()
+                                          : size_t(iter - m_report_dates.begin()) - 1;
+}
+
+HistoryFinanceInfo HistoryFinanceColumns::getHistoryFinanceInfo(size_t pos) const {
+    HistoryFinanceInfo result;
+    result.fileDate = m_file_dates[pos].datetime();
+    result.reportDate = m_report_dates[pos].datetime();
+    size_t field_count = m_fields.size();
+    result.values.resize(field_count);
+    for (size_t f = 0; f < field_count; f++) {
+        result.values[f] = m_fields[f][pos];
+    }
+    return result;
+}
+
+vector<HistoryFinanceInfo> HistoryFinanceColumns::toHistoryFinanceList() const {
+    size_t total = size();
+    vector<HistoryFinanceInfo> result(total);
+    for (size_t i = 0; i < total; i++) {
+        result[i] = getHistoryFinanceInfo(i);
+    }
+    return result;
+}
+
+}  // namespace hku
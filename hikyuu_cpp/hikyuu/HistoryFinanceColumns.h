@@ -0,0 +1,110 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-16
+ *      Author: fasiondog
+ */
+
+#pragma once
+#ifndef HISTORYFINANCECOLUMNS_H_
+#define HISTORYFINANCECOLUMNS_H_
+
+#include "utilities/datetime/CompactDatetime.h"
+#include "HistoryFinanceInfo.h"
+
+namespace hku {
+
+/**
+ * 历史财务信息的列式存储，每个字段各期报告的值连续存放
+ * @details
+ * <pre>
+ * 各期报告按发布日期（reportDate）升序排列，读取单个字段的时间序列时无需复制其他字段。
+ * 各期报告字段数不一致时，缺失的字段以 Null<float>() 填充。
+ * 通过 getPos 可按时点查询指定日期已发布的最近一期报告，避免使用未来数据。
+ * </pre>
+ * @ingroup StockManage
+ */
+class HKU_API HistoryFinanceColumns {
+public:
+    HistoryFinanceColumns() = default;
+    HistoryFinanceColumns(const HistoryFinanceColumns&) = default;
+    HistoryFinanceColumns(HistoryFinanceColumns&&) = default;
+    HistoryFinanceColumns& operator=(const HistoryFinanceColumns&) = default;
+    HistoryFinanceColumns& operator=(HistoryFinanceColumns&&) = default;
+
+    /** 由按发布日期升序排列的历史财务信息构造 */
+    explicit HistoryFinanceColumns(const vector<HistoryFinanceInfo>& finances);
+
+    /** 报告期数 */
+    size_t size() const {
+        return m_report_dates.size();
+    }
+
+    bool empty() const {
+        return m_report_dates.empty();
+    }
+
+    /** 字段数 */
+    size_t fieldCount() const {
+        return m_fields.size();
+    }
+
+    void reserve(size_t n);
+
+    /**
+     * 追加一期报告，发布日期须不早于已有报告
+     * @param fileDate 报告期（用于区分一季报、半年报、三季报、年报）
+     * @param reportDate 报告发布日期
+     * @param values 各字段值
+     * @param count 字段数
+     */
+    void push_back(const Datetime& fileDate, const Datetime& reportDate, const float* values,
+                   size_t count);
+
+    /** 报告期列 */
+    const CompactDatetimeList& fileDates() const {
+        return m_file_dates;
+    }
+
+    /** 发布日期列 */
+    const CompactDatetimeList& reportDates() const {
+        return m_report_dates;
+    }
+
+    /**
+     * 获取指定字段各期报告的连续数据，长度为 size()
+     * @return 字段不存在时返回 nullptr
+     */
+    const float* field(size_t ix) const {
+        return ix < m_fields.size() ? m_fields[ix].data() : nullptr;
+    }
+
+    /** 获取第 pos 期报告的指定字段值，未作越界检查 */
+    float get(size_t pos, size_t ix) const {
+        return m_fields[ix][pos];
+    }
+
+    /**
+     * 查找在指定日期已发布（发布日期 <= datetime）的最近一期报告位置
+     * @return 如不存在，返回 Null<size_t>()
+     */
+    size_t getPos(const Datetime& datetime) const;
+
+    /** 以 HistoryFinanceInfo 方式获取指定位置的报告，未作越界检查 */
+    HistoryFinanceInfo getHistoryFinanceInfo(size_t pos) const;
+
+    /** 转换为按发布日期升序排列的 HistoryFinanceInfo 列表 */
+    vector<HistoryFinanceInfo> toHistoryFinanceList() const;
+
+private:
+    CompactDatetimeList m_file_dates;
+    CompactDatetimeList m_report_dates;
+    vector<vector<float>> m_fields;
+};
+
+/** @ingroup StockManage */
+typedef shared_ptr<const HistoryFinanceColumns> HistoryFinanceColumnsPtr;
+
+}  // namespace hku
+
+#endif /* HISTORYFINANCECOLUMNS_H_ */
@@ -41,7 +41,10 @@ public:
 
     DatetimeList getDatetimeList() const;
 
-    /** 获取指定位置的KRecord，未作越界检查 */
+    /**
+     * 获取指定位置的KRecord，未作越界检查
+     * @note 列式存储时首次调用会生成一份完整的 KRecord 副本，可使用 getKRecordValue 或 columns
+     */
     const KRecord& getKRecord(size_t pos) const;
 
     /** 按日期查询KRecord */
@@ -57,6 +60,12 @@ public:
         return getKRecord(datetime);
     }
 
+    /**
+     * 按值获取指定位置的KRecord，未作越界检查
+     * @note 列式存储时直接由列数据生成，不会生成完整的 KRecord 副本
+     */
+    KRecord getKRecordValue(size_t pos) const;
+
     /**
      * 通过当前 KData 获取一个保持数据类型、复权类型不变的新的 KData
      * @note 新的 KData 并不一定是原 KData 的子集
@@ -116,9 +125,20 @@ public:
     iterator end();
     const_iterator cbegin() const;
     const_iterator cend() const;
+
+    /**
+     * 连续存放的 KRecord 数据
+     * @note 列式存储时首次调用会生成一份完整的 KRecord 副本，按位置访问请用 getKRecordValue
+     */
     const KRecord* data() const;
     KRecord* data();  // 谨慎使用（用于强制调整数据）
 
+    /**
+     * 列式存储数据视图，各价格字段连续存放，可直接按字段读取，直接引用证券缓存而不复制
+     * @note 仅当证券K线缓存为列式存储（预加载参数 columnar）且不复权时有效，否则返回 nullptr
+     */
+    const KRecordColumnsView* columns() const;
+
 private:
     static KRecord ms_null_krecord;
 
@@ -206,6 +226,10 @@ inline const KRecord& KData::getKRecord(Datetime datetime) const {
     return pos != Null<size_t>() ? getKRecord(pos) : ms_null_krecord;
 }
 
+inline KRecord KData::getKRecordValue(size_t pos) const {
+    return m_imp->getKRecordValue(pos);  // 不会抛出异常
+}
+
 inline size_t KData::getPos(const Datetime& datetime) const {
     return m_imp->getPos(datetime);
 }
@@ -266,6 +290,10 @@ inline KRecord* KData::data() {
     return m_imp->data();
 }
 
+inline const KRecordColumnsView* KData::columns() const {
+    return m_imp->columns();
+}
+
 } /* namespace hku */
 
 #if FMT_VERSION >= 90000
@@ -11,14 +11,35 @@
 
 namespace hku {
 
-KDataImp::KDataImp() : m_start(0), m_end(0), m_have_pos_in_stock(false) {}
+KDataImp::KDataImp() : m_columnar(false), m_start(0), m_end(0), m_have_pos_in_stock(false) {}
 
 KDataImp::KDataImp(const Stock& stock, const KQuery& query)
-: m_query(query), m_stock(stock), m_start(0), m_end(0), m_have_pos_in_stock(false) {
+: m_columnar(false),
+  m_query(query),
+  m_stock(stock),
+  m_start(0),
+  m_end(0),
+  m_have_pos_in_stock(false) {
     if (m_stock.isNull()) {
         return;
     }
 
+    // 证券为行式缓存且无需复权时，直接引用缓存快照，不复制数据也不加锁
+    if (query.recoverType() == KQuery::NO_RECOVER) {
+        m_snapshot = m_stock.getKRecordSnapshot(query, m_start, m_end);
+        if (m_snapshot) {
+            m_have_pos_in_stock = true;
+            return;
+        }
+    }
+
+    // 证券缓存为列式存储且无需复权时，直接引用缓存中的列数据，不复制
+    if (query.recoverType() == KQuery::NO_RECOVER && m_stock.isColumnarBuffer(query.kType())) {
+        m_columns = m_stock.getKRecordColumns(query);
+        m_columnar = true;
+        return;
+    }
+
     m_buffer = m_stock.getKRecordList(query);
 
     // 不支持复权时，直接返回
@@ -62,8 +83,32 @@ KDataImp::KDataImp(const Stock& stock, const KQuery& query)
 
 KDataImp::~KDataImp() {}
 
+void KDataImp::_buildRecordView() const {
+    std::call_once(m_record_view_flag, [this]() {
+        m_buffer = m_snapshot ? m_snapshot->toKRecordList(m_start, m_end)
+                              : m_columns.toKRecordList();
+    });
+}
+
+void KDataImp::_detach() {
+    HKU_IF_RETURN(!m_columnar && !m_snapshot, void());
+    _buildRecordView();
+    m_columnar = false;
+    m_columns = KRecordColumnsView();
+    m_snapshot.reset();
+}
+
 DatetimeList KDataImp::getDatetimeList() const {
+    HKU_IF_RETURN(m_columnar, m_columns.datetimes());
     DatetimeList result;
+    if (m_snapshot) {
+        result.reserve(m_end - m_start);
+        for (size_t i = m_start; i < m_end; i++) {
+            result.emplace_back((*m_snapshot)[i].datetime);
+        }
+        return result;
+    }
+
     for (const auto& record : m_buffer) {
         result.emplace_back(record.datetime);
     }
@@ -101,6 +146,19 @@ void KDataImp::_getPosInStock() {
 }
 
 size_t KDataImp::getPos(const Datetime& datetime) {
+    if (m_snapshot) {
+        size_t pos = m_snapshot->lowerBound(datetime, m_start, m_end);
+        return (pos >= m_end || (*m_snapshot)[pos].datetime != datetime) ? Null<size_t>()
+                                                                          : pos - m_start;
+    }
+
+    if (m_columnar) {
+        size_t pos = m_columns.lowerBound(datetime);
+        return (pos >= m_columns.size() || m_columns.date(pos) != CompactDatetime(datetime))
+                 ? Null<size_t>()
+                 : pos;
+    }
+
     KRecordList::const_iterator iter;
     KRecord comp_record;
     comp_record.datetime = datetime;
@@ -9,6 +9,7 @@
 #ifndef KDATAIMP_H_
 #define KDATAIMP_H_
 
+#include <mutex>
 #include "Stock.h"
 
 namespace hku {
@@ -28,15 +29,39 @@ public:
     }
 
     const KRecord& getKRecord(size_t pos) const {
+        if (m_snapshot) {
+            return (*m_snapshot)[m_start + pos];
+        }
+        if (m_columnar) {
+            _buildRecordView();
+        }
         return m_buffer[pos];
     }
 
+    KRecord getKRecordValue(size_t pos) const {
+        if (m_snapshot) {
+            return (*m_snapshot)[m_start + pos];
+        }
+        return m_columnar ? m_columns.get(pos) : m_buffer[pos];
+    }
+
     bool empty() const {
-        return m_buffer.empty();
+        if (m_snapshot) {
+            return m_start == m_end;
+        }
+        return m_columnar ? m_columns.empty() : m_buffer.empty();
     }
 
     size_t size() {
-        return m_buffer.size();
+        if (m_snapshot) {
+            return m_end - m_start;
+        }
+        return m_columnar ? m_columns.size() : m_buffer.size();
+    }
+
+    /** 列式存储的数据视图，仅当证券缓存为列式存储且不复权时有效，否则返回 nullptr */
+    const KRecordColumnsView* columns() const {
+        return m_columnar ? &m_columns : nullptr;
     }
 
     size_t startPos();
@@ -46,10 +71,20 @@ public:
     size_t getPos(const Datetime& datetime);
 
     const KRecord* data() const {
+        if (m_snapshot) {
+            const KRecord* ptr = m_snapshot->contiguous(m_start, m_end);
+            if (ptr) {
+                return ptr;
+            }
+        }
+        if (m_columnar || m_snapshot) {
+            _buildRecordView();
+        }
         return m_buffer.data();
     }
 
     KRecord* data() {
+        _detach();
         return m_buffer.data();
     }
 
@@ -60,22 +95,37 @@ public:
     typedef KRecordList::const_iterator const_iterator;
 
     iterator begin() {
+        _detach();
         return m_buffer.begin();
     }
 
     iterator end() {
+        _detach();
         return m_buffer.end();
     }
 
     const_iterator cbegin() const {
+        if (m_columnar || m_snapshot) {
+            _buildRecordView();
+        }
         return m_buffer.cbegin();
     }
 
     const_iterator cend() const {
+        if (m_columnar || m_snapshot) {
+            _buildRecordView();
+        }
         return m_buffer.cend();
     }
 
 private:
+    // 列式存储或引用缓存快照时，供 data()/cbegin()/cend() 按需生成连续的 KRecord 副本（仅生成一次），
+    // 按位置访问时直接读取列数据或快照，不会生成
+    void _buildRecordView() const;
+
+    // 可能被外部修改数据时，复制为独立的 KRecord 存储，放弃列式存储及缓存快照
+    void _detach();
+
     void _getPosInStock();
     void _recoverForward();
     void _recoverBackward();
@@ -84,7 +134,11 @@ private:
     void _recoverForUpDay();
 
 private:
-    KRecordList m_buffer;
+    mutable KRecordList m_buffer;
+    KRecordColumnsView m_columns;  // 列式存储时直接引用证券缓存中的列数据
+    bool m_columnar;
+    mutable std::once_flag m_record_view_flag;
+    KRecordSnapshotPtr m_snapshot;  // 不复权时直接引用的缓存快照，范围为 [m_start, m_end)
     KQuery m_query;
     Stock m_stock;
     size_t m_start;
@@ -0,0 +1,154 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-16
+ *      Author: fasiondog
+ */
+
+#include "KRecordColumns.h"
+
+namespace hku {
+
+KRecordColumns::KRecordColumns(const KRecordList& ks) : KRecordColumns(ks.data(), ks.size()) {}
+
+KRecordColumns::KRecordColumns(const KRecord* ks, size_t total) {
+    m_dates.resize(total);
+    for (size_t f = 0; f < FIELD_COUNT; f++) {
+        m_fields[f].resize(total);
+    }
+
+    auto* open = m_fields[OPEN].data();
+    auto* high = m_fields[HIGH].data();
+    auto* low = m_fields[LOW].data();
+    auto* close = m_fields[CLOSE].data();
+    auto* amount = m_fields[AMOUNT].data();
+    auto* vol = m_fields[VOL].data();
+    for (size_t i = 0; i < total; i++) {
+        const KRecord& k = ks[i];
+        m_dates[i] = CompactDatetime(k.datetime);
+        open[i] = k.openPrice;
+        high[i] = k.highPrice;
+        low[i] = k.lowPrice;
+        close[i] = k.closePrice;
+        amount[i] = k.transAmount;
+        vol[i] = k.transCount;
+    }
+}
+
+void KRecordColumns::reserve(size_t n) {
+    m_dates.reserve(n);
+    for (size_t f = 0; f < FIELD_COUNT; f++) {
+        m_fields[f].reserve(n);
+    }
+}
+
+void KRecordColumns::clear() {
+    m_dates.clear();
+    for (size_t f = 0; f < FIELD_COUNT; f++) {
+        m_fields[f].clear();
+    }
+}
+
+void KRecordColumns::push_back(const KRecord& record) {
+    m_dates.push_back(CompactDatetime(record.datetime));
+    m_fields[OPEN].push_back(record.openPrice);
+    m_fields[HIGH].push_back(record.highPrice);
+    m_fields[LOW].push_back(record.lowPrice);
+    m_fields[CLOSE].push_back(record.closePrice);
+    m_fields[AMOUNT].push_back(record.transAmount);
+    m_fields[VOL].push_back(record.transCount);
+}
+
+KRecord KRecordColumns::get(size_t pos) const {
+    return KRecord(m_dates[pos].datetime(), m_fields[OPEN][pos], m_fields[HIGH][pos],
+                   m_fields[LOW][pos], m_fields[CLOSE][pos], m_fields[AMOUNT][pos],
+                   m_fields[VOL][pos]);
+}
+
+void KRecordColumns::set(size_t pos, const KRecord& record) {
+    m_dates[pos] = CompactDatetime(record.datetime);
+    m_fields[OPEN][pos] = record.openPrice;
+    m_fields[HIGH][pos] = record.highPrice;
+    m_fields[LOW][pos] = record.lowPrice;
+    m_fields[CLOSE][pos] = record.closePrice;
+    m_fields[AMOUNT][pos] = record.transAmount;
+    m_fields[VOL][pos] = record.transCount;
+}
+
+KRecordList KRecordColumns::toKRecordList(size_t start, size_t end) const {
+    KRecordList result;
+    size_t total = size();
+    HKU_IF_RETURN(start >= total || start >= end, result);
+    if (end > total) {
+        end = total;
+    }
+
+    result.resize(end - start);
+    const auto* open = m_fields[OPEN].data();
+    const auto* high = m_fields[HIGH].data();
+    const auto* low = m_fields[LOW].data();
+    const auto* close = m_fields[CLOSE].data();
+    const auto* amount = m_fields[AMOUNT].data();
+    const auto* vol = m_fields[VOL].data();
+    for (size_t i = start; i < end; i++) {
+        KRecord& k = result[i - start];
+        k.datetime = m_dates[i].datetime();
+        k.openPrice = open[i];
+        k.highPrice = high[i];
+        k.lowPrice = low[i];
+        k.closePrice = close[i];
+        k.transAmount = amount[i];
+        k.transCount = vol[i];
+    }
+    return result;
+}
+
+DatetimeList KRecordColumns::datetimes() const {
+    DatetimeList result;
+    result.reserve(m_dates.size());
+    for (const auto& d : m_dates) {
+        result.push_back(d.datetime());
+    }
+    return result;
+}
+
+size_t KRecordColumns::lowerBound(const Datetime& datetime) const {
+    return std::lower_bound(m_dates.begin(), m_dates.end(), CompactDatetime(datetime)) -
+           m_dates.begin();
+}
+
+KRecordColumnsView::KRecordColumnsView(const shared_ptr<const KRecordColumns>& columns,
+                                       size_t start, size_t end)
+: m_columns(columns) {
+    size_t total = m_columns->size();
+    m_end = end > total ? total : end;
+    m_start = start > m_end ? m_end : start;
+}
+
+KRecordColumnsView::KRecordColumnsView(KRecordColumns&& columns)
+: m_columns(make_shared<const KRecordColumns>(std::move(columns))),
+  m_start(0),
+  m_end(m_columns->size()) {}
+
+DatetimeList KRecordColumnsView::datetimes() const {
+    DatetimeList result;
+    result.reserve(size());
+    for (size_t i = m_start; i < m_end; i++) {
+        result.push_back(m_columns->dates()[i].datetime());
+    }
+    return result;
+}
+
+KRecordList KRecordColumnsView::toKRecordList() const {
+    return m_columns ? m_columns->toKRecordList(m_start, m_end) : KRecordList();
+}
+
+size_t KRecordColumnsView::lowerBound(const Datetime& datetime) const {
+    HKU_IF_RETURN(!m_columns, 0);
+    const auto& dates = m_columns->dates();
+    return std::lower_bound(dates.begin() + m_start, dates.begin() + m_end,
+                            CompactDatetime(datetime)) -
+           dates.begin() - m_start;
+}
+
+}  // namespace hku
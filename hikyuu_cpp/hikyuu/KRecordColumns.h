@@ -0,0 +1,180 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-16
+ *      Author: fasiondog
+ */
+
+#pragma once
+#ifndef KRECORDCOLUMNS_H_
+#define KRECORDCOLUMNS_H_
+
+#include "utilities/datetime/CompactDatetime.h"
+#include "KRecord.h"
+
+namespace hku {
+
+/**
+ * K线数据的列式存储（SoA），每个字段各自连续存放
+ * @details 与 KRecordList 相比，按字段读取（如收盘价序列）时无需跨记录跳跃访问，
+ * 适用于大量预加载数据后仅按价格字段计算指标的场景。
+ * 通过 get(pos) 可按 KRecord 方式访问。日期列以紧凑日期（CompactDatetime）保存。
+ * @ingroup StockManage
+ */
+class HKU_API KRecordColumns {
+public:
+    /** 价格字段 */
+    enum Field {
+        OPEN = 0,    ///< 开盘价
+        HIGH = 1,    ///< 最高价
+        LOW = 2,     ///< 最低价
+        CLOSE = 3,   ///< 收盘价
+        AMOUNT = 4,  ///< 成交金额
+        VOL = 5,     ///< 成交量
+        FIELD_COUNT = 6
+    };
+
+    KRecordColumns() = default;
+    KRecordColumns(const KRecordColumns&) = default;
+    KRecordColumns(KRecordColumns&&) = default;
+    KRecordColumns& operator=(const KRecordColumns&) = default;
+    KRecordColumns& operator=(KRecordColumns&&) = default;
+
+    explicit KRecordColumns(const KRecordList& ks);
+
+    /** 由连续的 KRecord 数组构造 */
+    KRecordColumns(const KRecord* ks, size_t total);
+
+    size_t size() const {
+        return m_dates.size();
+    }
+
+    bool empty() const {
+        return m_dates.empty();
+    }
+
+    void reserve(size_t n);
+    void clear();
+
+    /** 追加一条记录 */
+    void push_back(const KRecord& record);
+
+    /** 以 KRecord 方式获取指定位置的记录，未作越界检查 */
+    KRecord get(size_t pos) const;
+
+    /** 修改指定位置的记录，未作越界检查 */
+    void set(size_t pos, const KRecord& record);
+
+    /** 获取最后一条记录 */
+    KRecord back() const {
+        return get(size() - 1);
+    }
+
+    /** 日期列 */
+    const CompactDatetimeList& dates() const {
+        return m_dates;
+    }
+
+    /** 日期列，转换为 Datetime */
+    DatetimeList datetimes() const;
+
+    /** 获取指定价格字段的连续数据 */
+    const price_t* data(Field field) const {
+        return m_fields[field].data();
+    }
+
+    /** 获取指定价格字段的连续数据，谨慎使用（用于强制调整数据） */
+    price_t* data(Field field) {
+        return m_fields[field].data();
+    }
+
+    /** 转换 [start, end) 范围的数据为 KRecordList，end 超出时截止至末尾 */
+    KRecordList toKRecordList(size_t start = 0, size_t end = Null<size_t>()) const;
+
+    /**
+     * 查找大于等于指定日期的第一条记录位置
+     * @return 如不存在，返回 size()
+     */
+    size_t lowerBound(const Datetime& datetime) const;
+
+private:
+    CompactDatetimeList m_dates;
+    PriceList m_fields[FIELD_COUNT];
+};
+
+/** @ingroup StockManage */
+typedef shared_ptr<KRecordColumns> KRecordColumnsPtr;
+
+/**
+ * K线列式数据中 [start, end) 范围的只读视图
+ * @details 共享所引用的列式数据，不复制任何字段。所引用的列式数据在视图存续期间不会被修改，
+ * 证券缓存更新时会另行复制（写时复制）。
+ * @ingroup StockManage
+ */
+class HKU_API KRecordColumnsView {
+public:
+    KRecordColumnsView() = default;
+
+    /**
+     * 引用 columns 中 [start, end) 范围的数据，end 超出时截止至末尾
+     * @note 调用者需保证 columns 不为空
+     */
+    KRecordColumnsView(const shared_ptr<const KRecordColumns>& columns, size_t start, size_t end);
+
+    /** 独占传入的列式数据，引用其全部范围 */
+    explicit KRecordColumnsView(KRecordColumns&& columns);
+
+    size_t size() const {
+        return m_end - m_start;
+    }
+
+    bool empty() const {
+        return m_start == m_end;
+    }
+
+    /** 在所引用列式数据中的起始位置 */
+    size_t start() const {
+        return m_start;
+    }
+
+    /** 所引用的列式数据 */
+    const shared_ptr<const KRecordColumns>& columns() const {
+        return m_columns;
+    }
+
+    /** 以 KRecord 方式获取视图中指定位置的记录，未作越界检查 */
+    KRecord get(size_t pos) const {
+        return m_columns->get(m_start + pos);
+    }
+
+    /** 视图中指定位置的日期，未作越界检查 */
+    const CompactDatetime& date(size_t pos) const {
+        return m_columns->dates()[m_start + pos];
+    }
+
+    /** 日期列，转换为 Datetime */
+    DatetimeList datetimes() const;
+
+    /** 获取指定价格字段的连续数据，视图为空时返回 nullptr */
+    const price_t* data(KRecordColumns::Field field) const {
+        return m_columns ? m_columns->data(field) + m_start : nullptr;
+    }
+
+    /** 转换为 KRecordList */
+    KRecordList toKRecordList() const;
+
+    /**
+     * 查找视图中大于等于指定日期的第一条记录位置
+     * @return 如不存在，返回 size()
+     */
+    size_t lowerBound(const Datetime& datetime) const;
+
+private:
+    shared_ptr<const KRecordColumns> m_columns;
+    size_t m_start{0};
+    size_t m_end{0};
+};
+
+}  // namespace hku
+
+#endif /* KRECORDCOLUMNS_H_ */
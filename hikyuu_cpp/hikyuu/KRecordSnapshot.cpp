@@ -0,0 +1,141 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-16
+ *      Author: fasiondog
+ */
+
+#include "KRecordSnapshot.h"
+
+namespace hku {
+
+KRecordSnapshot::Block::Block(KRecordList&& ks) : records(std::move(ks)) {
+    dates.reserve(records.capacity());
+    for (const auto& k : records) {
+        dates.push_back(CompactDatetime(k.datetime));
+    }
+    data = records.data();
+    date_data = dates.data();
+}
+
+KRecordSnapshot::KRecordSnapshot(KRecordList&& ks) {
+    if (ks.empty()) {
+        return;
+    }
+    m_block = make_shared<Block>(std::move(ks));
+    m_data = m_block->data;
+    m_dates = m_block->date_data;
+    m_closed = m_block->records.size();
+}
+
+size_t KRecordSnapshot::lowerBound(const Datetime& datetime, size_t start, size_t end) const {
+    size_t total = size();
+    if (end > total) {
+        end = total;
+    }
+    HKU_IF_RETURN(start >= end, end);
+
+    CompactDatetime target(datetime);
+    size_t closed_end = end < m_closed ? end : m_closed;
+    if (start < closed_end) {
+        size_t pos = std::lower_bound(m_dates + start, m_dates + closed_end, target) - m_dates;
+        HKU_IF_RETURN(pos < closed_end, pos);
+    }
+    // 已完结部分均小于指定日期，再比较最后一条
+    return (end > m_closed && m_tail.datetime < datetime) ? end : closed_end;
+}
+
+KRecordList KRecordSnapshot::toKRecordList(size_t start, size_t end) const {
+    KRecordList result;
+    size_t total = size();
+    if (end > total) {
+        end = total;
+    }
+    HKU_IF_RETURN(start >= end, result);
+
+    result.reserve(end - start);
+    size_t closed_end = end < m_closed ? end : m_closed;
+    if (start < closed_end) {
+        result.insert(result.end(), m_data + start, m_data + closed_end);
+    }
+    if (end > m_closed) {
+        result.push_back(m_tail);
+    }
+    return result;
+}
+
+shared_ptr<KRecordSnapshot::Block> KRecordSnapshot::_grow(const KRecord& tail, const KRecord* ks,
+                                                          size_t total) const {
+    size_t n = m_closed + 1 + total;
+    KRecordList records;
+    records.reserve(n + std::max<size_t>(n / 2, 64));
+    if (m_closed > 0) {
+        records.insert(records.end(), m_data, m_data + m_closed);
+    }
+    records.push_back(tail);
+    if (total > 0) {
+        records.insert(records.end(), ks, ks + total);
+    }
+    return make_shared<Block>(std::move(records));
+}
+
+KRecordSnapshotPtr KRecordSnapshot::append(const KRecord& record) const {
+    auto result = make_shared<KRecordSnapshot>(*this);
+    if (m_has_tail) {
+        // 原最后一条记录已完结，写入存储块。仅当本快照位于存储块末尾且容量足够时原地追加，
+        // 追加的位置不属于任何已发布的快照，因此不影响正在读取的线程
+        if (m_block && m_block->records.size() == m_closed &&
+            m_closed < m_block->records.capacity()) {
+            m_block->push_back(m_tail);
+        } else {
+            result->m_block = _grow(m_tail);
+            result->m_data = result->m_block->data;
+            result->m_dates = result->m_block->date_data;
+        }
+        result->m_closed = m_closed + 1;
+    }
+    result->m_tail = record;
+    result->m_has_tail = true;
+    return result;
+}
+
+KRecordSnapshotPtr KRecordSnapshot::append(const KRecord* ks, size_t total) const {
+    HKU_IF_RETURN(total == 0, make_shared<KRecordSnapshot>(*this));
+    HKU_IF_RETURN(total == 1, append(ks[0]));
+
+    // 原 tail 及新记录中除最后一条外均已完结，写入存储块，最后一条作为新的 tail
+    auto result = make_shared<KRecordSnapshot>(*this);
+    size_t closed_total = total - 1;
+    const KRecord& first = m_has_tail ? m_tail : ks[0];
+    const KRecord* rest = m_has_tail ? ks : ks + 1;
+    size_t rest_total = m_has_tail ? closed_total : closed_total - 1;
+    size_t add = rest_total + 1;
+    if (m_block && m_block->records.size() == m_closed &&
+        m_closed + add <= m_block->records.capacity()) {
+        m_block->push_back(first);
+        for (size_t i = 0; i < rest_total; i++) {
+            m_block->push_back(rest[i]);
+        }
+    } else {
+        result->m_block = _grow(first, rest, rest_total);
+        result->m_data = result->m_block->data;
+        result->m_dates = result->m_block->date_data;
+    }
+    result->m_closed = m_closed + add;
+    result->m_tail = ks[total - 1];
+    result->m_has_tail = true;
+    return result;
+}
+
+KRecordSnapshotPtr KRecordSnapshot::updateLast(const KRecord& record) const {
+    auto result = make_shared<KRecordSnapshot>(*this);
+    if (!m_has_tail) {
+        // 存储块中的最后一条可能正被读取，不能原地修改，改由新快照单独持有
+        result->m_closed = m_closed - 1;
+        result->m_has_tail = true;
+    }
+    result->m_tail = record;
+    return result;
+}
+
+} /* namespace hku */
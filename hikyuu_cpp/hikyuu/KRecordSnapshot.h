@@ -0,0 +1,108 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-16
+ *      Author: fasiondog
+ */
+
+#pragma once
+#ifndef KRECORDSNAPSHOT_H_
+#define KRECORDSNAPSHOT_H_
+
+#include "utilities/datetime/CompactDatetime.h"
+#include "KRecord.h"
+
+namespace hku {
+
+class HKU_API KRecordSnapshot;
+typedef shared_ptr<const KRecordSnapshot> KRecordSnapshotPtr;
+
+/**
+ * K线缓存的不可变快照
+ * @details 已完结的K线存放在多个快照共享的只追加存储块中，最后一根可能仍在更新的K线
+ * 由快照单独持有。快照一经发布便不再修改，读取方持有快照即可无锁、无拷贝地访问；
+ * 写入方通过 append/updateLast 生成新版本后发布，已发布的存储位置不会被改写。
+ * 写入方之间须自行串行（Stock 中由写锁保证）。
+ * @ingroup StockManage
+ */
+class HKU_API KRecordSnapshot {
+public:
+    KRecordSnapshot() = default;
+
+    /** 以已有的K线数据构造，全部视为已完结 */
+    explicit KRecordSnapshot(KRecordList&& ks);
+
+    size_t size() const {
+        return m_closed + (m_has_tail ? 1 : 0);
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    const KRecord& operator[](size_t pos) const {
+        return pos < m_closed ? m_data[pos] : m_tail;
+    }
+
+    const KRecord& back() const {
+        return m_has_tail ? m_tail : m_data[m_closed - 1];
+    }
+
+    /** 若 [start, end) 全部位于共享存储块中，返回其首地址，否则返回 nullptr */
+    const KRecord* contiguous(size_t start, size_t end) const {
+        return end <= m_closed ? m_data + start : nullptr;
+    }
+
+    /**
+     * 在 [start, end) 中查找大于等于指定日期的第一条记录位置，按紧凑日期索引二分查找
+     * @return 如不存在，返回 end（end 超出时为 size()）
+     */
+    size_t lowerBound(const Datetime& datetime, size_t start = 0,
+                      size_t end = Null<size_t>()) const;
+
+    /** 复制 [start, end) 至 KRecordList */
+    KRecordList toKRecordList(size_t start, size_t end) const;
+
+    /** 追加一条新记录后的新版本 */
+    KRecordSnapshotPtr append(const KRecord& record) const;
+
+    /**
+     * 依次追加多条新记录后的新版本，存储空间仅扩展一次
+     * @note 调用者须保证记录按日期升序且均晚于当前最后一条记录
+     */
+    KRecordSnapshotPtr append(const KRecord* ks, size_t total) const;
+
+    /** 替换最后一条记录后的新版本，调用者须保证当前快照非空 */
+    KRecordSnapshotPtr updateLast(const KRecord& record) const;
+
+private:
+    struct Block {
+        explicit Block(KRecordList&& ks);
+
+        void push_back(const KRecord& record) {
+            records.push_back(record);
+            dates.push_back(CompactDatetime(record.datetime));
+        }
+
+        // 仅写入方在容量范围内追加，不会重新分配内存，读取方只通过 data/date_data 访问
+        KRecordList records;
+        CompactDatetimeList dates;  // 与 records 一一对应的日期索引，二分查找时连续访问
+        const KRecord* data;
+        const CompactDatetime* date_data;
+    };
+
+    // 将已完结部分、tail 及 [ks, ks + total) 复制至新的存储块，并预留后续追加的空间
+    shared_ptr<Block> _grow(const KRecord& tail, const KRecord* ks = nullptr,
+                            size_t total = 0) const;
+
+private:
+    shared_ptr<Block> m_block;
+    const KRecord* m_data{nullptr};
+    const CompactDatetime* m_dates{nullptr};
+    size_t m_closed{0};  // 存储块中属于本快照的记录数
+    KRecord m_tail;
+    bool m_has_tail{false};
+};
+
+} /* namespace hku */
+#endif /* KRECORDSNAPSHOT_H_ */
@@ -9,6 +9,7 @@
 #include "StockManager.h"
 #include "data_driver/KDataDriver.h"
 #include "plugin/hkuextra.h"
+#include "global/KDataLoader.h"
 #include "KData.h"
 
 namespace hku {
@@ -66,6 +67,7 @@ Stock::Data::Data()
     const auto& ktype_list = KQuery::getBaseKTypeList();
     for (const auto& ktype : ktype_list) {
         pKData[ktype] = nullptr;
+        pKColumns[ktype] = nullptr;
         pMutex[ktype] = nullptr;
     }
 }
@@ -99,6 +101,7 @@ Stock::Data::Data(const string& market, const string& code, const string& name,
     for (const auto& ktype : ktype_list) {
         pMutex[ktype] = new std::shared_mutex();
         pKData[ktype] = nullptr;
+        pKColumns[ktype] = nullptr;
     }
 }
 
@@ -109,12 +112,6 @@ string Stock::Data::marketCode() const {
 }
 
 Stock::Data::~Data() {
-    for (auto iter = pKData.begin(); iter != pKData.end(); ++iter) {
-        if (iter->second) {
-            delete iter->second;
-        }
-    }
-
     for (auto iter = pMutex.begin(); iter != pMutex.end(); ++iter) {
         if (iter->second) {
             delete iter->second;
@@ -382,9 +379,10 @@ void Stock::setKDataDriver(const KDataDriverConnectPoolPtr& kdataDriver) {
         auto ktype_list = KQuery::getBaseKTypeList();
         for (auto& ktype : ktype_list) {
             std::unique_lock<std::shared_mutex> lock(*(m_data->pMutex[ktype]));
-            delete m_data->pKData[ktype];
-            m_data->pKData[ktype] = nullptr;
+            _setKRecordSnapshot(ktype, KRecordSnapshotPtr());
+            m_data->pKColumns[ktype].reset();
         }
+        m_data->m_data_version++;
     }
 }
 
@@ -396,15 +394,33 @@ void Stock::setWeightList(const StockWeightList& weightList) {
     if (m_data) {
         std::lock_guard<std::mutex> lock(m_data->m_weight_mutex);
         m_data->m_weightList = weightList;
+        m_data->m_data_version++;
     }
 }
 
+uint64_t Stock::dataVersion() const {
+    return m_data ? m_data->m_data_version.load() : 0;
+}
+
 bool Stock::isBuffer(KQuery::KType ktype) const {
     HKU_IF_RETURN(!m_data, false);
     string nktype(ktype);
     to_upper(nktype);
-    std::shared_lock<std::shared_mutex> lock(*(m_data->pMutex[ktype]));
-    return m_data->pKData.find(nktype) != m_data->pKData.end() && m_data->pKData[nktype];
+    // 行式缓存无需加锁
+    HKU_IF_RETURN(_getKRecordSnapshot(nktype), true);
+    HKU_IF_RETURN(m_data->pKColumns.find(nktype) == m_data->pKColumns.end(), false);
+    std::shared_lock<std::shared_mutex> lock(*(m_data->pMutex[nktype]));
+    return m_data->pKColumns[nktype] != nullptr;
+}
+
+bool Stock::isColumnarBuffer(KQuery::KType ktype) const {
+    HKU_IF_RETURN(!m_data, false);
+    string nktype(ktype);
+    to_upper(nktype);
+    auto iter = m_data->pKColumns.find(nktype);
+    HKU_IF_RETURN(iter == m_data->pKColumns.end(), false);
+    std::shared_lock<std::shared_mutex> lock(*(m_data->pMutex[nktype]));
+    return iter->second != nullptr;
 }
 
 void Stock::setPreload(vector<KQuery::KType>& preload_ktypes) {
@@ -430,11 +446,13 @@ void Stock::releaseKDataBuffer(KQuery::KType inkType) const {
     HKU_IF_RETURN(m_data->pMutex.find(ktype) == m_data->pMutex.end(), void());
 
     std::unique_lock<std::shared_mutex> lock(*(m_data->pMutex[ktype]));
-    auto iter = m_data->pKData.find(ktype);
-    if (iter->second) {
-        delete iter->second;
-        iter->second = nullptr;
+    _setKRecordSnapshot(ktype, KRecordSnapshotPtr());
+
+    auto col_iter = m_data->pKColumns.find(ktype);
+    if (col_iter != m_data->pKColumns.end()) {
+        col_iter->second.reset();
     }
+    m_data->m_data_version++;
 }
 
 // 仅在初始化时调用
@@ -449,9 +467,12 @@ void Stock::loadKDataToBuffer(KQuery::KType inkType) const {
     auto driver = m_kdataDriver->getConnect();
     size_t total = driver->getCount(m_data->m_market, m_data->m_code, kType);
 
+    // 预加载参数 columnar 为 true 时，以列式存储方式缓存
+    const auto& param = StockManager::instance().getPreloadParameter();
+    bool columnar = param.tryGet<bool>("columnar", false);
+
     // CSV 直接全部加载至内存，其他类型依据配置的预加载参数进行加载
     if (driver->name() != "TMPCSV") {
-        const auto& param = StockManager::instance().getPreloadParameter();
         string preload_type = fmt::format("{}_max", kType);
         to_lower(preload_type);
         int max_num = param.tryGet<int>(preload_type, 4096);
@@ -463,16 +484,41 @@ void Stock::loadKDataToBuffer(KQuery::KType inkType) const {
     {
         std::unique_lock<std::shared_mutex> lock(*(m_data->pMutex[kType]));
         // 需要对是否已缓存进行二次判定，防止加锁之前已被缓存
-        if (m_data->pKData.find(kType) != m_data->pKData.end() && m_data->pKData[kType]) {
+        if (_getKRecordSnapshot(kType) || m_data->pKColumns[kType]) {
             return;
         }
-        KRecordList* ptr_klist = new KRecordList;
-        m_data->pKData[kType] = ptr_klist;
+
+        KRecordList ks;
         if (total != 0) {
-            (*ptr_klist) = driver->getKRecordList(m_data->m_market, m_data->m_code,
-                                                  KQuery(start, Null<int64_t>(), kType));
+            ks = driver->getKRecordList(m_data->m_market, m_data->m_code,
+                                        KQuery(start, Null<int64_t>(), kType));
         }
+        _setPreloadBuffer(kType, std::move(ks), columnar);
+    }
+}
+
+void Stock::_setPreloadBuffer(const string& kType, KRecordList&& ks, bool columnar) const {
+    if (columnar) {
+        m_data->pKColumns[kType] = make_shared<KRecordColumns>(ks);
+        m_data->m_data_version++;
+        return;
     }
+
+    _setKRecordSnapshot(kType, make_shared<KRecordSnapshot>(std::move(ks)));
+}
+
+bool Stock::setPreloadKRecordList(const KQuery::KType& inkType, KRecordList&& ks,
+                                  bool columnar) const {
+    HKU_IF_RETURN(!m_data, false);
+
+    string kType(inkType);
+    to_upper(kType);
+    HKU_IF_RETURN(m_data->pKData.find(kType) == m_data->pKData.end(), false);
+
+    std::unique_lock<std::shared_mutex> lock(*(m_data->pMutex[kType]));
+    HKU_IF_RETURN(_getKRecordSnapshot(kType) || m_data->pKColumns[kType], false);
+    _setPreloadBuffer(kType, std::move(ks), columnar);
+    return true;
 }
 
 StockWeightList Stock::getWeight(const Datetime& start, const Datetime& end) const {
@@ -499,9 +545,25 @@ KData Stock::getKData(const KQuery& query) const {
     return KData(*this, query);
 }
 
+KRecordSnapshotPtr Stock::_getKRecordSnapshot(const string& ktype) const {
+    auto iter = m_data->pKData.find(ktype);
+    return iter != m_data->pKData.end() ? std::atomic_load(&iter->second) : KRecordSnapshotPtr();
+}
+
+void Stock::_setKRecordSnapshot(const string& ktype, KRecordSnapshotPtr&& snapshot) const {
+    auto iter = m_data->pKData.find(ktype);
+    if (iter != m_data->pKData.end()) {
+        std::atomic_store(&iter->second, std::move(snapshot));
+        m_data->m_data_version++;
+    }
+}
+
 size_t Stock::_getCountFromBuffer(const KQuery::KType& ktype) const {
+    auto snapshot = _getKRecordSnapshot(ktype);
+    HKU_IF_RETURN(snapshot, snapshot->size());
     std::shared_lock<std::shared_mutex> lock(*(m_data->pMutex[ktype]));
-    return m_data->pKData[ktype]->size();
+    const auto& columns = m_data->pKColumns[ktype];
+    return columns ? columns->size() : 0;
 }
 
 size_t Stock::getCount(KQuery::KType ktype) const {
@@ -650,12 +712,12 @@ bool Stock::getIndexRange(const KQuery& query, size_t& out_start, size_t& out_en
     return false;
 }
 
-bool Stock::_getIndexRangeByIndex(const KQuery& query, size_t& out_start, size_t& out_end) const {
+// 按索引查询时，根据总数计算对应的索引范围
+static bool getIndexRangeByIndex(const KQuery& query, size_t total, size_t& out_start,
+                                 size_t& out_end) {
     assert(query.queryType() == KQuery::INDEX);
     out_start = 0;
     out_end = 0;
-
-    size_t total = getCount(query.kType());
     HKU_IF_RETURN(0 == total, false);
 
     int64_t startix, endix;
@@ -702,79 +764,53 @@ bool Stock::_getIndexRangeByIndex(const KQuery& query, size_t& out_start, size_t
     return true;
 }
 
-bool Stock::_getIndexRangeByDateFromBuffer(const KQuery& query, size_t& out_start,
-                                           size_t& out_end) const {
-    std::shared_lock<std::shared_mutex> lock(*(m_data->pMutex[query.kType()]));
+// 按日期查询时，在快照中二分查找对应的索引范围
+static bool getIndexRangeByDate(const KRecordSnapshot& kdata, const KQuery& query,
+                                size_t& out_start, size_t& out_end) {
     out_start = 0;
     out_end = 0;
+    size_t startpos = kdata.lowerBound(query.startDatetime());
+    HKU_IF_RETURN(startpos >= kdata.size(), false);
+    size_t endpos = kdata.lowerBound(query.endDatetime(), startpos);
+    HKU_IF_RETURN(startpos >= endpos, false);
+    out_start = startpos;
+    out_end = endpos;
+    return true;
+}
 
-    const KRecordList& kdata = *(m_data->pKData[query.kType()]);
-    size_t total = kdata.size();
-    HKU_IF_RETURN(0 == total, false);
-
-    size_t mid = total, low = 0, high = total - 1;
-    size_t startpos, endpos;
-    while (low <= high) {
-        if (query.startDatetime() > kdata[high].datetime) {
-            mid = high + 1;
-            break;
-        }
-
-        if (kdata[low].datetime >= query.startDatetime()) {
-            mid = low;
-            break;
-        }
-
-        mid = (low + high) / 2;
-        if (query.startDatetime() > kdata[mid].datetime) {
-            low = mid + 1;
-        } else {
-            high = mid - 1;
-        }
-    }
-
-    if (mid >= total) {
-        return false;
-    }
-
-    startpos = mid;
-
-    low = mid;
-    high = total - 1;
-    while (low <= high) {
-        if (query.endDatetime() > kdata[high].datetime) {
-            mid = high + 1;
-            break;
-        }
+bool Stock::_getIndexRangeByIndex(const KQuery& query, size_t& out_start, size_t& out_end) const {
+    return getIndexRangeByIndex(query, getCount(query.kType()), out_start, out_end);
+}
 
-        if (kdata[low].datetime >= query.endDatetime()) {
-            mid = low;
-            break;
-        }
+bool Stock::_getIndexRangeByDateFromBuffer(const KQuery& query, size_t& out_start,
+                                           size_t& out_end) const {
+    auto snapshot = _getKRecordSnapshot(query.kType());
+    HKU_IF_RETURN(snapshot, getIndexRangeByDate(*snapshot, query, out_start, out_end));
 
-        mid = (low + high) / 2;
-        if (query.endDatetime() > kdata[mid].datetime) {
-            low = mid + 1;
-        } else {
-            high = mid - 1;
-        }
-    }
+    std::shared_lock<std::shared_mutex> lock(*(m_data->pMutex[query.kType()]));
+    out_start = 0;
+    out_end = 0;
 
-    endpos = (mid >= total) ? total : mid;
-    if (startpos >= endpos) {
-        return false;
-    }
+    const auto& columns = m_data->pKColumns[query.kType()];
+    HKU_IF_RETURN(!columns, false);
 
+    size_t startpos = columns->lowerBound(query.startDatetime());
+    size_t endpos = columns->lowerBound(query.endDatetime());
+    HKU_IF_RETURN(startpos >= endpos, false);
     out_start = startpos;
     out_end = endpos;
-
     return true;
 }
 
 KRecord Stock::_getKRecordFromBuffer(size_t pos, const KQuery::KType& ktype) const {
+    auto snapshot = _getKRecordSnapshot(ktype);
+    if (snapshot) {
+        return pos >= snapshot->size() ? KRecord() : (*snapshot)[pos];
+    }
+
     std::shared_lock<std::shared_mutex> lock(*(m_data->pMutex[ktype]));
-    const auto& buf = *(m_data->pKData[ktype]);
-    return pos >= buf.size() ? KRecord() : buf[pos];
+    const auto& columns = m_data->pKColumns[ktype];
+    return (!columns || pos >= columns->size()) ? KRecord() : columns->get(pos);
 }
 
 KRecord Stock::getKRecord(size_t pos, const KQuery::KType& kType) const {
@@ -836,18 +872,105 @@ KRecord Stock::getKRecord(const Datetime& datetime, const KQuery::KType& ktype)
 
 KRecordList Stock::_getKRecordListFromBuffer(size_t start_ix, size_t end_ix,
                                              KQuery::KType ktype) const {
-    std::shared_lock<std::shared_mutex> lock(*(m_data->pMutex[ktype]));
     KRecordList result;
-    size_t total = m_data->pKData[ktype]->size();
+    auto snapshot = _getKRecordSnapshot(ktype);
+    if (snapshot) {
+        size_t total = snapshot->size();
+        HKU_IF_RETURN(total == 0, result);
+        HKU_WARN_IF_RETURN(start_ix >= end_ix || start_ix >= total, result,
+                           "Invalid param (start_ix: {}, end_ix: {})! current total: {}",
+                           start_ix, end_ix, total);
+        return snapshot->toKRecordList(start_ix, end_ix);
+    }
+
+    std::shared_lock<std::shared_mutex> lock(*(m_data->pMutex[ktype]));
+    const auto& columns = m_data->pKColumns[ktype];
+    size_t total = columns ? columns->size() : 0;
     HKU_IF_RETURN(total == 0, result);
     HKU_WARN_IF_RETURN(start_ix >= end_ix || start_ix >= total, result,
                        "Invalid param (start_ix: {}, end_ix: {})! current total: {}", start_ix,
                        end_ix, total);
-    size_t length = end_ix > total ? total - start_ix : end_ix - start_ix;
-    result.resize(length);
-    std::memcpy((void*)&(result.front()), &((*m_data->pKData[ktype])[start_ix]),
-                sizeof(KRecord) * length);
-    return result;
+    return columns->toKRecordList(start_ix, end_ix);
+}
+
+KRecordColumnsView Stock::_getKRecordColumnsFromBuffer(size_t start_ix, size_t end_ix,
+                                                       KQuery::KType ktype) const {
+    KRecordColumnsView result;
+    auto snapshot = _getKRecordSnapshot(ktype);
+    if (snapshot) {
+        size_t total = snapshot->size();
+        HKU_IF_RETURN(total == 0, result);
+        HKU_WARN_IF_RETURN(start_ix >= end_ix || start_ix >= total, result,
+                           "Invalid param (start_ix: {}, end_ix: {})! current total: {}",
+                           start_ix, end_ix, total);
+        if (end_ix > total) {
+            end_ix = total;
+        }
+        const KRecord* ptr = snapshot->contiguous(start_ix, end_ix);
+        return KRecordColumnsView(ptr ? KRecordColumns(ptr, end_ix - start_ix)
+                                      : KRecordColumns(snapshot->toKRecordList(start_ix, end_ix)));
+    }
+
+    // 共享引用列式缓存，不复制数据
+    std::shared_lock<std::shared_mutex> lock(*(m_data->pMutex[ktype]));
+    const auto& columns = m_data->pKColumns[ktype];
+    size_t total = columns ? columns->size() : 0;
+    HKU_IF_RETURN(total == 0, result);
+    HKU_WARN_IF_RETURN(start_ix >= end_ix || start_ix >= total, result,
+                       "Invalid param (start_ix: {}, end_ix: {})! current total: {}", start_ix,
+                       end_ix, total);
+    return KRecordColumnsView(columns, start_ix, end_ix);
+}
+
+KRecordColumns* Stock::_getWritableColumns(const string& ktype) const {
+    auto& columns = m_data->pKColumns[ktype];
+    // 已被 KData 等共享引用时，复制后再修改，不影响已有的引用
+    if (columns && columns.use_count() > 1) {
+        columns = make_shared<KRecordColumns>(*columns);
+    }
+    return columns.get();
+}
+
+KRecordColumnsView Stock::getKRecordColumns(const KQuery& query) const {
+    HKU_IF_RETURN(isNull(), KRecordColumnsView());
+
+    if (KQuery::isBaseKType(query.kType())) {
+        if (isPreload(query.kType()) && !isBuffer(query.kType())) {
+            loadKDataToBuffer(query.kType());
+        }
+
+        if (isBuffer(query.kType())) {
+            size_t start_ix = 0, end_ix = 0;
+            HKU_IF_RETURN(!_getBufferIndexRange(query, start_ix, end_ix), KRecordColumnsView());
+            return _getKRecordColumnsFromBuffer(start_ix, end_ix, query.kType());
+        }
+    }
+
+    return KRecordColumnsView(KRecordColumns(getKRecordList(query)));
+}
+
+KRecordSnapshotPtr Stock::getKRecordSnapshot(const KQuery& query, size_t& out_start,
+                                              size_t& out_end) const {
+    out_start = 0;
+    out_end = 0;
+    HKU_IF_RETURN(isNull() || !KQuery::isBaseKType(query.kType()), KRecordSnapshotPtr());
+
+    if (isPreload(query.kType()) && !isBuffer(query.kType())) {
+        loadKDataToBuffer(query.kType());
+    }
+
+    // 索引范围须在同一快照上计算，避免与实时更新交错
+    auto snapshot = _getKRecordSnapshot(query.kType());
+    HKU_IF_RETURN(!snapshot, snapshot);
+
+    bool success = query.queryType() == KQuery::DATE
+                     ? getIndexRangeByDate(*snapshot, query, out_start, out_end)
+                     : getIndexRangeByIndex(query, snapshot->size(), out_start, out_end);
+    if (!success) {
+        out_start = 0;
+        out_end = 0;
+    }
+    return snapshot;
 }
 
 KRecordList Stock::getKRecordList(const KQuery& query) const {
@@ -873,24 +996,18 @@ KRecordList Stock::_getKRecordList(const KQuery& query) const {
     // 如果是在内存缓存中
     if (isBuffer(query.kType())) {
         size_t start_ix = 0, end_ix = 0;
-        if (query.queryType() == KQuery::DATE) {
-            if (!_getIndexRangeByDateFromBuffer(query, start_ix, end_ix)) {
-                return result;
-            }
-        } else {
-            if (query.start() < 0 || query.end() < 0) {
-                // 处理负数索引
-                if (!getIndexRange(query, start_ix, end_ix)) {
-                    return result;
-                }
-            } else {
-                start_ix = query.start();
-                end_ix = query.end();
-            }
+        if (!_getBufferIndexRange(query, start_ix, end_ix)) {
+            return result;
         }
         result = _getKRecordListFromBuffer(start_ix, end_ix, query.kType());
 
     } else {
+        // 已启用异步加载服务时，经由其缓存加载
+        auto loader = getGlobalKDataLoader();
+        if (loader) {
+            return loader->getKRecordList(*this, query);
+        }
+
         if (query.queryType() == KQuery::DATE) {
             result =
               m_kdataDriver->getConnect()->getKRecordList(m_data->m_market, m_data->m_code, query);
@@ -915,6 +1032,21 @@ KRecordList Stock::_getKRecordList(const KQuery& query) const {
     return result;
 }
 
+bool Stock::_getBufferIndexRange(const KQuery& query, size_t& start_ix, size_t& end_ix) const {
+    if (query.queryType() == KQuery::DATE) {
+        return _getIndexRangeByDateFromBuffer(query, start_ix, end_ix);
+    }
+
+    if (query.start() < 0 || query.end() < 0) {
+        // 处理负数索引
+        return getIndexRange(query, start_ix, end_ix);
+    }
+
+    start_ix = query.start();
+    end_ix = query.end();
+    return true;
+}
+
 DatetimeList Stock::getDatetimeList(const KQuery& query) const {
     DatetimeList result;
     KRecordList k_list = getKRecordList(query);
@@ -978,11 +1110,81 @@ bool Stock::isTransactionTime(Datetime time) {
     return time >= openTime2 && time <= closeTime2 + Seconds(30);
 }
 
+// 同一周期内的实时记录合并至最后一条记录
+static void mergeRealtimeRecord(KRecord& tmp, const KRecord& record) {
+    if (tmp.highPrice < record.highPrice) {
+        tmp.highPrice = record.highPrice;
+    }
+    if (tmp.lowPrice > record.lowPrice) {
+        tmp.lowPrice = record.lowPrice;
+    }
+    tmp.closePrice = record.closePrice;
+    tmp.transAmount = record.transAmount;
+    tmp.transCount = record.transCount;
+}
+
 void Stock::realtimeUpdate(KRecord record, KQuery::KType inktype) {
     HKU_IF_RETURN(!isBuffer(inktype) || record.datetime.isNull() ||
                     StockManager::instance().isHoliday(record.datetime),
                   void());
 
+    string ktype(inktype);
+    to_upper(ktype);
+    _realtimeUpdate(record, ktype);
+}
+
+void Stock::realtimeUpdate(const vector<std::pair<KQuery::KType, KRecord>>& records) {
+    HKU_IF_RETURN(!m_data, void());
+    const StockManager& sm = StockManager::instance();
+    for (const auto& item : records) {
+        const KRecord& record = item.second;
+        if (record.datetime.isNull() || sm.isHoliday(record.datetime)) {
+            continue;
+        }
+        string ktype(item.first);
+        to_upper(ktype);
+        if (m_data->pMutex.find(ktype) != m_data->pMutex.end()) {
+            _realtimeUpdate(record, ktype);
+        }
+    }
+}
+
+void Stock::realtimeUpdate(const KRecord* ks, size_t total, const KQuery::KType& inktype) {
+    HKU_IF_RETURN(total == 0 || !isBuffer(inktype), void());
+
+    // 剔除空日期及节假日记录，并合并日期重复的记录，通常输入已规整，无需复制
+    const StockManager& sm = StockManager::instance();
+    bool need_filter = false;
+    for (size_t i = 0; i < total; i++) {
+        if (ks[i].datetime.isNull() || sm.isHoliday(ks[i].datetime) ||
+            (i > 0 && ks[i].datetime <= ks[i - 1].datetime)) {
+            need_filter = true;
+            break;
+        }
+    }
+
+    KRecordList filtered;
+    if (need_filter) {
+        filtered.reserve(total);
+        for (size_t i = 0; i < total; i++) {
+            const KRecord& k = ks[i];
+            if (k.datetime.isNull() || sm.isHoliday(k.datetime)) {
+                continue;
+            }
+            if (filtered.empty() || filtered.back().datetime < k.datetime) {
+                filtered.push_back(k);
+            } else if (filtered.back().datetime == k.datetime) {
+                mergeRealtimeRecord(filtered.back(), k);
+            } else {
+                HKU_DEBUG("Ignore unordered record, datetime({})! {} {}", k.datetime,
+                          market_code(), inktype);
+            }
+        }
+        ks = filtered.data();
+        total = filtered.size();
+        HKU_IF_RETURN(total == 0, void());
+    }
+
     string ktype(inktype);
     to_upper(ktype);
 
@@ -990,34 +1192,97 @@ void Stock::realtimeUpdate(KRecord record, KQuery::KType inktype) {
     std::unique_lock<std::shared_mutex> lock(*(m_data->pMutex[ktype]));
 
     // 需要对是否已缓存进行二次判定，防止加锁之前缓存被释放
-    if (m_data->pKData.find(ktype) == m_data->pKData.end() || !m_data->pKData[ktype]) {
-        return;
+    HKU_IF_RETURN(m_data->pKData.find(ktype) == m_data->pKData.end(), void());
+
+    auto snapshot = _getKRecordSnapshot(ktype);
+    KRecordColumns* columns = snapshot ? nullptr : _getWritableColumns(ktype);
+    HKU_IF_RETURN(!snapshot && !columns, void());
+
+    // 早于最后一条记录的数据忽略，日期相同的合并至最后一条记录
+    size_t pos = 0;
+    bool has_last = snapshot ? !snapshot->empty() : !columns->empty();
+    if (has_last) {
+        KRecord last = snapshot ? snapshot->back() : columns->back();
+        pos = std::lower_bound(ks, ks + total, last.datetime,
+                               [](const KRecord& k, const Datetime& d) { return k.datetime < d; }) -
+              ks;
+        HKU_DEBUG_IF(pos > 0, "Ignore {} records, datetime < last record.datetime({})! {} {}", pos,
+                     last.datetime, market_code(), inktype);
+        if (pos < total && ks[pos].datetime == last.datetime) {
+            mergeRealtimeRecord(last, ks[pos]);
+            if (snapshot) {
+                snapshot = snapshot->updateLast(last);
+            } else {
+                columns->set(columns->size() - 1, last);
+            }
+            pos++;
+        }
     }
 
-    if (m_data->pKData[ktype]->empty()) {
-        m_data->pKData[ktype]->push_back(record);
+    if (snapshot) {
+        // 行式缓存生成新版本快照后发布
+        if (pos < total) {
+            snapshot = snapshot->append(ks + pos, total - pos);
+        }
+        _setKRecordSnapshot(ktype, std::move(snapshot));
         return;
     }
 
-    KRecord& tmp = m_data->pKData[ktype]->back();
+    // 列式缓存在写锁下更新，被共享引用时已先行复制
+    m_data->m_data_version++;
+    columns->reserve(columns->size() + total - pos);
+    for (size_t i = pos; i < total; i++) {
+        columns->push_back(ks[i]);
+    }
+}
 
-    // 如果传入的记录日期等于最后一条记录日期，则更新最后一条记录；否则，追加入缓存
-    if (tmp.datetime == record.datetime) {
-        if (tmp.highPrice < record.highPrice) {
-            tmp.highPrice = record.highPrice;
+void Stock::_realtimeUpdate(const KRecord& record, const string& ktype) {
+    // 加写锁
+    std::unique_lock<std::shared_mutex> lock(*(m_data->pMutex[ktype]));
+
+    // 需要对是否已缓存进行二次判定，防止加锁之前缓存被释放
+    HKU_IF_RETURN(m_data->pKData.find(ktype) == m_data->pKData.end(), void());
+
+    // 行式缓存生成新版本快照后发布，正在读取旧快照的线程不受影响
+    auto snapshot = _getKRecordSnapshot(ktype);
+    if (snapshot) {
+        if (snapshot->empty()) {
+            _setKRecordSnapshot(ktype, snapshot->append(record));
+            return;
         }
-        if (tmp.lowPrice > record.lowPrice) {
-            tmp.lowPrice = record.lowPrice;
+
+        // 如果传入的记录日期等于最后一条记录日期，则更新最后一条记录；否则，追加入缓存
+        KRecord tmp = snapshot->back();
+        if (tmp.datetime == record.datetime) {
+            mergeRealtimeRecord(tmp, record);
+            _setKRecordSnapshot(ktype, snapshot->updateLast(tmp));
+        } else if (tmp.datetime < record.datetime) {
+            _setKRecordSnapshot(ktype, snapshot->append(record));
+        } else {
+            HKU_DEBUG("Ignore record, datetime({}) < last record.datetime({})! {} {}",
+                      record.datetime, tmp.datetime, market_code(), ktype);
         }
-        tmp.closePrice = record.closePrice;
-        tmp.transAmount = record.transAmount;
-        tmp.transCount = record.transCount;
+        return;
+    }
 
+    // 列式缓存在写锁下更新，被共享引用时先行复制
+    KRecordColumns* columns = _getWritableColumns(ktype);
+    HKU_IF_RETURN(!columns, void());
+    m_data->m_data_version++;
+    if (columns->empty()) {
+        columns->push_back(record);
+        return;
+    }
+
+    KRecord tmp = columns->back();
+    if (tmp.datetime == record.datetime) {
+        mergeRealtimeRecord(tmp, record);
+        columns->set(columns->size() - 1, tmp);
     } else if (tmp.datetime < record.datetime) {
-        m_data->pKData[ktype]->push_back(record);
+        columns->push_back(record);
     } else {
         HKU_DEBUG("Ignore record, datetime({}) < last record.datetime({})! {} {}", record.datetime,
-                  tmp.datetime, market_code(), inktype);
+                  tmp.datetime, market_code(), ktype);
     }
 }
 
@@ -1035,11 +1300,9 @@ void Stock::setKRecordList(const KRecordList& ks, const KQuery::KType& ktype) {
     std::unique_lock<std::shared_mutex> lock(*(m_data->pMutex[ktype]));
     HKU_CHECK(m_data->pKData.find(nktype) != m_data->pKData.end(), "Invalid ktype: {}", ktype);
 
-    if (!m_data->pKData[nktype]) {
-        m_data->pKData[nktype] = new KRecordList();
-    }
+    m_data->pKColumns[nktype].reset();
 
-    (*(m_data->pKData[nktype])) = ks;
+    _setKRecordSnapshot(nktype, make_shared<KRecordSnapshot>(KRecordList(ks)));
 
     Parameter param;
     param.set<string>("type", "DoNothing");
@@ -1064,29 +1327,71 @@ void Stock::setKRecordList(KRecordList&& ks, const KQuery::KType& ktype) {
     std::unique_lock<std::shared_mutex> lock(*(m_data->pMutex[ktype]));
     HKU_CHECK(m_data->pKData.find(nktype) != m_data->pKData.end(), "Invalid ktype: {}", ktype);
 
-    if (!m_data->pKData[nktype]) {
-        m_data->pKData[nktype] = new KRecordList();
-    }
+    m_data->pKColumns[nktype].reset();
 
-    (*m_data->pKData[nktype]) = std::move(ks);
+    Datetime start_date = ks.front().datetime;
+    Datetime last_date = ks.back().datetime;
+    _setKRecordSnapshot(nktype, make_shared<KRecordSnapshot>(std::move(ks)));
 
     Parameter param;
     param.set<string>("type", "DoNothing");
     m_kdataDriver = DataDriverFactory::getKDataDriverPool(param);
 
     m_data->m_valid = true;
-    m_data->m_startDate = (*m_data->pKData[nktype]).front().datetime;
-    m_data->m_lastDate = (*m_data->pKData[nktype]).back().datetime;
+    m_data->m_startDate = start_date;
+    m_data->m_lastDate = last_date;
+}
+
+void Stock::setKRecordColumns(KRecordColumns&& ks, const KQuery::KType& ktype) {
+    HKU_CHECK(
+      isNull(),
+      "The stock is Null, can't set kdata! Please create a stock using the format Stock(market, "
+      "code, name)! Calling Stock() will create a special null instance.");
+
+    HKU_IF_RETURN(ks.empty(), void());
+    string nktype(ktype);
+    to_upper(nktype);
+
+    // 写锁
+    std::unique_lock<std::shared_mutex> lock(*(m_data->pMutex[ktype]));
+    HKU_CHECK(m_data->pKData.find(nktype) != m_data->pKData.end(), "Invalid ktype: {}", ktype);
+
+    _setKRecordSnapshot(nktype, KRecordSnapshotPtr());
+    m_data->pKColumns[nktype] = make_shared<KRecordColumns>(std::move(ks));
+
+    Parameter param;
+    param.set<string>("type", "DoNothing");
+    m_kdataDriver = DataDriverFactory::getKDataDriverPool(param);
+
+    const auto& dates = m_data->pKColumns[nktype]->dates();
+    m_data->m_valid = true;
+    m_data->m_startDate = dates.front().datetime();
+    m_data->m_lastDate = dates.back().datetime();
 }
 
 const vector<HistoryFinanceInfo>& Stock::getHistoryFinance() const {
+    static const vector<HistoryFinanceInfo> null_finance;
+    HKU_IF_RETURN(!m_data, null_finance);
+    auto columns = getHistoryFinanceColumns();
+    std::lock_guard<std::mutex> lock(m_data->m_history_finance_mutex);
+    if (!m_data->m_history_finance_list_ready) {
+        m_data->m_history_finance = columns->toHistoryFinanceList();
+        m_data->m_history_finance_list_ready = true;
+    }
+    return m_data->m_history_finance;
+}
+
+HistoryFinanceColumnsPtr Stock::getHistoryFinanceColumns() const {
+    static const HistoryFinanceColumnsPtr null_columns = std::make_shared<HistoryFinanceColumns>();
+    HKU_IF_RETURN(!m_data, null_columns);
     std::lock_guard<std::mutex> lock(m_data->m_history_finance_mutex);
     if (!m_data->m_history_finance_ready) {
-        m_data->m_history_finance =
-          StockManager::instance().getHistoryFinance(*this, Datetime::min(), Null<Datetime>());
+        m_data->m_history_finance_columns =
+          std::make_shared<const HistoryFinanceColumns>(StockManager::instance().getHistoryFinance(
+            *this, Datetime::min(), Null<Datetime>()));
         m_data->m_history_finance_ready = true;
     }
-    return m_data->m_history_finance;
+    return m_data->m_history_finance_columns;
 }
 
 DatetimeList Stock::getTradingCalendar(const KQuery& query) const {
@@ -12,9 +12,11 @@
 #include <shared_mutex>
 #include "StockWeight.h"
 #include "KQuery.h"
+#include "KRecordColumns.h"
+#include "KRecordSnapshot.h"
 #include "TimeLineRecord.h"
 #include "TransRecord.h"
-#include "HistoryFinanceInfo.h"
+#include "HistoryFinanceColumns.h"
 
 namespace hku {
 
@@ -178,6 +180,24 @@ public:
      */
     KRecordList getKRecordList(const KQuery& query) const;
 
+    /**
+     * 根据查询条件获取列式存储的K线数据视图，不建议在客户端直接使用
+     * @note 该方法不支持复权，如缓存为列式存储，则直接引用缓存中的列数据而不复制，
+     *       否则由 KRecordList 转换
+     * @param query 查询条件
+     */
+    KRecordColumnsView getKRecordColumns(const KQuery& query) const;
+
+    /**
+     * 获取行式缓存的K线快照及查询条件对应的索引范围，不建议在客户端直接使用
+     * @note 不加锁、不复制数据，未缓存或缓存为列式存储时返回空指针
+     * @param query [in] 查询条件
+     * @param out_start [out] 快照中的起始位置
+     * @param out_end [out] 快照中的结束位置，不包含自身
+     */
+    KRecordSnapshotPtr getKRecordSnapshot(const KQuery& query, size_t& out_start,
+                                          size_t& out_end) const;
+
     /** 获取日期列表 */
     DatetimeList getDatetimeList(const KQuery& query) const;
 
@@ -204,6 +224,12 @@ public:
      */
     const vector<HistoryFinanceInfo>& getHistoryFinance() const;
 
+    /**
+     * 获取列式存储的历史财务信息，可直接读取单个字段的时间序列
+     * @return 不会返回空指针，无财务信息时返回空的列式存储
+     */
+    HistoryFinanceColumnsPtr getHistoryFinanceColumns() const;
+
     /**
      * 获取自身市场的交易日日历（不是本身的交易日期）
      * @param query
@@ -232,18 +258,57 @@ public:
      */
     void loadKDataToBuffer(KQuery::KType) const;
 
+    /**
+     * 将已读取的K线数据存入缓存，供批量预加载使用
+     * @note 一般不主动调用，谨慎
+     * @param ktype K线类型，须为预加载类型
+     * @param ks K线数据
+     * @param columnar 是否以列式存储方式缓存
+     * @return 已缓存或非预加载类型时忽略并返回 false
+     */
+    bool setPreloadKRecordList(const KQuery::KType& ktype, KRecordList&& ks, bool columnar) const;
+
     /** 释放对应的K线缓存 */
     void releaseKDataBuffer(KQuery::KType) const;
 
     /** 指定类型的K线数据是否被缓存 */
     bool isBuffer(KQuery::KType) const;
 
+    /** 指定类型的K线数据是否以列式存储方式缓存 */
+    bool isColumnarBuffer(KQuery::KType) const;
+
+    /**
+     * K线缓存及权息数据的版本号，每次变更时递增
+     * @note 仅能反映已缓存数据的变化，供跨证券计算结果的缓存判断是否失效
+     */
+    uint64_t dataVersion() const;
+
     /** 是否为Null */
     bool isNull() const;
 
     /** （临时函数）只用于更新缓存中的K线数据 **/
     void realtimeUpdate(KRecord, KQuery::KType ktype = KQuery::DAY);
 
+    /**
+     * 同时更新多个K线类型缓存中的最后一条记录，如由同一 spot 生成的各周期K线
+     * @param records K线类型及对应的实时记录
+     */
+    void realtimeUpdate(const vector<std::pair<KQuery::KType, KRecord>>& records);
+
+    /**
+     * 批量更新缓存中的K线数据，与最后一条记录日期相同的记录合并，其余追加至缓存
+     * @details 仅加锁一次，存储空间仅扩展一次，早于缓存中最后一条记录的数据将被忽略
+     * @param ks 按日期升序排列的K线记录
+     * @param total 记录数
+     * @param ktype K线类型
+     */
+    void realtimeUpdate(const KRecord* ks, size_t total, const KQuery::KType& ktype);
+
+    /** 同上，批量更新缓存中的K线数据 */
+    void realtimeUpdate(const KRecordList& ks, const KQuery::KType& ktype) {
+        realtimeUpdate(ks.data(), ks.size(), ktype);
+    }
+
     /**
      * 部分临时创建的 Stock, 直接设置KRecordList
      * @note 谨慎调用，通常供外部数据源直接设定数据
@@ -251,6 +316,12 @@ public:
     void setKRecordList(const KRecordList& ks, const KQuery::KType& ktype = KQuery::DAY);
     void setKRecordList(KRecordList&& ks, const KQuery::KType& ktype = KQuery::DAY);
 
+    /**
+     * 同 setKRecordList，但以列式存储方式缓存
+     * @note 谨慎调用，通常供外部数据源直接设定数据
+     */
+    void setKRecordColumns(KRecordColumns&& ks, const KQuery::KType& ktype = KQuery::DAY);
+
     /** 仅用于python的__str__ */
     string toString() const;
 
@@ -259,16 +330,30 @@ private:
 
     // 以下函数属于基础操作添加了读锁
     size_t _getCountFromBuffer(const KQuery::KType& ktype) const;
+    KRecordSnapshotPtr _getKRecordSnapshot(const string& ktype) const;
+    void _setKRecordSnapshot(const string& ktype, KRecordSnapshotPtr&& snapshot) const;
     KRecord _getKRecordFromBuffer(size_t pos, const KQuery::KType& ktype) const;
     KRecordList _getKRecordListFromBuffer(size_t start_ix, size_t end_ix,
                                           KQuery::KType ktype) const;
+    KRecordColumnsView _getKRecordColumnsFromBuffer(size_t start_ix, size_t end_ix,
+                                                    KQuery::KType ktype) const;
+    KRecordColumns* _getWritableColumns(const string& ktype) const;  // 需在写锁下调用
     bool _getIndexRangeByDateFromBuffer(const KQuery&, size_t&, size_t&) const;
 
     KRecordList _getKRecordList(const KQuery& query) const;
 
+    // 将查询条件转换为缓存中的索引范围，仅在已缓存时调用
+    bool _getBufferIndexRange(const KQuery& query, size_t& start_ix, size_t& end_ix) const;
+
+    // 实时更新缓存中的最后一条记录，ktype 须为大写
+    void _realtimeUpdate(const KRecord& record, const string& ktype);
+
     // 仅供 StockManager 初始化时调用
     void setPreload(vector<KQuery::KType>& preload_ktypes);
 
+    // 将K线数据存入缓存，调用者须持有对应的写锁，kType 须为大写
+    void _setPreloadBuffer(const string& kType, KRecordList&& ks, bool columnar) const;
+
     bool isPreload(KQuery::KType ktype) const;
 
 private:
@@ -290,9 +375,11 @@ struct HKU_API Stock::Data {
     StockWeightList m_weightList;  // 权息信息列表
     std::mutex m_weight_mutex;
 
-    mutable vector<HistoryFinanceInfo>
-      m_history_finance;  // 历史财务信息 [财务报告日期, 字段1, 字段2, ...]
+    mutable HistoryFinanceColumnsPtr m_history_finance_columns;  // 列式存储的历史财务信息
     mutable std::atomic_bool m_history_finance_ready{false};
+    mutable vector<HistoryFinanceInfo>
+      m_history_finance;  // 历史财务信息 [财务报告日期, 字段1, 字段2, ...]，按需由列式存储转换
+    mutable bool m_history_finance_list_ready{false};
     mutable std::mutex m_history_finance_mutex;
 
     price_t m_tick;
@@ -303,8 +390,12 @@ struct HKU_API Stock::Data {
     double m_maxTradeNumber;
 
     std::unordered_set<string> m_ktype_preload;  // 记录当前证券的K线数据是否需要预加载
-    unordered_map<string, KRecordList*> pKData;
+    // 行式存储缓存的当前快照，只能通过 std::atomic_load/atomic_store 访问
+    unordered_map<string, KRecordSnapshotPtr> pKData;
+    // 列式存储缓存，与 pKData 同一时刻仅一个有效。可能被 KData 共享引用，修改时如被共享则先复制
+    unordered_map<string, KRecordColumnsPtr> pKColumns;
     unordered_map<string, std::shared_mutex*> pMutex;
+    std::atomic<uint64_t> m_data_version{0};  // K线缓存及权息数据版本
 
     Data();
     Data(const string& market, const string& code, const string& name, uint32_t type, bool valid,
@@ -23,6 +23,8 @@
 #include "plugin/interface/plugins.h"
 #include "plugin/device.h"
 #include "plugin/hkuextra.h"
+#include "global/KDataLoader.h"
+#include "indicator/IndicatorPanel.h"
 
 namespace hku {
 StockManager* StockManager::m_sm = nullptr;
@@ -233,19 +235,14 @@ void StockManager::loadAllKData() {
     auto driver = DataDriverFactory::getKDataDriverPool(m_kdataDriverParam);
     if (!driver->getPrototype()->canParallelLoad()) {
         for (size_t i = 0, len = ktypes.size(); i < len; i++) {
-            for (auto iter = m_stockDict.begin(); iter != m_stockDict.end(); ++iter) {
-                const auto& low_ktype = low_ktypes[i];
-                if (m_preloadParam.tryGet<bool>(low_ktype, false)) {
-                    iter->second.loadKDataToBuffer(ktypes[i]);
-                }
+            if (m_preloadParam.tryGet<bool>(low_ktypes[i], false)) {
+                preloadKData(ktypes[i], nullptr);
             }
         }
 
         if (m_hikyuuParam.tryGet<bool>("load_history_finance", true)) {
             ThreadPool tg;
-            for (auto iter = m_stockDict.begin(); iter != m_stockDict.end(); ++iter) {
-                tg.submit([stk = iter->second]() { stk.getHistoryFinance(); });
-            }
+            loadAllHistoryFinance(&tg);
             tg.join();
         }
 
@@ -256,22 +253,13 @@ void StockManager::loadAllKData() {
         std::thread t = std::thread([this, ktypes, low_ktypes]() {
             this->m_load_tg = std::make_unique<ThreadPool>();
             for (size_t i = 0, len = ktypes.size(); i < len; i++) {
-                std::shared_lock<std::shared_mutex> lock(*m_stockDict_mutex);
-                for (auto iter = m_stockDict.begin(); iter != m_stockDict.end(); ++iter) {
-                    if (m_preloadParam.tryGet<bool>(low_ktypes[i], false)) {
-                        m_load_tg->submit(
-                          [stk = iter->second, ktype = std::move(ktypes[i])]() mutable {
-                              stk.loadKDataToBuffer(ktype);
-                          });
-                    }
+                if (m_preloadParam.tryGet<bool>(low_ktypes[i], false)) {
+                    preloadKData(ktypes[i], m_load_tg.get());
                 }
             }
 
             if (m_hikyuuParam.tryGet<bool>("load_history_finance", true)) {
-                std::shared_lock<std::shared_mutex> lock(*m_stockDict_mutex);
-                for (auto iter = m_stockDict.begin(); iter != m_stockDict.end(); ++iter) {
-                    m_load_tg->submit([stk = iter->second]() { stk.getHistoryFinance(); });
-                }
+                loadAllHistoryFinance(m_load_tg.get());
             }
 
             m_load_tg->join();
@@ -282,11 +270,106 @@ void StockManager::loadAllKData() {
     }
 }
 
+void StockManager::preloadKData(const KQuery::KType& ktype, ThreadPool* tg) {
+    string low_ktype(ktype);
+    to_lower(low_ktype);
+    string preload_key = fmt::format("{}_max", low_ktype);
+    int max_num = m_preloadParam.tryGet<int>(preload_key, 4096);
+    HKU_ERROR_IF_RETURN(max_num < 0, void(), "Invalid preload {} param: {}", preload_key,
+                        max_num);
+    bool columnar = m_preloadParam.tryGet<bool>("columnar", false);
+
+    // 按市场代码排序，使同一市场的证券位于同一批次，便于驱动复用文件或连接
+    auto driver = DataDriverFactory::getKDataDriverPool(m_kdataDriverParam);
+    vector<Stock> stocks;
+    {
+        std::shared_lock<std::shared_mutex> lock(*m_stockDict_mutex);
+        stocks.reserve(m_stockDict.size());
+        for (auto iter = m_stockDict.begin(); iter != m_stockDict.end(); ++iter) {
+            stocks.emplace_back(iter->second);
+        }
+    }
+    HKU_IF_RETURN(stocks.empty(), void());
+    std::sort(stocks.begin(), stocks.end(), [](const Stock& a, const Stock& b) {
+        return a.market_code() < b.market_code();
+    });
+
+    // 每批次一次获取驱动连接并批量读取，各批次在线程池中并行执行
+    struct Progress {
+        std::chrono::steady_clock::time_point start_time;
+        std::atomic<size_t> remain_batch{0};
+        std::atomic<size_t> record_count{0};
+        size_t stock_count{0};
+    };
+    auto progress = std::make_shared<Progress>();
+    progress->start_time = std::chrono::steady_clock::now();
+    progress->stock_count = stocks.size();
+
+    const size_t batch_size = 256;
+    size_t batch_count = (stocks.size() + batch_size - 1) / batch_size;
+    progress->remain_batch = batch_count;
+
+    auto load_batch = [driver, ktype, max_num, columnar, progress](vector<Stock> batch) {
+        vector<std::pair<string, string>> market_codes;
+        vector<Stock> batch_stocks;
+        market_codes.reserve(batch.size());
+        batch_stocks.reserve(batch.size());
+        for (auto& stk : batch) {
+            if (stk.getKDataDirver() == driver) {
+                market_codes.emplace_back(stk.market(), stk.code());
+                batch_stocks.emplace_back(std::move(stk));
+            } else {
+                // 使用其他驱动的证券（如临时 CSV）仍单独加载
+                stk.loadKDataToBuffer(ktype);
+            }
+        }
+
+        if (!market_codes.empty()) {
+            try {
+                driver->getConnect()->getLastKRecordLists(
+                  market_codes, ktype, max_num, [&](size_t i, KRecordList&& ks) {
+                      progress->record_count += ks.size();
+                      batch_stocks[i].setPreloadKRecordList(ktype, std::move(ks), columnar);
+                  });
+            } catch (const std::exception& e) {
+                HKU_ERROR("Failed preload {} kdata! {}", ktype, e.what());
+            } catch (...) {
+                HKU_ERROR("Failed preload {} kdata! Unknown error!", ktype);
+            }
+        }
+
+        if (progress->remain_batch.fetch_sub(1) == 1) {
+            std::chrono::duration<double> sec =
+              std::chrono::steady_clock::now() - progress->start_time;
+            HKU_INFO(htr("{:<.2f}s Preloaded {} kdata, stocks: {}, records: {}"), sec.count(),
+                     ktype, progress->stock_count, progress->record_count.load());
+        }
+    };
+
+    for (size_t i = 0; i < batch_count; i++) {
+        size_t first = i * batch_size;
+        size_t last = std::min(first + batch_size, stocks.size());
+        vector<Stock> batch(stocks.begin() + first, stocks.begin() + last);
+        if (tg) {
+            tg->submit([load_batch, batch = std::move(batch)]() mutable {
+                load_batch(std::move(batch));
+            });
+        } else {
+            load_batch(std::move(batch));
+        }
+    }
+}
+
 void StockManager::reload() {
     HKU_IF_RETURN(m_initializing, void());
     m_initializing = true;
 
     HKU_INFO("start reload ...");
+    auto loader = getGlobalKDataLoader();
+    if (loader) {
+        loader->clear();
+    }
+    IndicatorPanel::clearCache();
     loadData();
     m_initializing = false;
 }
@@ -427,6 +510,16 @@ bool StockManager::isHoliday(const Datetime& d) const {
     return m_holidays.count(d);
 }
 
+void StockManager::realtimeUpdate(const vector<std::pair<Stock, KRecordList>>& updates,
+                                  const KQuery::KType& ktype) {
+    parallel_for(0, updates.size(), [&](size_t i) {
+        Stock stk = updates[i].first;
+        if (!stk.isNull()) {
+            stk.realtimeUpdate(updates[i].second, ktype);
+        }
+    });
+}
+
 Stock StockManager::addTempCsvStock(const string& code, const string& day_filename,
                                     const string& min_filename, price_t tick, price_t tickValue,
                                     int precision, size_t minTradeNumber, size_t maxTradeNumber) {
@@ -555,6 +648,7 @@ void StockManager::loadAllStocks() {
                 stock.m_data->m_minTradeNumber = info.minTradeNumber;
                 stock.m_data->m_maxTradeNumber = info.maxTradeNumber;
                 stock.m_data->m_history_finance_ready = false;
+                stock.m_data->m_history_finance_list_ready = false;
                 // 强制释放所有已缓存K线数据
                 for (const auto& ktype : base_ktypes) {
                     stock.releaseKDataBuffer(ktype);
@@ -631,6 +725,34 @@ void StockManager::loadAllStockWeights() {
     }
 }
 
+void StockManager::loadAllHistoryFinance(ThreadPool* tg) {
+    if (m_context.isAll()) {
+        auto all_finance_dict = m_baseInfoDriver->getAllHistoryFinance();
+        if (!all_finance_dict.empty()) {
+            auto null_finance = std::make_shared<const HistoryFinanceColumns>();
+            std::shared_lock<std::shared_mutex> lock1(*m_stockDict_mutex);
+            for (auto iter = m_stockDict.begin(); iter != m_stockDict.end(); ++iter) {
+                auto finance_iter = all_finance_dict.find(iter->first);
+                Stock& stock = iter->second;
+                std::lock_guard<std::mutex> lock2(stock.m_data->m_history_finance_mutex);
+                stock.m_data->m_history_finance_columns = finance_iter != all_finance_dict.end()
+                                                            ? std::move(finance_iter->second)
+                                                            : null_finance;
+                stock.m_data->m_history_finance.clear();
+                stock.m_data->m_history_finance_list_ready = false;
+                stock.m_data->m_history_finance_ready = true;
+            }
+            return;
+        }
+    }
+
+    // 未加载全部证券或数据驱动不支持批量获取时，逐个证券加载
+    std::shared_lock<std::shared_mutex> lock(*m_stockDict_mutex);
+    for (auto iter = m_stockDict.begin(); iter != m_stockDict.end(); ++iter) {
+        tg->submit([stk = iter->second]() { stk.getHistoryFinanceColumns(); });
+    }
+}
+
 void StockManager::loadAllZhBond10() {
     m_zh_bond10 = m_baseInfoDriver->getAllZhBond10();
 }
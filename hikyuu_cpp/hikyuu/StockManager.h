@@ -187,6 +187,15 @@ public:
      */
     bool isHoliday(const Datetime& d) const;
 
+    /**
+     * 批量更新多个证券缓存中的K线数据，各证券并行处理
+     * @param updates 证券及其按日期升序排列的K线记录
+     * @param ktype K线类型
+     * @see Stock::realtimeUpdate
+     */
+    void realtimeUpdate(const vector<std::pair<Stock, KRecordList>>& updates,
+                        const KQuery::KType& ktype);
+
     const string& getHistoryFinanceFieldName(size_t ix) const;
     size_t getHistoryFinanceFieldIndex(const string& name) const;
     vector<std::pair<size_t, string>> getHistoryFinanceAllFields() const;
@@ -272,6 +281,9 @@ private:
     /* 加载 K线数据至缓存 */
     void loadAllKData();
 
+    /* 分批预加载指定类型的K线数据，tg 为空时在当前线程中执行 */
+    void preloadKData(const KQuery::KType& ktype, ThreadPool* tg);
+
     /* 加载节假日信息 */
     void loadAllHolidays();
 
@@ -293,6 +305,9 @@ private:
     /** 加载历史财经字段索引 */
     void loadHistoryFinanceField();
 
+    /** 加载所有证券的历史财务信息，无法批量加载时逐个证券提交至 tg 加载 */
+    void loadAllHistoryFinance(ThreadPool* tg);
+
 private:
     StockManager();
 
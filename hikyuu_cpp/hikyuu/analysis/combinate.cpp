@@ -75,50 +75,48 @@ vector<CombinateAnalysisOutput> HKU_API combinateIndicatorAnalysisWithBlock(
     size_t total = stocks.size();
     HKU_IF_RETURN(total == 0, result);
 
-    auto work_num = std::thread::hardware_concurrency();
-    ThreadPool tg(work_num);
-    vector<std::future<vector<CombinateAnalysisOutput>>> tasks;
-
-    vector<Stock> buf;
-    auto ranges = parallelIndexRange(0, total);
-    for (const auto& range : ranges) {
-        buf.clear();
-        for (size_t i = range.first; i < range.second; i++) {
-            buf.emplace_back(stocks[i]);
-        }
-        tasks.emplace_back(tg.submit([sgs, stks = std::move(buf), n_query = query,
-                                      n_tm = tm->clone(), n_sys = sys->clone()]() {
-            vector<CombinateAnalysisOutput> ret;
-            Performance per;
-            CombinateAnalysisOutput out;
-            for (size_t i = 0, len = stks.size(); i < len; i++) {
-                const Stock& n_stk = stks[i];
-                for (const auto& sg : sgs) {
-                    try {
-                        auto n_sg = sg->clone();
-                        n_sys->setSG(n_sg);
-                        n_sys->setTM(n_tm);
-                        n_sys->run(n_stk, n_query);
-                        per.statistics(n_tm, Datetime::now());
-                        out.combinateName = n_sg->name();
-                        out.market_code = n_stk.market_code();
-                        out.name = n_stk.name();
-                        out.values = per.values();
-                        ret.emplace_back(out);
-                    } catch (const std::exception& e) {
-                        HKU_ERROR(e.what());
-                    } catch (...) {
-                        HKU_ERROR("Unknown error!");
-                    }
-                }
-            }
-            return ret;
-        }));
+    // tm/sys 的克隆非线程安全，须在当前线程中完成
+    vector<TradeManagerPtr> tms(total);
+    vector<SystemPtr> syss(total);
+    for (size_t i = 0; i < total; i++) {
+        tms[i] = tm->clone();
+        syss[i] = sys->clone();
     }
 
+    // 各股票数据长度不同、计算耗时差异较大，按股票动态分配至全局线程池
+    auto all_records = parallel_for_index(
+      0, total,
+      [&](size_t i) {
+          vector<CombinateAnalysisOutput> ret;
+          const Stock& n_stk = stocks[i];
+          auto& n_tm = tms[i];
+          auto& n_sys = syss[i];
+          Performance per;
+          CombinateAnalysisOutput out;
+          for (const auto& sg : sgs) {
+              try {
+                  auto n_sg = sg->clone();
+                  n_sys->setSG(n_sg);
+                  n_sys->setTM(n_tm);
+                  n_sys->run(n_stk, query);
+                  per.statistics(n_tm, Datetime::now());
+                  out.combinateName = n_sg->name();
+                  out.market_code = n_stk.market_code();
+                  out.name = n_stk.name();
+                  out.values = per.values();
+                  ret.emplace_back(out);
+              } catch (const std::exception& e) {
+                  HKU_ERROR(e.what());
+              } catch (...) {
+                  HKU_ERROR("Unknown error!");
+              }
+          }
+          return ret;
+      },
+      1, ParallelSchedule::GUIDED);
+
     result.reserve(sgs.size() * stocks.size());
-    for (auto& task : tasks) {
-        auto records = task.get();
+    for (auto& records : all_records) {
         for (auto& record : records) {
             result.emplace_back(std::move(record));
         }
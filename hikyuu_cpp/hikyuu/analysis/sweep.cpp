@@ -0,0 +1,201 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-16
+ *      Author: fasiondog
+ */
+
+#include <boost/algorithm/string.hpp>
+#include "hikyuu/StockManager.h"
+#include "hikyuu/indicator/IndicatorSharedCache.h"
+#include "hikyuu/utilities/thread/thread.h"
+#include "sweep.h"
+
+namespace hku {
+
+static void setAnyParam(Parameter& param, const string& name, const boost::any& value) {
+    if (value.type() == typeid(bool)) {
+        param.set<bool>(name, boost::any_cast<bool>(value));
+    } else if (value.type() == typeid(int)) {
+        param.set<int>(name, boost::any_cast<int>(value));
+    } else if (value.type() == typeid(int64_t)) {
+        param.set<int64_t>(name, boost::any_cast<int64_t>(value));
+    } else if (value.type() == typeid(double)) {
+        param.set<double>(name, boost::any_cast<double>(value));
+    } else if (value.type() == typeid(string)) {
+        param.set<string>(name, boost::any_cast<string>(value));
+    } else {
+        HKU_THROW("Unsupported parameter type! name: {}", name);
+    }
+}
+
+vector<Parameter> HKU_API combinateParameter(const std::map<string, vector<boost::any>>& grid) {
+    vector<Parameter> result;
+    HKU_IF_RETURN(grid.empty(), result);
+    for (const auto& item : grid) {
+        HKU_IF_RETURN(item.second.empty(), result);
+    }
+
+    result.emplace_back();
+    for (const auto& item : grid) {
+        vector<Parameter> tmp;
+        tmp.reserve(result.size() * item.second.size());
+        for (const auto& param : result) {
+            for (const auto& value : item.second) {
+                Parameter new_param(param);
+                setAnyParam(new_param, item.first, value);
+                tmp.emplace_back(std::move(new_param));
+            }
+        }
+        result.swap(tmp);
+    }
+    return result;
+}
+
+template <class T>
+static void setPartParam(const T& part, const string& part_name, const string& name,
+                         const boost::any& value) {
+    HKU_CHECK(part, "The system has no {} part!", part_name);
+    Parameter param = part->getParameter();
+    setAnyParam(param, name, value);
+    part->setParameter(param);
+}
+
+static void applySweepParameter(const SystemPtr& sys, const Parameter& params) {
+    for (auto iter = params.begin(); iter != params.end(); ++iter) {
+        auto pos = iter->first.find('.');
+        HKU_CHECK(pos != string::npos && pos > 0 && pos + 1 < iter->first.size(),
+                  "Invalid parameter name: {}, need \"part.name\"!", iter->first);
+        string part = iter->first.substr(0, pos);
+        string name = iter->first.substr(pos + 1);
+        boost::to_upper(part);
+        if ("SYS" == part) {
+            setPartParam(sys, part, name, iter->second);
+            continue;
+        }
+
+        switch (getSystemPartEnum(part)) {
+            case PART_ENVIRONMENT:
+                setPartParam(sys->getEV(), part, name, iter->second);
+                break;
+            case PART_CONDITION:
+                setPartParam(sys->getCN(), part, name, iter->second);
+                break;
+            case PART_SIGNAL:
+                setPartParam(sys->getSG(), part, name, iter->second);
+                break;
+            case PART_STOPLOSS:
+                setPartParam(sys->getST(), part, name, iter->second);
+                break;
+            case PART_TAKEPROFIT:
+                setPartParam(sys->getTP(), part, name, iter->second);
+                break;
+            case PART_MONEYMANAGER:
+                setPartParam(sys->getMM(), part, name, iter->second);
+                break;
+            case PART_PROFITGOAL:
+                setPartParam(sys->getPG(), part, name, iter->second);
+                break;
+            case PART_SLIPPAGE:
+                setPartParam(sys->getSP(), part, name, iter->second);
+                break;
+            default:
+                HKU_THROW("Invalid system part: {}!", part);
+        }
+    }
+}
+
+SystemList HKU_API createSweepSystems(const SystemPtr& proto, const vector<Parameter>& params) {
+    HKU_CHECK(proto, "proto is null!");
+    HKU_CHECK(proto->getTM(), "The proto system has no TradeManager!");
+
+    // 候选系统并行执行，除环境判定外，各部件均不能在候选系统间共享
+    SystemPtr base = proto->clone();
+    for (const char* name : {"shared_tm", "shared_cn", "shared_mm", "shared_sg", "shared_st",
+                             "shared_tp", "shared_pg", "shared_sp"}) {
+        base->setParam<bool>(name, false);
+    }
+
+    SystemList result;
+    result.reserve(params.size());
+    for (const auto& param : params) {
+        SystemPtr sys = base->clone();
+        applySweepParameter(sys, param);
+        result.emplace_back(std::move(sys));
+    }
+    return result;
+}
+
+vector<SweepSystemOutput> HKU_API sweepSystem(const SystemList& candidates, const StockList& stks,
+                                              const KQuery& query) {
+    SPEND_TIME(sweepSystem);
+    vector<SweepSystemOutput> result;
+    size_t total = candidates.size();
+    HKU_IF_RETURN(0 == total || stks.empty(), result);
+
+    // 保证只统计到 query 指定的最后日期，而不是默认到现在，否则仍有持仓的系统收益不合适
+    auto date_list = StockManager::instance().getTradingCalendar(query);
+    HKU_IF_RETURN(date_list.empty(), result);
+    Datetime last_datetime = date_list.back();
+
+    result.reserve(total * stks.size());
+    for (const auto& stk : stks) {
+        if (stk.isNull()) {
+            continue;
+        }
+
+        // 同一证券的K线数据及指标计算结果由全部候选系统共享
+        KData kdata = stk.getKData(query);
+        if (kdata.empty()) {
+            continue;
+        }
+
+        KData src_kdata = kdata;
+        if (query.recoverType() != KQuery::NO_RECOVER) {
+            KQuery no_recover_query = query;
+            no_recover_query.recoverType(KQuery::NO_RECOVER);
+            src_kdata = stk.getKData(no_recover_query);
+        }
+
+        IndicatorSharedCache cache;
+        auto outputs = parallel_for_index(
+          0, total,
+          [&, last_datetime](size_t i) {
+              SweepSystemOutput ret;
+              ret.index = i;
+              ret.market_code = stk.market_code();
+              ret.name = stk.name();
+
+              const auto& sys = candidates[i];
+              HKU_ERROR_IF_RETURN(!sys, ret, "candidates[{}] is null!", i);
+
+              IndicatorSharedCache::Guard guard(cache);
+              try {
+                  sys->run(kdata, src_kdata);
+                  Performance per;
+                  per.statistics(sys->getTM(), last_datetime);
+                  ret.values = per.values();
+              } catch (const std::exception& e) {
+                  HKU_ERROR("candidates[{}] run failed! {}", i, e.what());
+              } catch (...) {
+                  HKU_ERROR("candidates[{}] run failed! Unknown error!", i);
+              }
+              return ret;
+          },
+          1, ParallelSchedule::GUIDED);
+
+        for (auto& out : outputs) {
+            result.emplace_back(std::move(out));
+        }
+    }
+
+    return result;
+}
+
+vector<SweepSystemOutput> HKU_API sweepSystem(const SystemPtr& proto,
+                                              const vector<Parameter>& params,
+                                              const StockList& stks, const KQuery& query) {
+    return sweepSystem(createSweepSystems(proto, params), stks, query);
+}
+
+}  // namespace hku
@@ -0,0 +1,83 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-16
+ *      Author: fasiondog
+ */
+
+#pragma once
+
+#include "hikyuu/trade_sys/system/System.h"
+#include "hikyuu/trade_manage/Performance.h"
+
+namespace hku {
+
+/**
+ * @brief sweepSystem 输出结果定义
+ */
+struct HKU_API SweepSystemOutput {
+    size_t index{0};     ///< 候选系统在候选列表中的索引
+    string market_code;  ///< 证券代码
+    string name;         ///< 证券名称
+    PriceList values;    ///< 统计各项指标值，执行失败时为空
+
+    SweepSystemOutput() = default;
+    SweepSystemOutput(const SweepSystemOutput&) = default;
+    SweepSystemOutput(SweepSystemOutput&& rv)
+    : index(rv.index),
+      market_code(std::move(rv.market_code)),
+      name(std::move(rv.name)),
+      values(std::move(rv.values)) {}
+
+    SweepSystemOutput& operator=(const SweepSystemOutput&) = default;
+    SweepSystemOutput& operator=(SweepSystemOutput&& rv) {
+        HKU_IF_RETURN(this == &rv, *this);
+        index = rv.index;
+        market_code = std::move(rv.market_code);
+        name = std::move(rv.name);
+        values = std::move(rv.values);
+        return *this;
+    }
+};
+
+/**
+ * 按参数网格生成全部参数组合（笛卡尔积）
+ * @param grid 参数名称及其候选取值列表，取值类型支持 bool、int、int64_t、double、string
+ * @return vector<Parameter> 参数组合列表，网格中任一参数无候选值时返回空
+ */
+vector<Parameter> HKU_API combinateParameter(const std::map<string, vector<boost::any>>& grid);
+
+/**
+ * 以原型系统及参数组合生成候选系统列表
+ * @details 参数名称形如 "部件.参数名"，部件为 SYS、EV、CN、MM、SG、ST、TP、PG、SP
+ * （不区分大小写），如 "SG.alternate"、"SYS.buy_delay"。候选系统的部件及交易管理均为
+ * 独立实例，不受原型系统中 shared_xx 参数的影响。
+ * @exception 参数名称格式错误、部件不存在或参数类型不匹配时抛出异常
+ * @param proto 原型系统，须已指定交易管理
+ * @param params 参数组合列表
+ * @return SystemList 与参数组合一一对应
+ */
+SystemList HKU_API createSweepSystems(const SystemPtr& proto, const vector<Parameter>& params);
+
+/**
+ * 参数扫描，对每只证券执行全部候选系统
+ * @details 每只证券仅获取一次K线数据（含复权及未复权数据），由全部候选系统共享；候选系统在
+ * 全局线程池中并行执行，同一证券下各候选系统中等效的指标节点（如大量 SG_Cross 中相同的
+ * MA(CLOSE(), n)）只计算一次。候选系统的交易管理在各证券之间复位后复用。
+ * @note 统计截止至 query 对应的最后交易日
+ * @param candidates 候选系统列表，每一个都应是独立的实例，可由 createSweepSystems 生成
+ * @param stks 证券列表
+ * @param query 查询条件
+ * @return vector<SweepSystemOutput> 按证券、候选系统的顺序排列
+ */
+vector<SweepSystemOutput> HKU_API sweepSystem(const SystemList& candidates, const StockList& stks,
+                                              const KQuery& query);
+
+/**
+ * 以原型系统及参数组合进行参数扫描，参见 createSweepSystems 及 sweepSystem
+ */
+vector<SweepSystemOutput> HKU_API sweepSystem(const SystemPtr& proto,
+                                              const vector<Parameter>& params,
+                                              const StockList& stks, const KQuery& query);
+
+}  // namespace hku
@@ -15,7 +15,7 @@
 #include "../StockTypeInfo.h"
 #include "../Stock.h"
 #include "../ZhBond10.h"
-#include "../HistoryFinanceInfo.h"
+#include "../HistoryFinanceColumns.h"
 #include "../utilities/db_connect/SQLStatementBase.h"
 
 namespace hku {
@@ -166,6 +166,14 @@ public:
         return vector<HistoryFinanceInfo>();
     }
 
+    /**
+     * 批量获取所有证券的历史财务信息
+     * @return 以市场简称证券代码（如 SH600000）为键的列式存储，不支持批量获取时返回空
+     */
+    virtual unordered_map<string, HistoryFinanceColumnsPtr> getAllHistoryFinance() {
+        return unordered_map<string, HistoryFinanceColumnsPtr>();
+    }
+
     /**
      * 获取历史财务信息字段序号与名称
      * @return vector<std::pair<size_t, string>>
@@ -85,6 +85,21 @@ KRecordList KDataDriver::getKRecordList(const string& market, const string& code
     return KRecordList();
 }
 
+void KDataDriver::getLastKRecordLists(const vector<std::pair<string, string>>& market_codes,
+                                      const KQuery::KType& kType, size_t max_num,
+                                      const KRecordListCallback& callback) {
+    for (size_t i = 0, len = market_codes.size(); i < len; i++) {
+        const auto& [market, code] = market_codes[i];
+        KRecordList ks;
+        size_t total = getCount(market, code, kType);
+        if (total > 0) {
+            int64_t start = total <= max_num ? 0 : total - max_num;
+            ks = getKRecordList(market, code, KQuery(start, Null<int64_t>(), kType));
+        }
+        callback(i, std::move(ks));
+    }
+}
+
 TimeLineList KDataDriver::getTimeLineList(const string& market, const string& code,
                                           const KQuery& query) {
     HKU_INFO("The getTimeLineList method has not been implemented! (KDataDriver: {})", m_name);
@@ -9,6 +9,7 @@
 #ifndef KDATADRIVER_H_
 #define KDATADRIVER_H_
 
+#include <functional>
 #include "../utilities/Parameter.h"
 #include "../KQuery.h"
 #include "../TimeLineRecord.h"
@@ -100,6 +101,22 @@ public:
     virtual KRecordList getKRecordList(const string& market, const string& code,
                                        const KQuery& query);
 
+    /** 批量预加载时，每获取一只证券的K线数据后的回调函数，参数为证券在列表中的序号及其K线数据 */
+    typedef std::function<void(size_t, KRecordList&&)> KRecordListCallback;
+
+    /**
+     * 批量获取多只证券最后的 K 线数据，供预加载使用
+     * @note 默认逐只调用 getCount 及 getKRecordList，子类可重载以复用文件、数据集或数据库连接，
+     *       减少每只证券单独查询的开销
+     * @param market_codes 证券列表，每项为（市场简称，证券代码）
+     * @param kType K线类型
+     * @param max_num 每只证券最多获取的记录数，从最后一条记录向前计算
+     * @param callback 每获取一只证券的数据后调用，无数据的证券同样以空列表回调
+     */
+    virtual void getLastKRecordLists(const vector<std::pair<string, string>>& market_codes,
+                                     const KQuery::KType& kType, size_t max_num,
+                                     const KRecordListCallback& callback);
+
     /**
      * 获取分时线
      * @param market 市场简称
@@ -177,6 +194,12 @@ public:
         return m_driver->getKRecordList(market, code, query);
     }
 
+    void getLastKRecordLists(const vector<std::pair<string, string>>& market_codes,
+                             const KQuery::KType& kType, size_t max_num,
+                             const KDataDriver::KRecordListCallback& callback) {
+        m_driver->getLastKRecordLists(market_codes, kType, max_num, callback);
+    }
+
     TimeLineList getTimeLineList(const string& market, const string& code, const KQuery& query) {
         return m_driver->getTimeLineList(market, code, query);
     }
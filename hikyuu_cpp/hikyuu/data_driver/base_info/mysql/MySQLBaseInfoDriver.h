@@ -44,6 +44,7 @@ public:
     virtual vector<std::pair<size_t, string>> getHistoryFinanceField() override;
     virtual vector<HistoryFinanceInfo> getHistoryFinance(const string& market, const string& code,
                                                          Datetime start, Datetime end) override;
+    virtual unordered_map<string, HistoryFinanceColumnsPtr> getAllHistoryFinance() override;
 
 private:
     ConnectPool<MySQLConnect>* m_pool;
@@ -418,4 +418,44 @@ vector<HistoryFinanceInfo> SQLiteBaseInfoDriver::getHistoryFinance(const string&
     return result;
 }
 
+unordered_map<string, HistoryFinanceColumnsPtr> SQLiteBaseInfoDriver::getAllHistoryFinance() {
+    unordered_map<string, HistoryFinanceColumnsPtr> result;
+    HKU_ASSERT(m_pool);
+
+    try {
+        auto con = m_pool->getConnect();
+        HKU_CHECK(con, "Failed fetch connect!");
+
+        // 按证券、发布日期顺序逐行读取，直接追加至各证券的列式存储
+        auto st = con->getStatement(fmt::format("{} order by market_code, report_date",
+                                                HistoryFinanceTable::getSelectSQL()));
+        st->exec();
+
+        uint64_t file_date{0}, report_date{0};
+        string market_code, current_code;
+        vector<char> blob;
+        vector<float> values;
+        shared_ptr<HistoryFinanceColumns> current;
+        while (st->moveNext()) {
+            st->getColumn(1, file_date, report_date, market_code, blob);
+            if (!current || market_code != current_code) {
+                current = std::make_shared<HistoryFinanceColumns>();
+                result[market_code] = current;
+                current_code = market_code;
+            }
+            size_t count = blob.size() / sizeof(float);
+            values.resize(count);
+            memcpy(values.data(), blob.data(), count * sizeof(float));
+            current->push_back(Datetime(file_date), Datetime(report_date), values.data(), count);
+        }
+
+    } catch (const std::exception& e) {
+        HKU_ERROR("Failed load HistoryFinance table! {}", e.what());
+    } catch (...) {
+        HKU_ERROR_UNKNOWN;
+    }
+
+    return result;
+}
+
 }  // namespace hku
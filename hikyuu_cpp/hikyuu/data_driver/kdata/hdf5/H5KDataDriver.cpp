@@ -83,17 +83,46 @@ H5KDataDriver::H5KDataDriver() : KDataDriver("hdf5"), m_h5DataType(H5::CompType(
     m_h5TransType.insertMember("vol", HOFFSET(H5TransRecord, vol), H5::PredType::NATIVE_UINT64);
     m_h5TransType.insertMember("buyorsell", HOFFSET(H5TransRecord, buyorsell),
                                H5::PredType::NATIVE_UINT8);
+
+    m_h5DateType = H5::CompType(sizeof(uint64_t));
+    m_h5DateType.insertMember("datetime", 0, H5::PredType::NATIVE_UINT64);
 }
 
-H5KDataDriver::~H5KDataDriver() {}
+H5KDataDriver::~H5KDataDriver() {
+    // 先关闭数据集，再由 m_h5file_map 关闭文件
+    _clearDatasetCache();
+}
 
 bool H5KDataDriver::_init() {
     // 关闭HDF异常自动打印
     H5::Exception::dontPrint();
 
+    _clearDatasetCache();
+
+    // 缓存的数据集数量，及每个分块（压缩）数据集的块缓存大小，块缓存槽数建议为质数
+    // 每个缓存的数据集各自持有块缓存，缓存数量同时受所有块缓存总大小的限制
+    const char* dataset_cache_size = "dataset_cache_size";
+    const char* chunk_cache_size = "chunk_cache_size";
+    const char* chunk_cache_slots = "chunk_cache_slots";
+    const char* max_chunk_cache_size = "max_chunk_cache_size";
+    size_t chunk_bytes = _getSizeParam(chunk_cache_size, 1024 * 1024);
+    size_t max_chunk_bytes = _getSizeParam(max_chunk_cache_size, 64 * 1024 * 1024);
+    m_dataset_cache_capacity = _getSizeParam(dataset_cache_size, 512);
+    if (chunk_bytes > 0) {
+        m_dataset_cache_capacity =
+          std::min(m_dataset_cache_capacity, std::max<size_t>(max_chunk_bytes / chunk_bytes, 1));
+    }
+    m_dataset_access = H5::DSetAccPropList();
+    m_dataset_access.setChunkCache(_getSizeParam(chunk_cache_slots, 10007), chunk_bytes, 1.0);
+
     StringList keys = m_params.getNameList();
     string filename;
     for (auto iter = keys.begin(); iter != keys.end(); ++iter) {
+        if (*iter == dataset_cache_size || *iter == chunk_cache_size ||
+            *iter == chunk_cache_slots || *iter == max_chunk_cache_size) {
+            continue;
+        }
+
         size_t pos = iter->find("_");
         if (pos == string::npos || pos == 0 || pos == iter->size() - 1)
             continue;
@@ -163,51 +192,6 @@ void H5KDataDriver::H5ReadRecords(H5::DataSet& dataset, hsize_t start, hsize_t n
     return;
 }
 
-void H5KDataDriver::H5ReadIndexRecords(H5::DataSet& dataset, hsize_t start, hsize_t nrecords,
-                                       void* data) {
-    H5::DataSpace dataspace = dataset.getSpace();
-    hsize_t offset[1];
-    hsize_t count[1];
-    offset[0] = start;
-    count[0] = nrecords;
-    H5::DataSpace memspace(1, count);
-    dataspace.selectHyperslab(H5S_SELECT_SET, count, offset);
-    dataset.read(data, m_h5IndexType, memspace, dataspace);
-    memspace.close();
-    dataspace.close();
-    return;
-}
-
-void H5KDataDriver::H5ReadTimeLineRecords(H5::DataSet& dataset, hsize_t start, hsize_t nrecords,
-                                          void* data) {
-    H5::DataSpace dataspace = dataset.getSpace();
-    hsize_t offset[1];
-    hsize_t count[1];
-    offset[0] = start;
-    count[0] = nrecords;
-    H5::DataSpace memspace(1, count);
-    dataspace.selectHyperslab(H5S_SELECT_SET, count, offset);
-    dataset.read(data, m_h5TimeLineType, memspace, dataspace);
-    memspace.close();
-    dataspace.close();
-    return;
-}
-
-void H5KDataDriver::H5ReadTransRecords(H5::DataSet& dataset, hsize_t start, hsize_t nrecords,
-                                       void* data) {
-    H5::DataSpace dataspace = dataset.getSpace();
-    hsize_t offset[1];
-    hsize_t count[1];
-    offset[0] = start;
-    count[0] = nrecords;
-    H5::DataSpace memspace(1, count);
-    dataspace.selectHyperslab(H5S_SELECT_SET, count, offset);
-    dataset.read(data, m_h5TransType, memspace, dataspace);
-    memspace.close();
-    dataspace.close();
-    return;
-}
-
 bool H5KDataDriver::_getH5FileAndGroup(const string& market, const string& code,
                                        KQuery::KType kType, H5FilePtr& out_file,
                                        H5::Group& out_group) {
@@ -277,28 +261,124 @@ bool H5KDataDriver::_getH5FileAndGroup(const string& market, const string& code,
     return true;
 }
 
-size_t H5KDataDriver::getCount(const string& market, const string& code,
-                               const KQuery::KType& kType) {
+size_t H5KDataDriver::_getSizeParam(const string& name, size_t default_value) {
+    HKU_IF_RETURN(!haveParam(name), default_value);
+    try {
+        // 配置文件中的参数为字符串
+        return std::stoull(getParam<string>(name));
+    } catch (...) {
+    }
+
+    try {
+        int value = getParam<int>(name);
+        HKU_IF_RETURN(value >= 0, static_cast<size_t>(value));
+    } catch (...) {
+    }
+
+    HKU_WARN("Invalid param {}, use default value: {}", name, default_value);
+    return default_value;
+}
+
+H5KDataDriver::H5DatasetCachePtr H5KDataDriver::_getDataset(const string& market,
+                                                            const string& code,
+                                                            const KQuery::KType& kType) {
+    string key(format("{}_{}_{}", market, kType, code));
+    to_upper(key);
+    auto iter = m_dataset_map.find(key);
+    if (iter != m_dataset_map.end()) {
+        m_dataset_lru.splice(m_dataset_lru.begin(), m_dataset_lru, iter->second.second);
+        return iter->second.first;
+    }
+
     H5FilePtr h5file;
     H5::Group group;
-    HKU_IF_RETURN(!_getH5FileAndGroup(market, code, kType, h5file, group), 0);
+    HKU_IF_RETURN(!_getH5FileAndGroup(market, code, kType, h5file, group), H5DatasetCachePtr());
 
-    size_t total = 0;
+    H5DatasetCachePtr result = make_shared<H5DatasetCache>();
     try {
         string tablename(market + code);
-        CHECK_DATASET_EXISTS_RET(group, tablename, total);
-        H5::DataSet dataset(group.openDataSet(tablename));
-        H5::DataSpace dataspace = dataset.getSpace();
-        total = dataspace.getSelectNpoints();
-        dataspace.close();
-        dataset.close();
+        CHECK_DATASET_EXISTS_RET(group, tablename, H5DatasetCachePtr());
+        result->dataset = group.openDataSet(tablename, m_dataset_access);
+        result->dataspace = result->dataset.getSpace();
+        result->total = result->dataspace.getSelectNpoints();
     } catch (...) {
-        // HKU_WARN("Exception of some HDF5 operator! stock: {}{} {}", market, code,
-        //         KQuery::getKTypeName(kType));
-        total = 0;
+        return H5DatasetCachePtr();
     }
 
-    return total;
+    HKU_IF_RETURN(m_dataset_cache_capacity == 0, result);
+    m_dataset_lru.push_front(key);
+    m_dataset_map[key] = std::make_pair(result, m_dataset_lru.begin());
+    while (m_dataset_lru.size() > m_dataset_cache_capacity) {
+        m_dataset_map.erase(m_dataset_lru.back());
+        m_dataset_lru.pop_back();
+    }
+    return result;
+}
+
+void H5KDataDriver::_clearDatasetCache() {
+    m_dataset_map.clear();
+    m_dataset_lru.clear();
+}
+
+void H5KDataDriver::_readRecords(H5DatasetCache& cache, const H5::DataType& type, hsize_t start,
+                                 hsize_t nrecords, void* data) {
+    hsize_t offset[1] = {start};
+    hsize_t count[1] = {nrecords};
+    H5::DataSpace memspace(1, count);
+    cache.dataspace.selectHyperslab(H5S_SELECT_SET, count, offset);
+    cache.dataset.read(data, type, memspace, cache.dataspace);
+}
+
+hsize_t H5KDataDriver::_lowerBoundByDate(H5DatasetCache& cache, uint64_t number) {
+    HKU_IF_RETURN(cache.total == 0, 0);
+
+    // 首次查询时按固定间隔一次性读取日期列建立采样索引，之后每次查询最多读取一个采样区间，
+    // 避免逐条读取（压缩的分块数据集每次读取都需要解压整个数据块）
+    if (cache.date_step == 0) {
+        const hsize_t max_samples = 8192;
+        hsize_t step =
+          cache.total <= max_samples ? 1 : (cache.total + max_samples - 1) / max_samples;
+        hsize_t offset[1] = {0};
+        hsize_t count[1] = {(cache.total + step - 1) / step};
+        hsize_t stride[1] = {step};
+        cache.dates.resize(count[0]);
+        H5::DataSpace memspace(1, count);
+        cache.dataspace.selectHyperslab(H5S_SELECT_SET, count, offset, stride);
+        cache.dataset.read(cache.dates.data(), m_h5DateType, memspace, cache.dataspace);
+        cache.date_step = step;
+    }
+
+    const auto& dates = cache.dates;
+    hsize_t pos = std::lower_bound(dates.begin(), dates.end(), number) - dates.begin();
+    HKU_IF_RETURN(cache.date_step == 1 || pos == 0, pos * cache.date_step);
+
+    // 结果位于 ((pos - 1) * step, pos * step] 之间
+    hsize_t block_start = (pos - 1) * cache.date_step + 1;
+    hsize_t block_end = std::min(pos * cache.date_step, cache.total);
+    HKU_IF_RETURN(block_start >= block_end, block_end);
+
+    std::vector<uint64_t> block(block_end - block_start);
+    _readRecords(cache, m_h5DateType, block_start, block.size(), block.data());
+    return block_start + (std::lower_bound(block.begin(), block.end(), number) - block.begin());
+}
+
+bool H5KDataDriver::_getRangeByDate(H5DatasetCache& cache, uint64_t start_number,
+                                    uint64_t end_number, size_t& out_start, size_t& out_end) {
+    out_start = 0;
+    out_end = 0;
+    hsize_t startpos = _lowerBoundByDate(cache, start_number);
+    HKU_IF_RETURN(startpos >= cache.total, false);
+    hsize_t endpos = _lowerBoundByDate(cache, end_number);
+    HKU_IF_RETURN(startpos >= endpos, false);
+    out_start = startpos;
+    out_end = endpos;
+    return true;
+}
+
+size_t H5KDataDriver::getCount(const string& market, const string& code,
+                               const KQuery::KType& kType) {
+    H5DatasetCachePtr cache = _getDataset(market, code, kType);
+    return cache ? cache->total : 0;
 }
 
 bool H5KDataDriver::getIndexRangeByDate(const string& market, const string& code,
@@ -329,109 +409,23 @@ bool H5KDataDriver::_getBaseIndexRangeByDate(const string& market, const string&
         return false;
     }
 
-    H5FilePtr h5file;
-    H5::Group group;
-    bool success;
-    success = _getH5FileAndGroup(market, code, query.kType(), h5file, group);
-    HKU_IF_RETURN(!success, false);
+    H5DatasetCachePtr cache = _getDataset(market, code, query.kType());
+    HKU_IF_RETURN(!cache, false);
 
-    H5::DataSet dataset;
-    H5::DataSpace dataspace;
-    hsize_t startpos = 0, endpos = 0;
     try {
-        uint64_t start_number = query.startDatetime().number();
-        uint64_t end_number = query.endDatetime().number();
-        string tablename(market + code);
-        CHECK_DATASET_EXISTS_RET(group, tablename, false);
-        dataset = group.openDataSet(tablename);
-        dataspace = dataset.getSpace();
-        hsize_t total = dataspace.getSelectNpoints();
-        if (0 == total) {
-            return false;
-        }
-
-        hsize_t mid, low = 0, high = total - 1;
-        H5Record h5record;
-        while (low <= high) {
-            H5ReadRecords(dataset, high, 1, &h5record);
-            if (start_number > h5record.datetime) {
-                mid = high + 1;
-                break;
-            }
-
-            H5ReadRecords(dataset, low, 1, &h5record);
-            if (h5record.datetime >= start_number) {
-                mid = low;
-                break;
-            }
-
-            mid = (low + high) / 2;
-            H5ReadRecords(dataset, mid, 1, &h5record);
-            if (start_number > h5record.datetime) {
-                low = mid + 1;
-            } else {
-                high = mid - 1;
-            }
-        }
-
-        if (mid >= total) {
-            dataspace.close();
-            dataset.close();
-            return false;
-        }
-
-        startpos = mid;
-
-        low = mid;
-        high = total - 1;
-        while (low <= high) {
-            H5ReadRecords(dataset, high, 1, &h5record);
-            if (end_number > h5record.datetime) {
-                mid = high + 1;
-                break;
-            }
-
-            H5ReadRecords(dataset, low, 1, &h5record);
-            if (h5record.datetime >= end_number) {
-                mid = low;
-                break;
-            }
-
-            mid = (low + high) / 2;
-            H5ReadRecords(dataset, mid, 1, &h5record);
-            if (end_number > h5record.datetime) {
-                low = mid + 1;
-            } else {
-                high = mid - 1;
-            }
-        }
-
-        endpos = mid >= total ? total : mid;
-        if (startpos >= endpos) {
-            dataspace.close();
-            dataset.close();
-            return false;
-        }
-
-        dataspace.close();
-        dataset.close();
+        return _getRangeByDate(*cache, query.startDatetime().number(),
+                               query.endDatetime().number(), out_start, out_end);
 
     } catch (std::out_of_range&) {
         HKU_WARN("Invalid datetime!");
-        dataspace.close();
-        dataset.close();
-        return false;
 
     } catch (...) {
         HKU_INFO("error in {}{}", market, code);
-        dataspace.close();
-        dataset.close();
     }
 
-    out_start = startpos;
-    out_end = endpos;
-
-    return true;
+    out_start = 0;
+    out_end = 0;
+    return false;
 }
 
 bool H5KDataDriver::_getOtherIndexRangeByDate(const string& market, const string& code,
@@ -447,91 +441,18 @@ bool H5KDataDriver::_getOtherIndexRangeByDate(const string& market, const string
     out_end = 0;
     HKU_IF_RETURN(query.startDatetime() >= query.endDatetime(), false);
 
-    H5FilePtr h5file;
-    H5::Group group;
-    HKU_IF_RETURN(!_getH5FileAndGroup(market, code, query.kType(), h5file, group), false);
+    // 索引表中的 datetime 字段与K线记录同名，可使用相同的日期索引查找
+    H5DatasetCachePtr cache = _getDataset(market, code, query.kType());
+    HKU_IF_RETURN(!cache, false);
 
-    string _tablename(market + code);
     try {
-        CHECK_DATASET_EXISTS_RET(group, _tablename, false);
-        H5::DataSet dataset(group.openDataSet(_tablename));
-        H5::DataSpace dataspace = dataset.getSpace();
-        size_t total = dataspace.getSelectNpoints();
-        if (0 == total) {
-            return false;
-        }
-
-        size_t mid = total, low = 0, high = total - 1;
-        uint64_t startDatetime = query.startDatetime().number();
-        H5IndexRecord h5record;
-        while (low <= high) {
-            H5ReadIndexRecords(dataset, high, 1, &h5record);
-            if (startDatetime > h5record.datetime) {
-                mid = high + 1;
-                break;
-            }
-            H5ReadIndexRecords(dataset, low, 1, &h5record);
-            if (h5record.datetime >= startDatetime) {
-                mid = low;
-                break;
-            }
-
-            mid = (low + high) / 2;
-            H5ReadIndexRecords(dataset, mid, 1, &h5record);
-            if (h5record.datetime < startDatetime) {
-                low = mid + 1;
-            } else {
-                high = mid - 1;
-            }
-        }
-
-        if (mid >= total) {
-            out_start = 0;
-            out_end = 0;
-            return false;
-        }
-
-        out_start = mid;
-
-        uint64_t endDatetime = query.endDatetime().number();
-        low = mid, high = total - 1;
-        while (low <= high) {
-            H5ReadIndexRecords(dataset, high, 1, &h5record);
-            if (h5record.datetime < endDatetime) {
-                mid = high + 1;
-                break;
-            }
-
-            H5ReadIndexRecords(dataset, low, 1, &h5record);
-            if (h5record.datetime >= endDatetime) {
-                mid = low;
-                break;
-            }
-
-            mid = (low + high) / 2;
-            H5ReadIndexRecords(dataset, mid, 1, &h5record);
-            if (h5record.datetime < endDatetime) {
-                low = mid + 1;
-            } else {
-                high = mid - 1;
-            }
-        }
-
-        out_end = mid >= total ? total : mid;
-
-        if (out_start >= out_end) {
-            out_start = 0;
-            out_end = 0;
-            return false;
-        }
-
+        return _getRangeByDate(*cache, query.startDatetime().number(),
+                               query.endDatetime().number(), out_start, out_end);
     } catch (...) {
         out_start = 0;
         out_end = 0;
         return false;
     }
-
-    return true;
 }
 
 KRecordList H5KDataDriver::getKRecordList(const string& market, const string& code,
@@ -568,23 +489,18 @@ KRecordList H5KDataDriver::_getBaseKRecordList(const string& market, const strin
                                                const KQuery::KType& kType, size_t start_ix,
                                                size_t end_ix) {
     KRecordList result;
-    H5FilePtr h5file;
-    H5::Group group;
-    HKU_IF_RETURN(!_getH5FileAndGroup(market, code, kType, h5file, group), result);
+    H5DatasetCachePtr cache = _getDataset(market, code, kType);
+    HKU_IF_RETURN(!cache, result);
 
     try {
-        string tablename(format("{}{}", market, code));
-        CHECK_DATASET_EXISTS_RET(group, tablename, result);
-        H5::DataSet dataset(group.openDataSet(tablename));
-        H5::DataSpace dataspace = dataset.getSpace();
-        size_t all_total = dataspace.getSelectNpoints();
+        size_t all_total = cache->total;
         if (0 == all_total || start_ix >= all_total) {
             return result;
         }
 
         size_t total = end_ix > all_total ? all_total - start_ix : end_ix - start_ix;
         std::unique_ptr<H5Record[]> pBuf = std::make_unique<H5Record[]>(total);
-        H5ReadRecords(dataset, start_ix, total, pBuf.get());
+        _readRecords(*cache, m_h5DataType, start_ix, total, pBuf.get());
 
         KRecord record;
         result.reserve(total + 2);
@@ -612,29 +528,103 @@ KRecordList H5KDataDriver::_getBaseKRecordList(const string& market, const strin
     return result;
 }
 
+void H5KDataDriver::getLastKRecordLists(const vector<std::pair<string, string>>& market_codes,
+                                        const KQuery::KType& kType, size_t max_num,
+                                        const KRecordListCallback& callback) {
+    if (KQuery::DAY != kType && KQuery::MIN5 != kType && KQuery::MIN != kType) {
+        KDataDriver::getLastKRecordLists(market_codes, kType, max_num, callback);
+        return;
+    }
+
+    // 同一市场的证券位于同一文件的同一分组中，按市场只打开一次分组，数据集只打开一次，
+    // 读取缓冲区在各证券之间复用
+    string cur_market;
+    H5FilePtr h5file;
+    H5::Group group;
+    bool group_valid = false;
+    std::vector<H5Record> buf;
+    for (size_t i = 0, len = market_codes.size(); i < len; i++) {
+        const auto& [market, code] = market_codes[i];
+        if (i == 0 || market != cur_market) {
+            cur_market = market;
+            group_valid = _getH5FileAndGroup(market, code, kType, h5file, group);
+        }
+
+        KRecordList ks;
+        if (group_valid) {
+            ks = _getLastBaseKRecordList(group, format("{}{}", market, code), max_num, buf);
+        }
+        callback(i, std::move(ks));
+    }
+}
+
+KRecordList H5KDataDriver::_getLastBaseKRecordList(H5::Group& group, const string& tablename,
+                                                   size_t max_num, std::vector<H5Record>& buf) {
+    KRecordList result;
+    try {
+        CHECK_DATASET_EXISTS_RET(group, tablename, result);
+        H5::DataSet dataset(group.openDataSet(tablename));
+        H5::DataSpace dataspace = dataset.getSpace();
+        size_t all_total = dataspace.getSelectNpoints();
+        dataspace.close();
+        if (0 == all_total || 0 == max_num) {
+            return result;
+        }
+
+        size_t start_ix = all_total <= max_num ? 0 : all_total - max_num;
+        size_t total = all_total - start_ix;
+        if (buf.size() < total) {
+            buf.resize(total);
+        }
+        H5ReadRecords(dataset, start_ix, total, buf.data());
+
+        result.resize(total);
+        for (size_t i = 0; i < total; i++) {
+            KRecord& record = result[i];
+            record.datetime = Datetime(buf[i].datetime);
+            record.openPrice = price_t(buf[i].openPrice) * 0.001;
+            record.highPrice = price_t(buf[i].highPrice) * 0.001;
+            record.lowPrice = price_t(buf[i].lowPrice) * 0.001;
+            record.closePrice = price_t(buf[i].closePrice) * 0.001;
+            record.transAmount = price_t(buf[i].transAmount) * 0.1;
+            record.transCount = price_t(buf[i].transCount);
+        }
+
+    } catch (std::out_of_range& e) {
+        HKU_WARN("Invalid date! {} {}", tablename, e.what());
+        result.clear();
+
+    } catch (std::exception& e) {
+        HKU_WARN(e.what());
+        result.clear();
+
+    } catch (...) {
+        // 忽略
+        result.clear();
+    }
+
+    return result;
+}
+
 KRecordList H5KDataDriver::_getIndexKRecordList(const string& market, const string& code,
                                                 const KQuery::KType& kType, size_t start_ix,
                                                 size_t end_ix) {
     KRecordList result;
-    string tablename(format("{}{}", market, code));
-    H5FilePtr h5file;
-    H5::Group index_group;
-    HKU_IF_RETURN(!_getH5FileAndGroup(market, code, kType, h5file, index_group), result);
+    bool is_minute = KQuery::MIN15 == kType || KQuery::MIN30 == kType ||
+                     KQuery::MIN60 == kType || KQuery::HOUR2 == kType;
+    H5DatasetCachePtr index_cache = _getDataset(market, code, kType);
+    HKU_IF_RETURN(!index_cache, result);
+    H5DatasetCachePtr base_cache =
+      _getDataset(market, code, is_minute ? KQuery::MIN5 : KQuery::DAY);
+    HKU_IF_RETURN(!base_cache, result);
 
     try {
-        H5::Group base_group = h5file->openGroup("data");
-        CHECK_DATASET_EXISTS_RET(base_group, tablename, result);
-        H5::DataSet base_dataset(base_group.openDataSet(tablename));
-        H5::DataSpace base_dataspace = base_dataset.getSpace();
-        size_t base_total = base_dataspace.getSelectNpoints();
+        size_t base_total = base_cache->total;
         if (0 == base_total) {
             return result;
         }
 
-        CHECK_DATASET_EXISTS_RET(index_group, tablename, result);
-        H5::DataSet index_dataset(index_group.openDataSet(tablename));
-        H5::DataSpace index_dataspace = index_dataset.getSpace();
-        size_t index_total = index_dataspace.getSelectNpoints();
+        size_t index_total = index_cache->total;
         if (0 == index_total || start_ix >= index_total) {
             return result;
         }
@@ -643,16 +633,18 @@ KRecordList H5KDataDriver::_getIndexKRecordList(const string& market, const stri
         std::unique_ptr<H5IndexRecord[]> p_index_buf =
           std::make_unique<H5IndexRecord[]>(index_len + 1);
         if (end_ix >= index_total) {
-            H5ReadIndexRecords(index_dataset, start_ix, index_len, p_index_buf.get());
+            _readRecords(*index_cache, m_h5IndexType, start_ix, index_len, p_index_buf.get());
             p_index_buf[index_len].start = base_total;
         } else {
             index_len = end_ix - start_ix;
-            H5ReadIndexRecords(index_dataset, start_ix, index_len + 1, p_index_buf.get());
+            _readRecords(*index_cache, m_h5IndexType, start_ix, index_len + 1,
+                         p_index_buf.get());
         }
 
         size_t base_len = p_index_buf[index_len].start - p_index_buf[0].start;
         std::unique_ptr<H5Record[]> p_base_buf = std::make_unique<H5Record[]>(base_len);
-        H5ReadRecords(base_dataset, p_index_buf[0].start, base_len, p_base_buf.get());
+        _readRecords(*base_cache, m_h5DataType, p_index_buf[0].start, base_len,
+                     p_base_buf.get());
 
         KRecord record;
         result.reserve(index_len);
@@ -701,16 +693,11 @@ TimeLineList H5KDataDriver::getTimeLineList(const string& market, const string&
 TimeLineList H5KDataDriver::_getTimeLine(const string& market, const string& code, int64_t start_ix,
                                          int64_t end_ix) {
     TimeLineList result;
-    H5FilePtr h5file;
-    H5::Group group;
-    HKU_IF_RETURN(!_getH5FileAndGroup(market, code, "TIME", h5file, group), result);
+    H5DatasetCachePtr cache = _getDataset(market, code, "TIME");
+    HKU_IF_RETURN(!cache, result);
 
     try {
-        string tablename(market + code);
-        CHECK_DATASET_EXISTS_RET(group, tablename, result);
-        H5::DataSet dataset(group.openDataSet(tablename));
-        H5::DataSpace dataspace = dataset.getSpace();
-        size_t all_total = dataspace.getSelectNpoints();
+        size_t all_total = cache->total;
         if (0 == all_total) {
             return result;
         }
@@ -743,7 +730,7 @@ TimeLineList H5KDataDriver::_getTimeLine(const string& market, const string& cod
 
         size_t total = endpos - startpos;
         std::unique_ptr<H5TimeLineRecord[]> pBuf = std::make_unique<H5TimeLineRecord[]>(total);
-        H5ReadTimeLineRecords(dataset, start_ix, total, pBuf.get());
+        _readRecords(*cache, m_h5TimeLineType, start_ix, total, pBuf.get());
 
         TimeLineRecord record;
         result.reserve(total + 2);
@@ -772,117 +759,18 @@ TimeLineList H5KDataDriver::_getTimeLine(const string& market, const string& cod
     TimeLineList result;
     HKU_IF_RETURN(start >= end || start > Datetime::max(), result);
 
-    H5FilePtr h5file;
-    H5::Group group;
-    bool success;
-    success = _getH5FileAndGroup(market, code, "TIME", h5file, group);
-    HKU_IF_RETURN(!success, result);
+    H5DatasetCachePtr cache = _getDataset(market, code, "TIME");
+    HKU_IF_RETURN(!cache, result);
 
-    H5::DataSet dataset;
-    H5::DataSpace dataspace;
-    hsize_t startpos = 0, endpos = 0;
     try {
-        uint64_t start_number = start.number();
-        uint64_t end_number = end.number();
-        string tablename(market + code);
-        CHECK_DATASET_EXISTS_RET(group, tablename, result);
-        dataset = group.openDataSet(tablename);
-        dataspace = dataset.getSpace();
-        hsize_t total = dataspace.getSelectNpoints();
-        if (0 == total) {
-            return result;
-        }
-
-        hsize_t mid, low = 0, high = total - 1;
-        H5TimeLineRecord h5record;
-        while (low <= high) {
-            H5ReadTimeLineRecords(dataset, high, 1, &h5record);
-            if (start_number > h5record.datetime) {
-                mid = high + 1;
-                break;
-            }
-
-            H5ReadTimeLineRecords(dataset, low, 1, &h5record);
-            if (h5record.datetime >= start_number) {
-                mid = low;
-                break;
-            }
-
-            mid = (low + high) / 2;
-            H5ReadTimeLineRecords(dataset, mid, 1, &h5record);
-            if (start_number > h5record.datetime) {
-                low = mid + 1;
-            } else {
-                high = mid - 1;
-            }
-        }
-
-        if (mid >= total) {
-            dataspace.close();
-            dataset.close();
+        size_t startpos = 0, endpos = 0;
+        if (!_getRangeByDate(*cache, start.number(), end.number(), startpos, endpos)) {
             return result;
         }
 
-        startpos = mid;
-
-        low = mid;
-        high = total - 1;
-        while (low <= high) {
-            H5ReadTimeLineRecords(dataset, high, 1, &h5record);
-            if (end_number > h5record.datetime) {
-                mid = high + 1;
-                break;
-            }
-
-            H5ReadTimeLineRecords(dataset, low, 1, &h5record);
-            if (h5record.datetime >= end_number) {
-                mid = low;
-                break;
-            }
-
-            mid = (low + high) / 2;
-            H5ReadTimeLineRecords(dataset, mid, 1, &h5record);
-            if (end_number > h5record.datetime) {
-                low = mid + 1;
-            } else {
-                high = mid - 1;
-            }
-        }
-
-        endpos = mid >= total ? total : mid;
-        if (startpos >= endpos) {
-            dataspace.close();
-            dataset.close();
-            return result;
-        }
-
-        dataspace.close();
-        dataset.close();
-
-    } catch (std::out_of_range&) {
-        HKU_WARN("Invalid datetime!");
-        dataspace.close();
-        dataset.close();
-        return result;
-
-    } catch (...) {
-        HKU_INFO("error in {}{}", market, code);
-        dataspace.close();
-        dataset.close();
-        return result;
-    }
-
-    if (startpos >= endpos) {
-        return result;
-    }
-
-    try {
-        string tablename(market + code);
-        CHECK_DATASET_EXISTS_RET(group, tablename, result);
-        dataset = group.openDataSet(tablename);
         size_t total = endpos - startpos;
         std::unique_ptr<H5TimeLineRecord[]> pBuf = std::make_unique<H5TimeLineRecord[]>(total);
-        H5ReadTimeLineRecords(dataset, startpos, total, pBuf.get());
+        _readRecords(*cache, m_h5TimeLineType, startpos, total, pBuf.get());
 
         TimeLineRecord record;
         result.reserve(total + 2);
@@ -913,19 +801,30 @@ TransList H5KDataDriver::getTransList(const string& market, const string& code,
              : _getTransList(market, code, query.startDatetime(), query.endDatetime());
 }
 
+static void H5TransRecordsToTransList(const H5TransRecord* pBuf, size_t total, TransList& result) {
+    TransRecord record;
+    result.reserve(total + 2);
+    for (hsize_t i = 0; i < total; i++) {
+        uint64_t number = pBuf[i].datetime / 100;
+        uint64_t second = pBuf[i].datetime - number * 100;
+        Datetime d(number);
+        record.datetime =
+          Datetime(d.year(), d.month(), d.day(), d.hour(), d.minute(), (long)second);
+        record.price = price_t(pBuf[i].price) * 0.001;
+        record.vol = price_t(pBuf[i].vol);
+        record.direct = int(pBuf[i].buyorsell);
+        result.push_back(record);
+    }
+}
+
 TransList H5KDataDriver::_getTransList(const string& market, const string& code, int64_t start_ix,
                                        int64_t end_ix) {
     TransList result;
-    H5FilePtr h5file;
-    H5::Group group;
-    HKU_IF_RETURN(!_getH5FileAndGroup(market, code, "TRANS", h5file, group), result);
+    H5DatasetCachePtr cache = _getDataset(market, code, "TRANS");
+    HKU_IF_RETURN(!cache, result);
 
     try {
-        string tablename(market + code);
-        CHECK_DATASET_EXISTS_RET(group, tablename, result);
-        H5::DataSet dataset(group.openDataSet(tablename));
-        H5::DataSpace dataspace = dataset.getSpace();
-        size_t all_total = dataspace.getSelectNpoints();
+        size_t all_total = cache->total;
         if (0 == all_total) {
             return result;
         }
@@ -958,21 +857,8 @@ TransList H5KDataDriver::_getTransList(const string& market, const string& code,
 
         size_t total = endpos - startpos;
         std::unique_ptr<H5TransRecord[]> pBuf = std::make_unique<H5TransRecord[]>(total);
-        H5ReadTransRecords(dataset, start_ix, total, pBuf.get());
-
-        TransRecord record;
-        result.reserve(total + 2);
-        for (hsize_t i = 0; i < total; i++) {
-            uint64_t number = pBuf[i].datetime / 100;
-            uint64_t second = pBuf[i].datetime - number * 100;
-            Datetime d(number);
-            record.datetime =
-              Datetime(d.year(), d.month(), d.day(), d.hour(), d.minute(), (long)second);
-            record.price = price_t(pBuf[i].price) * 0.001;
-            record.vol = price_t(pBuf[i].vol);
-            record.direct = int(pBuf[i].buyorsell);
-            result.push_back(record);
-        }
+        _readRecords(*cache, m_h5TransType, start_ix, total, pBuf.get());
+        H5TransRecordsToTransList(pBuf.get(), total, result);
 
     } catch (std::out_of_range& e) {
         HKU_WARN("Invalid date! market_code({}{}) {}", market, code, e.what());
@@ -995,132 +881,22 @@ TransList H5KDataDriver::_getTransList(const string& market, const string& code,
     TransList result;
     HKU_IF_RETURN(start >= end || start > Datetime::max(), result);
 
-    H5FilePtr h5file;
-    H5::Group group;
-    bool success;
-    success = _getH5FileAndGroup(market, code, "TRANS", h5file, group);
-    HKU_IF_RETURN(!success, result);
-
-    H5::DataSet dataset;
-    H5::DataSpace dataspace;
-    uint64_t start_number = start.number() * 100 + start.second();
-    uint64_t end_number = end.number() * 100 + (end.isNull() ? 0 : end.second());
-    hsize_t startpos = 0, endpos = 0;
-    try {
-        string tablename(market + code);
-        CHECK_DATASET_EXISTS_RET(group, tablename, result);
-        dataset = group.openDataSet(tablename);
-        dataspace = dataset.getSpace();
-        hsize_t total = dataspace.getSelectNpoints();
-        if (0 == total) {
-            return result;
-        }
+    H5DatasetCachePtr cache = _getDataset(market, code, "TRANS");
+    HKU_IF_RETURN(!cache, result);
 
-        hsize_t mid, low = 0, high = total - 1;
-        H5TransRecord h5record;
-        while (low <= high) {
-            H5ReadTransRecords(dataset, high, 1, &h5record);
-            if (start_number > h5record.datetime) {
-                mid = high + 1;
-                break;
-            }
-
-            H5ReadTransRecords(dataset, low, 1, &h5record);
-            if (h5record.datetime >= start_number) {
-                mid = low;
-                break;
-            }
-
-            mid = (low + high) / 2;
-            H5ReadTransRecords(dataset, mid, 1, &h5record);
-            if (start_number > h5record.datetime) {
-                low = mid + 1;
-            } else {
-                high = mid - 1;
-            }
-        }
-
-        if (mid >= total) {
-            dataspace.close();
-            dataset.close();
-            return result;
-        }
-
-        startpos = mid;
-
-        low = mid;
-        high = total - 1;
-        while (low <= high) {
-            H5ReadTransRecords(dataset, high, 1, &h5record);
-            if (end_number > h5record.datetime) {
-                mid = high + 1;
-                break;
-            }
-
-            H5ReadTransRecords(dataset, low, 1, &h5record);
-            if (h5record.datetime >= end_number) {
-                mid = low;
-                break;
-            }
-
-            mid = (low + high) / 2;
-            H5ReadTransRecords(dataset, mid, 1, &h5record);
-            if (end_number > h5record.datetime) {
-                low = mid + 1;
-            } else {
-                high = mid - 1;
-            }
-        }
-
-        endpos = mid >= total ? total : mid;
-        if (startpos >= endpos) {
-            dataspace.close();
-            dataset.close();
+    try {
+        // 分笔记录的日期精确到秒
+        uint64_t start_number = start.number() * 100 + start.second();
+        uint64_t end_number = end.number() * 100 + (end.isNull() ? 0 : end.second());
+        size_t startpos = 0, endpos = 0;
+        if (!_getRangeByDate(*cache, start_number, end_number, startpos, endpos)) {
             return result;
         }
 
-        dataspace.close();
-        dataset.close();
-
-    } catch (std::out_of_range&) {
-        HKU_WARN("Invalid datetime!");
-        dataspace.close();
-        dataset.close();
-        return result;
-
-    } catch (...) {
-        HKU_INFO("error in {}{}", market, code);
-        dataspace.close();
-        dataset.close();
-        return result;
-    }
-
-    if (startpos == endpos) {
-        return result;
-    }
-
-    try {
-        string tablename(market + code);
-        CHECK_DATASET_EXISTS_RET(group, tablename, result);
-        dataset = group.openDataSet(tablename);
-
         size_t total = endpos - startpos;
         std::unique_ptr<H5TransRecord[]> pBuf = std::make_unique<H5TransRecord[]>(total);
-        H5ReadTransRecords(dataset, startpos, total, pBuf.get());
-
-        TransRecord record;
-        result.reserve(total + 2);
-        for (hsize_t i = 0; i < total; i++) {
-            uint64_t number = pBuf[i].datetime / 100;
-            uint64_t second = pBuf[i].datetime - number * 100;
-            Datetime d(number);
-            record.datetime =
-              Datetime(d.year(), d.month(), d.day(), d.hour(), d.minute(), (long)second);
-            record.price = price_t(pBuf[i].price) * 0.001;
-            record.vol = price_t(pBuf[i].vol);
-            record.direct = int(pBuf[i].buyorsell);
-            result.push_back(record);
-        }
+        _readRecords(*cache, m_h5TransType, startpos, total, pBuf.get());
+        H5TransRecordsToTransList(pBuf.get(), total, result);
 
     } catch (std::out_of_range& e) {
         HKU_WARN("Invalid date! market_code({}{}) {}", market, code, e.what());
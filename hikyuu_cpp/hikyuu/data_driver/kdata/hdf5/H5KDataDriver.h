@@ -9,6 +9,7 @@
 #ifndef DATA_DRIVER_KDATA_HDF5_H5KDATADRIVER_H_
 #define DATA_DRIVER_KDATA_HDF5_H5KDATADRIVER_H_
 
+#include <list>
 #include "../../KDataDriver.h"
 #include "H5Record.h"
 
@@ -44,20 +45,47 @@ public:
                                      size_t& out_start, size_t& out_end) override;
     virtual KRecordList getKRecordList(const string& market, const string& code,
                                        const KQuery& query) override;
+    virtual void getLastKRecordLists(const vector<std::pair<string, string>>& market_codes,
+                                     const KQuery::KType& kType, size_t max_num,
+                                     const KRecordListCallback& callback) override;
     virtual TimeLineList getTimeLineList(const string& market, const string& code,
                                          const KQuery& query) override;
     virtual TransList getTransList(const string& market, const string& code,
                                    const KQuery& query) override;
 
 private:
+    /** 已打开的数据集句柄及其日期采样索引 */
+    struct H5DatasetCache {
+        H5::DataSet dataset;
+        H5::DataSpace dataspace;
+        hsize_t total{0};
+        hsize_t date_step{0};          // 日期采样间隔，0 表示尚未建立日期索引
+        std::vector<uint64_t> dates;  // 每隔 date_step 条记录的日期
+    };
+    typedef shared_ptr<H5DatasetCache> H5DatasetCachePtr;
+
     void H5ReadRecords(H5::DataSet&, hsize_t, hsize_t, void*);
-    void H5ReadIndexRecords(H5::DataSet&, hsize_t, hsize_t, void*);
-    void H5ReadTimeLineRecords(H5::DataSet&, hsize_t, hsize_t, void*);
-    void H5ReadTransRecords(H5::DataSet&, hsize_t, hsize_t, void*);
 
     bool _getH5FileAndGroup(const string& market, const string& code, KQuery::KType kType,
                             H5FilePtr& out_file, H5::Group& out_group);
 
+    size_t _getSizeParam(const string& name, size_t default_value);
+
+    /** 获取缓存的数据集，不存在时返回空指针 */
+    H5DatasetCachePtr _getDataset(const string& market, const string& code,
+                                  const KQuery::KType& kType);
+    void _clearDatasetCache();
+
+    void _readRecords(H5DatasetCache& cache, const H5::DataType& type, hsize_t start,
+                      hsize_t nrecords, void* data);
+
+    /** 第一条日期 >= number 的记录位置，不存在时返回记录总数 */
+    hsize_t _lowerBoundByDate(H5DatasetCache& cache, uint64_t number);
+
+    /** 按日期 [start_number, end_number) 查找记录范围 */
+    bool _getRangeByDate(H5DatasetCache& cache, uint64_t start_number, uint64_t end_number,
+                         size_t& out_start, size_t& out_end);
+
     bool _getBaseIndexRangeByDate(const string&, const string&, const KQuery&, size_t& out_start,
                                   size_t& out_end);
     bool _getOtherIndexRangeByDate(const string&, const string&, const KQuery&, size_t& out_start,
@@ -65,6 +93,8 @@ private:
 
     KRecordList _getBaseKRecordList(const string& market, const string& code,
                                     const KQuery::KType& kType, size_t start_ix, size_t end_ix);
+    KRecordList _getLastBaseKRecordList(H5::Group& group, const string& tablename,
+                                        size_t max_num, std::vector<H5Record>& buf);
     KRecordList _getIndexKRecordList(const string& market, const string& code,
                                      const KQuery::KType& kType, size_t start_ix, size_t end_ix);
 
@@ -81,7 +111,15 @@ private:
     H5::CompType m_h5IndexType;
     H5::CompType m_h5TimeLineType;
     H5::CompType m_h5TransType;
+    H5::CompType m_h5DateType;  // 仅读取各类记录中的 datetime 字段
     unordered_map<string, H5FilePtr> m_h5file_map;  // key: market+code
+
+    // 按 market_ktype_code 缓存已打开的数据集，超出容量时关闭最久未使用的数据集
+    H5::DSetAccPropList m_dataset_access;  // 数据集访问属性（块缓存）
+    size_t m_dataset_cache_capacity{64};
+    std::list<string> m_dataset_lru;
+    unordered_map<string, std::pair<H5DatasetCachePtr, std::list<string>::iterator>>
+      m_dataset_map;
 };
 
 } /* namespace hku */
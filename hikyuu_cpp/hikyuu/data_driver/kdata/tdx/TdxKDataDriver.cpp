@@ -8,6 +8,7 @@
 #include <fstream>
 #include <cmath>
 #include <sys/stat.h>
+#include "TdxMappedFile.h"
 #include "TdxKDataDriver.h"
 
 namespace hku {
@@ -22,11 +23,11 @@ struct TdxDayData {
     uint32_t vol;
     uint32_t other;
 
-    Datetime getDatetime() {
+    Datetime getDatetime() const {
         return Datetime(uint64_t(date) * 10000);
     }
 
-    void toKRecord(KRecord& record) {
+    void toKRecord(KRecord& record) const {
         record.datetime = Datetime(uint64_t(date) * 10000);
         record.openPrice = price_t(open) * 0.01;
         record.highPrice = price_t(high) * 0.01;
@@ -49,7 +50,7 @@ struct TdxMinData {
     uint32_t vol;
     uint32_t other;  // cppcheck-suppress unusedStructMember
 
-    Datetime getDatetime() {
+    Datetime getDatetime() const {
         int tmp_date = date >> 11;
         int remainder = date & 0x7ff;
         int year = tmp_date + 2004;
@@ -60,7 +61,7 @@ struct TdxMinData {
         return Datetime(year, month, day, hh, mm);
     }
 
-    void toKRecord(KRecord& record) {
+    void toKRecord(KRecord& record) const {
         record.datetime = getDatetime();
         record.openPrice = price_t(open);
         record.highPrice = price_t(high);
@@ -71,13 +72,117 @@ struct TdxMinData {
     }
 };
 
-TdxKDataDriver::TdxKDataDriver() : KDataDriver("tdx") {}
+// 从 [low, total) 中查找第一个日期大于等于 datetime 的位置
+template <typename DatetimeAt>
+static size_t tdxLowerBound(size_t low, size_t total, const Datetime& datetime,
+                            DatetimeAt&& datetimeAt) {
+    size_t count = total - low;
+    while (count > 0) {
+        size_t step = count / 2;
+        size_t mid = low + step;
+        if (datetimeAt(mid) < datetime) {
+            low = mid + 1;
+            count -= step + 1;
+        } else {
+            count = step;
+        }
+    }
+    return low;
+}
+
+template <typename DatetimeAt>
+static bool tdxIndexRangeByDate(size_t total, const KQuery& query, size_t& out_start,
+                                size_t& out_end, DatetimeAt&& datetimeAt) {
+    size_t startpos = tdxLowerBound(0, total, query.startDatetime(), datetimeAt);
+    HKU_IF_RETURN(startpos >= total, false);
+    size_t endpos = tdxLowerBound(startpos, total, query.endDatetime(), datetimeAt);
+    HKU_IF_RETURN(startpos >= endpos, false);
+    out_start = startpos;
+    out_end = endpos;
+    return true;
+}
+
+// 读取 [start_ix, end_ix) 范围内的数据，使用内存映射时直接批量转换，无法映射时改用文件流读取
+template <typename TdxData>
+static KRecordList tdxReadKRecordList(const string& filename, bool use_mmap, size_t start_ix,
+                                      size_t end_ix) {
+    KRecordList result;
+    if (use_mmap) {
+        auto file = TdxMappedFile::get(filename);
+        if (file) {
+            size_t total = file->count<TdxData>();
+            HKU_IF_RETURN(start_ix >= total, result);
+            size_t stop = total < end_ix ? total : end_ix;
+            HKU_IF_RETURN(stop <= start_ix, result);
+            const TdxData* src = file->records<TdxData>();
+            result.resize(stop - start_ix);
+            for (size_t i = start_ix; i < stop; i++) {
+                src[i].toKRecord(result[i - start_ix]);
+            }
+            return result;
+        }
+    }
+
+    struct stat info;
+    HKU_IF_RETURN(0 != stat(filename.c_str(), &info), result);
+    size_t total = info.st_size / sizeof(TdxData);
+    HKU_IF_RETURN(0 == total || start_ix >= total, result);
+
+    std::ifstream file(filename.c_str(), std::ios::binary | std::ios::in);
+    HKU_IF_RETURN(!file, result);
+
+    size_t stop = total < end_ix ? total : end_ix;
+    HKU_IF_RETURN(stop <= start_ix, result);
+    vector<TdxData> buf(stop - start_ix);
+    file.seekg(start_ix * sizeof(TdxData));
+    file.read((char*)buf.data(), buf.size() * sizeof(TdxData));
+    size_t count = file.gcount() / sizeof(TdxData);
+    file.close();
+
+    result.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        buf[i].toKRecord(result[i]);
+    }
+    return result;
+}
+
+template <typename TdxData>
+static bool tdxReadIndexRangeByDate(const string& filename, bool use_mmap, const KQuery& query,
+                                    size_t& out_start, size_t& out_end) {
+    if (use_mmap) {
+        auto file = TdxMappedFile::get(filename);
+        if (file) {
+            const TdxData* records = file->records<TdxData>();
+            return tdxIndexRangeByDate(
+              file->count<TdxData>(), query, out_start, out_end,
+              [records](size_t pos) { return records[pos].getDatetime(); });
+        }
+    }
+
+    struct stat info;
+    HKU_IF_RETURN(0 != stat(filename.c_str(), &info), false);
+    size_t total = info.st_size / sizeof(TdxData);
+    HKU_IF_RETURN(0 == total, false);
+
+    std::ifstream file(filename.c_str(), std::ios::binary | std::ios::in);
+    HKU_IF_RETURN(!file, false);
+
+    TdxData tdx_data;
+    return tdxIndexRangeByDate(total, query, out_start, out_end, [&](size_t pos) {
+        file.seekg(pos * sizeof(TdxData), file.beg);
+        file.read((char*)&tdx_data, sizeof(TdxData));
+        return tdx_data.getDatetime();
+    });
+}
+
+TdxKDataDriver::TdxKDataDriver() : KDataDriver("tdx"), m_use_mmap(true) {}
 
 TdxKDataDriver::~TdxKDataDriver() {}
 
 bool TdxKDataDriver::_init() {
     try {
         m_dirname = getParam<string>("dir");
+        m_use_mmap = tryGetParam<bool>("mmap", true);
 
     } catch (...) {
         return false;
@@ -109,61 +214,16 @@ KRecordList TdxKDataDriver::getKRecordList(const string& market, const string& c
 KRecordList TdxKDataDriver::_getDayKRecordList(const string& market, const string& code,
                                                const KQuery::KType& ktype, size_t start_ix,
                                                size_t end_ix) {
-    KRecordList result;
-    size_t total = getCount(market, code, ktype);
-    HKU_IF_RETURN(0 == total || start_ix >= total, result);
-
-    string filename = _getFileName(market, code, ktype);
-    std::ifstream file(filename.c_str(), std::ios::binary | std::ios::in);
-    HKU_IF_RETURN(!file, result);
-
-    struct TdxDayData tdx_data;
-    file.seekg(start_ix * sizeof(tdx_data));
-
-    size_t i = start_ix;
-    size_t stop = total < end_ix ? total : end_ix;
-    while (!file.eof() && i < stop) {
-        KRecord record;
-        file.read((char*)&tdx_data, sizeof(tdx_data));
-        tdx_data.toKRecord(record);
-        result.push_back(record);
-        i++;
-    }
-
-    file.close();
-    return result;
+    return tdxReadKRecordList<TdxDayData>(_getFileName(market, code, ktype), m_use_mmap,
+                                          start_ix, end_ix);
 }
 
 KRecordList TdxKDataDriver::_getMinKRecordList(const string& market, const string& code,
                                                const KQuery::KType& ktype, size_t start_ix,
                                                size_t end_ix) {
     assert(KQuery::MIN == ktype || KQuery::MIN5 == ktype);
-    KRecordList result;
-
-    size_t total = getCount(market, code, ktype);
-    HKU_IF_RETURN(0 == total || start_ix >= total, result);
-
-    string filename = _getFileName(market, code, ktype);
-    std::ifstream file(filename.c_str(), std::ios::binary | std::ios::in);
-    if (!file) {
-        return result;
-    }
-
-    struct TdxMinData tdx_data;
-    file.seekg(start_ix * sizeof(tdx_data));
-
-    size_t i = start_ix;
-    size_t stop = total < end_ix ? total : end_ix;
-    while (!file.eof() && i < stop) {
-        KRecord record;
-        file.read((char*)&tdx_data, sizeof(tdx_data));
-        tdx_data.toKRecord(record);
-        result.push_back(record);
-        i++;
-    }
-
-    file.close();
-    return result;
+    return tdxReadKRecordList<TdxMinData>(_getFileName(market, code, ktype), m_use_mmap,
+                                          start_ix, end_ix);
 }
 
 bool TdxKDataDriver::getIndexRangeByDate(const string& market, const string& code,
@@ -196,91 +256,8 @@ bool TdxKDataDriver::_getDayIndexRangeByDate(const string& market, const string&
       query.startDatetime() >= query.endDatetime() || query.startDatetime() > Datetime::max(),
       false);
 
-    string filename = _getFileName(market, code, query.kType());
-    std::ifstream file(filename.c_str(), std::ios::binary | std::ios::in);
-    HKU_IF_RETURN(!file, false);
-
-    size_t total = getCount(market, code, query.kType());
-    HKU_IF_RETURN(0 == total, false);
-
-    Datetime start_number = query.startDatetime();
-    Datetime end_number = query.endDatetime();
-
-    struct TdxDayData tdx_data;
-
-    size_t len = sizeof(tdx_data);
-    size_t mid = total, low = 0, high = total - 1;
-    size_t startpos = 0, endpos = 0;
-    while (low <= high) {
-        file.seekg(high * len, file.beg);
-        file.read((char*)&tdx_data, sizeof(tdx_data));
-        if (start_number > tdx_data.getDatetime()) {
-            mid = high + 1;
-            break;
-        }
-
-        file.seekg(low * len, file.beg);
-        file.read((char*)&tdx_data, sizeof(tdx_data));
-        if (tdx_data.getDatetime() >= start_number) {
-            mid = low;
-            break;
-        }
-
-        mid = (low + high) / 2;
-        file.seekg(mid * len, file.beg);
-        file.read((char*)&tdx_data, sizeof(tdx_data));
-        if (start_number > tdx_data.getDatetime()) {
-            low = mid + 1;
-        } else {
-            high = mid - 1;
-        }
-    }
-
-    if (mid >= total) {
-        file.close();
-        return false;
-    }
-
-    startpos = mid;
-
-    low = mid;
-    high = total - 1;
-    while (low <= high) {
-        file.seekg(high * len, file.beg);
-        file.read((char*)&tdx_data, sizeof(tdx_data));
-        if (end_number > tdx_data.getDatetime()) {
-            mid = high + 1;
-            break;
-        }
-
-        file.seekg(low * len, file.beg);
-        file.read((char*)&tdx_data, sizeof(tdx_data));
-        if (tdx_data.getDatetime() >= end_number) {
-            mid = low;
-            break;
-        }
-
-        mid = (low + high) / 2;
-        file.seekg(mid * len, file.beg);
-        file.read((char*)&tdx_data, sizeof(tdx_data));
-        if (end_number > tdx_data.getDatetime()) {
-            low = mid + 1;
-        } else {
-            high = mid - 1;
-        }
-    }
-
-    endpos = mid >= total ? total : mid;
-    if (startpos >= endpos) {
-        file.close();
-        return false;
-    }
-
-    file.close();
-
-    out_start = startpos;
-    out_end = endpos;
-    return true;
+    return tdxReadIndexRangeByDate<TdxDayData>(_getFileName(market, code, query.kType()),
+                                               m_use_mmap, query, out_start, out_end);
 }
 
 bool TdxKDataDriver::_getMinIndexRangeByDate(const string& market, const string& code,
@@ -294,91 +271,8 @@ bool TdxKDataDriver::_getMinIndexRangeByDate(const string& market, const string&
       query.startDatetime() >= query.endDatetime() || query.startDatetime() > Datetime::max(),
       false);
 
-    string filename = _getFileName(market, code, query.kType());
-    std::ifstream file(filename.c_str(), std::ios::binary | std::ios::in);
-    HKU_IF_RETURN(!file, false);
-
-    size_t total = getCount(market, code, query.kType());
-    HKU_IF_RETURN(0 == total, false);
-
-    Datetime start_number = query.startDatetime();
-    Datetime end_number = query.endDatetime();
-
-    struct TdxMinData tdx_data;
-
-    size_t len = sizeof(tdx_data);
-    size_t mid = total, low = 0, high = total - 1;
-    size_t startpos = 0, endpos = 0;
-    while (low <= high) {
-        file.seekg(high * len, file.beg);
-        file.read((char*)&tdx_data, sizeof(tdx_data));
-        if (start_number > tdx_data.getDatetime()) {
-            mid = high + 1;
-            break;
-        }
-
-        file.seekg(low * len, file.beg);
-        file.read((char*)&tdx_data, sizeof(tdx_data));
-        if (tdx_data.getDatetime() >= start_number) {
-            mid = low;
-            break;
-        }
-
-        mid = (low + high) / 2;
-        file.seekg(mid * len, file.beg);
-        file.read((char*)&tdx_data, sizeof(tdx_data));
-        if (start_number > tdx_data.getDatetime()) {
-            low = mid + 1;
-        } else {
-            high = mid - 1;
-        }
-    }
-
-    if (mid >= total) {
-        file.close();
-        return false;
-    }
-
-    startpos = mid;
-
-    low = mid;
-    high = total - 1;
-    while (low <= high) {
-        file.seekg(high * len, file.beg);
-        file.read((char*)&tdx_data, sizeof(tdx_data));
-        if (end_number > tdx_data.getDatetime()) {
-            mid = high + 1;
-            break;
-        }
-
-        file.seekg(low * len, file.beg);
-        file.read((char*)&tdx_data, sizeof(tdx_data));
-        if (tdx_data.getDatetime() >= end_number) {
-            mid = low;
-            break;
-        }
-
-        mid = (low + high) / 2;
-        file.seekg(mid * len, file.beg);
-        file.read((char*)&tdx_data, sizeof(tdx_data));
-        if (end_number > tdx_data.getDatetime()) {
-            low = mid + 1;
-        } else {
-            high = mid - 1;
-        }
-    }
-
-    endpos = mid >= total ? total : mid;
-    if (startpos >= endpos) {
-        file.close();
-        return false;
-    }
-
-    file.close();
-
-    out_start = startpos;
-    out_end = endpos;
-    return true;
+    return tdxReadIndexRangeByDate<TdxMinData>(_getFileName(market, code, query.kType()),
+                                               m_use_mmap, query, out_start, out_end);
 }
 
 string TdxKDataDriver::_getFileName(const string& market, const string& code,
@@ -415,6 +309,13 @@ size_t TdxKDataDriver::_getBaseCount(const string& market, const string& code,
     string filename = _getFileName(market, code, ktype);
     HKU_IF_RETURN(filename.empty(), 0);
 
+    if (m_use_mmap) {
+        auto file = TdxMappedFile::get(filename);
+        if (file) {
+            return file->count<TdxDayData>();
+        }
+    }
+
     size_t count = 0;
     struct stat info;
     if (0 == stat(filename.c_str(), &info)) {
@@ -56,6 +56,7 @@ private:
 
 private:
     string m_dirname;
+    bool m_use_mmap;  // 使用内存映射方式读取数据文件，参数 mmap，默认为 true
 };
 
 } /* namespace hku */
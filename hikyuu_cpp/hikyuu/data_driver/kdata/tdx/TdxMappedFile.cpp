@@ -0,0 +1,57 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-16
+ *      Author: fasiondog
+ */
+
+#include <sys/stat.h>
+#include "hikyuu/utilities/LRUCache11.h"
+#include "TdxMappedFile.h"
+
+namespace hku {
+
+// 仅缓存最近使用的文件，全市场文件约 3 万个，超出时按 LRU 释放映射区域。
+// 映射区域会阻止通达信客户端改写文件（Windows），缓存数量不宜过大
+static lru11::Cache<string, TdxMappedFilePtr, std::mutex> g_tdx_mapped_files(256, 64);
+
+// mapped_region 建立后即可关闭 file_mapping，缓存的映射不再占用文件句柄
+TdxMappedFile::TdxMappedFile(const string& filename, size_t size, int64_t mtime)
+: m_region(boost::interprocess::file_mapping(filename.c_str(), boost::interprocess::read_only),
+           boost::interprocess::read_only, 0, size),
+  m_size(size),
+  m_mtime(mtime) {}
+
+TdxMappedFilePtr TdxMappedFile::get(const string& filename) {
+    TdxMappedFilePtr result;
+    HKU_IF_RETURN(filename.empty(), result);
+
+    struct stat info;
+    if (0 != stat(filename.c_str(), &info) || info.st_size <= 0) {
+        g_tdx_mapped_files.remove(filename);
+        return result;
+    }
+
+    size_t size = static_cast<size_t>(info.st_size);
+    int64_t mtime = static_cast<int64_t>(info.st_mtime);
+    if (g_tdx_mapped_files.tryGet(filename, result) && result->m_size == size &&
+        result->m_mtime == mtime) {
+        return result;
+    }
+
+    try {
+        result = std::make_shared<TdxMappedFile>(filename, size, mtime);
+        g_tdx_mapped_files.insert(filename, result);
+    } catch (const std::exception& e) {
+        HKU_WARN("Failed map file: {}! {}", filename, e.what());
+        result.reset();
+    }
+
+    return result;
+}
+
+void TdxMappedFile::clearCache() {
+    g_tdx_mapped_files.clear();
+}
+
+}  // namespace hku
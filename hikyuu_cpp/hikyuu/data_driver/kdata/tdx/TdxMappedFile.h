@@ -0,0 +1,69 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-16
+ *      Author: fasiondog
+ */
+
+#pragma once
+#ifndef DATA_DRIVER_KDATA_TDX_TDXMAPPEDFILE_H_
+#define DATA_DRIVER_KDATA_TDX_TDXMAPPEDFILE_H_
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include "hikyuu/DataType.h"
+
+namespace hku {
+
+/**
+ * 以只读内存映射方式打开的通达信数据文件（.day/.lc1/.lc5）
+ * @details 通过 get 获取时按文件名缓存映射，文件大小或修改时间变化（如通达信盘后追加数据）时重新映射。
+ * 映射建立后即关闭文件，不占用文件句柄。
+ */
+class TdxMappedFile {
+public:
+    TdxMappedFile(const string& filename, size_t size, int64_t mtime);
+
+    /** 文件内容起始地址 */
+    const char* data() const {
+        return static_cast<const char*>(m_region.get_address());
+    }
+
+    /** 文件大小 */
+    size_t size() const {
+        return m_size;
+    }
+
+    /** 以记录方式访问的记录数 */
+    template <typename T>
+    size_t count() const {
+        return m_size / sizeof(T);
+    }
+
+    /** 以记录方式访问 */
+    template <typename T>
+    const T* records() const {
+        return reinterpret_cast<const T*>(data());
+    }
+
+    /**
+     * 获取文件映射，优先使用缓存
+     * @param filename 文件名
+     * @return 文件不存在、为空或无法映射时返回空指针
+     */
+    static shared_ptr<TdxMappedFile> get(const string& filename);
+
+    /** 释放所有缓存的文件映射 */
+    static void clearCache();
+
+private:
+    boost::interprocess::mapped_region m_region;
+    size_t m_size;
+    int64_t m_mtime;
+};
+
+typedef shared_ptr<TdxMappedFile> TdxMappedFilePtr;
+
+}  // namespace hku
+
+#endif /* DATA_DRIVER_KDATA_TDX_TDXMAPPEDFILE_H_ */
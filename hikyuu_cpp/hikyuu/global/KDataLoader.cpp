@@ -0,0 +1,244 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-16
+ *      Author: fasiondog
+ */
+
+#include "../data_driver/KDataDriver.h"
+#include "../data_driver/DriverConnectPool.h"
+#include "KDataLoader.h"
+
+namespace hku {
+
+KDataLoader::KDataLoader(size_t max_bytes, size_t worker_num) : m_max_bytes(max_bytes) {
+    HKU_CHECK(worker_num > 0, "worker_num must be greater than 0!");
+    m_tg = std::make_unique<ThreadPool>(worker_num);
+}
+
+KDataLoader::~KDataLoader() {
+    m_tg->stop();
+}
+
+void KDataLoader::stop() {
+    m_tg->stop();
+}
+
+bool KDataLoader::_canParallelLoad(const Stock& stk) {
+    auto driver = stk.getKDataDirver();
+    return driver && driver->getPrototype()->canParallelLoad();
+}
+
+KRecordList KDataLoader::getKRecordList(const Stock& stk, const KQuery& query) {
+    KRecordList result;
+    HKU_IF_RETURN(stk.isNull(), result);
+
+    // 扩展K线类型由基础K线类型数据合成，基础K线数据仍经由本服务加载
+    if (!KQuery::isBaseKType(query.kType())) {
+        return stk.getKRecordList(query);
+    }
+
+    size_t start = 0, end = 0;
+    HKU_IF_RETURN(!stk.getIndexRange(query, start, end) || start >= end, result);
+
+    string key = fmt::format("{}_{}", stk.market_code(), query.kType());
+    if (_getFromCache(key, start, end, &result)) {
+        m_hits++;
+        return result;
+    }
+
+    m_misses++;
+    KRecordList records = _load(stk, query.kType(), start, end);
+    if (m_prefetch_next) {
+        _prefetchRange(stk, query.kType(), end, end + (end - start));
+    }
+
+    // 加载的记录数与索引区间不一致时（数据变化中），不放入缓存
+    HKU_IF_RETURN(records.size() != end - start, records);
+    result = records;
+    _put(key, start, std::move(records));
+    return result;
+}
+
+std::future<KData> KDataLoader::getKDataAsync(const Stock& stk, const KQuery& query) {
+    if (!_canParallelLoad(stk)) {
+        std::promise<KData> promise;
+        try {
+            promise.set_value(KData(stk, query));
+        } catch (...) {
+            promise.set_exception(std::current_exception());
+        }
+        return promise.get_future();
+    }
+    return m_tg->submit([stk, query]() { return KData(stk, query); });
+}
+
+void KDataLoader::prefetch(const Stock& stk, const KQuery& query) {
+    HKU_IF_RETURN(stk.isNull() || m_tg->done() || !_canParallelLoad(stk), void());
+    m_tg->submit([this, stk, query]() {
+        try {
+            getKRecordList(stk, query);
+        } catch (const std::exception& e) {
+            HKU_ERROR("Failed prefetch {} {}! {}", stk.market_code(), query, e.what());
+        }
+    });
+}
+
+void KDataLoader::prefetch(const StockList& stks, const KQuery& query) {
+    for (const auto& stk : stks) {
+        prefetch(stk, query);
+    }
+}
+
+void KDataLoader::prefetch(const Block& blk, const KQuery& query) {
+    prefetch(blk.getStockList(), query);
+}
+
+void KDataLoader::_prefetchRange(const Stock& stk, const KQuery::KType& ktype, size_t start,
+                                 size_t end) {
+    HKU_IF_RETURN(m_tg->done() || !_canParallelLoad(stk), void());
+    m_tg->submit([this, stk, ktype, start, end]() {
+        try {
+            size_t total = stk.getCount(ktype);
+            size_t last = end > total ? total : end;
+            string key = fmt::format("{}_{}", stk.market_code(), ktype);
+            HKU_IF_RETURN(start >= last || _getFromCache(key, start, last, nullptr), void());
+            KRecordList records = _load(stk, ktype, start, last);
+            if (records.size() == last - start) {
+                _put(key, start, std::move(records));
+            }
+        } catch (const std::exception& e) {
+            HKU_ERROR("Failed prefetch {} {}! {}", stk.market_code(), ktype, e.what());
+        }
+    });
+}
+
+KRecordList KDataLoader::_load(const Stock& stk, const KQuery::KType& ktype, size_t start,
+                               size_t end) {
+    auto driver = stk.getKDataDirver();
+    HKU_IF_RETURN(!driver, KRecordList());
+    return driver->getConnect()->getKRecordList(stk.market(), stk.code(),
+                                                KQuery(start, end, ktype));
+}
+
+bool KDataLoader::_getFromCache(const string& key, size_t start, size_t end,
+                                KRecordList* out) {
+    std::shared_ptr<const KRecordList> records;
+    size_t offset = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto iter = m_entries.find(key);
+        HKU_IF_RETURN(iter == m_entries.end(), false);
+        const Entry& entry = *iter->second;
+        HKU_IF_RETURN(start < entry.start || end > entry.start + entry.records->size(), false);
+        m_lru.splice(m_lru.begin(), m_lru, iter->second);
+        records = entry.records;
+        offset = start - entry.start;
+    }
+
+    // 在锁外复制，缓存中的区间只读，合并时整体替换
+    if (out) {
+        out->assign(records->begin() + offset, records->begin() + offset + (end - start));
+    }
+    return true;
+}
+
+void KDataLoader::_put(const string& key, size_t start, KRecordList&& records) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto iter = m_entries.find(key);
+    if (iter != m_entries.end()) {
+        const Entry& old = *iter->second;
+        size_t old_end = old.start + old.records->size();
+        size_t new_end = start + records.size();
+        // 与原区间相邻或重叠时合并，否则以新区间替换
+        if (start <= old_end && new_end >= old.start &&
+            (start > old.start || new_end < old_end)) {
+            KRecordList merged;
+            merged.reserve((new_end > old_end ? new_end : old_end) -
+                           (start < old.start ? start : old.start));
+            if (start < old.start) {
+                merged.insert(merged.end(), records.begin(),
+                              records.begin() + (old.start - start));
+            }
+            merged.insert(merged.end(), old.records->begin(), old.records->end());
+            if (new_end > old_end) {
+                merged.insert(merged.end(), records.begin() + (old_end - start), records.end());
+            }
+            start = start < old.start ? start : old.start;
+            records.swap(merged);
+        }
+        m_used_bytes -= old.bytes;
+        m_lru.erase(iter->second);
+        m_entries.erase(iter);
+    }
+
+    size_t bytes = records.size() * sizeof(KRecord) + key.size() + sizeof(Entry);
+    HKU_IF_RETURN(bytes > m_max_bytes, void());
+
+    Entry entry;
+    entry.key = key;
+    entry.start = start;
+    entry.records = std::make_shared<const KRecordList>(std::move(records));
+    entry.bytes = bytes;
+    m_lru.push_front(std::move(entry));
+    m_entries[key] = m_lru.begin();
+    m_used_bytes += bytes;
+    _evict();
+}
+
+void KDataLoader::_evict() {
+    while (m_used_bytes > m_max_bytes && !m_lru.empty()) {
+        const Entry& entry = m_lru.back();
+        m_used_bytes -= entry.bytes;
+        m_entries.erase(entry.key);
+        m_lru.pop_back();
+        m_evictions++;
+    }
+}
+
+void KDataLoader::setMaxBytes(size_t max_bytes) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_max_bytes = max_bytes;
+    _evict();
+}
+
+size_t KDataLoader::getMaxBytes() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_max_bytes;
+}
+
+size_t KDataLoader::getUsedBytes() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_used_bytes;
+}
+
+void KDataLoader::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_lru.clear();
+    m_entries.clear();
+    m_used_bytes = 0;
+    m_hits = 0;
+    m_misses = 0;
+    m_evictions = 0;
+}
+
+static KDataLoaderPtr g_kdata_loader;
+
+void startKDataLoader(size_t max_bytes, size_t worker_num) {
+    stopKDataLoader();
+    std::atomic_store(&g_kdata_loader, std::make_shared<KDataLoader>(max_bytes, worker_num));
+}
+
+void stopKDataLoader() {
+    auto loader = std::atomic_exchange(&g_kdata_loader, KDataLoaderPtr());
+    // 先在当前线程中停止后台任务，避免后台任务持有最后的引用时在工作线程中析构
+    if (loader) {
+        loader->stop();
+    }
+}
+
+KDataLoaderPtr getGlobalKDataLoader() {
+    return std::atomic_load(&g_kdata_loader);
+}
+
+}  // namespace hku
@@ -0,0 +1,156 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-16
+ *      Author: fasiondog
+ */
+
+#pragma once
+#ifndef GLOBAL_KDATALOADER_H_
+#define GLOBAL_KDATALOADER_H_
+
+#include <atomic>
+#include <future>
+#include <list>
+#include <unordered_map>
+#include "../utilities/thread/ThreadPool.h"
+#include "../Block.h"
+#include "../KData.h"
+
+namespace hku {
+
+/**
+ * 未预加载K线数据的异步加载服务
+ * @details
+ * <pre>
+ * 启用后（startKDataLoader），未在内存中缓存的K线数据（Stock::getKRecordList）均经由本服务
+ * 从数据驱动加载，并按 证券 + K线类型 缓存已加载的连续索引区间，重复或包含于已加载区间内的
+ * 查询直接从内存中获取；与已加载区间相邻或重叠的查询加载后与原区间合并为一个区间。
+ *
+ * 缓存占用的内存按字节数限定，超出时按最近最少使用的顺序淘汰。
+ * 可通过 prefetch 在后台线程中提前加载（如板块内的全部证券），或通过 getKDataAsync 异步获取。
+ *
+ * 数据驱动不支持并行加载时（如非线程安全的 HDF5），调用方线程仍会直接访问数据驱动，
+ * 此时不在后台线程中加载：prefetch 及预先加载后续区间不执行，getKDataAsync 在当前线程中加载。
+ * </pre>
+ * @ingroup StockManage
+ */
+class HKU_API KDataLoader {
+public:
+    /**
+     * @param max_bytes 缓存的最大字节数
+     * @param worker_num 后台加载线程数
+     */
+    KDataLoader(size_t max_bytes, size_t worker_num);
+    ~KDataLoader();
+
+    KDataLoader(const KDataLoader&) = delete;
+    KDataLoader& operator=(const KDataLoader&) = delete;
+
+    /** 获取K线记录，未命中缓存时从数据驱动加载，仅由 Stock 在未预加载时调用 */
+    KRecordList getKRecordList(const Stock& stk, const KQuery& query);
+
+    /** 在后台线程中获取K线数据，数据驱动不支持并行加载时在当前线程中加载 */
+    std::future<KData> getKDataAsync(const Stock& stk, const KQuery& query);
+
+    /** 在后台线程中预先加载指定证券的K线数据 */
+    void prefetch(const Stock& stk, const KQuery& query);
+
+    /** 在后台线程中预先加载多个证券的K线数据 */
+    void prefetch(const StockList& stks, const KQuery& query);
+
+    /** 在后台线程中预先加载板块内全部证券的K线数据 */
+    void prefetch(const Block& blk, const KQuery& query);
+
+    /** 未命中时是否同时在后台预先加载紧随其后的同等长度区间（顺序滚动查询时适用） */
+    void setPrefetchNext(bool prefetch_next) {
+        m_prefetch_next = prefetch_next;
+    }
+
+    bool getPrefetchNext() const {
+        return m_prefetch_next;
+    }
+
+    /** 缓存的最大字节数，缩小时立即淘汰超出部分 */
+    void setMaxBytes(size_t max_bytes);
+
+    size_t getMaxBytes() const;
+
+    /** 当前缓存占用的字节数 */
+    size_t getUsedBytes() const;
+
+    /** 命中次数 */
+    size_t hits() const {
+        return m_hits;
+    }
+
+    /** 未命中次数（含部分命中） */
+    size_t misses() const {
+        return m_misses;
+    }
+
+    /** 因超出内存限制而淘汰的区间数 */
+    size_t evictions() const {
+        return m_evictions;
+    }
+
+    /** 清除全部缓存及统计 */
+    void clear();
+
+    /** 停止后台加载线程，未完成的预加载任务直接放弃 */
+    void stop();
+
+private:
+    struct Entry {
+        string key;
+        size_t start{0};  // 首条记录的索引
+        std::shared_ptr<const KRecordList> records;
+        size_t bytes{0};
+    };
+    typedef std::list<Entry> EntryList;
+
+    static bool _canParallelLoad(const Stock& stk);
+    bool _getFromCache(const string& key, size_t start, size_t end, KRecordList* out);
+    KRecordList _load(const Stock& stk, const KQuery::KType& ktype, size_t start, size_t end);
+    void _put(const string& key, size_t start, KRecordList&& records);
+    void _evict();
+    void _prefetchRange(const Stock& stk, const KQuery::KType& ktype, size_t start,
+                        size_t end);
+
+private:
+    mutable std::mutex m_mutex;
+    EntryList m_lru;  // 最近使用的在前
+    std::unordered_map<string, EntryList::iterator> m_entries;
+    size_t m_max_bytes;
+    size_t m_used_bytes{0};
+
+    std::atomic_bool m_prefetch_next{false};
+    std::atomic<size_t> m_hits{0};
+    std::atomic<size_t> m_misses{0};
+    std::atomic<size_t> m_evictions{0};
+
+    std::unique_ptr<ThreadPool> m_tg;
+};
+
+typedef std::shared_ptr<KDataLoader> KDataLoaderPtr;
+
+/**
+ * 启用K线数据异步加载服务，如已启用则先停止原有服务
+ * @param max_bytes 缓存的最大字节数
+ * @param worker_num 后台加载线程数
+ * @ingroup StockManage
+ */
+void HKU_API startKDataLoader(size_t max_bytes = 1024 * 1024 * 1024, size_t worker_num = 2);
+
+/**
+ * 停止K线数据异步加载服务并释放缓存
+ * @ingroup StockManage
+ */
+void HKU_API stopKDataLoader();
+
+/** 获取当前的K线数据异步加载服务，未启用时返回空指针 */
+KDataLoaderPtr HKU_API getGlobalKDataLoader();
+
+}  // namespace hku
+
+#endif /* GLOBAL_KDATALOADER_H_ */
@@ -0,0 +1,263 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-16
+ *      Author: fasiondog
+ */
+
+#include "../StockManager.h"
+#include "SpotBarBuilder.h"
+
+namespace hku {
+
+SpotBarBuilder::SpotBarBuilder(const vector<KQuery::KType>& ktypes) {
+    setKTypes(ktypes);
+}
+
+void SpotBarBuilder::setKTypes(const vector<KQuery::KType>& ktypes) {
+    vector<Kind> kinds;
+    vector<TimeDelta> gaps;
+    for (const auto& ktype : ktypes) {
+        TimeDelta gap;
+        Kind kind = MIN_KIND;
+        if (KQuery::DAY == ktype) {
+            kind = DAY_KIND;
+        } else if (KQuery::WEEK == ktype || KQuery::MONTH == ktype || KQuery::QUARTER == ktype ||
+                   KQuery::HALFYEAR == ktype || KQuery::YEAR == ktype) {
+            kind = DAYUP_KIND;
+        } else if (KQuery::MIN == ktype) {
+            gap = TimeDelta(0, 0, 1);
+        } else if (KQuery::MIN5 == ktype) {
+            gap = TimeDelta(0, 0, 5);
+        } else if (KQuery::MIN15 == ktype) {
+            gap = TimeDelta(0, 0, 15);
+        } else if (KQuery::MIN30 == ktype) {
+            gap = TimeDelta(0, 0, 30);
+        } else if (KQuery::MIN60 == ktype) {
+            gap = TimeDelta(0, 0, 60);
+        } else if (KQuery::MIN3 == ktype) {
+            gap = TimeDelta(0, 0, 3);
+        } else if (KQuery::HOUR2 == ktype) {
+            gap = TimeDelta(0, 2);
+        } else if (KQuery::HOUR4 == ktype) {
+            gap = TimeDelta(0, 4);
+        } else if (KQuery::HOUR6 == ktype) {
+            gap = TimeDelta(0, 6);
+        } else if (KQuery::HOUR12 == ktype) {
+            gap = TimeDelta(0, 12);
+        } else {
+            HKU_THROW("Invalid ktype: {}", ktype);
+        }
+        kinds.push_back(kind);
+        gaps.push_back(gap);
+    }
+
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    m_ktypes = ktypes;
+    m_kinds = std::move(kinds);
+    m_gaps = std::move(gaps);
+    m_states.clear();
+}
+
+void SpotBarBuilder::clear() {
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    m_states.clear();
+}
+
+SpotBarBuilder::StockState* SpotBarBuilder::_getState(const string& market_code) {
+    {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        auto iter = m_states.find(market_code);
+        if (iter != m_states.end()) {
+            return iter->second.get();
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    auto& state = m_states[market_code];
+    if (!state) {
+        state = std::make_unique<StockState>();
+        state->bars.resize(m_ktypes.size());
+        state->updates.reserve(m_ktypes.size());
+    }
+    return state.get();
+}
+
+void SpotBarBuilder::update(const SpotRecord& spot) {
+    Stock stk = StockManager::instance().getStock(spot.market + spot.code);
+    HKU_IF_RETURN(stk.isNull(), void());
+    update(stk, spot);
+}
+
+void SpotBarBuilder::update(Stock& stk, const SpotRecord& spot) {
+    HKU_IF_RETURN(m_ktypes.empty() || !stk.isTransactionTime(spot.datetime), void());
+    StockState* state = _getState(stk.market_code());
+    std::lock_guard<std::mutex> lock(state->mutex);
+    _build(stk, spot, *state, state->updates);
+    stk.realtimeUpdate(state->updates);
+}
+
+void SpotBarBuilder::build(const Stock& stk, const SpotRecord& spot, BarList& out) {
+    out.clear();
+    HKU_IF_RETURN(m_ktypes.empty() || stk.isNull(), void());
+    StockState* state = _getState(stk.market_code());
+    std::lock_guard<std::mutex> lock(state->mutex);
+    _build(stk, spot, *state, out);
+}
+
+void SpotBarBuilder::_build(const Stock& stk, const SpotRecord& spot, StockState& state,
+                            BarList& out) {
+    out.clear();
+    Datetime today = spot.datetime.startOfDay();
+    MarketInfo market_info;
+    bool market_loaded = false;
+    for (size_t i = 0, total = m_ktypes.size(); i < total; i++) {
+        if (!stk.isBuffer(m_ktypes[i])) {
+            continue;
+        }
+        if (DAY_KIND == m_kinds[i]) {
+            out.emplace_back(m_ktypes[i], KRecord(today, spot.open, spot.high, spot.low,
+                                                  spot.close, spot.amount, spot.volume));
+        } else if (DAYUP_KIND == m_kinds[i]) {
+            _buildDayUp(stk, spot, i, today, state.bars[i], out);
+        } else {
+            if (!market_loaded) {
+                market_info = StockManager::instance().getMarketInfo(stk.market());
+                market_loaded = true;
+            }
+            _buildMin(stk, spot, i, today, market_info, state.bars[i], out);
+        }
+    }
+}
+
+void SpotBarBuilder::_buildMin(const Stock& stk, const SpotRecord& spot, size_t i,
+                               const Datetime& today, const MarketInfo& market_info,
+                               BarState& bar, BarList& out) {
+    const Datetime& minute = spot.datetime;
+    // 非24小时交易品种，且时间和当天零时相同认为无分钟线级别数据
+    HKU_IF_RETURN(stk.type() != STOCKTYPE_CRYPTO && minute == today, void());
+
+    const TimeDelta& gap = m_gaps[i];
+    Datetime end_minute = minute - (minute - today) % gap + gap;
+
+    // 处理闭市时最后一条记录
+    Datetime close1 = today + market_info.closeTime1();
+    Datetime close2 = today + market_info.closeTime2();
+    Datetime open2 = today + market_info.openTime2();
+    if (!close2.isNull() && end_minute > close2) {
+        end_minute = close2;
+    } else if (!open2.isNull() && !close1.isNull() && end_minute < open2 && end_minute > close1) {
+        end_minute = close1;
+    }
+
+    if (bar.day != today) {
+        bar.base_amount = 0.0;
+        bar.base_volume = 0.0;
+        if (bar.day.isNull()) {
+            // 首次收到该证券的 spot，从缓存中计算当天之前K线的累积成交金额、成交量
+            KRecordList klist = stk.getKRecordList(KQuery(today, end_minute, m_ktypes[i]));
+            for (const auto& k : klist) {
+                bar.base_amount += k.transAmount;
+                bar.base_volume += k.transCount;
+            }
+        }
+        bar.day = today;
+        bar.bar_end = Null<Datetime>();
+    }
+
+    if (bar.bar_end.isNull() || end_minute > bar.bar_end) {
+        // 新的K线，上一根K线的成交金额、成交量计入累积值
+        if (!bar.bar_end.isNull()) {
+            bar.base_amount += bar.amount;
+            bar.base_volume += bar.volume;
+        }
+        bar.bar_end = end_minute;
+        bar.open = spot.close;
+        bar.high = spot.close;
+        bar.low = spot.close;
+    } else if (end_minute < bar.bar_end) {
+        // 延迟到达的 spot 属于已完结的K线，忽略
+        return;
+    } else {
+        // 开盘价、最高价、最低价都须使用 spot 收盘价（因为 spot 中的开高低均为当天值）
+        if (bar.high < spot.close) {
+            bar.high = spot.close;
+        }
+        if (bar.low > spot.close) {
+            bar.low = spot.close;
+        }
+    }
+
+    price_t sum_amount = bar.base_amount, sum_volume = bar.base_volume;
+    bar.amount =
+      spot.amount > sum_amount ? spot.amount - sum_amount : (sum_amount == 0.0 ? spot.amount : 0.0);
+    price_t spot_volume = spot.volume * 100.;  // spot 传过来的是手数
+    bar.volume =
+      spot_volume > sum_volume ? spot_volume - sum_volume : (sum_volume == 0.0 ? spot_volume : 0.0);
+    out.emplace_back(m_ktypes[i], KRecord(end_minute, bar.open, bar.high, bar.low, spot.close,
+                                          bar.amount, bar.volume));
+}
+
+void SpotBarBuilder::_buildDayUp(const Stock& stk, const SpotRecord& spot, size_t i,
+                                 const Datetime& today, BarState& bar, BarList& out) {
+    const KQuery::KType& ktype = m_ktypes[i];
+    Datetime start_of_phase, end_of_phase;
+    if (KQuery::WEEK == ktype) {
+        start_of_phase = today.startOfWeek();
+        end_of_phase = today.endOfWeek() - TimeDelta(2);  // 周五日期
+    } else if (KQuery::MONTH == ktype) {
+        start_of_phase = today.startOfMonth();
+        end_of_phase = today.endOfMonth();
+    } else if (KQuery::QUARTER == ktype) {
+        start_of_phase = today.startOfQuarter();
+        end_of_phase = today.endOfQuarter();
+    } else if (KQuery::HALFYEAR == ktype) {
+        start_of_phase = today.startOfHalfyear();
+        end_of_phase = today.endOfHalfyear();
+    } else {
+        start_of_phase = today.startOfYear();
+        end_of_phase = today.endOfYear();
+    }
+
+    if (bar.day != today) {
+        if (bar.day.isNull() || bar.bar_end != end_of_phase) {
+            // 首次收到该证券的 spot 时，缓存中的当期K线视为截至上一交易日的累积
+            bar.base_amount = 0.0;
+            bar.base_volume = 0.0;
+            bar.open = spot.open;
+            bar.high = spot.high;
+            bar.low = spot.low;
+            if (bar.day.isNull()) {
+                KRecordList klist =
+                  stk.getKRecordList(KQuery(start_of_phase, end_of_phase + TimeDelta(1), ktype));
+                if (!klist.empty() && klist.back().datetime == end_of_phase) {
+                    const KRecord& k = klist.back();
+                    bar.base_amount = k.transAmount;
+                    bar.base_volume = k.transCount;
+                    bar.open = k.openPrice;
+                    bar.high = std::max(k.highPrice, spot.high);
+                    bar.low = std::min(k.lowPrice, spot.low);
+                }
+            }
+        } else {
+            // 同一周期内的新交易日，上一交易日的成交金额、成交量计入累积值
+            bar.base_amount += bar.amount;
+            bar.base_volume += bar.volume;
+        }
+        bar.day = today;
+        bar.bar_end = end_of_phase;
+    }
+
+    if (bar.high < spot.high) {
+        bar.high = spot.high;
+    }
+    if (bar.low > spot.low) {
+        bar.low = spot.low;
+    }
+    bar.amount = spot.amount;
+    bar.volume = spot.volume;
+    out.emplace_back(ktype, KRecord(end_of_phase, bar.open, bar.high, bar.low, spot.close,
+                                    bar.base_amount + bar.amount, bar.base_volume + bar.volume));
+}
+
+}  // namespace hku
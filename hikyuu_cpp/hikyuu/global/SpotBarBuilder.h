@@ -0,0 +1,116 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-16
+ *      Author: fasiondog
+ */
+
+#pragma once
+#ifndef GLOBAL_SPOTBARBUILDER_H_
+#define GLOBAL_SPOTBARBUILDER_H_
+
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include "../Stock.h"
+#include "SpotRecord.h"
+
+namespace hku {
+
+/**
+ * 由实时 spot 数据生成各周期当前K线
+ * @details
+ * <pre>
+ * 按 证券 + K线类型 保存当前K线的开高低收，以及同一阶段（分钟级为当日，周线及以上为当期）内
+ * 当前K线之前已累积的成交金额、成交量。收到 spot 后以 O(1) 更新所有K线类型的当前K线，
+ * 并通过 Stock::realtimeUpdate 一次性写入缓存，无需每次从缓存中取出当日K线重新累加。
+ *
+ * 仅在某证券首次收到 spot 时，从缓存中读取当日（当期）已有K线计算初始累积值。
+ * 支持的K线类型：DAY、WEEK/MONTH/QUARTER/HALFYEAR/YEAR 及 MIN/MIN3/MIN5/MIN15/MIN30/MIN60、
+ * HOUR2/HOUR4/HOUR6/HOUR12。
+ * </pre>
+ * @ingroup Agent
+ */
+class HKU_API SpotBarBuilder {
+public:
+    typedef vector<std::pair<KQuery::KType, KRecord>> BarList;
+
+    SpotBarBuilder() = default;
+
+    /**
+     * @param ktypes 需要生成的K线类型
+     * @exception 存在不支持的K线类型时抛出异常
+     */
+    explicit SpotBarBuilder(const vector<KQuery::KType>& ktypes);
+
+    SpotBarBuilder(const SpotBarBuilder&) = delete;
+    SpotBarBuilder& operator=(const SpotBarBuilder&) = delete;
+
+    /** 需要生成的K线类型 */
+    const vector<KQuery::KType>& getKTypes() const {
+        return m_ktypes;
+    }
+
+    /**
+     * 设置需要生成的K线类型，将清除已保存的状态
+     * @note 不能与 update/build 同时调用
+     */
+    void setKTypes(const vector<KQuery::KType>& ktypes);
+
+    /** 按 spot 更新对应证券各周期的当前K线，并写入其缓存 */
+    void update(const SpotRecord& spot);
+
+    /** 同上，指定证券 */
+    void update(Stock& stk, const SpotRecord& spot);
+
+    /**
+     * 按 spot 计算指定证券各周期的当前K线，不写入缓存，也不判断是否为交易时间
+     * @param stk 指定证券
+     * @param spot spot 数据
+     * @param out 输出各K线类型的当前K线，将先被清空
+     */
+    void build(const Stock& stk, const SpotRecord& spot, BarList& out);
+
+    /** 清除所有证券的状态 */
+    void clear();
+
+private:
+    enum Kind { DAY_KIND, MIN_KIND, DAYUP_KIND };
+
+    struct BarState {
+        Datetime day;                // 最近一次更新的日期（当日零时）
+        Datetime bar_end;            // 当前K线日期
+        price_t base_amount = 0.0;   // 同一阶段内当前K线之前已累积的成交金额
+        price_t base_volume = 0.0;   // 同一阶段内当前K线之前已累积的成交量
+        price_t amount = 0.0;        // 当前K线（周线及以上为当日）成交金额
+        price_t volume = 0.0;        // 当前K线（周线及以上为当日）成交量
+        price_t open = 0.0;
+        price_t high = 0.0;
+        price_t low = 0.0;
+    };
+
+    struct StockState {
+        std::mutex mutex;
+        vector<BarState> bars;  // 与 m_ktypes 一一对应
+        BarList updates;        // 复用的输出缓冲
+    };
+
+    StockState* _getState(const string& market_code);
+    void _build(const Stock& stk, const SpotRecord& spot, StockState& state, BarList& out);
+    void _buildMin(const Stock& stk, const SpotRecord& spot, size_t i, const Datetime& today,
+                   const MarketInfo& market_info, BarState& bar, BarList& out);
+    void _buildDayUp(const Stock& stk, const SpotRecord& spot, size_t i, const Datetime& today,
+                     BarState& bar, BarList& out);
+
+private:
+    vector<KQuery::KType> m_ktypes;
+    vector<Kind> m_kinds;
+    vector<TimeDelta> m_gaps;  // 分钟级K线的周期
+
+    std::shared_mutex m_mutex;
+    unordered_map<string, std::unique_ptr<StockState>> m_states;
+};
+
+}  // namespace hku
+
+#endif /* GLOBAL_SPOTBARBUILDER_H_ */
@@ -6,10 +6,12 @@
  */
 
 #include <chrono>
+#include <string_view>
 #include <nng/nng.h>
 #include <nng/protocol/pubsub0/sub.h>
 #include "hikyuu/StockManager.h"
 #include "hikyuu/lang.h"
+#include "hikyuu/utilities/datetime/CompactDatetime.h"
 #include "spot_generated.h"
 #include "SpotAgent.h"
 
@@ -42,6 +44,11 @@ void SpotAgent::start() {
         m_stop = false;
         m_receive_data_tg = std::make_unique<ThreadPool>(1);
         m_tg = std::make_unique<ThreadPool>(m_work_num);
+        size_t shard_num = m_work_num > 0 ? m_work_num : 1;
+        m_shard_index.clear();
+        m_shard_index.resize(shard_num);
+        m_shard_spots.clear();
+        m_shard_spots.resize(shard_num);
         m_receiveThread = std::thread([this]() { work_thread(); });
     }
 }
@@ -65,86 +72,99 @@ void SpotAgent::stop() {
     }
 }
 
-class ProcessTask {
-public:
-    ProcessTask(const std::function<void(const SpotRecord&)>& func, const SpotRecord& spot)
-    : m_func(func), m_spot(spot) {}
-
-    void operator()() {
-        try {
-            m_func(m_spot);
-        } catch (const std::exception& e) {
-            HKU_ERROR(e.what());
-        } catch (...) {
-            HKU_ERROR_UNKNOWN;
-        }
-    }
-
-private:
-    std::function<void(const SpotRecord&)> m_func;
-    SpotRecord m_spot;
-};
-
-unique_ptr<SpotRecord> SpotAgent::parseFlatSpot(const hikyuu::flat::Spot* spot) {
-    SpotRecord* result = nullptr;
-    try {
-        result = new SpotRecord;
-        result->market = spot->market()->str();
-        result->code = spot->code()->str();
-        result->name = spot->name()->str();
-        result->datetime = Datetime(spot->datetime()->str());
-        result->yesterday_close = spot->yesterday_close();
-        result->open = spot->open();
-        result->high = spot->high();
-        result->low = spot->low();
-        result->close = spot->close();
-        result->amount = spot->amount();
-        result->volume = spot->volume();
-        auto* bids = spot->bid();
-        if (bids) {
-            size_t length = bids->size();
-            result->bid.resize(length);
-            for (size_t i = 0; i < length; i++) {
-                result->bid[i] = bids->Get(i);
+Datetime HKU_API parseSpotDatetime(const char* s, size_t len) {
+    auto digits = [s](size_t pos, size_t n, long& value) {
+        value = 0;
+        for (size_t i = pos; i < pos + n; i++) {
+            if (s[i] < '0' || s[i] > '9') {
+                return false;
             }
+            value = value * 10 + (s[i] - '0');
         }
-
-        auto* bid_amounts = spot->bid_amount();
-        if (bid_amounts) {
-            size_t length = bid_amounts->size();
-            result->bid_amount.resize(length);
-            for (size_t i = 0; i < length; i++) {
-                result->bid_amount[i] = bid_amounts->Get(i);
+        return true;
+    };
+
+    long year, month, day, hh, mm, sec, microsec = 0;
+    if (len >= 19 && s[4] == '-' && s[7] == '-' && s[10] == ' ' && s[13] == ':' &&
+        s[16] == ':' && digits(0, 4, year) && digits(5, 2, month) && digits(8, 2, day) &&
+        digits(11, 2, hh) && digits(14, 2, mm) && digits(17, 2, sec)) {
+        size_t frac = len > 20 && s[19] == '.' ? len - 20 : 0;
+        if (len == 19 || (frac > 0 && frac <= 6 && digits(20, frac, microsec))) {
+            for (size_t i = frac; i < 6; i++) {
+                microsec *= 10;
             }
+            return CompactDatetime(year, month, day, hh, mm, sec, microsec).datetime();
         }
+    }
+    return Datetime(string(s, len));
+}
 
-        auto* asks = spot->ask();
-        if (asks) {
-            size_t length = asks->size();
-            result->ask.resize(length);
-            for (size_t i = 0; i < length; i++) {
-                result->ask[i] = asks->Get(i);
-            }
-        }
+size_t HKU_API getSpotShardIndex(std::string_view code, size_t shard_num) {
+    return shard_num > 1 ? std::hash<std::string_view>()(code) % shard_num : 0;
+}
 
-        auto* asks_amounts = spot->ask_amount();
-        if (asks_amounts) {
-            size_t length = asks_amounts->size();
-            result->ask_amount.resize(length);
-            for (size_t i = 0; i < length; i++) {
-                result->ask_amount[i] = asks_amounts->Get(i);
-            }
+template <typename FlatVector>
+static void assignFlatVector(vector<double>& dst, const FlatVector* src) {
+    if (src) {
+        dst.resize(src->size());
+        for (size_t i = 0, len = src->size(); i < len; i++) {
+            dst[i] = src->Get(i);
         }
+    } else {
+        dst.clear();
+    }
+}
+
+bool SpotAgent::parseFlatSpot(const hikyuu::flat::Spot* spot, SpotRecord& result) {
+    // 在原有对象上赋值，复用字符串及数组已分配的空间
+    try {
+        result.market.assign(spot->market()->c_str(), spot->market()->size());
+        result.code.assign(spot->code()->c_str(), spot->code()->size());
+        result.name.assign(spot->name()->c_str(), spot->name()->size());
+        result.datetime = parseSpotDatetime(spot->datetime()->c_str(), spot->datetime()->size());
+        result.yesterday_close = spot->yesterday_close();
+        result.open = spot->open();
+        result.high = spot->high();
+        result.low = spot->low();
+        result.close = spot->close();
+        result.amount = spot->amount();
+        result.volume = spot->volume();
+        assignFlatVector(result.bid, spot->bid());
+        assignFlatVector(result.bid_amount, spot->bid_amount());
+        assignFlatVector(result.ask, spot->ask());
+        assignFlatVector(result.ask_amount, spot->ask_amount());
+        return true;
 
     } catch (std::exception& e) {
-        result = nullptr;
         HKU_ERROR(e.what());
     } catch (...) {
-        result = nullptr;
         HKU_ERROR_UNKNOWN;
     }
+    return false;
+}
 
-    return unique_ptr<SpotRecord>(result);
+void SpotAgent::processShard(const hikyuu::flat::SpotList* spot_list,
+                             const vector<uint32_t>& index, vector<SpotRecord>& spots) {
+    auto* flat_spots = spot_list->spot();
+    size_t total = index.size();
+    if (spots.size() < total) {
+        spots.resize(total);
+    }
+    for (size_t i = 0; i < total; i++) {
+        SpotRecord& record = spots[i];
+        if (!parseFlatSpot(flat_spots->Get(index[i]), record)) {
+            continue;
+        }
+        for (const auto& process : m_processList) {
+            try {
+                process(record);
+            } catch (const std::exception& e) {
+                HKU_ERROR(e.what());
+            } catch (...) {
+                HKU_ERROR_UNKNOWN;
+            }
+        }
+    }
 }
 
 void SpotAgent::parseSpotData(const void* buf, size_t buf_len) {
@@ -160,24 +180,37 @@ void SpotAgent::parseSpotData(const void* buf, size_t buf_len) {
 #pragma warning(disable : 4267)
 #endif
 
-    // 更新K线数据
+    // 按证券代码分片，同一证券总是分配至同一分片
     auto* spot_list = GetSpotList(spot_list_buf);
     auto* spots = spot_list->spot();
     size_t total = spots->size();
-    vector<std::future<void>> tasks;
-    for (size_t i = 0; i < total; i++) {
-        auto* spot = spots->Get(i);
-        auto spot_record = parseFlatSpot(spot);
-        if (spot_record) {
-            for (const auto& process : m_processList) {
-                tasks.emplace_back(m_tg->submit(ProcessTask(process, *spot_record)));
+    size_t shard_num = m_shard_index.size();
+    dispatchSpotShards(
+      total,
+      [spots](size_t i) {
+          auto* code = spots->Get(i)->code();
+          return code ? std::string_view(code->c_str(), code->size()) : std::string_view();
+      },
+      m_shard_index);
+
+    // 更新K线数据，每个分片一个任务，单分片时直接在当前线程处理
+    if (shard_num == 1) {
+        processShard(spot_list, m_shard_index[0], m_shard_spots[0]);
+    } else {
+        vector<std::future<void>> tasks;
+        tasks.reserve(shard_num);
+        for (size_t n = 0; n < shard_num; n++) {
+            if (!m_shard_index[n].empty()) {
+                tasks.emplace_back(m_tg->submit([this, spot_list, n]() {
+                    processShard(spot_list, m_shard_index[n], m_shard_spots[n]);
+                }));
             }
         }
+        for (auto& task : tasks) {
+            task.get();
+        }
     }
 
-    for (auto& task : tasks) {
-        task.get();
-    }
     HKU_DEBUG("received count: {}", total);
     for (const auto& postProcess : m_postProcessList) {
         postProcess(ms_start_rev_time);
@@ -9,6 +9,7 @@
 
 #include <thread>
 #include <functional>
+#include <string_view>
 #include "../../DataType.h"
 #include "../../utilities/thread/ThreadPool.h"
 #include "../SpotRecord.h"
@@ -16,11 +17,43 @@
 namespace hikyuu {
 namespace flat {
 struct Spot;
+struct SpotList;
 }
 }  // namespace hikyuu
 
 namespace hku {
 
+/**
+ * 解析 spot 中的日期时间
+ * @details 常见的 "YYYY-MM-DD hh:mm:ss[.ffffff]"（小数秒 1~6 位）格式直接按字符解析，
+ * 避免构造临时字符串，其他格式仍由 Datetime(string) 处理
+ * @param s 日期时间字符串，无需以 '\0' 结尾
+ * @param len 字符串长度
+ */
+Datetime HKU_API parseSpotDatetime(const char* s, size_t len);
+
+/** 证券代码对应的分片序号，同一证券代码总是对应同一分片 */
+size_t HKU_API getSpotShardIndex(std::string_view code, size_t shard_num);
+
+/**
+ * 将一批 spot 按证券代码分配至各分片，各分片中的序号保持接收顺序
+ * @param total 本批次 spot 数量
+ * @param codeAt 获取第 i 条 spot 证券代码（std::string_view）的函数
+ * @param shards 各分片的 spot 序号，分片数量由调用者预先指定，原有内容将被清除
+ */
+template <typename CodeAt>
+void dispatchSpotShards(size_t total, CodeAt&& codeAt, vector<vector<uint32_t>>& shards) {
+    for (auto& shard : shards) {
+        shard.clear();
+    }
+    size_t shard_num = shards.size();
+    HKU_IF_RETURN(shard_num == 0, void());
+    for (size_t i = 0; i < total; i++) {
+        size_t n = shard_num > 1 ? getSpotShardIndex(codeAt(i), shard_num) : 0;
+        shards[n].push_back(uint32_t(i));
+    }
+}
+
 /**
  * 接收外部实时数据代理
  * @ingroup Agent
@@ -71,6 +104,8 @@ public:
     /**
      * 增加收到 Spot 数据时的处理函数
      * @note 仅能在停止状态时执行此操作，否则将抛出异常
+     * @note 同一证券的 spot 总是在同一分片中按接收顺序依次处理；传入的 SpotRecord 会被复用，
+     *       仅在调用期间有效，需保留时请自行复制
      * @param process 处理函数，仅处理单条 spot 数据
      */
     void addProcess(std::function<void(const SpotRecord&)> process);
@@ -115,9 +150,12 @@ private:
     SpotAgent& operator=(const SpotAgent&) = delete;
     SpotAgent& operator=(SpotAgent&&) = delete;
 
-    unique_ptr<SpotRecord> parseFlatSpot(const hikyuu::flat::Spot* spot);
+    bool parseFlatSpot(const hikyuu::flat::Spot* spot, SpotRecord& result);
     void parseSpotData(const void* buf, size_t buf_len);
 
+    void processShard(const hikyuu::flat::SpotList* spot_list, const vector<uint32_t>& index,
+                      vector<SpotRecord>& spots);
+
     void work_thread();
 
 private:
@@ -131,6 +169,10 @@ private:
     size_t m_work_num = 1;                          // 数据处理任务线程池线程数
     std::unique_ptr<ThreadPool> m_receive_data_tg;  // 数据接收任务组
 
+    // 按证券分片处理 spot，同一证券总是由同一分片按接收顺序处理，每批次每分片仅提交一个任务
+    vector<vector<uint32_t>> m_shard_index;    // 本批次分配至各分片的 spot 序号
+    vector<vector<SpotRecord>> m_shard_spots;  // 各分片复用的 spot 存储，保留已分配空间
+
     bool m_print = true;   // 是否打印连接信息
     string m_server_addr;  // 服务器地址
 
@@ -48,6 +48,11 @@ void Indicator::setContext(const KData& k) {
         m_imp->setContext(k);
 }
 
+void Indicator::updateContext(const KData& k) {
+    if (m_imp)
+        m_imp->updateContext(k);
+}
+
 KData Indicator::getContext() const {
     return m_imp ? m_imp->getContext() : KData();
 }
@@ -76,6 +76,12 @@ public:
     void setContext(const Stock&, const KQuery&);
     void setContext(const KData&);
 
+    /**
+     * 增量更新上下文，用于实时行情追加或修改最后一根K线后的重算
+     * @see IndicatorImp::updateContext
+     */
+    void updateContext(const KData&);
+
     /** 获取上下文 */
     KData getContext() const;
 
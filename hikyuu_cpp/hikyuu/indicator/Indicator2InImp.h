@@ -21,6 +21,10 @@ public:
 
     virtual IndicatorImpPtr _clone() override;
 
+    virtual IndicatorImpPtr getRefImp() const override {
+        return m_ref_ind.getImp();
+    }
+
 protected:
     Indicator prepare(const Indicator& ind);
 
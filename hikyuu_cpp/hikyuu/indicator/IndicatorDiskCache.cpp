@@ -0,0 +1,431 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-16
+ *      Author: fasiondog
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <thread>
+#include <xxhash.h>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include "hikyuu/utilities/osdef.h"
+#include "hikyuu/utilities/os.h"
+#include "hikyuu/version.h"
+#include "IndicatorDiskCache.h"
+
+#if HKU_OS_WINDOWS
+#include <io.h>
+#include <sys/utime.h>
+#else
+#include <dirent.h>
+#include <utime.h>
+#endif
+#include <sys/stat.h>
+
+namespace hku {
+
+namespace {
+
+// 缓存文件头，之后依次为键值（按8字节补齐）及各结果集数据
+struct DiskCacheHeader {
+    char magic[8];        // "HKUINDC"
+    uint32_t format;      // 文件格式版本
+    uint32_t value_size;  // sizeof(value_t)，区分低精度版本
+    uint64_t stamp;       // 上下文K线数据指纹
+    uint64_t total;       // 每个结果集的长度
+    uint64_t discard;
+    uint64_t result_num;
+    uint64_t key_len;
+    uint64_t reserved;
+};
+
+static_assert(sizeof(DiskCacheHeader) == 64, "DiskCacheHeader size must be 64");
+
+const char g_disk_cache_magic[8] = "HKUINDC";
+const uint32_t g_disk_cache_format = 1;
+const char* g_disk_cache_ext = ".hkc";
+
+std::mutex g_disk_cache_mutex;
+string g_disk_cache_path;
+std::atomic_bool g_disk_cache_enabled{false};
+std::atomic<size_t> g_disk_cache_hits{0};
+std::atomic<uint64_t> g_disk_cache_tmp_seq{0};
+std::atomic<uint64_t> g_disk_cache_max_bytes{1024ULL * 1024ULL * 1024ULL};
+std::atomic<uint64_t> g_disk_cache_used_bytes{0};
+std::mutex g_disk_cache_shrink_mutex;
+
+size_t align8(size_t len) {
+    return (len + 7) & ~size_t(7);
+}
+
+struct DiskCacheFile {
+    string filename;
+    uint64_t size;
+    int64_t mtime;
+};
+
+// 列出缓存目录中的缓存文件（不含写入中的临时文件）
+vector<DiskCacheFile> listCacheFiles(const string& path) {
+    vector<DiskCacheFile> result;
+#if HKU_OS_WINDOWS
+    string dir = HKU_PATH(path) + "\\";
+    struct _finddata_t fb;
+    intptr_t handle = _findfirst((dir + "*" + g_disk_cache_ext).c_str(), &fb);
+    HKU_IF_RETURN(handle == -1L, result);
+    do {
+        if (!(fb.attrib & _A_SUBDIR)) {
+            result.push_back({dir + fb.name, uint64_t(fb.size), int64_t(fb.time_write)});
+        }
+    } while (0 == _findnext(handle, &fb));
+    _findclose(handle);
+#else
+    string dir = path + "/";
+    size_t ext_len = strlen(g_disk_cache_ext);
+    DIR* d = opendir(dir.c_str());
+    HKU_IF_RETURN(d == NULL, result);
+    struct dirent* dt = NULL;
+    while (NULL != (dt = readdir(d))) {
+        size_t len = strlen(dt->d_name);
+        if (len <= ext_len || strcmp(dt->d_name + len - ext_len, g_disk_cache_ext) != 0) {
+            continue;
+        }
+        string filename = dir + dt->d_name;
+        struct stat st;
+        if (0 == stat(filename.c_str(), &st) && S_ISREG(st.st_mode)) {
+            result.push_back({filename, uint64_t(st.st_size), int64_t(st.st_mtime)});
+        }
+    }
+    closedir(d);
+#endif
+    return result;
+}
+
+// 更新缓存文件的修改时间，作为最近使用时间
+void touchCacheFile(const string& filename) {
+#if HKU_OS_WINDOWS
+    _utime(HKU_PATH(filename).c_str(), NULL);
+#else
+    utime(filename.c_str(), NULL);
+#endif
+}
+
+uint64_t sumCacheFileBytes(const vector<DiskCacheFile>& files) {
+    uint64_t total = 0;
+    for (const auto& file : files) {
+        total += file.size;
+    }
+    return total;
+}
+
+}  // namespace
+
+bool IndicatorDiskCache::setPath(const string& path) {
+    std::lock_guard<std::mutex> lock(g_disk_cache_mutex);
+    if (path.empty()) {
+        g_disk_cache_enabled = false;
+        g_disk_cache_path.clear();
+        return true;
+    }
+
+    if (!createDir(path)) {
+        g_disk_cache_enabled = false;
+        g_disk_cache_path.clear();
+        HKU_ERROR("Failed create indicator disk cache directory: {}", path);
+        return false;
+    }
+
+    g_disk_cache_path = path;
+    g_disk_cache_used_bytes = sumCacheFileBytes(listCacheFiles(path));
+    g_disk_cache_enabled = true;
+    return true;
+}
+
+string IndicatorDiskCache::getPath() {
+    std::lock_guard<std::mutex> lock(g_disk_cache_mutex);
+    return g_disk_cache_path;
+}
+
+bool IndicatorDiskCache::enabled() {
+    return g_disk_cache_enabled;
+}
+
+size_t IndicatorDiskCache::hits() {
+    return g_disk_cache_hits;
+}
+
+void IndicatorDiskCache::clear() {
+    std::lock_guard<std::mutex> lock(g_disk_cache_mutex);
+    HKU_IF_RETURN(g_disk_cache_path.empty(), void());
+    removeDir(g_disk_cache_path);
+    HKU_ERROR_IF(!createDir(g_disk_cache_path), "Failed create indicator disk cache directory: {}",
+                 g_disk_cache_path);
+    g_disk_cache_hits = 0;
+    g_disk_cache_used_bytes = 0;
+}
+
+void IndicatorDiskCache::setMaxBytes(uint64_t bytes) {
+    g_disk_cache_max_bytes = bytes;
+    if (bytes > 0 && g_disk_cache_used_bytes > bytes) {
+        _shrink();
+    }
+}
+
+uint64_t IndicatorDiskCache::getMaxBytes() {
+    return g_disk_cache_max_bytes;
+}
+
+uint64_t IndicatorDiskCache::usedBytes() {
+    return g_disk_cache_used_bytes;
+}
+
+void IndicatorDiskCache::_shrink() {
+    // 已有其他线程在清理时直接返回
+    std::unique_lock<std::mutex> lock(g_disk_cache_shrink_mutex, std::try_to_lock);
+    HKU_IF_RETURN(!lock.owns_lock(), void());
+
+    uint64_t max_bytes = g_disk_cache_max_bytes;
+    HKU_IF_RETURN(max_bytes == 0, void());
+    string path = getPath();
+    HKU_IF_RETURN(path.empty(), void());
+
+    // 重新统计目录中的实际大小，包含其他进程写入的文件
+    vector<DiskCacheFile> files = listCacheFiles(path);
+    uint64_t total = sumCacheFileBytes(files);
+    if (total > max_bytes) {
+        std::sort(files.begin(), files.end(),
+                  [](const DiskCacheFile& a, const DiskCacheFile& b) { return a.mtime < b.mtime; });
+        uint64_t target = max_bytes / 4 * 3;
+        for (const auto& file : files) {
+            if (total <= target) {
+                break;
+            }
+            // 其他进程可能正在读取（Windows 下无法删除）或已删除，忽略失败
+            if (0 == std::remove(file.filename.c_str())) {
+                total -= file.size;
+            }
+        }
+    }
+    g_disk_cache_used_bytes = total;
+}
+
+bool IndicatorDiskCache::getKey(const IndicatorImp& imp, string& key) {
+    KData k = imp.getContext();
+    HKU_IF_RETURN(k.empty() || k.getStock().isNull(), false);
+
+    // 含库版本，升级后算法变化的指标不会命中旧版本写入的缓存
+    std::ostringstream os;
+    os << HKU_VERSION << "|" << k.getStock().market_code() << "|" << k.getQuery() << "|";
+    HKU_IF_RETURN(!_buildKey(imp, os), false);
+    key = os.str();
+    return true;
+}
+
+bool IndicatorDiskCache::_buildKey(const IndicatorImp& imp, std::ostringstream& os) {
+    HKU_IF_RETURN(!imp.supportDiskCache(), false);
+    os << typeid(imp).name() << "|" << imp.m_optype << "|" << imp.name() << "|"
+       << imp.algorithmVersion() << "|";
+
+    // 参数须完整写入键值，列表类型参数以内容哈希代替
+    const Parameter& params = imp.getParameter();
+    for (auto iter = params.begin(); iter != params.end(); ++iter) {
+        const string& name = iter->first;
+        const boost::any& value = iter->second;
+        if (value.type() == typeid(KData)) {
+            // 上下文已单独写入键值，其他 K 线数据无法判断是否变化
+            HKU_IF_RETURN(name != "kdata", false);
+            continue;
+        }
+
+        os << name << "=";
+        if (value.type() == typeid(int)) {
+            os << boost::any_cast<int>(value);
+        } else if (value.type() == typeid(int64_t)) {
+            os << boost::any_cast<int64_t>(value);
+        } else if (value.type() == typeid(bool)) {
+            os << boost::any_cast<bool>(value);
+        } else if (value.type() == typeid(double)) {
+            os << fmt::format("{}", boost::any_cast<double>(value));
+        } else if (value.type() == typeid(string)) {
+            os << "\"" << boost::any_cast<const string&>(value) << "\"";
+        } else if (value.type() == typeid(PriceList)) {
+            const auto& x = boost::any_cast<const PriceList&>(value);
+            os << "P" << x.size() << ":" << XXH64(x.data(), x.size() * sizeof(price_t), 0);
+        } else if (value.type() == typeid(DatetimeList)) {
+            const auto& x = boost::any_cast<const DatetimeList&>(value);
+            vector<uint64_t> ticks(x.size());
+            for (size_t i = 0, total = x.size(); i < total; i++) {
+                ticks[i] = x[i].ticks();
+            }
+            os << "D" << ticks.size() << ":"
+               << XXH64(ticks.data(), ticks.size() * sizeof(uint64_t), 0);
+        } else {
+            // Stock、Block、KQuery 等参数表示依赖其他证券的数据
+            return false;
+        }
+        os << ",";
+    }
+
+    for (const auto& param : imp.m_ind_params) {
+        os << "[" << param.first << ":";
+        HKU_IF_RETURN(!_buildKey(*param.second, os), false);
+        os << "]";
+    }
+
+    const std::pair<const char*, const IndicatorImpPtr*> subs[] = {
+      {"3", &imp.m_three}, {"L", &imp.m_left}, {"R", &imp.m_right}};
+    for (const auto& sub : subs) {
+        if (*sub.second) {
+            os << "(" << sub.first << ":";
+            HKU_IF_RETURN(!_buildKey(**sub.second, os), false);
+            os << ")";
+        }
+    }
+
+    IndicatorImpPtr ref = imp.getRefImp();
+    if (ref) {
+        os << "{";
+        HKU_IF_RETURN(!_buildKey(*ref, os), false);
+        os << "}";
+    }
+    return true;
+}
+
+uint64_t IndicatorDiskCache::getDataStamp(const KData& kdata) {
+    XXH64_state_t* state = XXH64_createState();
+    HKU_IF_RETURN(!state, 0);
+
+    XXH64_reset(state, 0);
+    size_t total = kdata.size();
+    XXH64_update(state, &total, sizeof(total));
+    for (size_t i = 0; i < total; i++) {
+        // 列式存储时按值读取，避免生成完整的 KRecord 副本
+        KRecord record = kdata.getKRecordValue(i);
+        uint64_t ticks = record.datetime.ticks();
+        price_t values[6] = {record.openPrice,  record.highPrice,   record.lowPrice,
+                             record.closePrice, record.transAmount, record.transCount};
+        XXH64_update(state, &ticks, sizeof(ticks));
+        XXH64_update(state, values, sizeof(values));
+    }
+
+    uint64_t result = XXH64_digest(state);
+    XXH64_freeState(state);
+    return result;
+}
+
+string IndicatorDiskCache::_getFileName(const string& key) {
+    string path = getPath();
+    HKU_IF_RETURN(path.empty(), string());
+    return fmt::format("{}/{:016x}{}", path, XXH64(key.data(), key.size(), 0), g_disk_cache_ext);
+}
+
+bool IndicatorDiskCache::load(const string& key, const KData& kdata, IndicatorImp& imp,
+                              uint64_t& stamp) {
+    string filename = _getFileName(key);
+    HKU_IF_RETURN(filename.empty() || !existFile(filename), false);
+
+    try {
+        boost::interprocess::file_mapping file(filename.c_str(), boost::interprocess::read_only);
+        boost::interprocess::mapped_region region(file, boost::interprocess::read_only);
+        const char* data = static_cast<const char*>(region.get_address());
+        size_t size = region.get_size();
+        HKU_IF_RETURN(size < sizeof(DiskCacheHeader), false);
+
+        DiskCacheHeader header;
+        memcpy(&header, data, sizeof(header));
+        HKU_IF_RETURN(memcmp(header.magic, g_disk_cache_magic, sizeof(header.magic)) != 0 ||
+                        header.format != g_disk_cache_format ||
+                        header.value_size != sizeof(IndicatorImp::value_t) ||
+                        header.key_len != key.size() || header.result_num == 0 ||
+                        header.result_num > MAX_RESULT_NUM || header.discard > header.total,
+                      false);
+
+        size_t key_offset = sizeof(DiskCacheHeader);
+        size_t values_offset = key_offset + align8(header.key_len);
+        size_t values_len = header.total * sizeof(IndicatorImp::value_t);
+        HKU_IF_RETURN(size < values_offset + header.result_num * values_len, false);
+        HKU_IF_RETURN(memcmp(data + key_offset, key.data(), key.size()) != 0, false);
+
+        // 最后才计算数据指纹，需遍历全部K线数据
+        stamp = getDataStamp(kdata);
+        HKU_IF_RETURN(header.stamp != stamp, false);
+
+        imp._readyBuffer(header.total, header.result_num);
+        for (size_t r = 0; r < header.result_num; r++) {
+            memcpy(imp.m_pBuffer[r]->data(), data + values_offset + r * values_len, values_len);
+        }
+        imp.m_discard = header.discard;
+
+    } catch (const std::exception& e) {
+        HKU_WARN("Failed load indicator disk cache: {}! {}", filename, e.what());
+        return false;
+    }
+
+    // 仅恢复根节点，子节点未加载数据，保持待计算状态
+
+    touchCacheFile(filename);
+    g_disk_cache_hits++;
+    return true;
+}
+
+void IndicatorDiskCache::save(const string& key, uint64_t stamp, const IndicatorImp& imp) {
+    string filename = _getFileName(key);
+    HKU_IF_RETURN(filename.empty(), void());
+
+    DiskCacheHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, g_disk_cache_magic, sizeof(header.magic));
+    header.format = g_disk_cache_format;
+    header.value_size = sizeof(IndicatorImp::value_t);
+    header.stamp = stamp;
+    header.total = imp.size();
+    header.discard = imp.discard();
+    header.result_num = imp.getResultNumber();
+    header.key_len = key.size();
+
+    // 先写入临时文件再改名，避免其他进程读取到不完整的文件
+    uint64_t seq = g_disk_cache_tmp_seq++;
+    string tmpname = fmt::format(
+      "{}.{}.{}.{}.tmp", filename, std::hash<std::thread::id>()(std::this_thread::get_id()), seq,
+      std::chrono::steady_clock::now().time_since_epoch().count());
+    {
+        std::ofstream out(tmpname, std::ios::binary | std::ios::trunc);
+        HKU_WARN_IF_RETURN(!out, void(), "Failed create indicator disk cache file: {}", tmpname);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(key.data(), key.size());
+        const char padding[8] = {0};
+        out.write(padding, align8(key.size()) - key.size());
+        size_t values_len = header.total * sizeof(IndicatorImp::value_t);
+        for (size_t r = 0; r < header.result_num; r++) {
+            out.write(reinterpret_cast<const char*>(imp.data(r)), values_len);
+        }
+        out.close();
+        if (!out) {
+            HKU_WARN("Failed write indicator disk cache file: {}", tmpname);
+            removeFile(tmpname);
+            return;
+        }
+    }
+
+    if (!renameFile(tmpname, filename, true)) {
+        HKU_WARN("Failed rename indicator disk cache file: {}", tmpname);
+        removeFile(tmpname);
+        return;
+    }
+
+    // 覆盖写入时未扣除原文件大小，统计值偏大时会在清理时按实际大小修正
+    uint64_t max_bytes = g_disk_cache_max_bytes;
+    uint64_t used = g_disk_cache_used_bytes += sizeof(header) + align8(key.size()) +
+                                               header.result_num * header.total *
+                                                 sizeof(IndicatorImp::value_t);
+    if (max_bytes > 0 && used > max_bytes) {
+        _shrink();
+    }
+}
+
+} /* namespace hku */
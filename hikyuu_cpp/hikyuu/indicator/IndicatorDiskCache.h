@@ -0,0 +1,100 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-16
+ *      Author: fasiondog
+ */
+
+#pragma once
+#ifndef INDICATOR_INDICATORDISKCACHE_H_
+#define INDICATOR_INDICATORDISKCACHE_H_
+
+#include <sstream>
+#include "IndicatorImp.h"
+
+namespace hku {
+
+/**
+ * 指标计算结果的磁盘缓存，跨进程复用耗时指标（如滚动回归、卡尔曼滤波、SPEARMAN等）的结果
+ * @details
+ * <pre>
+ * 启用后，带有上下文的根节点在计算前先按 库版本 + 指标结构、参数及算法版本 + 证券 + 查询条件
+ * 查找缓存文件，文件中记录的上下文K线数据指纹与当前一致时直接加载，否则计算后覆盖写入。
+ * 上下文K线数据指纹仅在缓存文件存在或需写入时计算。
+ *
+ * 每个缓存文件保存一个指标的全部结果集，文件头之后按结果集依次连续存放，8字节对齐，
+ * 可直接内存映射读取。写入时先写临时文件再改名，多进程同时读写同一目录时不会读到不完整的文件。
+ *
+ * 仅缓存结果完全由上下文K线数据及参数决定的指标，含有财务、板块、其他证券等外部数据的指标
+ * 不缓存（见 IndicatorImp::supportDiskCache），自定义指标如依赖外部数据须重载该函数。
+ *
+ * 缓存文件总大小超出 setMaxBytes 指定的上限时，按最近使用时间由远及近删除缓存文件，
+ * 直至降至上限的 3/4 以下。
+ * </pre>
+ * @ingroup Indicator
+ */
+class HKU_API IndicatorDiskCache {
+public:
+    /**
+     * 设置缓存目录并启用磁盘缓存，目录不存在时自动创建
+     * @param path 缓存目录，为空时禁用磁盘缓存
+     * @return 目录无法创建时返回 false，此时磁盘缓存保持禁用
+     */
+    static bool setPath(const string& path);
+
+    /** 当前缓存目录，未启用时为空 */
+    static string getPath();
+
+    /** 是否已启用 */
+    static bool enabled();
+
+    /** 删除缓存目录中的全部缓存文件 */
+    static void clear();
+
+    /**
+     * 设置缓存文件占用的最大字节数，默认为 1GB
+     * @param bytes 最大字节数，为 0 时不限制
+     */
+    static void setMaxBytes(uint64_t bytes);
+
+    /** 缓存文件占用的最大字节数 */
+    static uint64_t getMaxBytes();
+
+    /** 缓存目录中缓存文件的总字节数（其他进程写入的文件在下一次清理时计入） */
+    static uint64_t usedBytes();
+
+    /** 本进程中从磁盘加载的次数 */
+    static size_t hits();
+
+    /**
+     * 获取指标根节点的缓存键值
+     * @param imp 已设置上下文的根节点
+     * @param key 输出，指标结构及参数、证券及查询条件
+     * @return 无上下文或节点（含子节点）无法缓存时返回 false
+     */
+    static bool getKey(const IndicatorImp& imp, string& key);
+
+    /** 上下文K线数据的指纹，K线数据发生任何变化时改变 */
+    static uint64_t getDataStamp(const KData& kdata);
+
+    /**
+     * 加载与键值及上下文K线数据一致的结果至 imp，仅由 IndicatorImp::calculate 调用
+     * @param key 缓存键值
+     * @param kdata 上下文K线数据
+     * @param imp 加载目标
+     * @param stamp 输出，上下文K线数据的指纹，缓存文件不存在或无效时不计算，保持不变
+     */
+    static bool load(const string& key, const KData& kdata, IndicatorImp& imp,
+                     uint64_t& stamp);
+
+    /** 保存已计算的结果，仅由 IndicatorImp::calculate 调用 */
+    static void save(const string& key, uint64_t stamp, const IndicatorImp& imp);
+
+private:
+    static bool _buildKey(const IndicatorImp& imp, std::ostringstream& os);
+    static string _getFileName(const string& key);
+    static void _shrink();
+};
+
+} /* namespace hku */
+#endif /* INDICATOR_INDICATORDISKCACHE_H_ */
@@ -11,10 +11,13 @@
 #include "hikyuu/global/sysinfo.h"
 #include "Indicator.h"
 #include "IndParam.h"
+#include "simd_kernel.h"
 #include "../Stock.h"
 #include "../GlobalInitializer.h"
 #include "imp/ICval.h"
 #include "imp/IContext.h"
+#include "IndicatorSharedCache.h"
+#include "IndicatorDiskCache.h"
 
 #if HKU_SUPPORT_SERIALIZATION
 BOOST_CLASS_EXPORT(hku::IndicatorImp)
@@ -23,6 +26,7 @@ BOOST_CLASS_EXPORT(hku::IndicatorImp)
 namespace hku {
 
 ThreadPool *IndicatorImp::ms_tg = nullptr;
+std::atomic_bool IndicatorImp::ms_fused_calculate{true};
 
 string HKU_API getOPTypeName(IndicatorImp::OPType op) {
     string name;
@@ -124,6 +128,14 @@ void IndicatorImp::releaseDynEngine() {
     }
 }
 
+void IndicatorImp::setFusedCalculate(bool enable) {
+    ms_fused_calculate = enable;
+}
+
+bool IndicatorImp::isFusedCalculate() {
+    return ms_fused_calculate;
+}
+
 HKU_API std::ostream &operator<<(std::ostream &os, const IndicatorImp &imp) {
     os << imp.str();
     return os;
@@ -190,7 +202,7 @@ void IndicatorImp::initContext() {
 void IndicatorImp::setContext(const Stock &stock, const KQuery &query) {
     KData kdata = getContext();
     if (kdata.getStock() == stock && kdata.getQuery() == query) {
-        if (m_need_calculate) {
+        if (m_need_calculate && !m_parent) {
             calculate();
         }
         return;
@@ -209,8 +221,10 @@ void IndicatorImp::setContext(const Stock &stock, const KQuery &query) {
     // 如果上下文有变化则重设上下文
     setParam<KData>("kdata", stock.getKData(query));
 
-    // 启动重新计算
-    calculate();
+    // 子节点由根节点统一计算，以便对逐元素运算的子树进行融合计算
+    if (!m_parent) {
+        calculate();
+    }
 }
 
 void IndicatorImp::setContext(const KData &k) {
@@ -218,7 +232,7 @@ void IndicatorImp::setContext(const KData &k) {
 
     // 上下文没变化的情况下根据自身标识进行计算
     if (old_k == k) {
-        if (m_need_calculate) {
+        if (m_need_calculate && !m_parent) {
             calculate();
         }
         return;
@@ -242,11 +256,11 @@ void IndicatorImp::setContext(const KData &k) {
     // 重设上下文
     setParam<KData>("kdata", k);
 
-    // 启动重新计算
-    calculate();
-
-    // 清理根节点之下所有节点中间计算数据
+    // 子节点由根节点统一计算，以便对逐元素运算的子树进行融合计算
     if (!m_parent) {
+        calculate();
+
+        // 清理根节点之下所有节点中间计算数据
         auto nodes = getAllSubNodes();
         for (const auto &node : nodes) {
             if (!node->m_need_calculate && node->size() > 0) {
@@ -256,6 +270,185 @@ void IndicatorImp::setContext(const KData &k) {
     }
 }
 
+// 判断新上下文是否仅在原上下文尾部追加或修改了最后一根K线，并获取需重新计算的起始位置
+static bool is_append_only(const KData &old_k, const KData &k, size_t &start_pos) {
+    size_t old_total = old_k.size();
+    HKU_IF_RETURN(old_total == 0 || k.size() < old_total, false);
+    HKU_IF_RETURN(old_k.getStock() != k.getStock(), false);
+
+    const KQuery &old_query = old_k.getQuery();
+    const KQuery &query = k.getQuery();
+    HKU_IF_RETURN(
+      old_query.kType() != query.kType() || old_query.recoverType() != query.recoverType(), false);
+
+    const KRecord &old_last = old_k.getKRecord(old_total - 1);
+    const KRecord &last = k.getKRecord(old_total - 1);
+    HKU_IF_RETURN(old_k.getKRecord(0).datetime != k.getKRecord(0).datetime ||
+                    old_last.datetime != last.datetime,
+                  false);
+
+    start_pos = old_last == last ? old_total : old_total - 1;
+    return true;
+}
+
+void IndicatorImp::updateContext(const KData &k) {
+    KData old_k = getContext();
+    size_t start_pos = 0;
+    size_t old_total = is_append_only(old_k, k, start_pos) ? old_k.size() : 0;
+
+    std::unordered_set<IndicatorImp *> visited;
+    _updateContext(k, old_total, start_pos, visited);
+}
+
+void IndicatorImp::_updateContext(const KData &k, size_t old_total, size_t start_pos,
+                                  std::unordered_set<IndicatorImp *> &visited) {
+    // 相同的节点可能被多个父节点引用，只需更新一次
+    HKU_IF_RETURN(!visited.insert(this).second, void());
+
+    // 子节点的长度需与上下文一致，且更新前后 discard 不变，本节点才可进行增量计算
+    bool can_increment = old_total > 0 && m_ind_params.empty();
+    IndicatorImp *children[3] = {m_three.get(), m_right.get(), m_left.get()};
+    for (auto *child : children) {
+        if (child) {
+            size_t old_discard = child->discard();
+            can_increment = can_increment && child->size() == old_total;
+            child->_updateContext(k, old_total, start_pos, visited);
+            can_increment =
+              can_increment && child->size() == k.size() && child->discard() == old_discard;
+        }
+    }
+
+    for (auto iter = m_ind_params.begin(); iter != m_ind_params.end(); ++iter) {
+        iter->second->_updateContext(k, old_total, start_pos, visited);
+    }
+
+    setParam<KData>("kdata", k);
+
+    if (!can_increment || !_tryIncrementCalculate(old_total, start_pos)) {
+        m_need_calculate = true;
+        calculate();
+    }
+    m_need_calculate = false;
+}
+
+bool IndicatorImp::_tryIncrementCalculate(size_t old_total, size_t start_pos) {
+    HKU_IF_RETURN(size() != old_total || m_discard >= start_pos, false);
+    HKU_IF_RETURN(m_optype == WEAVE || m_optype == INVALID, false);
+
+    size_t total = getContext().size();
+    for (size_t r = 0; r < m_result_num; ++r) {
+        HKU_IF_RETURN(!m_pBuffer[r], false);
+    }
+
+    // 扩展结果缓存，并将需重新计算的部分置为 Null
+    value_t null_value = Null<value_t>();
+    for (size_t r = 0; r < m_result_num; ++r) {
+        auto &buf = *m_pBuffer[r];
+        buf.resize(total, null_value);
+        std::fill(buf.begin() + start_pos, buf.end(), null_value);
+    }
+
+    bool success = true;
+    if (m_optype == LEAF) {
+        success = _increment_calculate(Indicator(), start_pos);
+    } else if (m_optype == OP) {
+        success = _increment_calculate(Indicator(m_right), start_pos);
+    } else {
+        execute_increment_op(start_pos);
+    }
+
+    // 失败时恢复原有长度，由完整计算重新生成
+    if (!success) {
+        for (size_t r = 0; r < m_result_num; ++r) {
+            m_pBuffer[r]->resize(old_total);
+        }
+    }
+    return success;
+}
+
+void IndicatorImp::execute_increment_op(size_t start_pos) {
+    // 各子节点长度与本节点相同，无需对齐
+    size_t total = size();
+    size_t pos = std::max(start_pos, m_discard);
+    HKU_IF_RETURN(pos >= total, void());
+
+    size_t n = total - pos;
+    for (size_t r = 0; r < m_result_num; ++r) {
+        auto *dst = this->data(r) + pos;
+        if (m_optype == OP_IF) {
+            simd::select(m_three->data(0) + pos, m_left->data(0) + pos, m_right->data(0) + pos,
+                         dst, n);
+            continue;
+        }
+
+        auto const *a = m_left->data(r) + pos;
+        auto const *b = m_right->data(r) + pos;
+        switch (m_optype) {
+            case ADD:
+                simd::add(a, b, dst, n);
+                break;
+
+            case SUB:
+                simd::sub(a, b, dst, n);
+                break;
+
+            case MUL:
+                simd::mul(a, b, dst, n);
+                break;
+
+            case DIV:
+                simd::div(a, b, dst, n);
+                break;
+
+            case MOD: {
+                value_t null_value = Null<value_t>();
+                for (size_t i = 0; i < n; i++) {
+                    if (b[i] == 0.0) {
+                        dst[i] = null_value;
+                    } else {
+                        dst[i] = int64_t(a[i]) % int64_t(b[i]);
+                    }
+                }
+            } break;
+
+            case EQ:
+                simd::eq(a, b, dst, n);
+                break;
+
+            case NE:
+                simd::ne(a, b, dst, n);
+                break;
+
+            case GT:
+                simd::gt(a, b, dst, n);
+                break;
+
+            case LT:
+                simd::lt(a, b, dst, n);
+                break;
+
+            case GE:
+                simd::ge(a, b, dst, n);
+                break;
+
+            case LE:
+                simd::le(a, b, dst, n);
+                break;
+
+            case AND:
+                simd::logic_and(a, b, dst, n);
+                break;
+
+            case OR:
+                simd::logic_or(a, b, dst, n);
+                break;
+
+            default:
+                break;
+        }
+    }
+}
+
 void IndicatorImp::_readyBuffer(size_t len, size_t result_num) {
     HKU_CHECK_THROW(result_num <= MAX_RESULT_NUM, std::invalid_argument,
                     "result_num oiverload MAX_RESULT_NUM! {}", name());
@@ -751,90 +944,127 @@ Indicator IndicatorImp::calculate() {
         return Indicator(result);
     }
 
-    switch (m_optype) {
-        case LEAF:
-            if (m_ind_params.empty()) {
-                _calculate(Indicator());
-            } else {
-                _dyn_calculate(Indicator());
-            }
-            break;
+    // 启用了共享缓存时（如参数扫描），优先复用其他实例中等效节点的计算结果
+    IndicatorSharedCache *shared_cache = IndicatorSharedCache::current();
+    IndicatorSharedCache::Scope shared_scope(shared_cache, *this);
+    IndicatorImpPtr shape;
+    bool loaded = false;
+    if (shared_scope.cacheable()) {
+        loaded = shared_cache->load(shared_scope.key(), *this);
+        if (!loaded) {
+            shape = shared_scope.shape();
+        }
+    }
 
-        case OP: {
-            m_right->calculate();
-            _readyBuffer(m_right->size(), m_result_num);
-            Indicator tmp_ind(m_right);
-            if (m_ind_params.empty()) {
-                _calculate(tmp_ind);
-            } else {
-                _dyn_calculate(tmp_ind);
-            }
-            setParam<KData>("kdata", m_right->getParam<KData>("kdata"));
-        } break;
+    // 启用了磁盘缓存时，根节点优先加载之前已保存的相同上下文数据下的计算结果
+    string disk_key;
+    uint64_t disk_stamp = 0;
+    bool disk_save = false;
+    if (!loaded && !m_parent && IndicatorDiskCache::enabled() &&
+        IndicatorDiskCache::getKey(*this, disk_key)) {
+        loaded = IndicatorDiskCache::load(disk_key, getContext(), *this, disk_stamp);
+        disk_save = !loaded;
+    }
 
-        case ADD:
-            execute_add();
-            break;
+    // 逐元素运算的子树优先进行融合计算，无法融合时按节点逐个计算
+    if (!loaded && !execute_fused()) {
+        switch (m_optype) {
+            case LEAF:
+                if (m_ind_params.empty()) {
+                    _calculate(Indicator());
+                } else {
+                    _dyn_calculate(Indicator());
+                }
+                break;
 
-        case SUB:
-            execute_sub();
-            break;
+            case OP: {
+                m_right->calculate();
+                _readyBuffer(m_right->size(), m_result_num);
+                Indicator tmp_ind(m_right);
+                if (m_ind_params.empty()) {
+                    _calculate(tmp_ind);
+                } else {
+                    _dyn_calculate(tmp_ind);
+                }
+                setParam<KData>("kdata", m_right->getParam<KData>("kdata"));
+            } break;
 
-        case MUL:
-            execute_mul();
-            break;
+            case ADD:
+                execute_add();
+                break;
 
-        case DIV:
-            execute_div();
-            break;
+            case SUB:
+                execute_sub();
+                break;
 
-        case MOD:
-            execute_mod();
-            break;
+            case MUL:
+                execute_mul();
+                break;
 
-        case EQ:
-            execute_eq();
-            break;
+            case DIV:
+                execute_div();
+                break;
 
-        case NE:
-            execute_ne();
-            break;
+            case MOD:
+                execute_mod();
+                break;
 
-        case GT:
-            execute_gt();
-            break;
+            case EQ:
+                execute_eq();
+                break;
 
-        case LT:
-            execute_lt();
-            break;
+            case NE:
+                execute_ne();
+                break;
 
-        case GE:
-            execute_ge();
-            break;
+            case GT:
+                execute_gt();
+                break;
 
-        case LE:
-            execute_le();
-            break;
+            case LT:
+                execute_lt();
+                break;
 
-        case AND:
-            execute_and();
-            break;
+            case GE:
+                execute_ge();
+                break;
 
-        case OR:
-            execute_or();
-            break;
+            case LE:
+                execute_le();
+                break;
 
-        case WEAVE:
-            execute_weave();
-            break;
+            case AND:
+                execute_and();
+                break;
 
-        case OP_IF:
-            execute_if();
-            break;
+            case OR:
+                execute_or();
+                break;
 
-        default:
-            HKU_ERROR("Unkown Indicator::OPType! {}", int(m_optype));
-            break;
+            case WEAVE:
+                execute_weave();
+                break;
+
+            case OP_IF:
+                execute_if();
+                break;
+
+            default:
+                HKU_ERROR("Unkown Indicator::OPType! {}", int(m_optype));
+                break;
+        }
+    }
+
+    if (shape && size() != 0) {
+        shared_cache->save(shared_scope.key(), std::move(shape), *this);
+    }
+
+    if (disk_save && size() != 0) {
+        // 缓存文件不存在时加载阶段未计算数据指纹
+        if (0 == disk_stamp) {
+            disk_stamp = IndicatorDiskCache::getDataStamp(getContext());
+        }
+        IndicatorDiskCache::save(disk_key, disk_stamp, *this);
     }
 
     // 使用原型方式时，不加此判断无法立刻重新计算
@@ -944,13 +1174,12 @@ void IndicatorImp::execute_add() {
     size_t diff = maxp->size() - minp->size();
     _readyBuffer(total, result_number);
     setDiscard(discard);
+    HKU_IF_RETURN(discard >= total, void());
     for (size_t r = 0; r < result_number; ++r) {
         auto const *data1 = maxp->data(r);
         auto const *data2 = minp->data(r);
         auto *result = this->data(r);
-        for (size_t i = discard; i < total; ++i) {
-            result[i] = data1[i] + data2[i - diff];
-        }
+        simd::add(data1 + discard, data2 + discard - diff, result + discard, total - discard);
     }
 }
 
@@ -977,23 +1206,20 @@ void IndicatorImp::execute_sub() {
     size_t diff = maxp->size() - minp->size();
     _readyBuffer(total, result_number);
     setDiscard(discard);
+    HKU_IF_RETURN(discard >= total, void());
     if (m_left->size() > m_right->size()) {
         for (size_t r = 0; r < result_number; ++r) {
             auto *data1 = m_left->data(r);
             auto *data2 = m_right->data(r);
             auto *result = this->data(r);
-            for (size_t i = discard; i < total; ++i) {
-                result[i] = data1[i] - data2[i - diff];
-            }
+            simd::sub(data1 + discard, data2 + discard - diff, result + discard, total - discard);
         }
     } else {
         for (size_t r = 0; r < result_number; ++r) {
             auto *data1 = m_left->data(r);
             auto *data2 = m_right->data(r);
             auto *result = this->data(r);
-            for (size_t i = discard; i < total; ++i) {
-                result[i] = data1[i - diff] - data2[i];
-            }
+            simd::sub(data1 + discard - diff, data2 + discard, result + discard, total - discard);
         }
     }
 }
@@ -1021,13 +1247,12 @@ void IndicatorImp::execute_mul() {
     size_t diff = maxp->size() - minp->size();
     _readyBuffer(total, result_number);
     setDiscard(discard);
+    HKU_IF_RETURN(discard >= total, void());
     for (size_t r = 0; r < result_number; ++r) {
         auto const *data1 = maxp->data(r);
         auto const *data2 = minp->data(r);
         auto *result = this->data(r);
-        for (size_t i = discard; i < total; ++i) {
-            result[i] = data1[i] * data2[i - diff];
-        }
+        simd::mul(data1 + discard, data2 + discard - diff, result + discard, total - discard);
     }
 }
 
@@ -1054,23 +1279,20 @@ void IndicatorImp::execute_div() {
     size_t diff = maxp->size() - minp->size();
     _readyBuffer(total, result_number);
     setDiscard(discard);
+    HKU_IF_RETURN(discard >= total, void());
     if (m_left->size() > m_right->size()) {
         for (size_t r = 0; r < result_number; ++r) {
             auto const *data1 = m_left->data(r);
             auto const *data2 = m_right->data(r);
             auto *result = this->data(r);
-            for (size_t i = discard; i < total; ++i) {
-                result[i] = data1[i] / data2[i - diff];
-            }
+            simd::div(data1 + discard, data2 + discard - diff, result + discard, total - discard);
         }
     } else {
         for (size_t r = 0; r < result_number; ++r) {
             auto const *data1 = m_left->data(r);
             auto const *data2 = m_right->data(r);
             auto *result = this->data(r);
-            for (size_t i = discard; i < total; ++i) {
-                result[i] = data1[i - diff] / data2[i];
-            }
+            simd::div(data1 + discard - diff, data2 + discard, result + discard, total - discard);
         }
     }
 }
@@ -1154,13 +1376,12 @@ void IndicatorImp::execute_eq() {
     size_t diff = maxp->size() - minp->size();
     _readyBuffer(total, result_number);
     setDiscard(discard);
+    HKU_IF_RETURN(discard >= total, void());
     for (size_t r = 0; r < result_number; ++r) {
         auto *dst = this->data(r);
         auto const *maxdata = maxp->data(r);
         auto const *mindata = minp->data(r);
-        for (size_t i = discard; i < total; ++i) {
-            dst[i] = (maxdata[i] == mindata[i - diff]) ? 1.0 : 0.0;
-        }
+        simd::eq(maxdata + discard, mindata + discard - diff, dst + discard, total - discard);
     }
 }
 
@@ -1187,13 +1408,12 @@ void IndicatorImp::execute_ne() {
     size_t diff = maxp->size() - minp->size();
     _readyBuffer(total, result_number);
     setDiscard(discard);
+    HKU_IF_RETURN(discard >= total, void());
     for (size_t r = 0; r < result_number; ++r) {
         auto *dst = this->data(r);
         auto const *maxdata = maxp->data(r);
         auto const *mindata = minp->data(r);
-        for (size_t i = discard; i < total; ++i) {
-            dst[i] = (maxdata[i] != mindata[i - diff]) ? 1.0 : 0.0;
-        }
+        simd::ne(maxdata + discard, mindata + discard - diff, dst + discard, total - discard);
     }
 }
 
@@ -1220,6 +1440,7 @@ void IndicatorImp::execute_gt() {
     size_t diff = maxp->size() - minp->size();
     _readyBuffer(total, result_number);
     setDiscard(discard);
+    HKU_IF_RETURN(discard >= total, void());
     value_t *dst = nullptr;
     value_t const *left = nullptr;
     value_t const *right = nullptr;
@@ -1228,18 +1449,14 @@ void IndicatorImp::execute_gt() {
             dst = this->data(r);
             left = m_left->data(r);
             right = m_right->data(r);
-            for (size_t i = discard; i < total; ++i) {
-                dst[i] = (left[i] > right[i - diff]) ? 1.0 : 0.0;
-            }
+            simd::gt(left + discard, right + discard - diff, dst + discard, total - discard);
         }
     } else {
         for (size_t r = 0; r < result_number; ++r) {
             dst = this->data(r);
             left = m_left->data(r);
             right = m_right->data(r);
-            for (size_t i = discard; i < total; ++i) {
-                dst[i] = (left[i - diff] > right[i]) ? 1.0 : 0.0;
-            }
+            simd::gt(left + discard - diff, right + discard, dst + discard, total - discard);
         }
     }
 }
@@ -1267,6 +1484,7 @@ void IndicatorImp::execute_lt() {
     size_t diff = maxp->size() - minp->size();
     _readyBuffer(total, result_number);
     setDiscard(discard);
+    HKU_IF_RETURN(discard >= total, void());
     value_t *dst = nullptr;
     value_t const *left = nullptr;
     value_t const *right = nullptr;
@@ -1275,18 +1493,14 @@ void IndicatorImp::execute_lt() {
             dst = this->data(r);
             left = m_left->data(r);
             right = m_right->data(r);
-            for (size_t i = discard; i < total; ++i) {
-                dst[i] = (left[i] < right[i - diff]) ? 1.0 : 0.0;
-            }
+            simd::lt(left + discard, right + discard - diff, dst + discard, total - discard);
         }
     } else {
         for (size_t r = 0; r < result_number; ++r) {
             dst = this->data(r);
             left = m_left->data(r);
             right = m_right->data(r);
-            for (size_t i = discard; i < total; ++i) {
-                dst[i] = left[i - diff] < right[i] ? 1.0 : 0.0;
-            }
+            simd::lt(left + discard - diff, right + discard, dst + discard, total - discard);
         }
     }
 }
@@ -1314,6 +1528,7 @@ void IndicatorImp::execute_ge() {
     size_t diff = maxp->size() - minp->size();
     _readyBuffer(total, result_number);
     setDiscard(discard);
+    HKU_IF_RETURN(discard >= total, void());
     value_t *dst = nullptr;
     value_t const *left = nullptr;
     value_t const *right = nullptr;
@@ -1322,18 +1537,14 @@ void IndicatorImp::execute_ge() {
             dst = this->data(r);
             left = m_left->data(r);
             right = m_right->data(r);
-            for (size_t i = discard; i < total; ++i) {
-                dst[i] = left[i] >= right[i - diff] ? 1.0 : 0.0;
-            }
+            simd::ge(left + discard, right + discard - diff, dst + discard, total - discard);
         }
     } else {
         for (size_t r = 0; r < result_number; ++r) {
             dst = this->data(r);
             left = m_left->data(r);
             right = m_right->data(r);
-            for (size_t i = discard; i < total; ++i) {
-                dst[i] = left[i - diff] >= right[i] ? 1.0 : 0.0;
-            }
+            simd::ge(left + discard - diff, right + discard, dst + discard, total - discard);
         }
     }
 }
@@ -1361,6 +1572,7 @@ void IndicatorImp::execute_le() {
     size_t diff = maxp->size() - minp->size();
     _readyBuffer(total, result_number);
     setDiscard(discard);
+    HKU_IF_RETURN(discard >= total, void());
     value_t *dst = nullptr;
     value_t const *left = nullptr;
     value_t const *right = nullptr;
@@ -1369,18 +1581,14 @@ void IndicatorImp::execute_le() {
             dst = this->data(r);
             left = m_left->data(r);
             right = m_right->data(r);
-            for (size_t i = discard; i < total; ++i) {
-                dst[i] = left[i] <= right[i - diff] ? 1.0 : 0.0;
-            }
+            simd::le(left + discard, right + discard - diff, dst + discard, total - discard);
         }
     } else {
         for (size_t r = 0; r < result_number; ++r) {
             dst = this->data(r);
             left = m_left->data(r);
             right = m_right->data(r);
-            for (size_t i = discard; i < total; ++i) {
-                dst[i] = left[i - diff] <= right[i] ? 1.0 : 0.0;
-            }
+            simd::le(left + discard - diff, right + discard, dst + discard, total - discard);
         }
     }
 }
@@ -1408,13 +1616,12 @@ void IndicatorImp::execute_and() {
     size_t diff = maxp->size() - minp->size();
     _readyBuffer(total, result_number);
     setDiscard(discard);
+    HKU_IF_RETURN(discard >= total, void());
     for (size_t r = 0; r < result_number; ++r) {
         auto *dst = this->data(r);
         auto const *maxdata = maxp->data(r);
         auto const *mindata = minp->data(r);
-        for (size_t i = discard; i < total; ++i) {
-            dst[i] = (maxdata[i] > 0.0) && (mindata[i - diff] > 0.0) ? 1.0 : 0.0;
-        }
+        simd::logic_and(maxdata + discard, mindata + discard - diff, dst + discard, total - discard);
     }
 }
 
@@ -1441,13 +1648,12 @@ void IndicatorImp::execute_or() {
     size_t diff = maxp->size() - minp->size();
     _readyBuffer(total, result_number);
     setDiscard(discard);
+    HKU_IF_RETURN(discard >= total, void());
     for (size_t r = 0; r < result_number; ++r) {
         auto *dst = this->data(r);
         auto const *maxdata = maxp->data(r);
         auto const *mindata = minp->data(r);
-        for (size_t i = discard; i < total; ++i) {
-            dst[i] = (maxdata[i] > 0.0) || (mindata[i - diff] > 0.0) ? 1.0 : 0.0;
-        }
+        simd::logic_or(maxdata + discard, mindata + discard - diff, dst + discard, total - discard);
     }
 }
 
@@ -1491,8 +1697,14 @@ void IndicatorImp::execute_if() {
     auto *left = m_left->data(0);
     auto *right = m_right->data(0);
     auto *three = m_three->data(0);
+    bool aligned = discard >= diff_cond && discard >= diff_left && discard >= diff_right;
     for (size_t r = 0; r < result_number; ++r) {
         auto *dst = this->data(r);
+        if (aligned && discard < total) {
+            simd::select(three + discard - diff_cond, left + discard - diff_left,
+                         right + discard - diff_right, dst + discard, total - discard);
+            continue;
+        }
         for (size_t i = discard; i < total; ++i) {
             if (three[i - diff_cond] > 0.0) {
                 dst[i] = left[i - diff_left];
@@ -1503,6 +1715,278 @@ void IndicatorImp::execute_if() {
     }
 }
 
+/*
+ * 融合计算节点
+ * 逐元素运算节点不再分配独立的结果缓存，而是在根节点的一次循环中按块（FUSED_BLOCK_SIZE）
+ * 递归求值，中间结果仅存放于块大小的临时缓存中。叶子节点（含无法融合的节点）直接读取其结果缓存。
+ * 各节点的长度、discard、对齐偏移与 execute_xxx 的计算规则完全一致，以保证结果相同。
+ */
+struct IndicatorImp::FusedNode {
+    static constexpr size_t FUSED_BLOCK_SIZE = 512;
+
+    IndicatorImp *imp{nullptr};
+    OPType optype{LEAF};    // 已计算完毕的节点统一标记为 LEAF
+    size_t first{0};        // 第一操作数在 prog 中的位置
+    size_t second{0};       // 第二操作数在 prog 中的位置
+    size_t third{0};        // IF 条件在 prog 中的位置
+    size_t first_offset{0};  // 各操作数与本节点的对齐偏移
+    size_t second_offset{0};
+    size_t third_offset{0};
+    size_t total{0};
+    size_t discard{0};
+    size_t result_num{0};
+    size_t scratch{0};  // 在临时缓存中的起始位置
+    const value_t *data[MAX_RESULT_NUM] = {nullptr};
+
+    static const value_t *fetch(const vector<FusedNode> &prog, size_t idx, size_t r,
+                                size_t start, size_t len, value_t *buf) {
+        const FusedNode &node = prog[idx];
+        if (node.optype == LEAF) {
+            return node.data[r] + start;
+        }
+        value_t *out = buf + node.scratch;
+        eval(prog, idx, r, start, len, out, buf);
+        return out;
+    }
+
+    // 计算 prog[idx] 在 [start, start + len) 范围的值，并写入 out
+    static void eval(const vector<FusedNode> &prog, size_t idx, size_t r, size_t start,
+                     size_t len, value_t *out, value_t *buf) {
+        const FusedNode &node = prog[idx];
+        size_t null_len = 0;
+        if (node.discard > start) {
+            null_len = node.discard - start < len ? node.discard - start : len;
+            value_t null_value = Null<value_t>();
+            for (size_t i = 0; i < null_len; i++) {
+                out[i] = null_value;
+            }
+        }
+
+        HKU_IF_RETURN(null_len >= len, void());
+        size_t pos = start + null_len;
+        size_t n = len - null_len;
+        value_t *dst = out + null_len;
+
+        if (node.optype == OP_IF) {
+            auto const *three = fetch(prog, node.third, 0, pos - node.third_offset, n, buf);
+            auto const *left = fetch(prog, node.first, 0, pos - node.first_offset, n, buf);
+            auto const *right = fetch(prog, node.second, 0, pos - node.second_offset, n, buf);
+            simd::select(three, left, right, dst, n);
+            return;
+        }
+
+        auto const *a = fetch(prog, node.first, r, pos - node.first_offset, n, buf);
+        auto const *b = fetch(prog, node.second, r, pos - node.second_offset, n, buf);
+        switch (node.optype) {
+            case ADD:
+                simd::add(a, b, dst, n);
+                break;
+
+            case SUB:
+                simd::sub(a, b, dst, n);
+                break;
+
+            case MUL:
+                simd::mul(a, b, dst, n);
+                break;
+
+            case DIV:
+                simd::div(a, b, dst, n);
+                break;
+
+            case MOD: {
+                value_t null_value = Null<value_t>();
+                for (size_t i = 0; i < n; i++) {
+                    if (b[i] == 0.0) {
+                        dst[i] = null_value;
+                    } else {
+                        dst[i] = int64_t(a[i]) % int64_t(b[i]);
+                    }
+                }
+            } break;
+
+            case EQ:
+                simd::eq(a, b, dst, n);
+                break;
+
+            case NE:
+                simd::ne(a, b, dst, n);
+                break;
+
+            case GT:
+                simd::gt(a, b, dst, n);
+                break;
+
+            case LT:
+                simd::lt(a, b, dst, n);
+                break;
+
+            case GE:
+                simd::ge(a, b, dst, n);
+                break;
+
+            case LE:
+                simd::le(a, b, dst, n);
+                break;
+
+            case AND:
+                simd::logic_and(a, b, dst, n);
+                break;
+
+            case OR:
+                simd::logic_or(a, b, dst, n);
+                break;
+
+            default:
+                break;
+        }
+    }
+};
+
+bool IndicatorImp::_canFuse() const {
+    return (m_optype >= ADD && m_optype <= OR) || m_optype == OP_IF;
+}
+
+size_t IndicatorImp::_compileFused(vector<FusedNode> &prog) {
+    // 子节点仅被当前节点引用且尚未计算时才进行融合，否则先按常规方式计算，并作为叶子节点
+    auto compile_child = [&prog](const IndicatorImpPtr &child) -> size_t {
+        if (child->_canFuse() && child.use_count() == 1 &&
+            (child->needCalculate() || child->size() == 0)) {
+            size_t mark = prog.size();
+            size_t pos = child->_compileFused(prog);
+            if (pos != Null<size_t>()) {
+                return pos;
+            }
+            prog.resize(mark);
+        }
+
+        child->calculate();
+        FusedNode node;
+        node.imp = child.get();
+        node.total = child->size();
+        node.discard = child->discard();
+        node.result_num = child->getResultNumber();
+        for (size_t r = 0; r < node.result_num; r++) {
+            node.data[r] = child->data(r);
+        }
+        prog.push_back(node);
+        return prog.size() - 1;
+    };
+
+    // 与 execute_xxx 保持相同的子节点计算顺序
+    size_t three = m_three ? compile_child(m_three) : 0;
+    size_t right = compile_child(m_right);
+    size_t left = compile_child(m_left);
+
+    const FusedNode &lnode = prog[left];
+    const FusedNode &rnode = prog[right];
+    HKU_IF_RETURN(lnode.result_num == 0 || rnode.result_num == 0, Null<size_t>());
+
+    FusedNode node;
+    node.imp = this;
+    node.optype = m_optype;
+    node.result_num = std::min(lnode.result_num, rnode.result_num);
+
+    if (m_optype == OP_IF) {
+        const FusedNode &cnode = prog[three];
+        HKU_IF_RETURN(cnode.result_num == 0, Null<size_t>());
+        const FusedNode &maxp = rnode.total > lnode.total ? rnode : lnode;
+        const FusedNode &minp = rnode.total > lnode.total ? lnode : rnode;
+        size_t total = maxp.total;
+        size_t discard = maxp.total - minp.total + minp.discard;
+        discard = std::max(discard, maxp.discard);
+        discard = std::max(discard, cnode.discard);
+        if (cnode.total >= maxp.total) {
+            total = cnode.total;
+            discard = total + discard - maxp.total;
+        } else {
+            discard = total - cnode.total;
+        }
+
+        node.first = left;
+        node.second = right;
+        node.third = three;
+        node.first_offset = total - lnode.total;
+        node.second_offset = total - rnode.total;
+        node.third_offset = total - cnode.total;
+        node.total = total;
+        node.discard = discard > total ? total : discard;
+
+        // 常规计算中存在越界访问的情况，不进行融合
+        HKU_IF_RETURN(node.discard < total &&
+                        (node.discard < node.first_offset || node.discard < node.second_offset ||
+                         node.discard < node.third_offset),
+                      Null<size_t>());
+
+    } else {
+        // 可交换的运算与 execute_xxx 一致，以较长的一方作为第一操作数
+        bool commutative = m_optype == ADD || m_optype == MUL || m_optype == EQ ||
+                           m_optype == NE || m_optype == AND || m_optype == OR;
+        if (commutative && rnode.total > lnode.total) {
+            std::swap(left, right);
+        }
+
+        const FusedNode &first = prog[left];
+        const FusedNode &second = prog[right];
+        size_t total = std::max(first.total, second.total);
+        node.first = left;
+        node.second = right;
+        node.first_offset = total - first.total;
+        node.second_offset = total - second.total;
+        node.total = total;
+        size_t discard =
+          std::max(node.first_offset + first.discard, node.second_offset + second.discard);
+        node.discard = discard > total ? total : discard;
+    }
+
+    prog.push_back(node);
+    return prog.size() - 1;
+}
+
+bool IndicatorImp::execute_fused() {
+    HKU_IF_RETURN(!ms_fused_calculate || !_canFuse(), false);
+
+    vector<FusedNode> prog;
+    prog.reserve(16);
+    size_t root = _compileFused(prog);
+    HKU_IF_RETURN(root == Null<size_t>(), false);
+
+    // 没有可融合的中间节点时，直接按常规方式计算
+    size_t scratch_len = 0;
+    for (size_t i = 0; i < root; i++) {
+        if (prog[i].optype != LEAF) {
+            prog[i].scratch = scratch_len;
+            scratch_len += FusedNode::FUSED_BLOCK_SIZE;
+        }
+    }
+    HKU_IF_RETURN(scratch_len == 0, false);
+
+    const FusedNode &node = prog[root];
+    size_t total = node.total;
+    _readyBuffer(total, node.result_num);
+    setDiscard(node.discard);
+
+    vector<value_t> scratch(scratch_len);
+    for (size_t r = 0; r < node.result_num; r++) {
+        auto *dst = this->data(r);
+        for (size_t start = node.discard; start < total;
+             start += FusedNode::FUSED_BLOCK_SIZE) {
+            size_t len = std::min(FusedNode::FUSED_BLOCK_SIZE, total - start);
+            FusedNode::eval(prog, root, r, start, len, dst + start, scratch.data());
+        }
+    }
+
+    // 被融合的中间节点视同已计算，其结果不再保留
+    for (size_t i = 0; i < root; i++) {
+        if (prog[i].optype != LEAF) {
+            prog[i].imp->_clearBuffer();
+            prog[i].imp->m_need_calculate = false;
+        }
+    }
+
+    return true;
+}
+
 void IndicatorImp::_dyn_calculate(const Indicator &ind) {
     // SPEND_TIME(IndicatorImp__dyn_calculate);
     const auto &ind_param = getIndParamImp("n");
@@ -1519,14 +2003,7 @@ void IndicatorImp::_dyn_calculate(const Indicator &ind) {
     size_t workerNum = ms_tg->worker_num();
     if (total < minCircleLength || isSerial() || workerNum == 1) {
         // HKU_INFO("single_thread");
-        for (size_t i = ind.discard(); i < total; i++) {
-            if (std::isnan(param_data[i])) {
-                _set(Null<value_t>(), i);
-            } else {
-                size_t step = size_t(param_data[i]);
-                _dyn_run_one_step(ind, i, step);
-            }
-        }
+        _dyn_run_range(ind, param_data, ind.discard(), total);
         _update_discard();
         return;
     }
@@ -1545,19 +2022,12 @@ void IndicatorImp::_dyn_calculate(const Indicator &ind) {
             break;
         }
         tasks.push_back(
-          ms_tg->submit([this, &ind, first, circleLength, total, group, param_data]() {
+          ms_tg->submit([this, &ind, first, circleLength, total, param_data]() {
               size_t endPos = first + circleLength;
               if (endPos > total) {
                   endPos = total;
               }
-              for (size_t i = circleLength * group; i < endPos; i++) {
-                  if (std::isnan(param_data[i])) {
-                      _set(Null<value_t>(), i);
-                  } else {
-                      size_t step = size_t(param_data[i]);
-                      _dyn_run_one_step(ind, i, step);
-                  }
-              }
+              _dyn_run_range(ind, param_data, std::max(first, ind.discard()), endPos);
           }));
     }
 
@@ -1568,6 +2038,17 @@ void IndicatorImp::_dyn_calculate(const Indicator &ind) {
     _update_discard();
 }
 
+void IndicatorImp::_dyn_run_range(const Indicator &ind, const value_t *steps, size_t start,
+                                  size_t end) {
+    for (size_t i = start; i < end; i++) {
+        if (std::isnan(steps[i])) {
+            _set(Null<value_t>(), i);
+        } else {
+            _dyn_run_one_step(ind, i, size_t(steps[i]));
+        }
+    }
+}
+
 void IndicatorImp::_update_discard() {
     size_t total = size();
     for (size_t result_index = 0; result_index < m_result_num; result_index++) {
@@ -1604,7 +2085,7 @@ bool IndicatorImp::alike(const IndicatorImp &other) const {
     }
 
     auto iter1 = m_ind_params.cbegin();
-    auto iter2 = other.m_ind_params.cend();
+    auto iter2 = other.m_ind_params.cbegin();
     for (; iter1 != m_ind_params.cend() && iter2 != other.m_ind_params.cend(); ++iter1, ++iter2) {
         HKU_IF_RETURN(iter1->first != iter2->first, false);
         HKU_IF_RETURN(!iter1->second->alike(*(iter2->second)), false);
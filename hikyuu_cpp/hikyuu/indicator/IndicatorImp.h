@@ -9,17 +9,26 @@
 #ifndef INDICATORIMP_H_
 #define INDICATORIMP_H_
 
+#include <atomic>
+#include <unordered_set>
 #include "../config.h"
 #include "../KData.h"
 #include "../utilities/Parameter.h"
 #include "../utilities/thread/thread.h"
 
+#if HKU_SUPPORT_SERIALIZATION
+#include <boost/serialization/version.hpp>
+#include "../serialization/BinaryArray_serialization.h"
+#endif
+
 namespace hku {
 
 #define MAX_RESULT_NUM 6
 
 class HKU_API Indicator;
 class HKU_API IndParam;
+class HKU_API IndicatorSharedCache;
+class HKU_API IndicatorDiskCache;
 
 /**
  * 指标实现类，定义新指标时，应从此类继承
@@ -28,6 +37,8 @@ class HKU_API IndParam;
 class HKU_API IndicatorImp : public enable_shared_from_this<IndicatorImp> {
     PARAMETER_SUPPORT_WITH_CHECK
     friend HKU_API std::ostream& operator<<(std::ostream& os, const IndicatorImp& imp);
+    friend class IndicatorSharedCache;
+    friend class IndicatorDiskCache;
 
 public:
     enum OPType {
@@ -132,6 +143,14 @@ public:
 
     void setContext(const KData&);
 
+    /**
+     * 增量更新上下文，用于实时行情更新后的指标重算
+     * @details 新上下文与原上下文为同一证券、相同K线类型及复权方式，且仅在尾部追加了K线或
+     * 修改了最后一根K线时，支持增量计算的节点只计算尾部数据，其余节点进行完整计算；否则
+     * 等同于完整重算。与 setContext 不同，计算后保留中间节点的结果，以便下次增量计算。
+     */
+    void updateContext(const KData&);
+
     KData getContext() const;
 
     void add(OPType, IndicatorImpPtr left, IndicatorImpPtr right);
@@ -159,6 +178,24 @@ public:
 
     virtual void _dyn_run_one_step(const Indicator& ind, size_t curPos, size_t step) {}
 
+    /**
+     * 动态参数时计算 [start, end) 范围内各位置的值，steps 为各位置的动态参数值（可能为 NaN）
+     * @details 默认逐个调用 _dyn_run_one_step，滑动窗口类指标可重载以便在连续位置间增量计算
+     */
+    virtual void _dyn_run_range(const Indicator& ind, const value_t* steps, size_t start,
+                                size_t end);
+
+    /**
+     * 增量计算，仅计算 [start_pos, size()) 范围内的结果，之前的结果保持不变
+     * @details 调用前结果缓存已扩展至新的长度，且 [start_pos, size()) 已置为 Null。
+     * 无法进行增量计算时返回 false，此时将进行完整计算。
+     * @param ind 输入指标，叶子节点时为空
+     * @param start_pos 需重新计算的起始位置
+     */
+    virtual bool _increment_calculate(const Indicator& ind, size_t start_pos) {
+        return false;
+    }
+
     /** 是否支持指标动态参数 */
     virtual bool supportIndParam() const {
         return false;
@@ -177,6 +214,21 @@ public:
         return false;
     }
 
+    /** 计算结果是否仅由上下文K线数据及参数决定，可持久化至磁盘缓存 */
+    virtual bool supportDiskCache() const {
+        return true;
+    }
+
+    /** 算法版本，算法调整导致计算结果变化时递增，使之前保存的磁盘缓存失效 */
+    virtual int algorithmVersion() const {
+        return 0;
+    }
+
+    /** 计算时依赖的其他指标节点（如双输入指标的参考指标），生成缓存键值时一并计入 */
+    virtual IndicatorImpPtr getRefImp() const {
+        return IndicatorImpPtr();
+    }
+
     virtual void _dyn_calculate(const Indicator&);
 
 private:
@@ -198,6 +250,16 @@ private:
     void execute_weave();
     void execute_if();
 
+    struct FusedNode;
+    bool execute_fused();
+    bool _canFuse() const;
+    size_t _compileFused(std::vector<FusedNode>& prog);
+
+    void _updateContext(const KData& k, size_t old_total, size_t start_pos,
+                        std::unordered_set<IndicatorImp*>& visited);
+    bool _tryIncrementCalculate(size_t old_total, size_t start_pos);
+    void execute_increment_op(size_t start_pos);
+
     std::vector<IndicatorImpPtr> getAllSubNodes() const;
     void repeatALikeNodes();
 
@@ -228,8 +290,13 @@ public:
     static void initDynEngine();
     static void releaseDynEngine();
 
+    /** 设置是否对逐元素运算（ADD..OR、IF）组成的子树进行融合计算，默认开启 */
+    static void setFusedCalculate(bool enable);
+    static bool isFusedCalculate();
+
 protected:
     static ThreadPool* ms_tg;
+    static std::atomic_bool ms_fused_calculate;
 
 #if HKU_SUPPORT_SERIALIZATION
 private:
@@ -255,6 +322,14 @@ private:
             }
         }
         ar& BOOST_SERIALIZATION_NVP(act_result_num);
+        if constexpr (is_binary_archive<Archive>::value) {
+            // 二进制归档按连续数组整体写入
+            for (size_t i = 0; i < act_result_num; ++i) {
+                saveBinaryArray(ar, m_pBuffer[i]->data(), size());
+            }
+            return;
+        }
+
         string nan("nan");
         string inf;
         for (size_t i = 0; i < act_result_num; ++i) {
@@ -290,6 +365,16 @@ private:
 
         size_t act_result_num = 0;
         ar& BOOST_SERIALIZATION_NVP(act_result_num);
+        if constexpr (is_binary_archive<Archive>::value) {
+            if (version >= 1) {
+                for (size_t i = 0; i < act_result_num; ++i) {
+                    m_pBuffer[i] = new vector<value_t>();
+                    loadBinaryArray(ar, *m_pBuffer[i]);
+                }
+                return;
+            }
+        }
+
         for (size_t i = 0; i < act_result_num; ++i) {
             m_pBuffer[i] = new vector<value_t>();
             size_t count = 0;
@@ -356,6 +441,20 @@ public:                                           \
         return true;                              \
     }
 
+// 计算结果依赖财务、板块、其他证券等上下文K线以外的数据，不可持久化缓存
+#define INDICATOR_NO_DISK_CACHE                      \
+public:                                              \
+    virtual bool supportDiskCache() const override { \
+        return false;                                \
+    }
+
+// 算法调整导致计算结果变化时递增版本号，之前保存的磁盘缓存不再命中
+#define INDICATOR_ALGORITHM_VERSION(ver)            \
+public:                                             \
+    virtual int algorithmVersion() const override { \
+        return ver;                                 \
+    }
+
 /** 获取 OPType 名称字符串 */
 string HKU_API getOPTypeName(IndicatorImp::OPType);
 
@@ -414,6 +513,11 @@ inline size_t IndicatorImp::_get_step_start(size_t pos, size_t step, size_t disc
 
 } /* namespace hku */
 
+#if HKU_SUPPORT_SERIALIZATION
+// 版本 1: 二进制归档中的结果集改为按连续数组存放
+BOOST_CLASS_VERSION(hku::IndicatorImp, 1)
+#endif
+
 #if FMT_VERSION >= 90000
 template <>
 struct fmt::formatter<hku::IndicatorImp> : ostream_formatter {};
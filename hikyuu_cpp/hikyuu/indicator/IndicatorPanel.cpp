@@ -0,0 +1,505 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-16
+ *      Author: fasiondog
+ */
+
+#include <future>
+#include <list>
+#include "hikyuu/utilities/thread/algorithm.h"
+#include "crt/ALIGN.h"
+#include "crt/PRICELIST.h"
+#include "IndicatorSharedCache.h"
+#include "IndicatorPanel.h"
+
+namespace hku {
+
+IndicatorPanel::IndicatorPanel(const DatetimeList& dates, const StockList& stks)
+: m_dates(dates),
+  m_stks(stks),
+  m_values(dates.size() * stks.size(), Null<value_t>()),
+  m_discards(stks.size(), dates.size()) {}
+
+IndicatorPanel::IndicatorPanel(const IndicatorPanel& other)
+: m_dates(other.m_dates),
+  m_stks(other.m_stks),
+  m_values(other.m_values),
+  m_discards(other.m_discards) {}
+
+IndicatorPanel::IndicatorPanel(IndicatorPanel&& other)
+: m_dates(std::move(other.m_dates)),
+  m_stks(std::move(other.m_stks)),
+  m_values(std::move(other.m_values)),
+  m_discards(std::move(other.m_discards)) {}
+
+IndicatorPanel& IndicatorPanel::operator=(const IndicatorPanel& other) {
+    HKU_IF_RETURN(this == &other, *this);
+    IndicatorPanel tmp(other);
+    *this = std::move(tmp);
+    return *this;
+}
+
+IndicatorPanel& IndicatorPanel::operator=(IndicatorPanel&& other) {
+    HKU_IF_RETURN(this == &other, *this);
+    m_dates = std::move(other.m_dates);
+    m_stks = std::move(other.m_stks);
+    m_values = std::move(other.m_values);
+    m_discards = std::move(other.m_discards);
+    // 排序缓存随数据失效
+    std::lock_guard<std::mutex> lock(m_sorted_mutex);
+    m_sorted_ready = false;
+    m_sorted.clear();
+    m_sorted_count.clear();
+    return *this;
+}
+
+PriceList IndicatorPanel::getColumn(size_t stk_pos) const {
+    HKU_CHECK(stk_pos < m_stks.size(), "Out of range! stk_pos: {}, total: {}", stk_pos,
+              m_stks.size());
+    size_t total = m_dates.size();
+    size_t stk_count = m_stks.size();
+    PriceList ret(total);
+    const value_t* src = m_values.data() + stk_pos;
+    for (size_t i = 0; i < total; i++) {
+        ret[i] = src[i * stk_count];
+    }
+    return ret;
+}
+
+Indicator IndicatorPanel::getIndicator(size_t stk_pos) const {
+    return PRICELIST(getColumn(stk_pos), m_dates, static_cast<int>(m_discards[stk_pos]));
+}
+
+//-----------------------------------------------------------------------------
+// 每日截面统计
+//-----------------------------------------------------------------------------
+
+template <typename ReduceFunc>
+static PriceList reduce_by_row(const IndicatorPanel& panel, ReduceFunc func) {
+    size_t total = panel.dateCount();
+    size_t stk_count = panel.stockCount();
+    PriceList ret(total, Null<price_t>());
+    HKU_IF_RETURN(stk_count == 0, ret);
+    parallel_for_index_void(
+      0, total,
+      [&](size_t di) {
+          ret[di] = func(panel.row(di), stk_count);
+      },
+      0, ParallelSchedule::DYNAMIC);
+    return ret;
+}
+
+PriceList IndicatorPanel::sum() const {
+    return reduce_by_row(*this, [](const value_t* src, size_t len) {
+        value_t ret = Null<value_t>();
+        for (size_t i = 0; i < len; i++) {
+            if (!std::isnan(src[i])) {
+                ret = std::isnan(ret) ? src[i] : ret + src[i];
+            }
+        }
+        return ret;
+    });
+}
+
+PriceList IndicatorPanel::mean() const {
+    return reduce_by_row(*this, [](const value_t* src, size_t len) {
+        value_t ret = Null<value_t>();
+        size_t count = 0;
+        for (size_t i = 0; i < len; i++) {
+            if (!std::isnan(src[i])) {
+                ret = std::isnan(ret) ? src[i] : ret + src[i];
+                count++;
+            }
+        }
+        return count > 0 ? ret / count : ret;
+    });
+}
+
+PriceList IndicatorPanel::max() const {
+    return reduce_by_row(*this, [](const value_t* src, size_t len) {
+        value_t ret = Null<value_t>();
+        for (size_t i = 0; i < len; i++) {
+            if (!std::isnan(src[i]) && (std::isnan(ret) || src[i] > ret)) {
+                ret = src[i];
+            }
+        }
+        return ret;
+    });
+}
+
+PriceList IndicatorPanel::min() const {
+    return reduce_by_row(*this, [](const value_t* src, size_t len) {
+        value_t ret = Null<value_t>();
+        for (size_t i = 0; i < len; i++) {
+            if (!std::isnan(src[i]) && (std::isnan(ret) || src[i] < ret)) {
+                ret = src[i];
+            }
+        }
+        return ret;
+    });
+}
+
+void IndicatorPanel::_initSortedRows() const {
+    HKU_IF_RETURN(m_sorted_ready, void());
+    std::lock_guard<std::mutex> lock(m_sorted_mutex);
+    HKU_IF_RETURN(m_sorted_ready, void());
+
+    size_t total = m_dates.size();
+    size_t stk_count = m_stks.size();
+    m_sorted.resize(m_values.size());
+    m_sorted_count.resize(total);
+    parallel_for_index_void(
+      0, total,
+      [this, stk_count](size_t di) {
+          const value_t* src = row(di);
+          value_t* dst = m_sorted.data() + di * stk_count;
+          size_t count = 0;
+          for (size_t i = 0; i < stk_count; i++) {
+              if (!std::isnan(src[i])) {
+                  dst[count++] = src[i];
+              }
+          }
+          std::sort(dst, dst + count);
+          m_sorted_count[di] = count;
+      },
+      0, ParallelSchedule::DYNAMIC);
+    m_sorted_ready = true;
+}
+
+IndicatorPanel::value_t IndicatorPanel::rankOf(size_t date_pos, value_t value,
+                                               bool ascending) const {
+    HKU_IF_RETURN(std::isnan(value), 1.0);
+    _initSortedRows();
+    const value_t* first = m_sorted.data() + date_pos * m_stks.size();
+    const value_t* last = first + m_sorted_count[date_pos];
+    size_t better = ascending ? std::lower_bound(first, last, value) - first
+                              : last - std::upper_bound(first, last, value);
+    return static_cast<value_t>(better + 1);
+}
+
+//-----------------------------------------------------------------------------
+// 每日截面变换
+//-----------------------------------------------------------------------------
+
+template <typename TransformFunc>
+static IndicatorPanel transform_by_row(const IndicatorPanel& panel, TransformFunc func) {
+    IndicatorPanel ret(panel);
+    size_t stk_count = panel.stockCount();
+    HKU_IF_RETURN(stk_count == 0, ret);
+    parallel_for_index_void(
+      0, panel.dateCount(),
+      [&](size_t di) {
+          IndicatorPanel::value_t* dst = ret.row(di);
+          std::fill(dst, dst + stk_count, Null<IndicatorPanel::value_t>());
+          func(dst, panel.row(di), stk_count);
+      },
+      0, ParallelSchedule::DYNAMIC);
+    return ret;
+}
+
+IndicatorPanel IndicatorPanel::rank(bool ascending) const {
+    return transform_by_row(*this, [ascending](value_t* dst, const value_t* src, size_t len) {
+        vector<value_t> sorted;
+        sorted.reserve(len);
+        for (size_t i = 0; i < len; i++) {
+            if (!std::isnan(src[i])) {
+                sorted.push_back(src[i]);
+            }
+        }
+        std::sort(sorted.begin(), sorted.end());
+        auto first = sorted.cbegin();
+        auto last = sorted.cend();
+        for (size_t i = 0; i < len; i++) {
+            if (!std::isnan(src[i])) {
+                size_t better = ascending ? std::lower_bound(first, last, src[i]) - first
+                                          : last - std::upper_bound(first, last, src[i]);
+                dst[i] = static_cast<value_t>(better + 1);
+            }
+        }
+    });
+}
+
+// 与 IZScore 的计算方式保持一致
+static void zscore_row(IndicatorPanel::value_t* dst, const IndicatorPanel::value_t* src,
+                       size_t total, bool out_extreme, double nsigma, bool recursive) {
+    typedef IndicatorPanel::value_t value_t;
+    value_t sum = 0.0;
+    size_t count = 0;
+    for (size_t i = 0; i < total; i++) {
+        if (!std::isnan(src[i])) {
+            sum += src[i];
+            count++;
+        }
+    }
+    HKU_IF_RETURN(count <= 1, void());
+
+    value_t mean = sum / count;
+    sum = 0.0;
+    for (size_t i = 0; i < total; i++) {
+        if (!std::isnan(src[i])) {
+            value_t diff = src[i] - mean;
+            sum += diff * diff;
+        }
+    }
+
+    value_t sigma = std::sqrt(sum / (count - 1));
+    for (size_t i = 0; i < total; i++) {
+        if (!std::isnan(src[i])) {
+            dst[i] = (src[i] - mean) / sigma;
+        }
+    }
+
+    HKU_IF_RETURN(!out_extreme, void());
+    bool found = false;
+    for (size_t i = 0; i < total; i++) {
+        if (!std::isnan(dst[i])) {
+            if (dst[i] > nsigma) {
+                dst[i] = nsigma;
+                found = true;
+            } else if (dst[i] < -nsigma) {
+                dst[i] = -nsigma;
+                found = true;
+            }
+        }
+    }
+
+    if (found && recursive) {
+        zscore_row(dst, dst, total, out_extreme, nsigma, recursive);
+    }
+}
+
+IndicatorPanel IndicatorPanel::zscore(bool out_extreme, double nsigma, bool recursive) const {
+    HKU_CHECK(nsigma > 0.0, "nsigma must be > 0!");
+    return transform_by_row(*this, [=](value_t* dst, const value_t* src, size_t len) {
+        zscore_row(dst, src, len, out_extreme, nsigma, recursive);
+    });
+}
+
+IndicatorPanel IndicatorPanel::normalize() const {
+    return transform_by_row(*this, [](value_t* dst, const value_t* src, size_t len) {
+        value_t min_value = Null<value_t>();
+        value_t max_value = Null<value_t>();
+        for (size_t i = 0; i < len; i++) {
+            if (!std::isnan(src[i])) {
+                if (std::isnan(min_value) || src[i] < min_value) {
+                    min_value = src[i];
+                }
+                if (std::isnan(max_value) || src[i] > max_value) {
+                    max_value = src[i];
+                }
+            }
+        }
+
+        HKU_IF_RETURN(std::isnan(max_value) || max_value == min_value, void());
+        value_t diff = max_value - min_value;
+        for (size_t i = 0; i < len; i++) {
+            if (!std::isnan(src[i])) {
+                dst[i] = (src[i] - min_value) / diff;
+            }
+        }
+    });
+}
+
+IndicatorPanel IndicatorPanel::quantile(int n) const {
+    HKU_CHECK(n >= 1, "n must be >= 1!");
+    return transform_by_row(*this, [n](value_t* dst, const value_t* src, size_t len) {
+        vector<value_t> sorted;
+        sorted.reserve(len);
+        for (size_t i = 0; i < len; i++) {
+            if (!std::isnan(src[i])) {
+                sorted.push_back(src[i]);
+            }
+        }
+        std::sort(sorted.begin(), sorted.end());
+        size_t count = sorted.size();
+        for (size_t i = 0; i < len; i++) {
+            if (!std::isnan(src[i])) {
+                size_t less =
+                  std::lower_bound(sorted.cbegin(), sorted.cend(), src[i]) - sorted.cbegin();
+                dst[i] = static_cast<value_t>(less * static_cast<size_t>(n) / count);
+            }
+        }
+    });
+}
+
+//-----------------------------------------------------------------------------
+// 面板计算及缓存
+//-----------------------------------------------------------------------------
+
+IndicatorPanelPtr IndicatorPanel::_build(const Indicator& ind, const StockList& stks,
+                                         const KQuery& query, const DatetimeList& dates,
+                                         bool fill_null, bool parallel) {
+    auto ret = make_shared<IndicatorPanel>(dates, stks);
+    size_t total = dates.size();
+    size_t stk_count = stks.size();
+    HKU_IF_RETURN(total == 0 || stk_count == 0, ret);
+
+    // 各证券写入不同的列，互不冲突
+    value_t* dst = ret->m_values.data();
+    size_t* discards = ret->m_discards.data();
+    auto fill_column = [&](const Indicator& nind, size_t si) {
+        auto k = stks[si].getKData(query);
+        HKU_IF_RETURN(k.empty(), void());
+        auto value = ALIGN(nind, dates, fill_null)(k);
+        HKU_WARN_IF_RETURN(value.size() != total, void(),
+                           "Ignore stock: {}, value len: {}, dst len: {}",
+                           stks[si].market_code(), value.size(), total);
+        const auto* src = value.data();
+        for (size_t di = 0; di < total; di++) {
+            dst[di * stk_count + si] = src[di];
+        }
+        discards[si] = value.discard();
+    };
+
+    if (parallel) {
+        parallel_for_index_void(
+          0, stk_count,
+          [&fill_column, nind = ind.clone()](size_t si) {
+              fill_column(nind, si);
+          },
+          0, ParallelSchedule::GUIDED);
+    } else {
+        for (size_t si = 0; si < stk_count; si++) {
+            fill_column(ind, si);
+        }
+    }
+    return ret;
+}
+
+namespace {
+
+struct PanelCacheItem {
+    string key;
+    IndicatorImpPtr shape;  // 不含上下文的指标公式副本，用于等效判断
+    StockList stks;
+    KQuery query;
+    DatetimeList dates;
+    bool fill_null;
+    uint64_t version;  // 计算时各证券数据版本之和
+    std::shared_future<IndicatorPanelPtr> panel;
+};
+
+typedef shared_ptr<PanelCacheItem> PanelCacheItemPtr;
+
+struct PanelCache {
+    std::mutex mutex;
+    std::list<PanelCacheItemPtr> items;  // 按最近使用排序
+    size_t capacity{8};
+};
+
+PanelCache& getPanelCache() {
+    static PanelCache cache;
+    return cache;
+}
+
+}  // namespace
+
+static uint64_t getStocksDataVersion(const StockList& stks) {
+    uint64_t ret = 0;
+    for (const auto& stk : stks) {
+        ret += stk.dataVersion();
+    }
+    return ret;
+}
+
+// 数据版本仅反映已缓存K线数据的变化，未缓存的证券直接从数据驱动读取，无法判断是否变化
+// 空证券无数据，不影响缓存
+static bool isAllBuffered(const StockList& stks, const KQuery::KType& ktype) {
+    for (const auto& stk : stks) {
+        HKU_IF_RETURN(!stk.isNull() && !stk.isBuffer(ktype), false);
+    }
+    return true;
+}
+
+IndicatorPanelPtr IndicatorPanel::create(const Indicator& ind, const StockList& stks,
+                                         const KQuery& query, const DatetimeList& dates,
+                                         bool fill_null, bool parallel) {
+    HKU_IF_RETURN(!ind.getImp(), make_shared<IndicatorPanel>(dates, stks));
+    Indicator proto = ind.clone();
+    proto.setContext(KData());
+
+    auto& cache = getPanelCache();
+    string key;
+    bool can_cache = IndicatorSharedCache::getKey(*proto.getImp(), key) &&
+                     isAllBuffered(stks, query.kType());
+    if (can_cache) {
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        can_cache = cache.capacity > 0;
+    }
+    HKU_IF_RETURN(!can_cache, _build(proto, stks, query, dates, fill_null, parallel));
+
+    uint64_t version = getStocksDataVersion(stks);
+    std::promise<IndicatorPanelPtr> promise;
+    PanelCacheItemPtr new_item;
+    {
+        std::unique_lock<std::mutex> lock(cache.mutex);
+        for (auto iter = cache.items.begin(); iter != cache.items.end(); ++iter) {
+            const auto& item = **iter;
+            if (item.key != key || item.fill_null != fill_null || item.query != query ||
+                item.dates != dates || item.stks != stks || !item.shape->alike(*proto.getImp())) {
+                continue;
+            }
+
+            if (item.version == version) {
+                // 正在计算中的面板同样在此等待，避免重复计算
+                auto future = item.panel;
+                cache.items.splice(cache.items.begin(), cache.items, iter);
+                lock.unlock();
+                return future.get();
+            }
+
+            // 数据已变更，丢弃旧结果
+            cache.items.erase(iter);
+            break;
+        }
+
+        new_item = make_shared<PanelCacheItem>();
+        new_item->key = key;
+        new_item->shape = proto.getImp();
+        new_item->stks = stks;
+        new_item->query = query;
+        new_item->dates = dates;
+        new_item->fill_null = fill_null;
+        new_item->version = version;
+        new_item->panel = promise.get_future().share();
+        cache.items.push_front(new_item);
+        while (cache.items.size() > cache.capacity) {
+            cache.items.pop_back();
+        }
+    }
+
+    try {
+        auto ret = _build(proto, stks, query, dates, fill_null, parallel);
+        promise.set_value(ret);
+        return ret;
+    } catch (...) {
+        promise.set_exception(std::current_exception());
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        cache.items.remove(new_item);
+        throw;
+    }
+}
+
+void IndicatorPanel::setCacheCapacity(size_t capacity) {
+    auto& cache = getPanelCache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    cache.capacity = capacity;
+    while (cache.items.size() > capacity) {
+        cache.items.pop_back();
+    }
+}
+
+size_t IndicatorPanel::cacheSize() {
+    auto& cache = getPanelCache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    return cache.items.size();
+}
+
+void IndicatorPanel::clearCache() {
+    auto& cache = getPanelCache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    cache.items.clear();
+}
+
+} /* namespace hku */
@@ -0,0 +1,177 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-16
+ *      Author: fasiondog
+ */
+
+#pragma once
+#ifndef INDICATOR_INDICATORPANEL_H_
+#define INDICATOR_INDICATORPANEL_H_
+
+#include <atomic>
+#include <mutex>
+#include "Indicator.h"
+
+namespace hku {
+
+class IndicatorPanel;
+typedef shared_ptr<const IndicatorPanel> IndicatorPanelPtr;
+
+/**
+ * 截面指标面板，保存一组证券按相同日期对齐后的指标值（日期 × 证券）
+ * @details
+ * <pre>
+ * 数据按日期连续存放，同一日期所有证券的指标值相邻，每日截面运算（合计、排名、标准化等）
+ * 可直接顺序访问，并按日期并行计算。
+ *
+ * 通过 create 创建的面板按 指标公式 + 证券列表 + 查询条件 + 对齐日期 缓存，INSUM、IC 及多因子
+ * 等在同一板块、同一查询条件下使用相同公式时只计算一次。缓存同时记录各证券的 K 线数据版本，
+ * 已缓存的 K 线数据变更后自动重新计算。
+ * </pre>
+ * @ingroup Indicator
+ */
+class HKU_API IndicatorPanel {
+public:
+    typedef Indicator::value_t value_t;
+
+    IndicatorPanel() = default;
+
+    /** 创建指定大小的面板，所有值初始化为 Null */
+    IndicatorPanel(const DatetimeList& dates, const StockList& stks);
+
+    IndicatorPanel(const IndicatorPanel&);
+    IndicatorPanel(IndicatorPanel&&);
+    IndicatorPanel& operator=(const IndicatorPanel&);
+    IndicatorPanel& operator=(IndicatorPanel&&);
+
+    /** 日期数量 */
+    size_t dateCount() const {
+        return m_dates.size();
+    }
+
+    /** 证券数量 */
+    size_t stockCount() const {
+        return m_stks.size();
+    }
+
+    bool empty() const {
+        return m_values.empty();
+    }
+
+    const DatetimeList& getDatetimeList() const {
+        return m_dates;
+    }
+
+    const StockList& getStockList() const {
+        return m_stks;
+    }
+
+    /** 指定日期的截面数据，长度为 stockCount() */
+    const value_t* row(size_t date_pos) const {
+        return m_values.data() + date_pos * m_stks.size();
+    }
+
+    value_t* row(size_t date_pos) {
+        return m_values.data() + date_pos * m_stks.size();
+    }
+
+    value_t get(size_t date_pos, size_t stk_pos) const {
+        return m_values[date_pos * m_stks.size() + stk_pos];
+    }
+
+    /** 指定证券对齐后指标的抛弃数量 */
+    size_t discard(size_t stk_pos) const {
+        return m_discards[stk_pos];
+    }
+
+    /** 指定证券的时间序列 */
+    PriceList getColumn(size_t stk_pos) const;
+
+    /** 指定证券的时间序列，以对齐日期为参考日期的 PRICELIST 指标返回 */
+    Indicator getIndicator(size_t stk_pos) const;
+
+    //-------------------------------------------------------------
+    // 每日截面统计，忽略 Null 值，某日全部为 Null 时结果为 Null
+    //-------------------------------------------------------------
+
+    PriceList sum() const;
+    PriceList mean() const;
+    PriceList max() const;
+    PriceList min() const;
+
+    /**
+     * 指定值在当日截面中的排名，排名从 1 开始
+     * @param date_pos 日期位置
+     * @param value 待比较的值，为 Null 时返回 1
+     * @param ascending 为 true 时值越小排名越靠前，否则值越大排名越靠前
+     * @return 1 + 当日截面中严格优于 value 的证券数量
+     */
+    value_t rankOf(size_t date_pos, value_t value, bool ascending = false) const;
+
+    //-------------------------------------------------------------
+    // 每日截面变换，返回新的面板，Null 值保持为 Null
+    //-------------------------------------------------------------
+
+    /** 每日截面排名，值相同时排名相同 */
+    IndicatorPanel rank(bool ascending = false) const;
+
+    /**
+     * 每日截面标准化，与对当日截面数据计算 ZSCORE 相同
+     * @param out_extreme 是否剔除极值
+     * @param nsigma 剔除极值时的标准差倍数
+     * @param recursive 是否递归剔除极值
+     */
+    IndicatorPanel zscore(bool out_extreme = false, double nsigma = 3.0,
+                          bool recursive = false) const;
+
+    /** 每日截面最小最大值归一化至 [0, 1]，当日最大值等于最小值时全部为 Null */
+    IndicatorPanel normalize() const;
+
+    /** 每日截面按升序等分为 n 组，返回组号 [0, n) */
+    IndicatorPanel quantile(int n) const;
+
+    /**
+     * 计算并缓存截面面板
+     * @note 仅在全部证券的K线数据均已缓存（预加载）时缓存面板，证券数据版本变化时重新计算
+     * @param ind 指标公式，忽略其自身上下文
+     * @param stks 证券列表
+     * @param query 各证券的查询条件
+     * @param dates 对齐日期
+     * @param fill_null 对齐时是否以 Null 填充缺失值，否则以之前的最后值填充
+     * @param parallel 是否并行计算各证券指标，Python 中实现的指标不可并行
+     */
+    static IndicatorPanelPtr create(const Indicator& ind, const StockList& stks,
+                                    const KQuery& query, const DatetimeList& dates,
+                                    bool fill_null = false, bool parallel = true);
+
+    /** 设置最多缓存的面板数量，默认为 8 */
+    static void setCacheCapacity(size_t capacity);
+
+    /** 当前缓存的面板数量 */
+    static size_t cacheSize();
+
+    static void clearCache();
+
+private:
+    static IndicatorPanelPtr _build(const Indicator& ind, const StockList& stks,
+                                    const KQuery& query, const DatetimeList& dates,
+                                    bool fill_null, bool parallel);
+
+    void _initSortedRows() const;
+
+private:
+    DatetimeList m_dates;
+    StockList m_stks;
+    vector<value_t> m_values;  // m_values[date_pos * stockCount() + stk_pos]
+    vector<size_t> m_discards;
+
+    // 每日截面升序排列的非 Null 值，供 rankOf 使用，首次使用时生成
+    mutable std::mutex m_sorted_mutex;
+    mutable std::atomic_bool m_sorted_ready{false};
+    mutable vector<value_t> m_sorted;
+    mutable vector<size_t> m_sorted_count;
+};
+
+} /* namespace hku */
+#endif /* INDICATOR_INDICATORPANEL_H_ */
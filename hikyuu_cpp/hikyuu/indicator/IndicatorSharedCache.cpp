@@ -0,0 +1,230 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-16
+ *      Author: fasiondog
+ */
+
+#include "imp/IContext.h"
+#include "IndicatorSharedCache.h"
+
+namespace hku {
+
+static thread_local IndicatorSharedCache* g_current_shared_cache = nullptr;
+
+IndicatorSharedCache::Guard::Guard(IndicatorSharedCache& cache) : m_prev(g_current_shared_cache) {
+    g_current_shared_cache = &cache;
+}
+
+IndicatorSharedCache::Guard::~Guard() {
+    g_current_shared_cache = m_prev;
+}
+
+IndicatorSharedCache* IndicatorSharedCache::current() {
+    return g_current_shared_cache;
+}
+
+size_t IndicatorSharedCache::size() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t total = 0;
+    for (const auto& bucket : m_items) {
+        total += bucket.second.size();
+    }
+    return total;
+}
+
+void IndicatorSharedCache::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_items.clear();
+    m_hits = 0;
+}
+
+struct IndicatorSharedCache::Scope::Session {
+    key_map_t keys;
+    shape_map_t shapes;
+};
+
+static thread_local IndicatorSharedCache::Scope::Session* g_current_session = nullptr;
+
+IndicatorSharedCache::Scope::Scope(IndicatorSharedCache* cache, IndicatorImp& imp)
+: m_imp(&imp), m_prev(g_current_session) {
+    if (!cache) {
+        return;
+    }
+
+    // 非当前指标树中的节点（如最外层节点或计算中临时创建的指标），为其整棵树生成键值
+    if (!m_prev || m_prev->keys.find(&imp) == m_prev->keys.end()) {
+        m_session = new Session();
+        m_own = true;
+        _buildKeys(imp, m_session->keys);
+        g_current_session = m_session;
+    } else {
+        m_session = m_prev;
+    }
+
+    const string& key = m_session->keys[&imp];
+    if (!key.empty()) {
+        m_key = &key;
+    }
+}
+
+IndicatorSharedCache::Scope::~Scope() {
+    if (m_own) {
+        g_current_session = m_prev;
+        delete m_session;
+    }
+}
+
+IndicatorImpPtr IndicatorSharedCache::Scope::shape() {
+    HKU_IF_RETURN(!m_session, IndicatorImpPtr());
+    return _buildShape(*m_imp, m_session->shapes);
+}
+
+bool IndicatorSharedCache::getKey(const IndicatorImp& imp, string& key) {
+    key_map_t keys;
+    const string& ret = _buildKeys(imp, keys);
+    HKU_IF_RETURN(ret.empty(), false);
+    key = ret;
+    return true;
+}
+
+const string& IndicatorSharedCache::_buildKeys(const IndicatorImp& imp, key_map_t& keys) {
+    auto iter = keys.find(&imp);
+    if (iter != keys.end()) {
+        return iter->second;
+    }
+
+    string& key = keys[&imp];
+    // IContext 的结果由其自身持有的指标决定，alike 不认为其等效，无需缓存
+    HKU_IF_RETURN(typeid(imp) == typeid(IContext), key);
+
+    std::ostringstream os;
+    os << typeid(imp).name() << "|" << imp.m_optype << "|" << imp.name() << "|"
+       << imp.getParameter().getNameValueList();
+    for (const auto& param : imp.m_ind_params) {
+        const string& sub_key = _buildKeys(*param.second, keys);
+        HKU_IF_RETURN(sub_key.empty(), key);
+        os << "[" << param.first << ":" << sub_key << "]";
+    }
+
+    const std::pair<const char*, const IndicatorImpPtr*> subs[] = {
+      {"3", &imp.m_three}, {"L", &imp.m_left}, {"R", &imp.m_right}};
+    for (const auto& sub : subs) {
+        if (*sub.second) {
+            const string& sub_key = _buildKeys(**sub.second, keys);
+            HKU_IF_RETURN(sub_key.empty(), key);
+            os << "(" << sub.first << ":" << sub_key << ")";
+        }
+    }
+
+    // 参考指标在计算时才设置上下文，不属于当前指标树，单独生成键值
+    auto ref = imp.getRefImp();
+    if (ref) {
+        key_map_t ref_keys;
+        const string& ref_key = _buildKeys(*ref, ref_keys);
+        HKU_IF_RETURN(ref_key.empty(), key);
+        os << "{" << ref_key << "}";
+    }
+
+    key = os.str();
+    return key;
+}
+
+IndicatorImpPtr IndicatorSharedCache::_buildShape(IndicatorImp& imp, shape_map_t& shapes) {
+    auto iter = shapes.find(&imp);
+    if (iter != shapes.end()) {
+        return iter->second;
+    }
+
+    IndicatorImpPtr p = imp._clone();
+    p->m_params = imp.m_params;
+    p->m_name = imp.m_name;
+    p->m_discard = imp.m_discard;
+    p->m_result_num = imp.m_result_num;
+    p->m_need_calculate = imp.m_need_calculate;
+    p->m_optype = imp.m_optype;
+
+    // alike 仅比较叶子节点的数据，非叶子节点不复制计算结果
+    if (imp.isLeaf()) {
+        for (size_t i = 0; i < imp.m_result_num; ++i) {
+            if (imp.m_pBuffer[i]) {
+                p->m_pBuffer[i] = new vector<IndicatorImp::value_t>(imp.m_pBuffer[i]->begin(),
+                                                                     imp.m_pBuffer[i]->end());
+            }
+        }
+    }
+
+    // 副本仅用于比较，子节点不设置父节点，共享的子节点仍只复制一次
+    if (imp.m_left) {
+        p->m_left = _buildShape(*imp.m_left, shapes);
+    }
+    if (imp.m_right) {
+        p->m_right = _buildShape(*imp.m_right, shapes);
+    }
+    if (imp.m_three) {
+        p->m_three = _buildShape(*imp.m_three, shapes);
+    }
+    for (const auto& param : imp.m_ind_params) {
+        p->m_ind_params[param.first] = _buildShape(*param.second, shapes);
+    }
+
+    shapes[&imp] = p;
+    return p;
+}
+
+bool IndicatorSharedCache::load(const string& key, IndicatorImp& imp) {
+    vector<ItemPtr> bucket;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto iter = m_items.find(key);
+        HKU_IF_RETURN(iter == m_items.end(), false);
+        bucket = iter->second;
+    }
+
+    ItemPtr item;
+    for (const auto& candidate : bucket) {
+        if (candidate->shape->alike(imp)) {
+            item = candidate;
+            break;
+        }
+    }
+    HKU_IF_RETURN(!item, false);
+
+    size_t result_num = item->values.size();
+    size_t total = item->values[0].size();
+    imp._readyBuffer(total, result_num);
+    for (size_t r = 0; r < result_num; r++) {
+        std::copy(item->values[r].cbegin(), item->values[r].cend(), imp.m_pBuffer[r]->begin());
+    }
+    imp.m_discard = item->discard;
+
+    // 仅恢复当前节点，子节点未加载数据，须保持待计算状态，以免共享该子节点的其他父节点
+    // 读取到空结果
+
+    m_hits++;
+    return true;
+}
+
+void IndicatorSharedCache::save(const string& key, IndicatorImpPtr&& shape,
+                                const IndicatorImp& result) {
+    auto item = make_shared<Item>();
+    item->shape = std::move(shape);
+    item->discard = result.discard();
+    size_t total = result.size();
+    size_t result_num = result.getResultNumber();
+    item->values.resize(result_num);
+    for (size_t r = 0; r < result_num; r++) {
+        const auto* src = result.data(r);
+        item->values[r].assign(src, src + total);
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto& bucket = m_items[key];
+    for (const auto& old : bucket) {
+        // 其他线程可能已同时完成了相同的计算
+        HKU_IF_RETURN(old->shape->alike(*item->shape), void());
+    }
+    bucket.emplace_back(std::move(item));
+}
+
+} /* namespace hku */
@@ -0,0 +1,136 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-16
+ *      Author: fasiondog
+ */
+
+#pragma once
+#ifndef INDICATOR_INDICATORSHAREDCACHE_H_
+#define INDICATOR_INDICATORSHAREDCACHE_H_
+
+#include <atomic>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+#include "IndicatorImp.h"
+
+namespace hku {
+
+/**
+ * 多个指标实例之间共享的计算结果缓存
+ * @details 通过 Guard 在当前线程启用后，指标节点计算前先在缓存中查找等效（alike）且已计算
+ * 的节点，存在时直接复制其结果，否则计算后存入缓存。适用于参数扫描等大量候选系统在同一
+ * KData 上重复计算相同子指标的场景，同一缓存实例可同时在多个线程中启用。
+ * @note 等效判断包含上下文，缓存中可同时存在不同 KData 的结果，但一般按证券分别使用
+ * @ingroup Indicator
+ */
+class HKU_API IndicatorSharedCache {
+public:
+    IndicatorSharedCache() = default;
+    IndicatorSharedCache(const IndicatorSharedCache&) = delete;
+    IndicatorSharedCache& operator=(const IndicatorSharedCache&) = delete;
+
+    /** 在当前线程启用指定的缓存，析构时恢复原先的设置 */
+    class HKU_API Guard {
+    public:
+        explicit Guard(IndicatorSharedCache& cache);
+        ~Guard();
+
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+
+    private:
+        IndicatorSharedCache* m_prev;
+    };
+
+    /** 当前线程启用的缓存，未启用时返回 nullptr */
+    static IndicatorSharedCache* current();
+
+    /** 已缓存的节点结果数量 */
+    size_t size() const;
+
+    /** 命中次数 */
+    size_t hits() const {
+        return m_hits;
+    }
+
+    void clear();
+
+    /**
+     * 单个指标树一次计算过程中各节点的键值及比较副本，仅由 IndicatorImp::calculate 使用
+     * @details 最外层节点计算时一次生成整棵树各节点的键值，比较副本仅在未命中时复制且
+     * 不含非叶子节点的计算结果，子节点计算时直接复用，不再逐节点递归生成键值及深度复制
+     */
+    class HKU_API Scope {
+    public:
+        /** cache 为空时不使用共享缓存 */
+        Scope(IndicatorSharedCache* cache, IndicatorImp& imp);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        /** 已启用共享缓存且节点（含子节点）可以缓存 */
+        bool cacheable() const {
+            return m_key != nullptr;
+        }
+
+        /** 节点的结构键值，仅在 cacheable 时有效 */
+        const string& key() const {
+            return *m_key;
+        }
+
+        /** 节点的比较副本，须在节点计算前获取 */
+        IndicatorImpPtr shape();
+
+        struct Session;
+
+    private:
+        IndicatorImp* m_imp;
+        const string* m_key{nullptr};
+        Session* m_session{nullptr};
+        Session* m_prev{nullptr};
+        bool m_own{false};
+    };
+
+    /**
+     * 获取节点的结构键值，结构相同的节点键值相同，最终由 alike 判断是否等效
+     * @return 节点（含子节点）无法缓存时返回 false
+     */
+    static bool getKey(const IndicatorImp& imp, string& key);
+
+    /** 查找等效节点并将其结果复制至 imp，仅由 IndicatorImp::calculate 调用 */
+    bool load(const string& key, IndicatorImp& imp);
+
+    /**
+     * 保存计算结果，仅由 IndicatorImp::calculate 调用
+     * @param key 结构键值
+     * @param shape 计算前的节点副本，用于后续的等效判断
+     * @param result 已计算的节点
+     */
+    void save(const string& key, IndicatorImpPtr&& shape, const IndicatorImp& result);
+
+private:
+    typedef std::unordered_map<const IndicatorImp*, string> key_map_t;
+    typedef std::unordered_map<const IndicatorImp*, IndicatorImpPtr> shape_map_t;
+
+    // 生成 imp 及其全部子节点的键值，无法缓存的节点键值为空
+    static const string& _buildKeys(const IndicatorImp& imp, key_map_t& keys);
+    static IndicatorImpPtr _buildShape(IndicatorImp& imp, shape_map_t& shapes);
+
+private:
+    struct Item {
+        IndicatorImpPtr shape;
+        size_t discard{0};
+        vector<vector<IndicatorImp::value_t>> values;
+    };
+    typedef shared_ptr<const Item> ItemPtr;
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<string, vector<ItemPtr>> m_items;
+    std::atomic<size_t> m_hits{0};
+};
+
+} /* namespace hku */
+#endif /* INDICATOR_INDICATORSHAREDCACHE_H_ */
@@ -37,12 +37,15 @@ Indicator HKU_API POS(const Block& block, KQuery query, SignalPtr sg) {
     }
 
     auto stks = block.getStockList();
-    vector<SGPtr> sgs = parallel_for_index(0, stks.size(), [&](size_t i) {
-        auto tmpsg = sg->clone();
-        auto kdata = stks[i].getKData(query);
-        tmpsg->setTO(kdata);
-        return tmpsg;
-    });
+    vector<SGPtr> sgs = parallel_for_index(
+      0, stks.size(),
+      [&](size_t i) {
+          auto tmpsg = sg->clone();
+          auto kdata = stks[i].getKData(query);
+          tmpsg->setTO(kdata);
+          return tmpsg;
+      },
+      0, ParallelSchedule::GUIDED);
 
     // 计算每日持仓的股票数
     vector<size_t> position(dayTotal);
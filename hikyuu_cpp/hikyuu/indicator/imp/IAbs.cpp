@@ -6,6 +6,7 @@
  */
 
 #include "IAbs.h"
+#include "../simd_kernel.h"
 
 #if HKU_SUPPORT_SERIALIZATION
 BOOST_CLASS_EXPORT(hku::IAbs)
@@ -27,9 +28,7 @@ void IAbs::_calculate(const Indicator &data) {
 
     auto const *src = data.data();
     auto *dst = this->data();
-    for (size_t i = m_discard; i < total; ++i) {
-        dst[i] = std::abs(src[i]);
-    }
+    simd::abs(src + m_discard, dst + m_discard, total - m_discard);
 }
 
 Indicator HKU_API ABS() {
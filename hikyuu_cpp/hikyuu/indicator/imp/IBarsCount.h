@@ -17,6 +17,7 @@ namespace hku {
 
 class IBarsCount : public IndicatorImp {
     INDICATOR_IMP(IBarsCount)
+    INDICATOR_NO_DISK_CACHE
     INDICATOR_IMP_NO_PRIVATE_MEMBER_SERIALIZATION
 
 public:
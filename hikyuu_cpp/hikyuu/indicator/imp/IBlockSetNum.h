@@ -15,6 +15,7 @@ namespace hku {
 
 class IBlockSetNum : public IndicatorImp {
     INDICATOR_IMP(IBlockSetNum)
+    INDICATOR_NO_DISK_CACHE
     INDICATOR_IMP_NO_PRIVATE_MEMBER_SERIALIZATION
 
 public:
@@ -8,6 +8,7 @@
  */
 
 #include "ICeil.h"
+#include "../simd_kernel.h"
 
 #if HKU_SUPPORT_SERIALIZATION
 BOOST_CLASS_EXPORT(hku::ICeil)
@@ -29,9 +30,7 @@ void ICeil::_calculate(const Indicator &data) {
 
     auto const *src = data.data();
     auto *dst = this->data();
-    for (size_t i = m_discard; i < total; ++i) {
-        dst[i] = std::ceil(src[i]);
-    }
+    simd::ceil(src + m_discard, dst + m_discard, total - m_discard);
 }
 
 Indicator HKU_API CEILING() {
@@ -12,6 +12,8 @@
 namespace hku {
 
 class IContext : public IndicatorImp {
+    INDICATOR_NO_DISK_CACHE
+
 public:
     IContext();
     explicit IContext(const Indicator& ref_ind);
@@ -6,6 +6,7 @@
  */
 
 #include "ICorr.h"
+#include "../sliding_window.h"
 
 #if HKU_SUPPORT_SERIALIZATION
 BOOST_CLASS_EXPORT(hku::ICorr)
@@ -49,49 +50,33 @@ void ICorr::_calculate(const Indicator& ind) {
         return;
     }
 
-    size_t first_end = startPos + n >= total ? total : startPos + n;
-
     auto const* datax = ind.data();
     auto const* datay = ref.data();
-    value_t kx = datax[startPos];
-    value_t ky = datay[startPos];
-    value_t ex = 0.0, ey = 0.0, exy = 0.0, varx = 0.0, vary = 0.0, cov = 0.0;
-    value_t ex2 = 0.0, ey2 = 0.0;
-    value_t ix, iy;
-
     auto* dst0 = this->data(0);
     auto* dst1 = this->data(1);
-    for (size_t i = startPos + 1; i < first_end; i++) {
-        ix = datax[i] - kx;
-        iy = datay[i] - ky;
-        ex += ix;
-        ey += iy;
-        ex2 += ix * ix;
-        ey2 += iy * iy;
-        exy += ix * iy;
-    }
-
-    varx = ex2 - ex * ex / n;
-    vary = ey2 - ey * ey / n;
-    cov = exy - ex * ey / n;
-    dst0[first_end - 1] = cov / std::sqrt(varx * vary);
-    dst1[first_end - 1] = cov / (n - 1);
-
-    for (size_t i = first_end; i < total; i++) {
-        ix = datax[i] - kx;
-        iy = datay[i] - ky;
-        ex += datax[i] - datax[i - n];
-        ey += datay[i] - datay[i - n];
-        value_t preix = datax[i - n] - kx;
-        value_t preiy = datay[i - n] - ky;
-        ex2 += ix * ix - preix * preix;
-        ey2 += iy * iy - preiy * preiy;
-        exy += ix * iy - preix * preiy;
-        varx = (ex2 - ex * ex / n);
-        vary = (ey2 - ey * ey / n);
-        cov = (exy - ex * ey / n);
-        dst0[i] = cov / std::sqrt(varx * vary);
-        dst1[i] = cov / (n - 1);
+    RollingCovariance cov;
+    RebuildCounter counter;
+    for (size_t i = startPos; i < total; i++) {
+        cov.add(datax[i], datay[i]);
+        if (i < m_discard) {
+            continue;
+        }
+        if (i > m_discard) {
+            cov.remove(datax[i - n], datay[i - n]);
+            if (counter.remove(n)) {
+                cov.clear();
+                for (size_t j = i + 1 - n; j <= i; j++) {
+                    cov.add(datax[j], datay[j]);
+                }
+            }
+        }
+        if (cov.nanCount() > 0) {
+            dst0[i] = Null<value_t>();
+            dst1[i] = Null<value_t>();
+        } else {
+            dst0[i] = cov.corr();
+            dst1[i] = cov.cov();
+        }
     }
 }
 
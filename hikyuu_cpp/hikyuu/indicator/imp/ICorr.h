@@ -14,6 +14,7 @@ namespace hku {
 class ICorr : public Indicator2InImp {
     INDICATOR2IN_IMP(ICorr)
     INDICATOR2IN_IMP_NO_PRIVATE_MEMBER_SERIALIZATION
+    INDICATOR_ALGORITHM_VERSION(1)
 
 public:
     ICorr();
@@ -17,6 +17,7 @@ namespace hku {
 class ICost : public IndicatorImp {
     INDICATOR_IMP(ICost)
     INDICATOR_NEED_CONTEXT
+    INDICATOR_NO_DISK_CACHE
     INDICATOR_IMP_NO_PRIVATE_MEMBER_SERIALIZATION
 
 public:
@@ -6,6 +6,7 @@
  */
 
 #include "ICount.h"
+#include "../sliding_window.h"
 
 #if HKU_SUPPORT_SERIALIZATION
 BOOST_CLASS_EXPORT(hku::ICount)
@@ -84,22 +85,41 @@ void ICount::_calculate(const Indicator& data) {
     }
 }
 
-void ICount::_dyn_run_one_step(const Indicator& ind, size_t curPos, size_t step) {
-    size_t start = 0;
+static bool count_window_start(size_t pos, size_t step, size_t discard, size_t& start) {
     if (0 == step) {
-        start = ind.discard();
-    } else if (curPos < ind.discard() + step - 1) {
-        return;
+        start = discard;
+    } else if (pos < discard + step - 1) {
+        return false;
     } else {
-        start = curPos + 1 - step;
+        start = pos + 1 - step;
     }
-    price_t count = 0;
+    return true;
+}
+
+void ICount::_dyn_run_one_step(const Indicator& ind, size_t curPos, size_t step) {
+    size_t start = 0;
+    HKU_IF_RETURN(!count_window_start(curPos, step, ind.discard(), start), void());
+    RollingCount count;
+    auto const* src = ind.data();
     for (size_t i = start; i <= curPos; i++) {
-        if (ind[i] != 0.0) {
-            count++;
-        }
+        count.add(src[i]);
     }
-    _set(count, curPos);
+    _set(count.value(), curPos);
+}
+
+void ICount::_dyn_run_range(const Indicator& ind, const value_t* steps, size_t start, size_t end) {
+    auto* dst = this->data();
+    size_t discard = ind.discard();
+    dyn_rolling_accumulate<RollingCount>(
+      ind.data(), start, end,
+      [=](size_t i, size_t& window_start) {
+          if (std::isnan(steps[i])) {
+              dst[i] = Null<value_t>();
+              return false;
+          }
+          return count_window_start(i, size_t(steps[i]), discard, window_start);
+      },
+      [dst](size_t i, const RollingCount& count) { dst[i] = count.value(); });
 }
 
 Indicator HKU_API COUNT(int n) {
@@ -25,6 +25,8 @@ class ICount : public IndicatorImp {
 public:
     ICount();
     virtual ~ICount();
+    virtual void _dyn_run_range(const Indicator& ind, const value_t* steps, size_t start,
+                                size_t end) override;
     virtual void _checkParam(const string& name) const override;
 };
 
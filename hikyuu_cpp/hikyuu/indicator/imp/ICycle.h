@@ -15,6 +15,7 @@ namespace hku {
 class ICycle : public IndicatorImp {
     INDICATOR_IMP(ICycle)
     INDICATOR_NEED_CONTEXT
+    INDICATOR_NO_DISK_CACHE
     INDICATOR_IMP_NO_PRIVATE_MEMBER_SERIALIZATION
 
 public:
@@ -17,6 +17,7 @@ namespace hku {
 
 class IDecline : public IndicatorImp {
     INDICATOR_IMP(IDecline)
+    INDICATOR_NO_DISK_CACHE
     INDICATOR_IMP_NO_PRIVATE_MEMBER_SERIALIZATION
 
 public:
@@ -48,6 +48,20 @@ void IEma::_calculate(const Indicator& indicator) {
     }
 }
 
+bool IEma::_increment_calculate(const Indicator& ind, size_t start_pos) {
+    HKU_IF_RETURN(start_pos <= m_discard, false);
+
+    size_t total = ind.size();
+    auto const* src = ind.data();
+    auto* dst = this->data();
+    int n = getParam<int>("n");
+    price_t multiplier = 2.0 / (n + 1);
+    for (size_t i = start_pos; i < total; ++i) {
+        dst[i] = (src[i] - dst[i - 1]) * multiplier + dst[i - 1];
+    }
+    return true;
+}
+
 void IEma::_dyn_run_one_step(const Indicator& ind, size_t curPos, size_t step) {
     Indicator slice = SLICE(ind, 0, curPos + 1);
     Indicator ema = EMA(slice, step);
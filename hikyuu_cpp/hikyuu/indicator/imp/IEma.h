@@ -23,6 +23,7 @@ class IEma : public IndicatorImp {
 public:
     IEma();
     virtual ~IEma();
+    virtual bool _increment_calculate(const Indicator& ind, size_t start_pos) override;
     virtual void _checkParam(const string& name) const override;
 };
 
@@ -47,19 +47,18 @@ void IFinance::_calculate(const Indicator& data) {
     _readyBuffer(total, 1);
 
     Stock stock = kdata.getStock();
-    auto finances = stock.getHistoryFinance();
-
-    if (getParam<bool>("only_year_report")) {
-        vector<HistoryFinanceInfo> tmp_finances;
-        for (auto&& finance : finances) {
-            if (finance.fileDate.month() == 12L) {
-                tmp_finances.emplace_back(std::move(finance));
-            }
-        }
-        finances = std::move(tmp_finances);
+    auto finances = stock.getHistoryFinanceColumns();
+    size_t finances_total = finances->size();
+    const auto& file_dates = finances->fileDates();
+    const auto& report_dates = finances->reportDates();
+
+    bool only_year_report = getParam<bool>("only_year_report");
+    bool has_report = finances_total > 0;
+    if (has_report && only_year_report) {
+        has_report = std::any_of(file_dates.begin(), file_dates.end(),
+                                 [](const CompactDatetime& d) { return d.month() == 12L; });
     }
-
-    if (finances.empty()) {
+    if (!has_report) {
         m_discard = total;
         return;
     }
@@ -71,62 +70,45 @@ void IFinance::_calculate(const Indicator& data) {
           StockManager::instance().getHistoryFinanceFieldIndex(getParam<string>("field_name")));
     }
 
+    // 直接读取指定字段各期报告的连续数据，无需复制其他字段
+    const float* values = finances->field(field_ix);
+    HKU_CHECK(field_ix >= 0 && values, "Invalid field_ix: {}!", field_ix);
+
     bool dynamic = getParam<bool>("dynamic");
     auto* dst = this->data();
     const auto* k = kdata.data();
 
-    size_t finances_total = finances.size();
+    // 每根K线取其时点已发布的最近一期报告
     size_t cur_kix = 0;
     size_t pos = 0;
-    while (pos < finances_total && cur_kix < total) {
-        auto value = finances[pos].values.at(field_ix);
-        if (pos + 1 == finances_total) {
-            while (cur_kix < total && finances[pos].reportDate <= k[cur_kix].datetime) {
-                if (dynamic) {
-                    long month = finances[pos].fileDate.month();
-                    if (3L == month) {
-                        // 一季报
-                        dst[cur_kix] = value * 4;
-                    } else if (6L == month) {
-                        // 半年报
-                        dst[cur_kix] = value * 2;
-                    } else if (9L == month) {
-                        // 三季报
-                        dst[cur_kix] = value / 3.0 * 4.0;
-                    } else {
-                        // 年报
-                        dst[cur_kix] = value;
-                    }
-                } else {
-                    dst[cur_kix] = value;
-                }
-                cur_kix++;
+    size_t last = Null<size_t>();
+    while (cur_kix < total) {
+        CompactDatetime cur_date(k[cur_kix].datetime);
+        while (pos < finances_total && report_dates[pos] <= cur_date) {
+            if (!only_year_report || file_dates[pos].month() == 12L) {
+                last = pos;
             }
-        } else {
-            while (cur_kix < total && finances[pos].reportDate <= k[cur_kix].datetime &&
-                   finances[pos + 1].reportDate > k[cur_kix].datetime) {
-                if (dynamic) {
-                    long month = finances[pos].fileDate.month();
-                    if (3L == month) {
-                        // 一季报
-                        dst[cur_kix] = value * 4;
-                    } else if (6L == month) {
-                        // 半年报
-                        dst[cur_kix] = value * 2;
-                    } else if (9L == month) {
-                        // 三季报
-                        dst[cur_kix] = value / 3.0 * 4.0;
-                    } else {
-                        // 年报
-                        dst[cur_kix] = value;
-                    }
-                } else {
-                    dst[cur_kix] = value;
+            pos++;
+        }
+
+        if (last != Null<size_t>()) {
+            price_t value = values[last];
+            if (dynamic) {
+                long month = file_dates[last].month();
+                if (3L == month) {
+                    // 一季报
+                    value = value * 4;
+                } else if (6L == month) {
+                    // 半年报
+                    value = value * 2;
+                } else if (9L == month) {
+                    // 三季报
+                    value = value / 3.0 * 4.0;
                 }
-                cur_kix++;
             }
+            dst[cur_kix] = value;
         }
-        pos++;
+        cur_kix++;
     }
 }
 
@@ -8,6 +8,7 @@
  */
 
 #include "IFloor.h"
+#include "../simd_kernel.h"
 
 #if HKU_SUPPORT_SERIALIZATION
 BOOST_CLASS_EXPORT(hku::IFloor)
@@ -29,9 +30,7 @@ void IFloor::_calculate(const Indicator &data) {
 
     auto const *src = data.data();
     auto *dst = this->data();
-    for (size_t i = m_discard; i < total; ++i) {
-        dst[i] = std::floor(src[i]);
-    }
+    simd::floor(src + m_discard, dst + m_discard, total - m_discard);
 }
 
 Indicator HKU_API FLOOR() {
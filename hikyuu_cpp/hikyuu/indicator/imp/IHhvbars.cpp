@@ -8,6 +8,7 @@
  */
 
 #include "IHhvbars.h"
+#include "../sliding_window.h"
 
 #if HKU_SUPPORT_SERIALIZATION
 BOOST_CLASS_EXPORT(hku::IHhvbars)
@@ -56,51 +57,45 @@ void IHhvbars::_calculate(const Indicator& ind) {
 
     auto const* src = ind.data();
     auto* dst = this->data();
-
-    price_t max = src[m_discard];
-    size_t pre_pos = m_discard;
-    size_t start_pos = m_discard + n < total ? m_discard + n : total;
-    for (size_t i = m_discard; i < start_pos; i++) {
-        if (src[i] >= max) {
-            max = src[i];
-            pre_pos = i;
-        }
-        dst[i] = i - pre_pos;
-    }
-
-    for (size_t i = start_pos; i < total; i++) {
-        size_t j = i + 1 - n;
-        if (pre_pos < j) {
-            pre_pos = j;
-            max = src[j];
-            for (size_t k = pre_pos + 1; k <= i; k++) {
-                if (src[k] >= max) {
-                    max = src[k];
-                    pre_pos = k;
-                }
-            }
-
-        } else {
-            if (src[i] >= max) {
-                max = src[i];
-                pre_pos = i;
-            }
-        }
-        dst[i] = i - pre_pos;
-    }
+    rolling_extremum<MaxQueue<value_t>>(
+      src, m_discard, total, n, [dst](size_t i, const MaxQueue<value_t>& queue) {
+          dst[i] = queue.empty() ? Null<value_t>() : value_t(i - queue.pos());
+      });
 }
 
 void IHhvbars::_dyn_run_one_step(const Indicator& ind, size_t curPos, size_t step) {
     size_t start = _get_step_start(curPos, step, ind.discard());
-    price_t maxVal = ind[start];
-    size_t maxPos = start;
-    for (size_t i = start + 1; i <= curPos; i++) {
-        if (ind[i] > maxVal) {
-            maxVal = ind[i];
-            maxPos = i;
+    auto const* src = ind.data();
+    value_t max_val = Null<value_t>();
+    size_t max_pos = Null<size_t>();
+    for (size_t i = start; i <= curPos; i++) {
+        // NaN 不参与比较，相同值取最后出现的位置
+        if (src[i] >= max_val || (std::isnan(max_val) && !std::isnan(src[i]))) {
+            max_val = src[i];
+            max_pos = i;
         }
     }
-    _set(curPos - maxPos, curPos);
+    _set(max_pos == Null<size_t>() ? Null<value_t>() : value_t(curPos - max_pos), curPos);
+}
+
+void IHhvbars::_dyn_run_range(const Indicator& ind, const value_t* steps, size_t start,
+                              size_t end) {
+    auto const* src = ind.data();
+    auto* dst = this->data();
+    size_t discard = ind.discard();
+    dyn_rolling_extremum<MaxQueue<value_t>>(
+      src, start, end,
+      [=](size_t i, size_t& window_start) {
+          if (std::isnan(steps[i])) {
+              dst[i] = Null<value_t>();
+              return false;
+          }
+          window_start = _get_step_start(i, size_t(steps[i]), discard);
+          return true;
+      },
+      [dst](size_t i, const MaxQueue<value_t>& queue) {
+          dst[i] = queue.empty() ? Null<value_t>() : value_t(i - queue.pos());
+      });
 }
 
 Indicator HKU_API HHVBARS(int n) {
@@ -17,6 +17,7 @@ namespace hku {
 class IHsl : public IndicatorImp {
     INDICATOR_IMP(IHsl)
     INDICATOR_NEED_CONTEXT
+    INDICATOR_NO_DISK_CACHE
     INDICATOR_IMP_NO_PRIVATE_MEMBER_SERIALIZATION
 
 public:
@@ -6,7 +6,9 @@
  */
 
 #include "hikyuu/Block.h"
-#include "hikyuu/indicator/crt/ALIGN.h"
+#include "hikyuu/utilities/thread/algorithm.h"
+#include "hikyuu/indicator/IndicatorPanel.h"
+#include "hikyuu/indicator/crt/KDATA.h"
 #include "hikyuu/indicator/crt/REF.h"
 #include "hikyuu/indicator/crt/ROCP.h"
 #include "hikyuu/indicator/crt/PRICELIST.h"
@@ -77,19 +79,13 @@ void IIc::_calculate(const Indicator& inputInd) {
 
     bool fill_null = getParam<bool>("fill_null");
 
-    // 计算每支证券对齐后的因子值与 n 日收益率
-    vector<Indicator> all_inds(stk_count);     // 保存每支证券对齐后的因子值
-    vector<Indicator> all_returns(stk_count);  // 保存每支证券对齐后的 n 日收益率
-    Indicator ind = inputInd;
-    size_t discard = n;
-    for (size_t i = 0; i < stk_count; i++) {
-        auto k = m_stks[i].getKData(m_query);
-        all_inds[i] = ALIGN(ind(k), ref_dates, fill_null);
-        // 计算 n 日收益率，同时需要右移 n 位，即第 i 日的因子值和第 i + n 的收益率对应
-        all_returns[i] = ALIGN(REF(ROCP(k.close(), n), n), ref_dates, fill_null);
-    }
+    // 对齐后的因子值与 n 日收益率截面，相同证券列表及查询条件下可被其他 IC/INSUM 等复用
+    // 计算 n 日收益率时同时右移 n 位，即第 i 日的因子值和第 i + n 的收益率对应
+    auto all_inds = IndicatorPanel::create(inputInd, m_stks, m_query, ref_dates, fill_null);
+    auto all_returns =
+      IndicatorPanel::create(REF(ROCP(CLOSE(), n), n), m_stks, m_query, ref_dates, fill_null);
 
-    m_discard = discard;
+    m_discard = n;
     HKU_IF_RETURN(m_discard >= days_total, void());
 
     Indicator (*spearman)(const Indicator&, const Indicator&, int, bool) = hku::SPEARMAN;
@@ -97,20 +93,19 @@ void IIc::_calculate(const Indicator& inputInd) {
         spearman = hku::CORR;
     }
 
-    PriceList tmp(stk_count, Null<price_t>());
-    PriceList tmp_return(stk_count, Null<price_t>());
+    // 计算日截面 spearman 相关系数即 ic 值，各日相互独立
     auto* dst = this->data();
-    for (size_t i = m_discard; i < days_total; i++) {
-        // 计算日截面 spearman 相关系数即 ic 值
-        for (size_t j = 0; j < stk_count; j++) {
-            tmp[j] = all_inds[j][i];
-            tmp_return[j] = all_returns[j][i];
-        }
-        auto a = PRICELIST(tmp);
-        auto b = PRICELIST(tmp_return);
-        auto ic = spearman(a, b, stk_count, true);
-        dst[i] = ic[ic.size() - 1];
-    }
+    parallel_for_index_void(
+      m_discard, days_total,
+      [&](size_t i) {
+          const auto* factor_row = all_inds->row(i);
+          const auto* return_row = all_returns->row(i);
+          auto a = PRICELIST(PriceList(factor_row, factor_row + stk_count));
+          auto b = PRICELIST(PriceList(return_row, return_row + stk_count));
+          auto ic = spearman(a, b, stk_count, true);
+          dst[i] = ic[ic.size() - 1];
+      },
+      0, ParallelSchedule::DYNAMIC);
 
     for (size_t i = m_discard; i < days_total; i++) {
         if (!std::isnan(dst[i])) {
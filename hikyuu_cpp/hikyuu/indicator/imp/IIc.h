@@ -12,6 +12,8 @@
 namespace hku {
 
 class IIc : public IndicatorImp {
+    INDICATOR_NO_DISK_CACHE
+
 public:
     IIc();
     IIc(const StockList& stks, const KQuery& query, int n, const Stock& ref_stk, bool spearman);
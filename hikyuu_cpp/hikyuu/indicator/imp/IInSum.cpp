@@ -7,9 +7,9 @@
  *      Author: fasiondog
  */
 
-#include "hikyuu/utilities/thread/thread.h"
 #include "IInSum.h"
 #include "../Indicator.h"
+#include "../IndicatorPanel.h"
 #include "../crt/ALIGN.h"
 #include "../../StockManager.h"
 
@@ -41,187 +41,26 @@ void IInSum::_checkParam(const string& name) const {
     }
 }
 
-static IndicatorList getAllIndicators(const Block& block, const KQuery& query,
-                                      const DatetimeList& dates, const Indicator& ind,
-                                      bool fill_null) {
-#if 0
-    IndicatorList ret;
-    for (auto iter = block.begin(); iter != block.end(); ++iter) {
-        auto k = iter->getKData(query);
-        ret.emplace_back(ALIGN(ind, dates, fill_null)(k));
-    }
-    return ret;
-#else
-    auto stks = block.getStockList();
-    return parallel_for_index(0, stks.size(),
-                              [nind = ind.clone(), fill_null, &stks, &query, &dates](size_t index) {
-                                  auto k = stks[index].getKData(query);
-                                  return ALIGN(nind, dates, fill_null)(k);
-                              });
-#endif
-}
-
-static void insum_cum(const IndicatorList& inds, Indicator::value_t* dst, size_t len) {
-    for (const auto& value : inds) {
-        if (value.empty()) {
-            continue;
-        }
-        if (value.size() != len) {
-            HKU_WARN("Ignore stock: {}, value len: {}, dst len: {}",
-                     value.getContext().getStock().market_code(), value.size(), len);
-            continue;
-        }
-        const auto* data = value.data();
-        for (size_t i = 0; i < len; i++) {
-            if (!std::isnan(data[i])) {
-                if (std::isnan(dst[i])) {
-                    dst[i] = data[i];
-                } else {
-                    dst[i] += data[i];
-                }
-            }
-        }
-    }
-}
-
-static void insum_mean(const IndicatorList& inds, Indicator::value_t* dst, size_t len) {
-    vector<size_t> count(len, 0);
-    for (const auto& value : inds) {
-        if (value.empty()) {
-            continue;
-        }
-        if (value.size() != len) {
-            HKU_WARN("Ignore stock: {}, value len: {}, dst len: {}",
-                     value.getContext().getStock().market_code(), value.size(), len);
-            continue;
-        }
-        const auto* data = value.data();
-        for (size_t i = 0; i < len; i++) {
-            if (!std::isnan(data[i])) {
-                if (std::isnan(dst[i])) {
-                    dst[i] = data[i];
-                } else {
-                    dst[i] += data[i];
-                }
-                count[i]++;
-            }
-        }
-    }
-
-    for (size_t i = 0; i < len; i++) {
-        if (!std::isnan(dst[i])) {
-            dst[i] = dst[i] / count[i];
-        }
-    }
-}
-
-static void insum_max(const IndicatorList& inds, Indicator::value_t* dst, size_t len) {
-    for (const auto& value : inds) {
-        if (value.empty()) {
-            continue;
-        }
-        if (value.size() != len) {
-            HKU_WARN("Ignore stock: {}, value len: {}, dst len: {}",
-                     value.getContext().getStock().market_code(), value.size(), len);
-            continue;
-        }
-        const auto* data = value.data();
-        for (size_t i = 0; i < len; i++) {
-            if (!std::isnan(data[i])) {
-                if (std::isnan(dst[i])) {
-                    dst[i] = data[i];
-                } else if (data[i] > dst[i]) {
-                    dst[i] = data[i];
-                }
-            }
-        }
-    }
-}
-
-static void insum_min(const IndicatorList& inds, Indicator::value_t* dst, size_t len) {
-    for (const auto& value : inds) {
-        if (value.empty()) {
-            continue;
-        }
-        if (value.size() != len) {
-            HKU_WARN("Ignore stock: {}, value len: {}, dst len: {}",
-                     value.getContext().getStock().market_code(), value.size(), len);
-            continue;
-        }
-        const auto* data = value.data();
-        // 遍历所有数据data,dst为空则等于data[i],data[i]小于原来值则为data[i]
-        for (size_t i = 0; i < len; i++) {
-            if (!std::isnan(data[i])) {
-                if (std::isnan(dst[i])) {
-                    dst[i] = data[i];
-                } else if (data[i] < dst[i]) {
-                    dst[i] = data[i];
-                }
-            }
-        }
-    }
-}
-
 // 排名按降序，指标值最高的排名为1
-static void insum_rank_desc(const IndicatorList& inds, Indicator::value_t* dst,
+static void insum_rank_desc(const IndicatorPanel& panel, Indicator::value_t* dst,
                             const Indicator& ind, size_t len) {
-    size_t discard = ind.discard();
-    for (size_t i = discard; i < len; i++) {
-        if (std::isnan(dst[i])) {
-            dst[i] = 1;  // 相当于初始化
-        }
-    }
-    for (const auto& value : inds) {  // 单个ind
-        if (value.empty()) {
-            continue;
-        }
-        if (value.size() != len) {
-            HKU_WARN("Ignore stock: {}, value len: {}, dst len: {}",
-                     value.getContext().getStock().market_code(), value.size(), len);
-            continue;
-        }
-        const auto* data = value.data();    // 对比股的数据
-        const auto* data_ind = ind.data();  // 本股数据
-
-        for (size_t i = discard; i < len; i++) {
-            if (!std::isnan(data[i])) {
-                if (data[i] > data_ind[i]) {
-                    dst[i]++;
-                }
-            }
-        }
+    const auto* data_ind = ind.data();  // 本股数据
+    for (size_t i = ind.discard(); i < len; i++) {
+        dst[i] = panel.rankOf(i, data_ind[i], false);
     }
 }
 
 // 排名按升序，指标值最低的排名为1，指标值越高排名值越高
-static void insum_rank_asc(const IndicatorList& inds, Indicator::value_t* dst, const Indicator& ind,
-                           size_t len) {
-    size_t discard = ind.discard();
-    for (size_t i = discard; i < len; i++) {
-        if (std::isnan(dst[i])) {
-            dst[i] = 1;  // 相当于初始化
-        }
+static void insum_rank_asc(const IndicatorPanel& panel, Indicator::value_t* dst,
+                           const Indicator& ind, size_t len) {
+    const auto* data_ind = ind.data();  // 本股数据
+    for (size_t i = ind.discard(); i < len; i++) {
+        dst[i] = panel.rankOf(i, data_ind[i], true);
     }
-    for (const auto& value : inds) {  // 单个ind
-        if (value.empty()) {
-            continue;
-        }
-        if (value.size() != len) {
-            HKU_WARN("Ignore stock: {}, value len: {}, dst len: {}",
-                     value.getContext().getStock().market_code(), value.size(), len);
-            continue;
-        }
-        const auto* data = value.data();    // 对比股的数据
-        const auto* data_ind = ind.data();  // 本股数据
+}
 
-        for (size_t i = discard; i < len; i++) {
-            if (!std::isnan(data[i])) {
-                if (data[i] < data_ind[i]) {  // 如果比dst_tmp值小,则排名+1,如果比dst_tmp值大,则不变
-                    dst[i]++;
-                }
-            }
-        }
-    }
+static void insum_copy(const PriceList& src, Indicator::value_t* dst) {
+    std::copy(src.cbegin(), src.cend(), dst);
 }
 
 void IInSum::_calculate(const Indicator& ind) {
@@ -254,17 +93,19 @@ void IInSum::_calculate(const Indicator& ind) {
         }
     }
 
-    auto inds = getAllIndicators(block, q, dates, ind, getParam<bool>("fill_null"));
+    // 同一板块、查询条件及公式的截面数据只计算一次，板块内各证券的 INSUM 共享
+    auto panel = IndicatorPanel::create(ind, block.getStockList(), q, dates,
+                                        getParam<bool>("fill_null"));
     auto* dst = this->data();
 
     if (0 == mode) {
-        insum_cum(inds, dst, total);
+        insum_copy(panel->sum(), dst);
     } else if (1 == mode) {
-        insum_mean(inds, dst, total);
+        insum_copy(panel->mean(), dst);
     } else if (2 == mode) {
-        insum_max(inds, dst, total);
+        insum_copy(panel->max(), dst);
     } else if (3 == mode) {
-        insum_min(inds, dst, total);
+        insum_copy(panel->min(), dst);
     } else if (4 == mode) {
         // 指标值越大排名值越低，即指标最大的值对应排名值为1
         auto nind = ind;
@@ -272,7 +113,7 @@ void IInSum::_calculate(const Indicator& ind) {
             nind = ALIGN(ind, dates, getParam<bool>("fill_null"));
             HKU_CHECK(nind.size() == total, "ind size: {}  != total: {}", ind.size(), total);
         }
-        insum_rank_desc(inds, dst, nind, total);
+        insum_rank_desc(*panel, dst, nind, total);
     } else if (5 == mode) {
         // 指标值越高排名值越高，即指标值最低的排名值为1
         auto nind = ind;
@@ -280,7 +121,7 @@ void IInSum::_calculate(const Indicator& ind) {
             nind = ALIGN(ind, dates, getParam<bool>("fill_null"));
             HKU_CHECK(nind.size() == total, "ind size: {}  != total: {}", ind.size(), total);
         }
-        insum_rank_asc(inds, dst, nind, total);
+        insum_rank_asc(*panel, dst, nind, total);
     } else {
         HKU_ERROR("Not support mode: {}", mode);
     }
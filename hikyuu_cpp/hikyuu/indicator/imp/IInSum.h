@@ -15,6 +15,7 @@ namespace hku {
 
 class IInSum : public IndicatorImp {
     INDICATOR_IMP(IInSum)
+    INDICATOR_NO_DISK_CACHE
     INDICATOR_IMP_NO_PRIVATE_MEMBER_SERIALIZATION
 
 public:
@@ -13,6 +13,7 @@ namespace hku {
 
 class IIndex : public IndicatorImp {
     INDICATOR_IMP(IIndex)
+    INDICATOR_NO_DISK_CACHE
     INDICATOR_IMP_NO_PRIVATE_MEMBER_SERIALIZATION
 
 public:
@@ -47,6 +47,14 @@ void IKData::_calculate(const Indicator& ind) {
     HKU_IF_RETURN(total == 0, void());
 
     string part_name = getParam<string>("kpart");
+
+    // 列式存储时直接由缓存中的列数据复制
+    const KRecordColumnsView* columns = kdata.columns();
+    if (columns) {
+        _calculateFromColumns(*columns, part_name);
+        return;
+    }
+
     auto const* ks = kdata.data();
 
     if ("KDATA" == part_name) {
@@ -121,6 +129,101 @@ void IKData::_calculate(const Indicator& ind) {
     }
 }
 
+static bool get_kpart_field(const string& part_name, KRecordColumns::Field& field) {
+    if ("OPEN" == part_name) {
+        field = KRecordColumns::OPEN;
+    } else if ("HIGH" == part_name) {
+        field = KRecordColumns::HIGH;
+    } else if ("LOW" == part_name) {
+        field = KRecordColumns::LOW;
+    } else if ("CLOSE" == part_name) {
+        field = KRecordColumns::CLOSE;
+    } else if ("AMO" == part_name) {
+        field = KRecordColumns::AMOUNT;
+    } else if ("VOL" == part_name) {
+        field = KRecordColumns::VOL;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static price_t get_krecord_field(const KRecord& record, KRecordColumns::Field field) {
+    switch (field) {
+        case KRecordColumns::OPEN:
+            return record.openPrice;
+        case KRecordColumns::HIGH:
+            return record.highPrice;
+        case KRecordColumns::LOW:
+            return record.lowPrice;
+        case KRecordColumns::CLOSE:
+            return record.closePrice;
+        case KRecordColumns::AMOUNT:
+            return record.transAmount;
+        case KRecordColumns::VOL:
+            return record.transCount;
+        default:
+            return Null<price_t>();
+    }
+}
+
+void IKData::_calculateFromColumns(const KRecordColumnsView& columns, const string& part_name) {
+    size_t total = columns.size();
+    if ("KDATA" == part_name) {
+        m_name = "KDATA";
+        _readyBuffer(total, 6);
+        for (size_t r = 0; r < 6; r++) {
+            const auto* src = columns.data(KRecordColumns::Field(r));
+            std::copy(src, src + total, this->data(r));
+        }
+        return;
+    }
+
+    KRecordColumns::Field field;
+    if (!get_kpart_field(part_name, field)) {
+        m_name = "Unknown";
+        m_discard = total;
+        HKU_INFO("Unkown ValueType of KData");
+        return;
+    }
+
+    m_name = part_name;
+    _readyBuffer(total, 1);
+    const auto* src = columns.data(field);
+    std::copy(src, src + total, this->data());
+}
+
+bool IKData::_increment_calculate(const Indicator& ind, size_t start_pos) {
+    KRecordColumns::Field fields[KRecordColumns::FIELD_COUNT];
+    size_t field_num = 0;
+    string part_name = getParam<string>("kpart");
+    if ("KDATA" == part_name) {
+        for (size_t r = 0; r < KRecordColumns::FIELD_COUNT; r++) {
+            fields[r] = KRecordColumns::Field(r);
+        }
+        field_num = KRecordColumns::FIELD_COUNT;
+    } else if (get_kpart_field(part_name, fields[0])) {
+        field_num = 1;
+    }
+    HKU_IF_RETURN(field_num == 0 || field_num != m_result_num, false);
+
+    KData kdata = getContext();
+    size_t total = kdata.size();
+    const KRecordColumnsView* columns = kdata.columns();
+    for (size_t r = 0; r < field_num; r++) {
+        auto* dst = this->data(r);
+        if (columns) {
+            const auto* src = columns->data(fields[r]);
+            std::copy(src + start_pos, src + total, dst + start_pos);
+        } else {
+            for (size_t i = start_pos; i < total; i++) {
+                dst[i] = get_krecord_field(kdata.getKRecord(i), fields[r]);
+            }
+        }
+    }
+    return true;
+}
+
 Indicator HKU_API KDATA(const KData& kdata) {
     return Indicator(make_shared<IKData>(kdata, "KDATA"));
 }
@@ -22,7 +22,11 @@ public:
     IKData();
     IKData(const KData&, const string&);
     virtual ~IKData();
+    virtual bool _increment_calculate(const Indicator& ind, size_t start_pos) override;
     virtual void _checkParam(const string& name) const override;
+
+private:
+    void _calculateFromColumns(const KRecordColumnsView& columns, const string& part_name);
 };
 
 } /* namespace hku */
@@ -16,6 +16,7 @@ namespace hku {
 class ILiuTongPan : public IndicatorImp {
     INDICATOR_IMP(ILiuTongPan)
     INDICATOR_NEED_CONTEXT
+    INDICATOR_NO_DISK_CACHE
     INDICATOR_IMP_NO_PRIVATE_MEMBER_SERIALIZATION
 
 public:
@@ -8,6 +8,7 @@
  */
 
 #include "ILowLine.h"
+#include "../sliding_window.h"
 
 #if HKU_SUPPORT_SERIALIZATION
 BOOST_CLASS_EXPORT(hku::ILowLine)
@@ -56,52 +57,74 @@ void ILowLine::_calculate(const Indicator& ind) {
 
     auto const* src = ind.data();
     auto* dst = this->data();
+    rolling_extremum<MinQueue<value_t>>(
+      src, m_discard, total, n, [dst](size_t i, const MinQueue<value_t>& queue) {
+          dst[i] = queue.empty() ? Null<value_t>() : queue.value();
+      });
+}
 
-    size_t startPos = m_discard;
-    size_t first_end = startPos + n >= total ? total : startPos + n;
+bool ILowLine::_increment_calculate(const Indicator& ind, size_t start_pos) {
+    size_t total = ind.size();
+    auto const* src = ind.data();
+    auto* dst = this->data();
 
-    price_t min = src[startPos];
-    size_t pre_pos = startPos;
-    for (size_t i = startPos; i < first_end; i++) {
-        if (src[i] <= min) {
-            min = src[i];
-            pre_pos = i;
-        }
-        dst[i] = min;
+    // 窗口不限长度时，前一位置的结果即为之前所有数据的极值
+    MinQueue<value_t> queue;
+    int n = getParam<int>("n");
+    size_t first = m_discard;
+    if (n <= 0) {
+        queue.push(start_pos - 1, dst[start_pos - 1]);
+        first = start_pos;
+    } else if (start_pos >= m_discard + n) {
+        first = start_pos - n;
+    }
+    for (size_t i = first; i < start_pos; i++) {
+        queue.push(i, src[i]);
     }
 
-    for (size_t i = first_end; i < total; i++) {
-        size_t j = i + 1 - n;
-        if (pre_pos < j) {
-            pre_pos = j;
-            min = src[j];
-            for (size_t k = pre_pos + 1; k <= i; k++) {
-                if (src[k] <= min) {
-                    min = src[k];
-                    pre_pos = k;
-                }
-            }
-        } else {
-            if (src[i] <= min) {
-                min = src[i];
-                pre_pos = i;
-            }
+    for (size_t i = start_pos; i < total; i++) {
+        queue.push(i, src[i]);
+        if (n > 0 && i >= m_discard + n) {
+            queue.popBefore(i + 1 - n);
         }
-        dst[i] = min;
+        dst[i] = queue.empty() ? Null<value_t>() : queue.value();
     }
+    return true;
 }
 
 void ILowLine::_dyn_run_one_step(const Indicator& ind, size_t curPos, size_t step) {
     size_t start = _get_step_start(curPos, step, ind.discard());
-    price_t min_val = ind[start];
-    for (size_t i = start + 1; i <= curPos; i++) {
-        if (ind[i] < min_val) {
-            min_val = ind[i];
+    auto const* src = ind.data();
+    value_t min_val = Null<value_t>();
+    for (size_t i = start; i <= curPos; i++) {
+        // NaN 不参与比较
+        if (src[i] < min_val || (std::isnan(min_val) && !std::isnan(src[i]))) {
+            min_val = src[i];
         }
     }
     _set(min_val, curPos);
 }
 
+void ILowLine::_dyn_run_range(const Indicator& ind, const value_t* steps, size_t start,
+                              size_t end) {
+    auto const* src = ind.data();
+    auto* dst = this->data();
+    size_t discard = ind.discard();
+    dyn_rolling_extremum<MinQueue<value_t>>(
+      src, start, end,
+      [=](size_t i, size_t& window_start) {
+          if (std::isnan(steps[i])) {
+              dst[i] = Null<value_t>();
+              return false;
+          }
+          window_start = _get_step_start(i, size_t(steps[i]), discard);
+          return true;
+      },
+      [dst](size_t i, const MinQueue<value_t>& queue) {
+          dst[i] = queue.empty() ? Null<value_t>() : queue.value();
+      });
+}
+
 Indicator HKU_API LLV(int n = 20) {
     IndicatorImpPtr p = make_shared<ILowLine>();
     p->setParam<int>("n", n);
@@ -18,10 +18,14 @@ namespace hku {
 class ILowLine : public IndicatorImp {
     INDICATOR_IMP_SUPPORT_DYNAMIC_STEP(ILowLine)
     INDICATOR_IMP_NO_PRIVATE_MEMBER_SERIALIZATION
+    INDICATOR_ALGORITHM_VERSION(1)
 
 public:
     ILowLine();
     virtual ~ILowLine();
+    virtual bool _increment_calculate(const Indicator& ind, size_t start_pos) override;
+    virtual void _dyn_run_range(const Indicator& ind, const value_t* steps, size_t start,
+                                size_t end) override;
     virtual void _checkParam(const string& name) const override;
 };
 
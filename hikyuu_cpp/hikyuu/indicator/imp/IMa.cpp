@@ -67,6 +67,28 @@ void IMa::_calculate(const Indicator& indicator) {
     }
 }
 
+bool IMa::_increment_calculate(const Indicator& ind, size_t start_pos) {
+    // 仅在窗口已满且新窗口内不含 NaN 时增量计算，其余情况由完整计算处理
+    int n = getParam<int>("n");
+    HKU_IF_RETURN(n <= 0 || start_pos < m_discard + n, false);
+
+    size_t total = ind.size();
+    auto const* src = ind.data();
+    auto* dst = this->data();
+    price_t sum = 0.0;
+    for (size_t i = start_pos - n; i < start_pos; i++) {
+        HKU_IF_RETURN(std::isnan(src[i]), false);
+        sum += src[i];
+    }
+
+    for (size_t i = start_pos; i < total; i++) {
+        HKU_IF_RETURN(std::isnan(src[i]), false);
+        sum = src[i] + sum - src[i - n];
+        dst[i] = sum / n;
+    }
+    return true;
+}
+
 void IMa::_dyn_run_one_step(const Indicator& ind, size_t curPos, size_t step) {
     size_t start = _get_step_start(curPos, step, ind.discard());
     price_t sum = 0.0;
@@ -20,6 +20,7 @@ class IMa : public IndicatorImp {
 public:
     IMa();
     virtual ~IMa();
+    virtual bool _increment_calculate(const Indicator& ind, size_t start_pos) override;
     virtual void _checkParam(const string& name) const override;
 };
 
@@ -13,6 +13,7 @@ namespace hku {
 
 class IRecover : public IndicatorImp {
     INDICATOR_IMP(IRecover)
+    INDICATOR_NO_DISK_CACHE
     INDICATOR_IMP_NO_PRIVATE_MEMBER_SERIALIZATION
 
 public:
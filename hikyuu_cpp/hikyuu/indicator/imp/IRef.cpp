@@ -42,6 +42,17 @@ void IRef::_calculate(const Indicator& data) {
     }
 }
 
+bool IRef::_increment_calculate(const Indicator& ind, size_t start_pos) {
+    size_t total = ind.size();
+    int n = getParam<int>("n");
+    auto const* src = ind.data();
+    auto* dst = this->data();
+    for (size_t i = std::max(start_pos, m_discard); i < total; ++i) {
+        dst[i] = src[i - n];
+    }
+    return true;
+}
+
 void IRef::_dyn_run_one_step(const Indicator& ind, size_t curPos, size_t step) {
     if (curPos >= step) {
         _set(ind[curPos - step], curPos);
@@ -26,6 +26,7 @@ class IRef : public IndicatorImp {
 public:
     IRef();
     virtual ~IRef();
+    virtual bool _increment_calculate(const Indicator& ind, size_t start_pos) override;
     virtual void _checkParam(const string& name) const override;
 };
 
@@ -6,6 +6,7 @@
  */
 
 #include "ISlope.h"
+#include "../sliding_window.h"
 
 #if HKU_SUPPORT_SERIALIZATION
 BOOST_CLASS_EXPORT(hku::ISlope)
@@ -25,6 +26,10 @@ void ISlope::_checkParam(const string& name) const {
     }
 }
 
+static IndicatorImp::value_t slope_value(const RollingCovariance& cov) {
+    return cov.nanCount() > 0 ? Null<IndicatorImp::value_t>() : cov.slope();
+}
+
 void ISlope::_calculate(const Indicator& ind) {
     size_t total = ind.size();
     m_discard = ind.discard() + 1;
@@ -44,23 +49,23 @@ void ISlope::_calculate(const Indicator& ind) {
         return;
     }
 
+    // 以位置作为 x，窗口内 y 对 x 的线性回归斜率
     size_t startPos = m_discard - 1;
-    price_t xsum = 0.0, ysum = 0.0, xysum = 0.0, x2sum = 0.0;
-    size_t first_end = startPos + n >= total ? total : startPos + n;
-    for (size_t i = startPos; i < first_end; i++) {
-        xsum += i;
-        ysum += src[i];
-        xysum += i * src[i];
-        x2sum += std::pow(i, 2);
-        dst[i] = ((i + 1) * xysum - xsum * ysum) / ((i + 1) * x2sum - xsum * xsum);
-    }
-
-    for (size_t i = first_end; i < total; i++) {
-        xsum += n;
-        ysum += src[i] - src[i - n];
-        xysum += src[i] * i - src[i - n] * (i - n);
-        x2sum += (2 * i - n) * n;
-        dst[i] = (n * xysum - xsum * ysum) / (n * x2sum - xsum * xsum);
+    RollingCovariance cov;
+    RebuildCounter counter;
+    cov.add(startPos, src[startPos]);
+    for (size_t i = m_discard; i < total; i++) {
+        cov.add(i, src[i]);
+        if (i >= startPos + n) {
+            cov.remove(i - n, src[i - n]);
+            if (counter.remove(n)) {
+                cov.clear();
+                for (size_t j = i + 1 - n; j <= i; j++) {
+                    cov.add(j, src[j]);
+                }
+            }
+        }
+        dst[i] = slope_value(cov);
     }
 }
 
@@ -76,16 +81,37 @@ void ISlope::_dyn_run_one_step(const Indicator& ind, size_t curPos, size_t step)
         return;
     }
 
-    double n = curPos - start + 1;
-    price_t xsum = 0.0, ysum = 0.0, xysum = 0.0, x2sum = 0.0;
+    RollingCovariance cov;
+    auto const* src = ind.data();
     for (size_t i = start; i <= curPos; i++) {
-        xsum += i;
-        ysum += ind[i];
-        xysum += ind[i] * i;
-        x2sum += std::pow(i, 2);
+        cov.add(i, src[i]);
     }
+    _set(slope_value(cov), curPos);
+}
 
-    _set((n * xysum - xsum * ysum) / (n * x2sum - std::pow(xsum, 2)), curPos);
+void ISlope::_dyn_run_range(const Indicator& ind, const value_t* steps, size_t start, size_t end) {
+    auto const* src = ind.data();
+    auto* dst = this->data();
+    size_t discard = ind.discard();
+    RollingCovariance cov;
+    SlidingWindow window(true);
+    for (size_t i = start; i < end; i++) {
+        if (std::isnan(steps[i]) || i <= discard) {
+            dst[i] = Null<value_t>();
+            continue;
+        }
+
+        size_t step = size_t(steps[i]);
+        if (step <= 1) {
+            dst[i] = 0.0;
+            continue;
+        }
+
+        window.moveTo(
+          _get_step_start(i, step, discard), i + 1, [&](size_t pos) { cov.add(pos, src[pos]); },
+          [&](size_t pos) { cov.remove(pos, src[pos]); }, [&]() { cov.clear(); });
+        dst[i] = slope_value(cov);
+    }
 }
 
 Indicator HKU_API SLOPE(int n) {
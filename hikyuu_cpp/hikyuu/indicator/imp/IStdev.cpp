@@ -6,6 +6,7 @@
  */
 
 #include "IStdev.h"
+#include "../sliding_window.h"
 #include "../crt/MA.h"
 
 #if HKU_SUPPORT_SERIALIZATION
@@ -36,61 +37,17 @@ void IStdev::_calculate(const Indicator& data) {
     }
 
     int n = getParam<int>("n");
-    if (0 == n) {
-        n = total;
-    }
 
     auto const* src = data.data();
     auto* dst = this->data();
 
-    vector<price_t> pow_buf(data.size());
-    price_t ex = 0.0, ex2 = 0.0;
-    size_t num = 0;
-    size_t start_pos = m_discard;
-    size_t first_end = start_pos + n >= total ? total : start_pos + n;
-    price_t k = src[start_pos];
-    for (size_t i = start_pos; i < first_end; i++) {
-        if (!std::isnan(src[i])) {
-            num++;
-            price_t d = src[i] - k;
-            ex += d;
-            price_t d_pow = std::pow(d, 2);
-            pow_buf[i] = d_pow;
-            ex2 += d_pow;
-            // dst[i] = num == 1 ? 0. : std::sqrt((ex2 - std::pow(ex, 2) / num) / (num - 1));
-            if (num > 1) {
-                dst[i] = std::sqrt((ex2 - std::pow(ex, 2) / num) / (num - 1));
-            }
-        }
-    }
-
-    for (size_t i = first_end; i < total; i++) {
-        if (!std::isnan(src[i])) {
-            size_t j = i - n;
-            for (; j < i; j++) {
-                if (!std::isnan(src[j])) {
-                    break;
-                }
-            }
-            if (j == i) {
-                continue;
-            }
-            // ex -= src[i - n] - k;
-            // ex2 -= pow_buf[i - n];
-            ex -= src[j] - k;
-            ex2 -= pow_buf[j];
-            price_t d = src[i] - k;
-            ex += d;
-            price_t d_pow = std::pow(d, 2);
-            pow_buf[i] = d_pow;
-            ex2 += d_pow;
-            num = i - j;
-            if (num != 1) {
-                dst[i] = std::sqrt((ex2 - std::pow(ex, 2) / num) / (num - 1));
-            }
-            // dst[i] = std::sqrt((ex2 - std::pow(ex, 2) / n) / (n - 1));
-        }
-    }
+    // 窗口内的 NaN 值不参与计算
+    rolling_accumulate<RollingMoments>(src, m_discard, total, n,
+                                       [src, dst](size_t i, const RollingMoments& m) {
+                                           if (!std::isnan(src[i]) && m.count() > 1) {
+                                               dst[i] = std::sqrt(m.var());
+                                           }
+                                       });
 
     // 排除第一位的0值
     if (m_discard < total) {
@@ -99,18 +56,38 @@ void IStdev::_calculate(const Indicator& data) {
     }
 }
 
+static IndicatorImp::value_t dyn_stdev(const RollingMoments& m) {
+    size_t num = m.count() + m.nanCount();
+    if (num <= 1) {
+        return 0.0;
+    }
+    return m.nanCount() > 0 ? Null<IndicatorImp::value_t>() : std::sqrt(m.var());
+}
+
 void IStdev::_dyn_run_one_step(const Indicator& ind, size_t curPos, size_t step) {
     size_t start = _get_step_start(curPos, step, ind.discard());
-    size_t num = 0;
-    price_t ex = 0.0, ex2 = 0.0;
-    price_t k = ind[start];
+    RollingMoments m;
+    auto const* src = ind.data();
     for (size_t i = start; i <= curPos; i++) {
-        num++;
-        price_t d = ind[i] - k;
-        ex += d;
-        ex2 += std::pow(d, 2);
+        m.add(src[i]);
     }
-    _set(num <= 1 ? 0.0 : std::sqrt((ex2 - std::pow(ex, 2) / num) / (num - 1)), curPos);
+    _set(dyn_stdev(m), curPos);
+}
+
+void IStdev::_dyn_run_range(const Indicator& ind, const value_t* steps, size_t start, size_t end) {
+    auto* dst = this->data();
+    size_t discard = ind.discard();
+    dyn_rolling_accumulate<RollingMoments>(
+      ind.data(), start, end,
+      [=](size_t i, size_t& window_start) {
+          if (std::isnan(steps[i])) {
+              dst[i] = Null<value_t>();
+              return false;
+          }
+          window_start = _get_step_start(i, size_t(steps[i]), discard);
+          return true;
+      },
+      [dst](size_t i, const RollingMoments& m) { dst[i] = dyn_stdev(m); });
 }
 
 Indicator HKU_API STDEV(int n) {
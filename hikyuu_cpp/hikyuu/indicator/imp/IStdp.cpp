@@ -8,6 +8,7 @@
  */
 
 #include "IStdp.h"
+#include "../sliding_window.h"
 #include "../crt/MA.h"
 
 #if HKU_SUPPORT_SERIALIZATION
@@ -38,53 +39,47 @@ void IStdp::_calculate(const Indicator& data) {
     }
 
     int n = getParam<int>("n");
-    if (0 == n) {
-        n = total;
-    }
 
     auto const* src = data.data();
     auto* dst = this->data();
+    rolling_accumulate<RollingMoments>(src, m_discard, total, n,
+                                       [dst](size_t i, const RollingMoments& m) {
+                                           dst[i] = m.nanCount() > 0 ? Null<value_t>()
+                                                                     : std::sqrt(m.varp());
+                                       });
+}
 
-    vector<price_t> pow_buf(data.size());
-    price_t ex = 0.0, ex2 = 0.0;
-    size_t num = 0;
-    size_t start_pos = m_discard;
-    size_t first_end = start_pos + n >= total ? total : start_pos + n;
-    price_t k = src[start_pos];
-    for (size_t i = start_pos; i < first_end; i++) {
-        num++;
-        price_t d = src[i] - k;
-        ex += d;
-        price_t d_pow = std::pow(d, 2);
-        pow_buf[i] = d_pow;
-        ex2 += d_pow;
-        dst[i] = std::sqrt((ex2 - std::pow(ex, 2) / num) / num);
-    }
-
-    for (size_t i = first_end; i < total; i++) {
-        ex -= src[i - n] - k;
-        ex2 -= pow_buf[i - n];
-        price_t d = src[i] - k;
-        ex += d;
-        price_t d_pow = std::pow(d, 2);
-        pow_buf[i] = d_pow;
-        ex2 += d_pow;
-        dst[i] = std::sqrt((ex2 - std::pow(ex, 2) / n) / n);
+static IndicatorImp::value_t dyn_stdp(const RollingMoments& m) {
+    if (m.nanCount() > 0) {
+        return Null<IndicatorImp::value_t>();
     }
+    return m.count() == 0 ? 0.0 : std::sqrt(m.varp());
 }
 
 void IStdp::_dyn_run_one_step(const Indicator& ind, size_t curPos, size_t step) {
     size_t start = _get_step_start(curPos, step, ind.discard());
-    size_t num = 0;
-    price_t ex = 0.0, ex2 = 0.0;
-    price_t k = ind[start];
+    RollingMoments m;
+    auto const* src = ind.data();
     for (size_t i = start; i <= curPos; i++) {
-        num++;
-        price_t d = ind[i] - k;
-        ex += d;
-        ex2 += std::pow(d, 2);
+        m.add(src[i]);
     }
-    _set(num == 0 ? 0.0 : std::sqrt((ex2 - std::pow(ex, 2) / num) / num), curPos);
+    _set(dyn_stdp(m), curPos);
+}
+
+void IStdp::_dyn_run_range(const Indicator& ind, const value_t* steps, size_t start, size_t end) {
+    auto* dst = this->data();
+    size_t discard = ind.discard();
+    dyn_rolling_accumulate<RollingMoments>(
+      ind.data(), start, end,
+      [=](size_t i, size_t& window_start) {
+          if (std::isnan(steps[i])) {
+              dst[i] = Null<value_t>();
+              return false;
+          }
+          window_start = _get_step_start(i, size_t(steps[i]), discard);
+          return true;
+      },
+      [dst](size_t i, const RollingMoments& m) { dst[i] = dyn_stdp(m); });
 }
 
 Indicator HKU_API STDP(int n) {
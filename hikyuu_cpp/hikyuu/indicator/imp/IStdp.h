@@ -22,10 +22,13 @@ namespace hku {
 class IStdp : public hku::IndicatorImp {
     INDICATOR_IMP_SUPPORT_DYNAMIC_STEP(IStdp)
     INDICATOR_IMP_NO_PRIVATE_MEMBER_SERIALIZATION
+    INDICATOR_ALGORITHM_VERSION(1)
 
 public:
     IStdp();
     virtual ~IStdp();
+    virtual void _dyn_run_range(const Indicator& ind, const value_t* steps, size_t start,
+                                size_t end) override;
     virtual void _checkParam(const string& name) const override;
 };
 
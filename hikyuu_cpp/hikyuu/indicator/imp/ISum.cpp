@@ -6,6 +6,7 @@
  */
 
 #include "ISum.h"
+#include "../sliding_window.h"
 
 #if HKU_SUPPORT_SERIALIZATION
 BOOST_CLASS_EXPORT(hku::ISum)
@@ -52,28 +53,79 @@ void ISum::_calculate(const Indicator& ind) {
         return;
     }
 
-    price_t sum = 0.0;
-    for (size_t i = m_discard, len = (m_discard + n) >= total ? total : m_discard + n; i < len;
-         i++) {
-        sum += src[i];
-        dst[i] = sum;
+    rolling_accumulate<RollingSum>(src, m_discard, total, n,
+                                   [dst](size_t i, const RollingSum& sum) { dst[i] = sum.value(); });
+}
+
+bool ISum::_increment_calculate(const Indicator& ind, size_t start_pos) {
+    size_t total = ind.size();
+    auto const* src = ind.data();
+    auto* dst = this->data();
+
+    int n = getParam<int>("n");
+    if (n <= 0) {
+        HKU_IF_RETURN(start_pos <= m_discard, false);
+        price_t sum = dst[start_pos - 1];
+        for (size_t i = start_pos; i < total; i++) {
+            sum += src[i];
+            dst[i] = sum;
+        }
+        return true;
     }
 
-    for (size_t i = m_discard + n; i < total; i++) {
-        sum = sum - src[i - n] + src[i];
-        dst[i] = sum;
+    if (n == 1) {
+        memcpy(dst + start_pos, src + start_pos, (total - start_pos) * sizeof(value_t));
+        return true;
     }
 
-    return;
+    // 先累加 start_pos 之前仍在窗口内的数据
+    RollingSum sum;
+    size_t first = start_pos >= m_discard + n ? start_pos - n : m_discard;
+    for (size_t i = first; i < start_pos; i++) {
+        sum.add(src[i]);
+    }
+
+    RebuildCounter counter;
+    for (size_t i = start_pos; i < total; i++) {
+        sum.add(src[i]);
+        if (i >= m_discard + n) {
+            sum.remove(src[i - n]);
+            if (counter.remove(n)) {
+                sum.clear();
+                for (size_t j = i + 1 - n; j <= i; j++) {
+                    sum.add(src[j]);
+                }
+            }
+        }
+        dst[i] = sum.value();
+    }
+    return true;
 }
 
 void ISum::_dyn_run_one_step(const Indicator& ind, size_t curPos, size_t step) {
     size_t start = _get_step_start(curPos, step, ind.discard());
-    price_t sum = 0.0;
+    RollingSum sum;
+    auto const* src = ind.data();
     for (size_t i = start; i <= curPos; i++) {
-        sum += ind[i];
+        sum.add(src[i]);
     }
-    _set(sum, curPos);
+    _set(sum.value(), curPos);
+}
+
+void ISum::_dyn_run_range(const Indicator& ind, const value_t* steps, size_t start, size_t end) {
+    auto* dst = this->data();
+    size_t discard = ind.discard();
+    dyn_rolling_accumulate<RollingSum>(
+      ind.data(), start, end,
+      [=](size_t i, size_t& window_start) {
+          if (std::isnan(steps[i])) {
+              dst[i] = Null<value_t>();
+              return false;
+          }
+          window_start = _get_step_start(i, size_t(steps[i]), discard);
+          return true;
+      },
+      [dst](size_t i, const RollingSum& sum) { dst[i] = sum.value(); });
 }
 
 Indicator HKU_API SUM(int n) {
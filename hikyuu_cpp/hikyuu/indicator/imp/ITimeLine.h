@@ -18,6 +18,7 @@ namespace hku {
 class ITimeLine : public IndicatorImp {
     INDICATOR_IMP(ITimeLine)
     INDICATOR_NEED_CONTEXT
+    INDICATOR_NO_DISK_CACHE
     INDICATOR_IMP_NO_PRIVATE_MEMBER_SERIALIZATION
 
 public:
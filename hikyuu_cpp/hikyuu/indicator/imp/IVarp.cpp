@@ -8,6 +8,7 @@
  */
 
 #include "IVarp.h"
+#include "../sliding_window.h"
 #include "../crt/MA.h"
 
 #if HKU_SUPPORT_SERIALIZATION
@@ -44,54 +45,50 @@ void IVarp::_calculate(const Indicator& data) {
         return;
     }
 
-    auto const* src = data.data();
     auto* dst = this->data();
+    size_t first_pos = m_discard;
+    rolling_accumulate<RollingMoments>(data.data(), data.discard(), total, n,
+                                       [=](size_t i, const RollingMoments& m) {
+                                           if (i >= first_pos) {
+                                               dst[i] = m.nanCount() > 0 ? Null<value_t>()
+                                                                         : m.varp();
+                                           }
+                                       });
+}
 
-    vector<price_t> pow_buf(data.size());
-
-    size_t start_pos = data.discard();
-    size_t first_end = start_pos + n >= total ? total : start_pos + n;
-    value_t ex = 0.0, ex2 = 0.0;
-
-    value_t k = src[start_pos];
-    for (size_t i = start_pos; i < first_end; i++) {
-        value_t d = src[i] - k;
-        ex += d;
-        value_t d_pow = d * d;
-        pow_buf[i] = d_pow;
-        ex2 += d_pow;
-    }
-
-    value_t p1 = 1. / n;
-    value_t p2 = 1. / (n * n);
-    dst[first_end - 1] = ex2 * p1 - ex * ex * p2;
-
-    for (size_t i = first_end, pre_ix = first_end - n; i < total; i++, pre_ix++) {
-        ex -= src[pre_ix] - k;
-        ex2 -= pow_buf[pre_ix];
-        value_t d = src[i] - k;
-        ex += d;
-        value_t d_pow = d * d;
-        pow_buf[i] = d_pow;
-        ex2 += d_pow;
-        dst[i] = ex2 * p1 - ex * ex * p2;
-    }
+// 仅计算完整窗口
+static bool varp_window_start(size_t pos, size_t step, size_t discard, size_t& start) {
+    HKU_IF_RETURN(step < 2 || pos + 1 < discard + step, false);
+    start = pos + 1 - step;
+    return true;
 }
 
 void IVarp::_dyn_run_one_step(const Indicator& ind, size_t curPos, size_t step) {
-    HKU_IF_RETURN(step < 2, void());
-
-    size_t start = _get_step_start(curPos, step, ind.discard());
-    HKU_IF_RETURN(start != curPos + 1 - step, void());
-
-    price_t ex = 0.0, ex2 = 0.0;
-    price_t k = ind[start];
+    size_t start = 0;
+    HKU_IF_RETURN(!varp_window_start(curPos, step, ind.discard(), start), void());
+    RollingMoments m;
+    auto const* src = ind.data();
     for (size_t i = start; i <= curPos; i++) {
-        price_t d = ind[i] - k;
-        ex += d;
-        ex2 += d * d;
+        m.add(src[i]);
     }
-    _set((ex2 - ex * ex / step) / step, curPos);
+    _set(m.nanCount() > 0 ? Null<value_t>() : m.varp(), curPos);
+}
+
+void IVarp::_dyn_run_range(const Indicator& ind, const value_t* steps, size_t start, size_t end) {
+    auto* dst = this->data();
+    size_t discard = ind.discard();
+    dyn_rolling_accumulate<RollingMoments>(
+      ind.data(), start, end,
+      [=](size_t i, size_t& window_start) {
+          if (std::isnan(steps[i])) {
+              dst[i] = Null<value_t>();
+              return false;
+          }
+          return varp_window_start(i, size_t(steps[i]), discard, window_start);
+      },
+      [dst](size_t i, const RollingMoments& m) {
+          dst[i] = m.nanCount() > 0 ? Null<value_t>() : m.varp();
+      });
 }
 
 Indicator HKU_API VARP(int n) {
@@ -19,6 +19,7 @@ namespace hku {
  */
 class IZhBond10 : public IndicatorImp {
     INDICATOR_IMP(IZhBond10)
+    INDICATOR_NO_DISK_CACHE
     INDICATOR_IMP_NO_PRIVATE_MEMBER_SERIALIZATION
 
 public:
@@ -14,6 +14,7 @@ namespace hku {
 class IZongGuBen : public IndicatorImp {
     INDICATOR_IMP(IZongGuBen)
     INDICATOR_NEED_CONTEXT
+    INDICATOR_NO_DISK_CACHE
     INDICATOR_IMP_NO_PRIVATE_MEMBER_SERIALIZATION
 
 public:
@@ -0,0 +1,387 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-16
+ *      Author: fasiondog
+ */
+
+#include <atomic>
+#include <cmath>
+#include "simd_kernel.h"
+
+#if !defined(HKU_DISABLE_SIMD) && (defined(__x86_64__) || defined(_M_X64))
+#define HKU_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define HKU_TARGET_AVX2
+#else
+#define HKU_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#else
+#define HKU_SIMD_X86 0
+#endif
+
+namespace hku {
+namespace simd {
+
+typedef void (*binary_func)(const value_t*, const value_t*, value_t*, size_t);
+typedef void (*unary_func)(const value_t*, value_t*, size_t);
+typedef void (*select_func)(const value_t*, const value_t*, const value_t*, value_t*, size_t);
+
+struct Kernels {
+    const char* name;
+    binary_func add;
+    binary_func sub;
+    binary_func mul;
+    binary_func div;
+    binary_func eq;
+    binary_func ne;
+    binary_func gt;
+    binary_func lt;
+    binary_func ge;
+    binary_func le;
+    binary_func logic_and;
+    binary_func logic_or;
+    select_func select;
+    unary_func abs;
+    unary_func sqrt;
+    unary_func floor;
+    unary_func ceil;
+    unary_func neg;
+};
+
+//-----------------------------------------------------------------------------
+// 标量实现，同时作为向量实现的尾部处理
+//-----------------------------------------------------------------------------
+#define HKU_SCALAR_BINARY(name, expr)                                               \
+    static void name##_scalar(const value_t* a, const value_t* b, value_t* dst, \
+                              size_t n) {                                       \
+        for (size_t i = 0; i < n; i++) {                                        \
+            value_t x = a[i];                                                   \
+            value_t y = b[i];                                                   \
+            dst[i] = expr;                                                      \
+        }                                                                       \
+    }
+
+#define HKU_SCALAR_UNARY(name, expr)                                              \
+    static void name##_scalar(const value_t* src, value_t* dst, size_t n) { \
+        for (size_t i = 0; i < n; i++) {                                      \
+            value_t x = src[i];                                               \
+            dst[i] = expr;                                                    \
+        }                                                                     \
+    }
+
+HKU_SCALAR_BINARY(add, x + y)
+HKU_SCALAR_BINARY(sub, x - y)
+HKU_SCALAR_BINARY(mul, x* y)
+HKU_SCALAR_BINARY(div, x / y)
+HKU_SCALAR_BINARY(eq, (x == y) ? 1.0 : 0.0)
+HKU_SCALAR_BINARY(ne, (x != y) ? 1.0 : 0.0)
+HKU_SCALAR_BINARY(gt, (x > y) ? 1.0 : 0.0)
+HKU_SCALAR_BINARY(lt, (x < y) ? 1.0 : 0.0)
+HKU_SCALAR_BINARY(ge, (x >= y) ? 1.0 : 0.0)
+HKU_SCALAR_BINARY(le, (x <= y) ? 1.0 : 0.0)
+HKU_SCALAR_BINARY(logic_and, (x > 0.0) && (y > 0.0) ? 1.0 : 0.0)
+HKU_SCALAR_BINARY(logic_or, (x > 0.0) || (y > 0.0) ? 1.0 : 0.0)
+
+HKU_SCALAR_UNARY(abs, std::abs(x))
+HKU_SCALAR_UNARY(sqrt, std::sqrt(x))
+HKU_SCALAR_UNARY(floor, std::floor(x))
+HKU_SCALAR_UNARY(ceil, std::ceil(x))
+HKU_SCALAR_UNARY(neg, -x)
+
+static void select_scalar(const value_t* cond, const value_t* a, const value_t* b, value_t* dst,
+                          size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        dst[i] = cond[i] > 0.0 ? a[i] : b[i];
+    }
+}
+
+static const Kernels g_scalar_kernels = {
+  "scalar",       add_scalar,       sub_scalar,      mul_scalar,    div_scalar,
+  eq_scalar,      ne_scalar,        gt_scalar,       lt_scalar,     ge_scalar,
+  le_scalar,      logic_and_scalar, logic_or_scalar, select_scalar, abs_scalar,
+  sqrt_scalar,    floor_scalar,     ceil_scalar,     neg_scalar};
+
+#if HKU_SIMD_X86
+//-----------------------------------------------------------------------------
+// SSE2 / AVX2 实现，比较运算均使用有序比较（NaN 为 false），不等比较使用无序比较（NaN 为
+// true），与标量运算符语义一致
+//-----------------------------------------------------------------------------
+#if HKU_USE_LOW_PRECISION
+#define HKU_M128 __m128
+#define HKU_MM(op) _mm_##op##_ps
+#define HKU_M256 __m256
+#define HKU_MM256(op) _mm256_##op##_ps
+#else
+#define HKU_M128 __m128d
+#define HKU_MM(op) _mm_##op##_pd
+#define HKU_M256 __m256d
+#define HKU_MM256(op) _mm256_##op##_pd
+#endif
+
+static constexpr size_t SSE_WIDTH = 16 / sizeof(value_t);
+static constexpr size_t AVX_WIDTH = 32 / sizeof(value_t);
+
+#define HKU_SSE_BINARY(name, vexpr)                                                           \
+    static void name##_sse2(const value_t* a, const value_t* b, value_t* dst, size_t n) {   \
+        const HKU_M128 zero = HKU_MM(setzero)();                                            \
+        const HKU_M128 one = HKU_MM(set1)(1.0);                                             \
+        (void)zero;                                                                         \
+        (void)one;                                                                          \
+        size_t i = 0;                                                                       \
+        for (; i + SSE_WIDTH <= n; i += SSE_WIDTH) {                                        \
+            HKU_M128 x = HKU_MM(loadu)(a + i);                                              \
+            HKU_M128 y = HKU_MM(loadu)(b + i);                                              \
+            HKU_MM(storeu)(dst + i, vexpr);                                                 \
+        }                                                                                   \
+        name##_scalar(a + i, b + i, dst + i, n - i);                                        \
+    }
+
+#define HKU_AVX2_BINARY(name, vexpr)                                                        \
+    HKU_TARGET_AVX2 static void name##_avx2(const value_t* a, const value_t* b, value_t* dst, \
+                                            size_t n) {                                     \
+        const HKU_M256 zero = HKU_MM256(setzero)();                                         \
+        const HKU_M256 one = HKU_MM256(set1)(1.0);                                          \
+        (void)zero;                                                                         \
+        (void)one;                                                                          \
+        size_t i = 0;                                                                       \
+        for (; i + AVX_WIDTH <= n; i += AVX_WIDTH) {                                        \
+            HKU_M256 x = HKU_MM256(loadu)(a + i);                                           \
+            HKU_M256 y = HKU_MM256(loadu)(b + i);                                           \
+            HKU_MM256(storeu)(dst + i, vexpr);                                              \
+        }                                                                                   \
+        name##_scalar(a + i, b + i, dst + i, n - i);                                        \
+    }
+
+#define HKU_SSE_UNARY(name, vexpr)                                              \
+    static void name##_sse2(const value_t* src, value_t* dst, size_t n) {     \
+        const HKU_M128 sign = HKU_MM(set1)(-0.0);                             \
+        (void)sign;                                                           \
+        size_t i = 0;                                                         \
+        for (; i + SSE_WIDTH <= n; i += SSE_WIDTH) {                          \
+            HKU_M128 x = HKU_MM(loadu)(src + i);                              \
+            HKU_MM(storeu)(dst + i, vexpr);                                   \
+        }                                                                     \
+        name##_scalar(src + i, dst + i, n - i);                               \
+    }
+
+#define HKU_AVX2_UNARY(name, vexpr)                                                   \
+    HKU_TARGET_AVX2 static void name##_avx2(const value_t* src, value_t* dst, size_t n) { \
+        const HKU_M256 sign = HKU_MM256(set1)(-0.0);                                  \
+        (void)sign;                                                                   \
+        size_t i = 0;                                                                 \
+        for (; i + AVX_WIDTH <= n; i += AVX_WIDTH) {                                  \
+            HKU_M256 x = HKU_MM256(loadu)(src + i);                                   \
+            HKU_MM256(storeu)(dst + i, vexpr);                                        \
+        }                                                                             \
+        name##_scalar(src + i, dst + i, n - i);                                       \
+    }
+
+HKU_SSE_BINARY(add, HKU_MM(add)(x, y))
+HKU_SSE_BINARY(sub, HKU_MM(sub)(x, y))
+HKU_SSE_BINARY(mul, HKU_MM(mul)(x, y))
+HKU_SSE_BINARY(div, HKU_MM(div)(x, y))
+HKU_SSE_BINARY(eq, HKU_MM(and)(HKU_MM(cmpeq)(x, y), one))
+HKU_SSE_BINARY(ne, HKU_MM(and)(HKU_MM(cmpneq)(x, y), one))
+HKU_SSE_BINARY(gt, HKU_MM(and)(HKU_MM(cmpgt)(x, y), one))
+HKU_SSE_BINARY(lt, HKU_MM(and)(HKU_MM(cmplt)(x, y), one))
+HKU_SSE_BINARY(ge, HKU_MM(and)(HKU_MM(cmpge)(x, y), one))
+HKU_SSE_BINARY(le, HKU_MM(and)(HKU_MM(cmple)(x, y), one))
+HKU_SSE_BINARY(logic_and,
+               HKU_MM(and)(HKU_MM(and)(HKU_MM(cmpgt)(x, zero), HKU_MM(cmpgt)(y, zero)), one))
+HKU_SSE_BINARY(logic_or,
+               HKU_MM(and)(HKU_MM(or)(HKU_MM(cmpgt)(x, zero), HKU_MM(cmpgt)(y, zero)), one))
+
+HKU_SSE_UNARY(abs, HKU_MM(andnot)(sign, x))
+HKU_SSE_UNARY(sqrt, HKU_MM(sqrt)(x))
+HKU_SSE_UNARY(neg, HKU_MM(xor)(sign, x))
+
+static void select_sse2(const value_t* cond, const value_t* a, const value_t* b, value_t* dst,
+                        size_t n) {
+    const HKU_M128 zero = HKU_MM(setzero)();
+    size_t i = 0;
+    for (; i + SSE_WIDTH <= n; i += SSE_WIDTH) {
+        HKU_M128 mask = HKU_MM(cmpgt)(HKU_MM(loadu)(cond + i), zero);
+        HKU_M128 x = HKU_MM(and)(mask, HKU_MM(loadu)(a + i));
+        HKU_M128 y = HKU_MM(andnot)(mask, HKU_MM(loadu)(b + i));
+        HKU_MM(storeu)(dst + i, HKU_MM(or)(x, y));
+    }
+    select_scalar(cond + i, a + i, b + i, dst + i, n - i);
+}
+
+HKU_AVX2_BINARY(add, HKU_MM256(add)(x, y))
+HKU_AVX2_BINARY(sub, HKU_MM256(sub)(x, y))
+HKU_AVX2_BINARY(mul, HKU_MM256(mul)(x, y))
+HKU_AVX2_BINARY(div, HKU_MM256(div)(x, y))
+HKU_AVX2_BINARY(eq, HKU_MM256(and)(HKU_MM256(cmp)(x, y, _CMP_EQ_OQ), one))
+HKU_AVX2_BINARY(ne, HKU_MM256(and)(HKU_MM256(cmp)(x, y, _CMP_NEQ_UQ), one))
+HKU_AVX2_BINARY(gt, HKU_MM256(and)(HKU_MM256(cmp)(x, y, _CMP_GT_OQ), one))
+HKU_AVX2_BINARY(lt, HKU_MM256(and)(HKU_MM256(cmp)(x, y, _CMP_LT_OQ), one))
+HKU_AVX2_BINARY(ge, HKU_MM256(and)(HKU_MM256(cmp)(x, y, _CMP_GE_OQ), one))
+HKU_AVX2_BINARY(le, HKU_MM256(and)(HKU_MM256(cmp)(x, y, _CMP_LE_OQ), one))
+HKU_AVX2_BINARY(logic_and,
+                HKU_MM256(and)(HKU_MM256(and)(HKU_MM256(cmp)(x, zero, _CMP_GT_OQ),
+                                              HKU_MM256(cmp)(y, zero, _CMP_GT_OQ)),
+                               one))
+HKU_AVX2_BINARY(logic_or,
+                HKU_MM256(and)(HKU_MM256(or)(HKU_MM256(cmp)(x, zero, _CMP_GT_OQ),
+                                             HKU_MM256(cmp)(y, zero, _CMP_GT_OQ)),
+                               one))
+
+HKU_AVX2_UNARY(abs, HKU_MM256(andnot)(sign, x))
+HKU_AVX2_UNARY(sqrt, HKU_MM256(sqrt)(x))
+HKU_AVX2_UNARY(floor, HKU_MM256(floor)(x))
+HKU_AVX2_UNARY(ceil, HKU_MM256(ceil)(x))
+HKU_AVX2_UNARY(neg, HKU_MM256(xor)(sign, x))
+
+HKU_TARGET_AVX2 static void select_avx2(const value_t* cond, const value_t* a, const value_t* b,
+                                        value_t* dst, size_t n) {
+    const HKU_M256 zero = HKU_MM256(setzero)();
+    size_t i = 0;
+    for (; i + AVX_WIDTH <= n; i += AVX_WIDTH) {
+        HKU_M256 mask = HKU_MM256(cmp)(HKU_MM256(loadu)(cond + i), zero, _CMP_GT_OQ);
+        HKU_MM256(storeu)
+        (dst + i, HKU_MM256(blendv)(HKU_MM256(loadu)(b + i), HKU_MM256(loadu)(a + i), mask));
+    }
+    select_scalar(cond + i, a + i, b + i, dst + i, n - i);
+}
+
+// SSE2 无 floor/ceil 指令（需 SSE4.1），使用标量实现
+static const Kernels g_sse2_kernels = {
+  "sse2",       add_sse2,       sub_sse2,      mul_sse2,    div_sse2,
+  eq_sse2,      ne_sse2,        gt_sse2,       lt_sse2,     ge_sse2,
+  le_sse2,      logic_and_sse2, logic_or_sse2, select_sse2, abs_sse2,
+  sqrt_sse2,    floor_scalar,   ceil_scalar,   neg_sse2};
+
+static const Kernels g_avx2_kernels = {
+  "avx2",       add_avx2,       sub_avx2,      mul_avx2,    div_avx2,
+  eq_avx2,      ne_avx2,        gt_avx2,       lt_avx2,     ge_avx2,
+  le_avx2,      logic_and_avx2, logic_or_avx2, select_avx2, abs_avx2,
+  sqrt_avx2,    floor_avx2,     ceil_avx2,     neg_avx2};
+
+static bool cpuSupportAvx2() {
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) {
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+static const Kernels* bestKernels() {
+    static const Kernels* best = cpuSupportAvx2() ? &g_avx2_kernels : &g_sse2_kernels;
+    return best;
+}
+
+#else
+static const Kernels* bestKernels() {
+    return &g_scalar_kernels;
+}
+#endif /* HKU_SIMD_X86 */
+
+static std::atomic<bool> g_simd_enable{true};
+
+static inline const Kernels* kernels() {
+    return g_simd_enable.load(std::memory_order_relaxed) ? bestKernels() : &g_scalar_kernels;
+}
+
+const char* instructionSet() {
+    return kernels()->name;
+}
+
+void setEnable(bool enable) {
+    g_simd_enable = enable;
+}
+
+bool isEnable() {
+    return g_simd_enable;
+}
+
+void add(const value_t* a, const value_t* b, value_t* dst, size_t n) {
+    kernels()->add(a, b, dst, n);
+}
+
+void sub(const value_t* a, const value_t* b, value_t* dst, size_t n) {
+    kernels()->sub(a, b, dst, n);
+}
+
+void mul(const value_t* a, const value_t* b, value_t* dst, size_t n) {
+    kernels()->mul(a, b, dst, n);
+}
+
+void div(const value_t* a, const value_t* b, value_t* dst, size_t n) {
+    kernels()->div(a, b, dst, n);
+}
+
+void eq(const value_t* a, const value_t* b, value_t* dst, size_t n) {
+    kernels()->eq(a, b, dst, n);
+}
+
+void ne(const value_t* a, const value_t* b, value_t* dst, size_t n) {
+    kernels()->ne(a, b, dst, n);
+}
+
+void gt(const value_t* a, const value_t* b, value_t* dst, size_t n) {
+    kernels()->gt(a, b, dst, n);
+}
+
+void lt(const value_t* a, const value_t* b, value_t* dst, size_t n) {
+    kernels()->lt(a, b, dst, n);
+}
+
+void ge(const value_t* a, const value_t* b, value_t* dst, size_t n) {
+    kernels()->ge(a, b, dst, n);
+}
+
+void le(const value_t* a, const value_t* b, value_t* dst, size_t n) {
+    kernels()->le(a, b, dst, n);
+}
+
+void logic_and(const value_t* a, const value_t* b, value_t* dst, size_t n) {
+    kernels()->logic_and(a, b, dst, n);
+}
+
+void logic_or(const value_t* a, const value_t* b, value_t* dst, size_t n) {
+    kernels()->logic_or(a, b, dst, n);
+}
+
+void select(const value_t* cond, const value_t* a, const value_t* b, value_t* dst, size_t n) {
+    kernels()->select(cond, a, b, dst, n);
+}
+
+void abs(const value_t* src, value_t* dst, size_t n) {
+    kernels()->abs(src, dst, n);
+}
+
+void sqrt(const value_t* src, value_t* dst, size_t n) {
+    kernels()->sqrt(src, dst, n);
+}
+
+void floor(const value_t* src, value_t* dst, size_t n) {
+    kernels()->floor(src, dst, n);
+}
+
+void ceil(const value_t* src, value_t* dst, size_t n) {
+    kernels()->ceil(src, dst, n);
+}
+
+void neg(const value_t* src, value_t* dst, size_t n) {
+    kernels()->neg(src, dst, n);
+}
+
+}  // namespace simd
+}  // namespace hku
@@ -0,0 +1,101 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-16
+ *      Author: fasiondog
+ */
+
+#pragma once
+#ifndef INDICATOR_SIMD_KERNEL_H_
+#define INDICATOR_SIMD_KERNEL_H_
+
+#include <cstddef>
+#include "../config.h"
+#include "../utilities/osdef.h"
+
+#ifndef HKU_API
+#define HKU_API
+#endif
+
+namespace hku {
+
+/**
+ * 指标逐元素运算内核
+ * @details 运行时根据 CPU 支持情况选择 AVX2 / SSE2 实现，非 x86_64 平台或定义 HKU_DISABLE_SIMD
+ * 时使用标量实现。各实现的计算结果与对应标量表达式完全一致（含 NaN 的处理），调用者负责
+ * 处理 discard 及对齐，只需传入连续的有效数据区间。
+ */
+namespace simd {
+
+#if HKU_USE_LOW_PRECISION
+typedef float value_t;
+#else
+typedef double value_t;
+#endif
+
+/** 当前使用的指令集: "avx2" | "sse2" | "scalar" */
+HKU_API const char* instructionSet();
+
+/** 启用/关闭 SIMD 实现（关闭后使用标量实现，主要用于对比测试），默认启用 */
+HKU_API void setEnable(bool enable);
+HKU_API bool isEnable();
+
+/** dst[i] = a[i] + b[i] */
+HKU_API void add(const value_t* a, const value_t* b, value_t* dst, size_t n);
+
+/** dst[i] = a[i] - b[i] */
+HKU_API void sub(const value_t* a, const value_t* b, value_t* dst, size_t n);
+
+/** dst[i] = a[i] * b[i] */
+HKU_API void mul(const value_t* a, const value_t* b, value_t* dst, size_t n);
+
+/** dst[i] = a[i] / b[i] */
+HKU_API void div(const value_t* a, const value_t* b, value_t* dst, size_t n);
+
+/** dst[i] = a[i] == b[i] ? 1.0 : 0.0 */
+HKU_API void eq(const value_t* a, const value_t* b, value_t* dst, size_t n);
+
+/** dst[i] = a[i] != b[i] ? 1.0 : 0.0 */
+HKU_API void ne(const value_t* a, const value_t* b, value_t* dst, size_t n);
+
+/** dst[i] = a[i] > b[i] ? 1.0 : 0.0 */
+HKU_API void gt(const value_t* a, const value_t* b, value_t* dst, size_t n);
+
+/** dst[i] = a[i] < b[i] ? 1.0 : 0.0 */
+HKU_API void lt(const value_t* a, const value_t* b, value_t* dst, size_t n);
+
+/** dst[i] = a[i] >= b[i] ? 1.0 : 0.0 */
+HKU_API void ge(const value_t* a, const value_t* b, value_t* dst, size_t n);
+
+/** dst[i] = a[i] <= b[i] ? 1.0 : 0.0 */
+HKU_API void le(const value_t* a, const value_t* b, value_t* dst, size_t n);
+
+/** dst[i] = (a[i] > 0.0) && (b[i] > 0.0) ? 1.0 : 0.0 */
+HKU_API void logic_and(const value_t* a, const value_t* b, value_t* dst, size_t n);
+
+/** dst[i] = (a[i] > 0.0) || (b[i] > 0.0) ? 1.0 : 0.0 */
+HKU_API void logic_or(const value_t* a, const value_t* b, value_t* dst, size_t n);
+
+/** dst[i] = cond[i] > 0.0 ? a[i] : b[i] */
+HKU_API void select(const value_t* cond, const value_t* a, const value_t* b, value_t* dst,
+                    size_t n);
+
+/** dst[i] = std::abs(src[i]) */
+HKU_API void abs(const value_t* src, value_t* dst, size_t n);
+
+/** dst[i] = std::sqrt(src[i]) */
+HKU_API void sqrt(const value_t* src, value_t* dst, size_t n);
+
+/** dst[i] = std::floor(src[i]) */
+HKU_API void floor(const value_t* src, value_t* dst, size_t n);
+
+/** dst[i] = std::ceil(src[i]) */
+HKU_API void ceil(const value_t* src, value_t* dst, size_t n);
+
+/** dst[i] = -src[i] */
+HKU_API void neg(const value_t* src, value_t* dst, size_t n);
+
+}  // namespace simd
+}  // namespace hku
+
+#endif /* INDICATOR_SIMD_KERNEL_H_ */
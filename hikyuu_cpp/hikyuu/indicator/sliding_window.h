@@ -0,0 +1,533 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-16
+ *      Author: fasiondog
+ */
+
+#pragma once
+#ifndef INDICATOR_SLIDING_WINDOW_H_
+#define INDICATOR_SLIDING_WINDOW_H_
+
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace hku {
+
+/**
+ * 增删式累加的重新累加计数
+ * @details Welford、Kahan 等增删式累加每次移出数据都会引入舍入误差，在长序列、数值较大时
+ * 误差持续累积。移出的数据量达到窗口长度时重新累加当前窗口，误差只与窗口长度有关，
+ * 整体仍为 O(n)。
+ */
+class RebuildCounter {
+public:
+    void clear() {
+        m_removed = 0;
+    }
+
+    /** 记录一次移出，返回当前长度为 n 的窗口是否需要重新累加 */
+    bool remove(size_t n) {
+        if (++m_removed < n) {
+            return false;
+        }
+        m_removed = 0;
+        return true;
+    }
+
+private:
+    size_t m_removed{0};
+};
+
+/**
+ * 滑动窗口区间维护
+ * @details 记录当前窗口 [start, end)，移动至新窗口时仅对移出、移入的位置调用 remove/add。
+ * 窗口起点或终点后退（如动态参数突然变大）时，调用 reset 后重新累加，否则每个位置最多
+ * 被加入、移出各一次，整体为 O(n)。
+ * rebuild 为 true 时，移出的数据量达到窗口长度后调用 reset 并重新累加当前窗口，
+ * 用于增删式累加消除累积的舍入误差（@see RebuildCounter）。
+ */
+class SlidingWindow {
+public:
+    explicit SlidingWindow(bool rebuild) : m_rebuild(rebuild) {}
+
+    size_t start() const {
+        return m_start;
+    }
+
+    size_t end() const {
+        return m_end;
+    }
+
+    size_t size() const {
+        return m_end - m_start;
+    }
+
+    void clear() {
+        m_start = 0;
+        m_end = 0;
+        m_counter.clear();
+    }
+
+    /**
+     * 移动至新窗口 [start, end)
+     * @param start 新窗口起点
+     * @param end 新窗口终点（不含）
+     * @param add void(size_t pos) 位置 pos 移入窗口
+     * @param remove void(size_t pos) 位置 pos 移出窗口
+     * @param reset void() 清空窗口
+     */
+    template <typename AddFunc, typename RemoveFunc, typename ResetFunc>
+    void moveTo(size_t start, size_t end, AddFunc&& add, RemoveFunc&& remove, ResetFunc&& reset) {
+        if (start < m_start || end < m_end || start >= m_end) {
+            reset();
+            m_start = start;
+            m_end = start;
+            m_counter.clear();
+        }
+
+        bool need_rebuild = false;
+        for (; m_start < start; m_start++) {
+            remove(m_start);
+            if (m_rebuild && m_counter.remove(end - start)) {
+                need_rebuild = true;
+            }
+        }
+
+        if (need_rebuild) {
+            reset();
+            m_end = m_start;
+        }
+        for (; m_end < end; m_end++) {
+            add(m_end);
+        }
+    }
+
+private:
+    size_t m_start{0};
+    size_t m_end{0};
+    bool m_rebuild;
+    RebuildCounter m_counter;
+};
+
+/**
+ * 单调队列，用于 O(1) 获取滑动窗口内的最大（最小）值及其位置
+ * @details Compare 为 std::less_equal 时求最大值，std::greater_equal 时求最小值；
+ * 相同值保留最后出现的位置。NaN 值不加入队列。
+ */
+template <typename ValueT, typename Compare>
+class MonotonicQueue {
+public:
+    void clear() {
+        m_items.clear();
+        m_head = 0;
+    }
+
+    bool empty() const {
+        return m_head >= m_items.size();
+    }
+
+    /** 加入新值，位置需递增 */
+    void push(size_t pos, ValueT value) {
+        if (std::isnan(value)) {
+            return;
+        }
+        while (!empty() && m_cmp(m_items.back().value, value)) {
+            m_items.pop_back();
+        }
+        m_items.push_back(Item{pos, value});
+    }
+
+    /** 移除位置小于 start 的值 */
+    void popBefore(size_t start) {
+        while (!empty() && m_items[m_head].pos < start) {
+            m_head++;
+        }
+        if (m_head > 64 && m_head * 2 > m_items.size()) {
+            m_items.erase(m_items.begin(), m_items.begin() + m_head);
+            m_head = 0;
+        }
+    }
+
+    /** 窗口内的极值位置，调用者需保证非空 */
+    size_t pos() const {
+        return m_items[m_head].pos;
+    }
+
+    /** 窗口内的极值，调用者需保证非空 */
+    ValueT value() const {
+        return m_items[m_head].value;
+    }
+
+private:
+    struct Item {
+        size_t pos;
+        ValueT value;
+    };
+
+    std::vector<Item> m_items;
+    size_t m_head{0};
+    Compare m_cmp;
+};
+
+template <typename ValueT>
+using MaxQueue = MonotonicQueue<ValueT, std::less_equal<ValueT>>;
+
+template <typename ValueT>
+using MinQueue = MonotonicQueue<ValueT, std::greater_equal<ValueT>>;
+
+/**
+ * 可增删的 Kahan 补偿求和，窗口中存在 NaN 时结果为 NaN
+ */
+class RollingSum {
+public:
+    void clear() {
+        m_sum = 0.0;
+        m_c = 0.0;
+        m_nan = 0;
+    }
+
+    void add(double x) {
+        if (std::isnan(x)) {
+            m_nan++;
+        } else {
+            _accumulate(x);
+        }
+    }
+
+    void remove(double x) {
+        if (std::isnan(x)) {
+            m_nan--;
+        } else {
+            _accumulate(-x);
+        }
+    }
+
+    double value() const {
+        return m_nan > 0 ? std::nan("") : m_sum;
+    }
+
+private:
+    void _accumulate(double x) {
+        double y = x - m_c;
+        double t = m_sum + y;
+        m_c = (t - m_sum) - y;
+        m_sum = t;
+    }
+
+private:
+    double m_sum{0.0};
+    double m_c{0.0};
+    size_t m_nan{0};
+};
+
+/**
+ * 可增删的非零值计数器（NaN 视为非零）
+ */
+class RollingCount {
+public:
+    void clear() {
+        m_count = 0;
+    }
+
+    void add(double x) {
+        if (x != 0.0) {
+            m_count++;
+        }
+    }
+
+    void remove(double x) {
+        if (x != 0.0) {
+            m_count--;
+        }
+    }
+
+    size_t value() const {
+        return m_count;
+    }
+
+private:
+    size_t m_count{0};
+};
+
+/**
+ * 可增删的 Welford 均值/方差累加器
+ * @details NaN 值单独计数，不参与计算，由调用者决定如何处理
+ */
+class RollingMoments {
+public:
+    void clear() {
+        m_n = 0;
+        m_nan = 0;
+        m_mean = 0.0;
+        m_m2 = 0.0;
+    }
+
+    void add(double x) {
+        if (std::isnan(x)) {
+            m_nan++;
+            return;
+        }
+        m_n++;
+        double delta = x - m_mean;
+        m_mean += delta / m_n;
+        m_m2 += delta * (x - m_mean);
+    }
+
+    void remove(double x) {
+        if (std::isnan(x)) {
+            m_nan--;
+            return;
+        }
+        if (m_n <= 1) {
+            m_n = 0;
+            m_mean = 0.0;
+            m_m2 = 0.0;
+            return;
+        }
+        m_n--;
+        double delta = x - m_mean;
+        m_mean -= delta / m_n;
+        m_m2 -= delta * (x - m_mean);
+    }
+
+    /** 非 NaN 值的数量 */
+    size_t count() const {
+        return m_n;
+    }
+
+    /** NaN 值的数量 */
+    size_t nanCount() const {
+        return m_nan;
+    }
+
+    double mean() const {
+        return m_mean;
+    }
+
+    /** 离差平方和 */
+    double m2() const {
+        return m_m2 > 0.0 ? m_m2 : 0.0;
+    }
+
+    /** 样本方差，需 count() > 1 */
+    double var() const {
+        return m2() / (m_n - 1);
+    }
+
+    /** 总体方差，需 count() > 0 */
+    double varp() const {
+        return m2() / m_n;
+    }
+
+private:
+    size_t m_n{0};
+    size_t m_nan{0};
+    double m_mean{0.0};
+    double m_m2{0.0};
+};
+
+/**
+ * 可增删的 Welford 协方差累加器，用于相关系数、线性回归斜率
+ * @details 任一值为 NaN 的数据对单独计数，不参与计算
+ */
+class RollingCovariance {
+public:
+    void clear() {
+        m_n = 0;
+        m_nan = 0;
+        m_mean_x = 0.0;
+        m_mean_y = 0.0;
+        m_m2_x = 0.0;
+        m_m2_y = 0.0;
+        m_cxy = 0.0;
+    }
+
+    void add(double x, double y) {
+        if (std::isnan(x) || std::isnan(y)) {
+            m_nan++;
+            return;
+        }
+        m_n++;
+        double dx = x - m_mean_x;
+        double dy = y - m_mean_y;
+        m_mean_x += dx / m_n;
+        m_mean_y += dy / m_n;
+        m_m2_x += dx * (x - m_mean_x);
+        m_m2_y += dy * (y - m_mean_y);
+        m_cxy += dx * (y - m_mean_y);
+    }
+
+    void remove(double x, double y) {
+        if (std::isnan(x) || std::isnan(y)) {
+            m_nan--;
+            return;
+        }
+        if (m_n <= 1) {
+            size_t nan = m_nan;
+            clear();
+            m_nan = nan;
+            return;
+        }
+        m_n--;
+        double dx = x - m_mean_x;
+        double dy = y - m_mean_y;
+        m_mean_x -= dx / m_n;
+        m_mean_y -= dy / m_n;
+        m_m2_x -= dx * (x - m_mean_x);
+        m_m2_y -= dy * (y - m_mean_y);
+        m_cxy -= dx * (y - m_mean_y);
+    }
+
+    size_t count() const {
+        return m_n;
+    }
+
+    size_t nanCount() const {
+        return m_nan;
+    }
+
+    /** x 的离差平方和 */
+    double m2x() const {
+        return m_m2_x > 0.0 ? m_m2_x : 0.0;
+    }
+
+    /** y 的离差平方和 */
+    double m2y() const {
+        return m_m2_y > 0.0 ? m_m2_y : 0.0;
+    }
+
+    /** 离差乘积和 */
+    double cxy() const {
+        return m_cxy;
+    }
+
+    /** 样本协方差，需 count() > 1 */
+    double cov() const {
+        return m_cxy / (m_n - 1);
+    }
+
+    /** 相关系数 */
+    double corr() const {
+        return m_cxy / std::sqrt(m2x() * m2y());
+    }
+
+    /** y 对 x 的线性回归斜率 */
+    double slope() const {
+        return m_cxy / m2x();
+    }
+
+private:
+    size_t m_n{0};
+    size_t m_nan{0};
+    double m_mean_x{0.0};
+    double m_mean_y{0.0};
+    double m_m2_x{0.0};
+    double m_m2_y{0.0};
+    double m_cxy{0.0};
+};
+
+/**
+ * 依次计算 [first, total) 各位置 i 在窗口 [max(first, i + 1 - n), i] 内的极值
+ * @param src 源数据
+ * @param first 起始位置
+ * @param total 数据总数
+ * @param n 窗口长度，为 0 时窗口为 [first, i]
+ * @param func void(size_t i, const Queue& queue) 输出位置 i 的结果，queue 可能为空
+ */
+template <typename Queue, typename ValueT, typename Func>
+void rolling_extremum(const ValueT* src, size_t first, size_t total, size_t n, Func&& func) {
+    Queue queue;
+    for (size_t i = first; i < total; i++) {
+        queue.push(i, src[i]);
+        if (n > 0 && i >= first + n) {
+            queue.popBefore(i + 1 - n);
+        }
+        func(i, queue);
+    }
+}
+
+/**
+ * 依次计算 [first, last) 各位置 i 在窗口 [window_start(i), i] 内的极值，窗口长度可变
+ * @param src 源数据
+ * @param first 起始位置
+ * @param last 结束位置（不含）
+ * @param window_start bool(size_t i, size_t& start) 获取位置 i 的窗口起点，返回 false 时跳过该位置
+ * @param func void(size_t i, const Queue& queue) 输出位置 i 的结果，queue 可能为空
+ */
+template <typename Queue, typename ValueT, typename StartFunc, typename Func>
+void dyn_rolling_extremum(const ValueT* src, size_t first, size_t last, StartFunc&& window_start,
+                          Func&& func) {
+    // 单调队列的结果是精确的，无需重新累加
+    Queue queue;
+    SlidingWindow window(false);
+    size_t start = 0;
+    for (size_t i = first; i < last; i++) {
+        if (!window_start(i, start)) {
+            continue;
+        }
+        window.moveTo(
+          start, i + 1, [&](size_t pos) { queue.push(pos, src[pos]); }, [](size_t) {},
+          [&]() { queue.clear(); });
+        queue.popBefore(start);
+        func(i, queue);
+    }
+}
+
+/**
+ * 依次计算 [first, total) 各位置 i 在窗口 [max(first, i + 1 - n), i] 内的累加结果
+ * @param src 源数据
+ * @param first 起始位置
+ * @param total 数据总数
+ * @param n 窗口长度，为 0 时窗口为 [first, i]
+ * @param func void(size_t i, const Accumulator& acc) 输出位置 i 的结果
+ */
+template <typename Accumulator, typename ValueT, typename Func>
+void rolling_accumulate(const ValueT* src, size_t first, size_t total, size_t n, Func&& func) {
+    Accumulator acc;
+    RebuildCounter counter;
+    for (size_t i = first; i < total; i++) {
+        acc.add(src[i]);
+        if (n > 0 && i >= first + n) {
+            acc.remove(src[i - n]);
+            if (counter.remove(n)) {
+                acc.clear();
+                for (size_t j = i + 1 - n; j <= i; j++) {
+                    acc.add(src[j]);
+                }
+            }
+        }
+        func(i, acc);
+    }
+}
+
+/**
+ * 依次计算 [first, last) 各位置 i 在窗口 [window_start(i), i] 内的累加结果，窗口长度可变
+ * @param src 源数据
+ * @param first 起始位置
+ * @param last 结束位置（不含）
+ * @param window_start bool(size_t i, size_t& start) 获取位置 i 的窗口起点，返回 false 时跳过该位置
+ * @param func void(size_t i, const Accumulator& acc) 输出位置 i 的结果
+ */
+template <typename Accumulator, typename ValueT, typename StartFunc, typename Func>
+void dyn_rolling_accumulate(const ValueT* src, size_t first, size_t last, StartFunc&& window_start,
+                            Func&& func) {
+    Accumulator acc;
+    SlidingWindow window(true);
+    size_t start = 0;
+    for (size_t i = first; i < last; i++) {
+        if (!window_start(i, start)) {
+            continue;
+        }
+        window.moveTo(
+          start, i + 1, [&](size_t pos) { acc.add(src[pos]); },
+          [&](size_t pos) { acc.remove(src[pos]); }, [&]() { acc.clear(); });
+        func(i, acc);
+    }
+}
+
+}  // namespace hku
+
+#endif /* INDICATOR_SLIDING_WINDOW_H_ */
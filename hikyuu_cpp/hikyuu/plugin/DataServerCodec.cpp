@@ -0,0 +1,302 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-16
+ *      Author: fasiondog
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <boost/endian/conversion.hpp>
+#include "hikyuu/utilities/datetime/CompactDatetime.h"
+#include "DataServerCodec.h"
+
+namespace hku {
+
+namespace {
+
+constexpr uint32_t KRECORD_BLOCK_MAGIC = 0x4b554b48;  // "HKUK"
+constexpr uint32_t SPOT_BLOCK_MAGIC = 0x53554b48;     // "HKUS"
+constexpr uint16_t BLOCK_VERSION = 1;
+constexpr size_t BLOCK_HEADER_SIZE = 12;
+constexpr size_t KRECORD_BYTES = sizeof(int64_t) + 6 * sizeof(double);
+constexpr size_t SPOT_BYTES = sizeof(int64_t) + 7 * sizeof(double) + 2 * sizeof(uint8_t);
+
+/** 数据块固定为小端字节序，大端主机在读写时逐个数值翻转字节 */
+template <typename T>
+inline void copyLittleEndian(void* dst, const void* src) {
+    std::memcpy(dst, src, sizeof(T));
+    if constexpr (boost::endian::order::native != boost::endian::order::little) {
+        uint8_t* p = static_cast<uint8_t*>(dst);
+        std::reverse(p, p + sizeof(T));
+    }
+}
+
+/** 按已计算好的长度顺序写入数据块 */
+class BlockWriter {
+public:
+    explicit BlockWriter(uint8_t* p) : m_p(p) {}
+
+    template <typename T>
+    void put(T value) {
+        copyLittleEndian<T>(m_p, &value);
+        m_p += sizeof(T);
+    }
+
+    void put(const string& s) {
+        put(uint16_t(s.size()));
+        std::memcpy(m_p, s.data(), s.size());
+        m_p += s.size();
+    }
+
+    void putHeader(uint32_t magic, uint32_t count) {
+        put(magic);
+        put(BLOCK_VERSION);
+        put(uint16_t(0));
+        put(count);
+    }
+
+private:
+    uint8_t* m_p;
+};
+
+/** 顺序读取数据块，长度不足时抛出异常 */
+class BlockReader {
+public:
+    BlockReader(const uint8_t* data, size_t len) : m_p(data), m_end(data + len) {}
+
+    template <typename T>
+    T get() {
+        T value;
+        copyLittleEndian<T>(&value, take(sizeof(T)));
+        return value;
+    }
+
+    string getString() {
+        uint16_t len = get<uint16_t>();
+        const uint8_t* p = take(len);
+        return string((const char*)p, len);
+    }
+
+    /** 读取 n 字节并返回其起始地址 */
+    const uint8_t* take(size_t n) {
+        HKU_CHECK(size_t(m_end - m_p) >= n, "Invalid data block, insufficient length!");
+        const uint8_t* p = m_p;
+        m_p += n;
+        return p;
+    }
+
+    uint32_t getHeader(uint32_t magic) {
+        HKU_CHECK(get<uint32_t>() == magic, "Invalid data block, mismatched magic!");
+        uint16_t version = get<uint16_t>();
+        HKU_CHECK(version == BLOCK_VERSION, "Unsupported data block version: {}", version);
+        get<uint16_t>();
+        return get<uint32_t>();
+    }
+
+private:
+    const uint8_t* m_p;
+    const uint8_t* m_end;
+};
+
+/** 读取列中第 i 个元素，列数据不保证对齐 */
+template <typename T>
+inline T load(const uint8_t* column, size_t i) {
+    T value;
+    copyLittleEndian<T>(&value, column + i * sizeof(T));
+    return value;
+}
+
+}  // namespace
+
+void HKU_API encodeKRecordBlock(const MarketKRecordList& data, vector<uint8_t>& out) {
+    out.clear();
+    size_t total = BLOCK_HEADER_SIZE;
+    for (const auto& item : data) {
+        HKU_CHECK(item.first.size() <= UINT16_MAX, "Invalid market code: {}", item.first);
+        total += sizeof(uint16_t) + item.first.size() + sizeof(uint32_t) +
+                 item.second.size() * KRECORD_BYTES;
+    }
+    out.resize(total);
+
+    BlockWriter writer(out.data());
+    writer.putHeader(KRECORD_BLOCK_MAGIC, uint32_t(data.size()));
+    for (const auto& item : data) {
+        const KRecordList& ks = item.second;
+        writer.put(item.first);
+        writer.put(uint32_t(ks.size()));
+        for (const auto& k : ks) {
+            writer.put(CompactDatetime(k.datetime).ticks());
+        }
+        for (const auto& k : ks) {
+            writer.put(double(k.openPrice));
+        }
+        for (const auto& k : ks) {
+            writer.put(double(k.highPrice));
+        }
+        for (const auto& k : ks) {
+            writer.put(double(k.lowPrice));
+        }
+        for (const auto& k : ks) {
+            writer.put(double(k.closePrice));
+        }
+        for (const auto& k : ks) {
+            writer.put(double(k.transAmount));
+        }
+        for (const auto& k : ks) {
+            writer.put(double(k.transCount));
+        }
+    }
+}
+
+void HKU_API decodeKRecordBlock(const uint8_t* data, size_t len, MarketKRecordList& out) {
+    out.clear();
+    BlockReader reader(data, len);
+    uint32_t stock_count = reader.getHeader(KRECORD_BLOCK_MAGIC);
+    out.reserve(stock_count);
+    for (uint32_t s = 0; s < stock_count; s++) {
+        string market_code = reader.getString();
+        size_t n = reader.get<uint32_t>();
+        const uint8_t* p = reader.take(n * KRECORD_BYTES);
+        const uint8_t* dates = p;
+        const uint8_t* open = dates + n * sizeof(int64_t);
+        const uint8_t* high = open + n * sizeof(double);
+        const uint8_t* low = high + n * sizeof(double);
+        const uint8_t* close = low + n * sizeof(double);
+        const uint8_t* amount = close + n * sizeof(double);
+        const uint8_t* volume = amount + n * sizeof(double);
+
+        KRecordList ks(n);
+        for (size_t i = 0; i < n; i++) {
+            KRecord& k = ks[i];
+            k.datetime = CompactDatetime::fromTicks(load<int64_t>(dates, i)).datetime();
+            k.openPrice = load<double>(open, i);
+            k.highPrice = load<double>(high, i);
+            k.lowPrice = load<double>(low, i);
+            k.closePrice = load<double>(close, i);
+            k.transAmount = load<double>(amount, i);
+            k.transCount = load<double>(volume, i);
+        }
+        out.emplace_back(std::move(market_code), std::move(ks));
+    }
+}
+
+void HKU_API encodeSpotBlock(const vector<SpotRecord>& spots, vector<uint8_t>& out) {
+    out.clear();
+    size_t bid_total = 0, ask_total = 0;
+    for (const auto& spot : spots) {
+        HKU_CHECK(spot.bid.size() <= UINT8_MAX && spot.bid.size() == spot.bid_amount.size() &&
+                    spot.ask.size() <= UINT8_MAX && spot.ask.size() == spot.ask_amount.size(),
+                  "Invalid bid/ask of spot {}{} {}", spot.market, spot.code, spot.datetime);
+        bid_total += spot.bid.size();
+        ask_total += spot.ask.size();
+    }
+    out.resize(BLOCK_HEADER_SIZE + spots.size() * SPOT_BYTES +
+               2 * (bid_total + ask_total) * sizeof(double));
+
+    BlockWriter writer(out.data());
+    writer.putHeader(SPOT_BLOCK_MAGIC, uint32_t(spots.size()));
+    for (const auto& spot : spots) {
+        writer.put(CompactDatetime(spot.datetime).ticks());
+    }
+    for (const auto& spot : spots) {
+        writer.put(double(spot.yesterday_close));
+    }
+    for (const auto& spot : spots) {
+        writer.put(double(spot.open));
+    }
+    for (const auto& spot : spots) {
+        writer.put(double(spot.high));
+    }
+    for (const auto& spot : spots) {
+        writer.put(double(spot.low));
+    }
+    for (const auto& spot : spots) {
+        writer.put(double(spot.close));
+    }
+    for (const auto& spot : spots) {
+        writer.put(double(spot.amount));
+    }
+    for (const auto& spot : spots) {
+        writer.put(double(spot.volume));
+    }
+    for (const auto& spot : spots) {
+        writer.put(uint8_t(spot.bid.size()));
+    }
+    for (const auto& spot : spots) {
+        writer.put(uint8_t(spot.ask.size()));
+    }
+    for (const auto& spot : spots) {
+        for (auto v : spot.bid) {
+            writer.put(double(v));
+        }
+    }
+    for (const auto& spot : spots) {
+        for (auto v : spot.bid_amount) {
+            writer.put(double(v));
+        }
+    }
+    for (const auto& spot : spots) {
+        for (auto v : spot.ask) {
+            writer.put(double(v));
+        }
+    }
+    for (const auto& spot : spots) {
+        for (auto v : spot.ask_amount) {
+            writer.put(double(v));
+        }
+    }
+}
+
+void HKU_API decodeSpotBlock(const uint8_t* data, size_t len, const string& market,
+                             const string& code, vector<SpotRecord>& out) {
+    out.clear();
+    BlockReader reader(data, len);
+    size_t n = reader.getHeader(SPOT_BLOCK_MAGIC);
+    const uint8_t* dates = reader.take(n * sizeof(int64_t));
+    const uint8_t* prices = reader.take(n * 7 * sizeof(double));
+    const uint8_t* bid_levels = reader.take(n);
+    const uint8_t* ask_levels = reader.take(n);
+
+    size_t bid_total = 0, ask_total = 0;
+    for (size_t i = 0; i < n; i++) {
+        bid_total += bid_levels[i];
+        ask_total += ask_levels[i];
+    }
+    const uint8_t* bid = reader.take(bid_total * sizeof(double));
+    const uint8_t* bid_amount = reader.take(bid_total * sizeof(double));
+    const uint8_t* ask = reader.take(ask_total * sizeof(double));
+    const uint8_t* ask_amount = reader.take(ask_total * sizeof(double));
+
+    out.resize(n);
+    size_t bid_pos = 0, ask_pos = 0;
+    for (size_t i = 0; i < n; i++) {
+        SpotRecord& spot = out[i];
+        spot.market = market;
+        spot.code = code;
+        spot.datetime = CompactDatetime::fromTicks(load<int64_t>(dates, i)).datetime();
+        spot.yesterday_close = load<double>(prices, i);
+        spot.open = load<double>(prices, n + i);
+        spot.high = load<double>(prices, 2 * n + i);
+        spot.low = load<double>(prices, 3 * n + i);
+        spot.close = load<double>(prices, 4 * n + i);
+        spot.amount = load<double>(prices, 5 * n + i);
+        spot.volume = load<double>(prices, 6 * n + i);
+
+        spot.bid.resize(bid_levels[i]);
+        spot.bid_amount.resize(bid_levels[i]);
+        for (size_t j = 0; j < bid_levels[i]; j++, bid_pos++) {
+            spot.bid[j] = load<double>(bid, bid_pos);
+            spot.bid_amount[j] = load<double>(bid_amount, bid_pos);
+        }
+
+        spot.ask.resize(ask_levels[i]);
+        spot.ask_amount.resize(ask_levels[i]);
+        for (size_t j = 0; j < ask_levels[i]; j++, ask_pos++) {
+            spot.ask[j] = load<double>(ask, ask_pos);
+            spot.ask_amount[j] = load<double>(ask_amount, ask_pos);
+        }
+    }
+}
+
+}  // namespace hku
@@ -0,0 +1,83 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-16
+ *      Author: fasiondog
+ */
+
+#pragma once
+
+#include "hikyuu/DataType.h"
+#include "hikyuu/KRecord.h"
+#include "hikyuu/global/SpotRecord.h"
+
+namespace hku {
+
+/**
+ * dataserver 缓存服务二进制列式数据格式名称
+ * @details
+ * <pre>
+ * 客户端在 market/tick 请求中附带 "format": "columnar"，支持该格式的服务端在响应中返回
+ * "format": "columnar"，"data" 为 msgpack 二进制块（json::binary）；
+ * 否则仍按原 json 数组格式返回，客户端按响应中的 format 字段选择解码方式。
+ * </pre>
+ */
+#define HKU_DATASERVER_COLUMNAR_FORMAT "columnar"
+
+/*
+ * 二进制块均为小端字节序（大端主机编解码时转换），日期为距 1970-01-01 00:00:00 的微秒数
+ * （int64，Null 为 int64 最大值）
+ *
+ * K线数据块（market 命令）:
+ *   uint32 magic('HKUK') | uint16 version | uint16 reserved | uint32 证券数
+ *   每只证券: uint16 代码长度 | 代码 | uint32 记录数 n |
+ *             int64 datetime[n] | double open[n] | high[n] | low[n] | close[n] |
+ *             amount[n] | volume[n]
+ *
+ * spot 数据块（tick 命令，同一证券）:
+ *   uint32 magic('HKUS') | uint16 version | uint16 reserved | uint32 记录数 n |
+ *   int64 datetime[n] | double yesterday_close[n] | open[n] | high[n] | low[n] | close[n] |
+ *   amount[n] | volume[n] | uint8 委买档数[n] | uint8 委卖档数[n] |
+ *   double bid[委买总档数] | bid_amount[委买总档数] | ask[委卖总档数] | ask_amount[委卖总档数]
+ */
+
+/** 以市场代码（如 SH600000）标识的K线数据，用于二进制列式编解码 */
+typedef vector<std::pair<string, KRecordList>> MarketKRecordList;
+
+/**
+ * 将各证券K线数据编码为二进制列式数据块
+ * @param data 各证券K线数据
+ * @param out [out] 输出数据块，将先被清空
+ */
+void HKU_API encodeKRecordBlock(const MarketKRecordList& data, vector<uint8_t>& out);
+
+/**
+ * 解码二进制列式K线数据块
+ * @param data 数据块
+ * @param len 数据块长度
+ * @param out [out] 解码结果，将先被清空
+ * @exception 数据块格式错误或长度不足时抛出异常
+ */
+void HKU_API decodeKRecordBlock(const uint8_t* data, size_t len, MarketKRecordList& out);
+
+/**
+ * 将同一证券的 spot 数据编码为二进制列式数据块，不包含市场、代码及名称
+ * @param spots spot 数据
+ * @param out [out] 输出数据块，将先被清空
+ * @exception 委买/委卖档数超过 255 时抛出异常
+ */
+void HKU_API encodeSpotBlock(const vector<SpotRecord>& spots, vector<uint8_t>& out);
+
+/**
+ * 解码二进制列式 spot 数据块
+ * @param data 数据块
+ * @param len 数据块长度
+ * @param market 填入 spot 的市场标识
+ * @param code 填入 spot 的证券代码
+ * @param out [out] 解码结果，将先被清空
+ * @exception 数据块格式错误或长度不足时抛出异常
+ */
+void HKU_API decodeSpotBlock(const uint8_t* data, size_t len, const string& market,
+                             const string& code, vector<SpotRecord>& out);
+
+}  // namespace hku
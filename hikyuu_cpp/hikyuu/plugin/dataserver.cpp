@@ -7,10 +7,22 @@
 
 #include "hikyuu/utilities/node/NodeClient.h"
 #include "interface/plugins.h"
+#include "DataServerCodec.h"
 #include "dataserver.h"
 
 namespace hku {
 
+/** 服务端是否按二进制列式格式返回数据，不支持该格式的服务端仍返回 json 数组 */
+static bool isColumnarResponse(const json& res) {
+    auto iter = res.find("format");
+    if (iter == res.end() || !iter->is_string() ||
+        iter->get<string>() != HKU_DATASERVER_COLUMNAR_FORMAT) {
+        return false;
+    }
+    auto data = res.find("data");
+    return data != res.end() && data->is_binary();
+}
+
 void HKU_API startDataServer(const std::string& addr, size_t work_num, bool save_tick,
                              bool buf_tick) {
     auto& sm = StockManager::instance();
@@ -41,6 +53,7 @@ void HKU_API getDataFromBufferServer(const std::string& addr, const StockList& s
         json req;
         req["cmd"] = "market";
         req["ktype"] = ktype;
+        req["format"] = HKU_DATASERVER_COLUMNAR_FORMAT;
         json code_list;
         json date_list;
         for (const auto& stk : stklist) {
@@ -63,8 +76,26 @@ void HKU_API getDataFromBufferServer(const std::string& addr, const StockList& s
                             "Recieved error: {}, msg: {}", res["ret"].get<int>(),
                             res["msg"].get<string>());
 
+        vector<std::pair<Stock, KRecordList>> updates;
+        if (isColumnarResponse(res)) {
+            // 二进制列式数据直接解码至 KRecordList
+            const auto& bin = res["data"].get_binary();
+            MarketKRecordList data;
+            decodeKRecordBlock(bin.data(), bin.size(), data);
+            updates.reserve(data.size());
+            for (auto& item : data) {
+                Stock stk = getStock(item.first);
+                if (!stk.isNull()) {
+                    updates.emplace_back(std::move(stk), std::move(item.second));
+                }
+            }
+            StockManager::instance().realtimeUpdate(updates, ktype);
+            return;
+        }
+
         const auto& jdata = res["data"];
         // HKU_INFO("{}", to_string(jdata));
+        updates.reserve(jdata.size());
         for (auto iter = jdata.cbegin(); iter != jdata.cend(); ++iter) {
             const auto& r = *iter;
             try {
@@ -75,17 +106,23 @@ void HKU_API getDataFromBufferServer(const std::string& addr, const StockList& s
                 }
 
                 const auto& jklist = r["data"];
+                KRecordList klist;
+                klist.reserve(jklist.size());
                 for (auto kiter = jklist.cbegin(); kiter != jklist.cend(); ++kiter) {
                     const auto& k = *kiter;
-                    KRecord kr(Datetime(k[0].get<string>()), k[1], k[2], k[3], k[4], k[5], k[6]);
-                    stk.realtimeUpdate(kr, ktype);
+                    klist.emplace_back(Datetime(k[0].get<string>()), k[1], k[2], k[3], k[4], k[5],
+                                       k[6]);
                 }
+                updates.emplace_back(std::move(stk), std::move(klist));
 
             } catch (const std::exception& e) {
                 HKU_ERROR("Failed decode json: {}! {}", to_string(r), e.what());
             }
         }
 
+        // 各证券批量合并至缓存
+        StockManager::instance().realtimeUpdate(updates, ktype);
+
     } catch (const std::exception& e) {
         HKU_ERROR("Failed get data from buffer server! {}", e.what());
     } catch (...) {
@@ -106,6 +143,7 @@ vector<SpotRecord> HKU_API getSpotFromBufferServer(const std::string& addr,
         req["market"] = market;
         req["code"] = code;
         req["datetime"] = datetime.str();
+        req["format"] = HKU_DATASERVER_COLUMNAR_FORMAT;
 
         json res;
         client.post(req, res);
@@ -113,8 +151,15 @@ vector<SpotRecord> HKU_API getSpotFromBufferServer(const std::string& addr,
                             "Recieved error: {}, msg: {}", res["ret"].get<int>(),
                             res["msg"].get<string>());
 
+        if (isColumnarResponse(res)) {
+            const auto& bin = res["data"].get_binary();
+            decodeSpotBlock(bin.data(), bin.size(), market, code, ret);
+            return ret;
+        }
+
         const auto& jdata = res["data"];
         // HKU_INFO("{}", to_string(jdata));
+        ret.reserve(jdata.size());
         for (auto iter = jdata.cbegin(); iter != jdata.cend(); ++iter) {
             const auto& r = *iter;
             try {
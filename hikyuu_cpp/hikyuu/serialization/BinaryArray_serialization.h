@@ -0,0 +1,206 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-16
+ *      Author: fasiondog
+ */
+
+#pragma once
+#ifndef BINARY_ARRAY_SERIALIZATION_H_
+#define BINARY_ARRAY_SERIALIZATION_H_
+
+#include "../config.h"
+#include "../DataType.h"
+#include "PriceList_serialization.h"
+
+#if HKU_SUPPORT_SERIALIZATION
+#include <boost/serialization/access.hpp>
+#include <boost/serialization/split_member.hpp>
+#include <boost/serialization/wrapper.hpp>
+
+namespace hku {
+
+/**
+ * 设置二进制归档中的浮点数组是否压缩，默认不压缩
+ * @note 仅在编译时启用 zip 支持（http_client_zip）时生效，否则忽略
+ */
+void HKU_API setBinaryArrayCompress(bool compress);
+
+/** 二进制归档中的浮点数组当前是否压缩 */
+bool HKU_API isBinaryArrayCompress();
+
+/** 是否为二进制归档，二进制归档中的数组按连续内存整体读写 */
+template <class Archive>
+struct is_binary_archive : std::false_type {};
+
+#if HKU_SUPPORT_BINARY_ARCHIVE
+template <>
+struct is_binary_archive<boost::archive::binary_oarchive> : std::true_type {};
+
+template <>
+struct is_binary_archive<boost::archive::binary_iarchive> : std::true_type {};
+#endif
+
+/**
+ * 将连续的非空值编码（按字节重排后压缩）
+ * @param src 数据
+ * @param bytes 数据字节数
+ * @param elem_size 单个元素的字节数
+ * @param out 输出编码后的数据
+ * @return 是否已压缩，未启用压缩或压缩无收益时返回 false，此时 out 为空
+ */
+bool HKU_API encodeBinaryArray(const char* src, size_t bytes, size_t elem_size, string& out);
+
+/** 解码 encodeBinaryArray 压缩后的数据至 dst，dst 须有 bytes 字节 */
+void HKU_API decodeBinaryArray(const char* src, size_t len, size_t elem_size, char* dst,
+                               size_t bytes);
+
+/**
+ * 以二进制方式写入浮点数组
+ * @details
+ * <pre>
+ * 格式: 总数, 空值数, 是否压缩, [空值位图], 非空值(连续存放或压缩后的长度及数据)
+ * 空值（NaN）仅记录于位图中，指标前端抛弃的部分不占用空间；inf 按原值保存
+ * </pre>
+ */
+template <class Archive, typename T>
+void saveBinaryArray(Archive& ar, const T* data, size_t count) {
+    static_assert(std::is_floating_point<T>::value, "Only support float array!");
+    uint64_t total = count;
+    uint64_t null_count = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (std::isnan(data[i])) {
+            null_count++;
+        }
+    }
+
+    std::vector<uint8_t> bitmap;
+    std::vector<T> packed;
+    const T* values = data;
+    if (null_count > 0) {
+        bitmap.resize((count + 7) / 8, 0);
+        packed.reserve(count - null_count);
+        for (size_t i = 0; i < count; i++) {
+            if (std::isnan(data[i])) {
+                bitmap[i >> 3] |= uint8_t(1) << (i & 7);
+            } else {
+                packed.push_back(data[i]);
+            }
+        }
+        values = packed.data();
+    }
+
+    string compressed;
+    size_t bytes = (count - null_count) * sizeof(T);
+    bool is_compress = encodeBinaryArray((const char*)values, bytes, sizeof(T), compressed);
+    ar << total << null_count << is_compress;
+    if (null_count > 0) {
+        ar.save_binary(bitmap.data(), bitmap.size());
+    }
+    if (is_compress) {
+        uint64_t len = compressed.size();
+        ar << len;
+        ar.save_binary(compressed.data(), compressed.size());
+    } else if (bytes > 0) {
+        ar.save_binary(values, bytes);
+    }
+}
+
+/** 读取 saveBinaryArray 写入的浮点数组 */
+template <class Archive, typename T>
+void loadBinaryArray(Archive& ar, std::vector<T>& values) {
+    static_assert(std::is_floating_point<T>::value, "Only support float array!");
+    uint64_t total = 0, null_count = 0;
+    bool is_compress = false;
+    ar >> total >> null_count >> is_compress;
+    HKU_CHECK(null_count <= total, "Invalid binary array! total: {}, null_count: {}", total,
+              null_count);
+
+    std::vector<uint8_t> bitmap;
+    if (null_count > 0) {
+        bitmap.resize((total + 7) / 8);
+        ar.load_binary(bitmap.data(), bitmap.size());
+    }
+
+    size_t packed_count = total - null_count;
+    std::vector<T> packed;
+    T* dst = nullptr;
+    values.resize(total);
+    if (null_count > 0) {
+        packed.resize(packed_count);
+        dst = packed.data();
+    } else {
+        dst = values.data();
+    }
+
+    size_t bytes = packed_count * sizeof(T);
+    if (is_compress) {
+        uint64_t len = 0;
+        ar >> len;
+        string compressed(len, '\0');
+        ar.load_binary(&compressed[0], len);
+        decodeBinaryArray(compressed.data(), len, sizeof(T), (char*)dst, bytes);
+    } else if (bytes > 0) {
+        ar.load_binary(dst, bytes);
+    }
+
+    if (null_count > 0) {
+        size_t pos = 0;
+        for (size_t i = 0; i < total; i++) {
+            if (bitmap[i >> 3] & (uint8_t(1) << (i & 7))) {
+                values[i] = Null<T>();
+            } else {
+                values[i] = packed[pos++];
+            }
+        }
+    }
+}
+
+/**
+ * 浮点数组序列化包装，二进制归档中按 saveBinaryArray 格式读写，其他归档按原有方式读写
+ * @note boost 归档不记录基础类型 vector（如 PriceList）的类版本，无法据此兼容旧格式，
+ *       因此 PriceList 默认序列化方式不变，需按连续数组存放时须显式使用该包装:
+ *       ar& make_nvp("values", make_binary_array(values));
+ */
+template <typename T>
+class BinaryArrayWrapper
+  : public boost::serialization::wrapper_traits<const BinaryArrayWrapper<T>> {
+public:
+    explicit BinaryArrayWrapper(std::vector<T>& values) : m_values(values) {}
+
+private:
+    friend class boost::serialization::access;
+    template <class Archive>
+    void save(Archive& ar, const unsigned int version) const {
+        if constexpr (is_binary_archive<Archive>::value) {
+            saveBinaryArray(ar, m_values.data(), m_values.size());
+        } else {
+            ar& boost::serialization::make_nvp("values", m_values);
+        }
+    }
+
+    template <class Archive>
+    void load(Archive& ar, const unsigned int version) {
+        if constexpr (is_binary_archive<Archive>::value) {
+            loadBinaryArray(ar, m_values);
+        } else {
+            ar& boost::serialization::make_nvp("values", m_values);
+        }
+    }
+
+    BOOST_SERIALIZATION_SPLIT_MEMBER()
+
+private:
+    std::vector<T>& m_values;
+};
+
+template <typename T>
+inline const BinaryArrayWrapper<T> make_binary_array(std::vector<T>& values) {
+    return BinaryArrayWrapper<T>(values);
+}
+
+}  // namespace hku
+
+#endif /* HKU_SUPPORT_SERIALIZATION */
+
+#endif /* BINARY_ARRAY_SERIALIZATION_H_ */
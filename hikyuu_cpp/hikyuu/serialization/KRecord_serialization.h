@@ -11,6 +11,11 @@
 
 #include "../config.h"
 #include "../KRecord.h"
+#include "BinaryArray_serialization.h"
+
+#if HKU_SUPPORT_SERIALIZATION
+#include <boost/serialization/version.hpp>
+#endif
 
 #if HKU_SUPPORT_SERIALIZATION
 
@@ -40,11 +45,76 @@ void load(Archive& ar, hku::KRecord& record, unsigned int version) {
     ar& make_nvp("transAmount", record.transAmount);
     ar& make_nvp("transCount", record.transCount);
 }
+
+#if HKU_SUPPORT_BINARY_ARCHIVE
+// 二进制归档中的 KRecordList 按列整体读写，各价格列以浮点数组方式存放（类版本 1）
+inline constexpr hku::price_t hku::KRecord::*g_krecord_price_fields[] = {
+  &hku::KRecord::openPrice,  &hku::KRecord::highPrice,   &hku::KRecord::lowPrice,
+  &hku::KRecord::closePrice, &hku::KRecord::transAmount, &hku::KRecord::transCount};
+
+inline void serialize(boost::archive::binary_oarchive& ar, hku::KRecordList& records,
+                      const unsigned int version) {
+    size_t total = records.size();
+    std::vector<hku::uint64_t> dates(total);
+    for (size_t i = 0; i < total; i++) {
+        dates[i] = records[i].datetime.number();
+    }
+    hku::uint64_t count = total;
+    ar << count;
+    if (total > 0) {
+        ar.save_binary(dates.data(), total * sizeof(hku::uint64_t));
+    }
+
+    hku::PriceList column(total);
+    for (auto field : g_krecord_price_fields) {
+        for (size_t i = 0; i < total; i++) {
+            column[i] = records[i].*field;
+        }
+        hku::saveBinaryArray(ar, column.data(), total);
+    }
+}
+
+inline void serialize(boost::archive::binary_iarchive& ar, hku::KRecordList& records,
+                      const unsigned int version) {
+    if (version == 0) {
+        // 版本 0 为逐条记录存放的旧格式
+        boost::serialization::load(ar, records, version);
+        return;
+    }
+
+    hku::uint64_t total = 0;
+    ar >> total;
+    std::vector<hku::uint64_t> dates(total);
+    if (total > 0) {
+        ar.load_binary(dates.data(), total * sizeof(hku::uint64_t));
+    }
+
+    records.resize(total);
+    for (size_t i = 0; i < total; i++) {
+        records[i].datetime = hku::Datetime(dates[i]);
+    }
+
+    hku::PriceList column;
+    for (auto field : g_krecord_price_fields) {
+        hku::loadBinaryArray(ar, column);
+        HKU_CHECK(column.size() == total, "Invalid KRecordList binary archive!");
+        for (size_t i = 0; i < total; i++) {
+            records[i].*field = column[i];
+        }
+    }
+}
+#endif /* HKU_SUPPORT_BINARY_ARCHIVE */
+
 }  // namespace serialization
 }  // namespace boost
 
 BOOST_SERIALIZATION_SPLIT_FREE(hku::KRecord)
 
+#if HKU_SUPPORT_BINARY_ARCHIVE
+// 版本 1: 二进制归档中的 KRecordList 改为按列存放
+BOOST_CLASS_VERSION(hku::KRecordList, 1)
+#endif
+
 #endif /* HKU_SUPPORT_SERIALIZATION */
 
 #endif /* KRECORD_SERIALIZATION_H_ */
@@ -10,6 +10,7 @@
 #define ALL_SERIALIZATION_H_
 
 #include "PriceList_serialization.h"
+#include "BinaryArray_serialization.h"
 #include "Datetime_serialization.h"
 #include "TimeDelta_serialization.h"
 #include "KData_serialization.h"
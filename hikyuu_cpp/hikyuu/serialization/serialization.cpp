@@ -7,4 +7,83 @@
  *      Author: fasiondog
  */
 
+#include <atomic>
+#include "hikyuu/utilities/config.h"
+#if HKU_ENABLE_HTTP_CLIENT_ZIP
+#include "gzip/compress.hpp"
+#include "gzip/decompress.hpp"
+#endif
+
 #include "all.h"
+#include "BinaryArray_serialization.h"
+
+#if HKU_SUPPORT_SERIALIZATION
+
+namespace hku {
+
+static std::atomic_bool g_binary_array_compress{false};
+
+void HKU_API setBinaryArrayCompress(bool compress) {
+    g_binary_array_compress = compress;
+}
+
+bool HKU_API isBinaryArrayCompress() {
+    return g_binary_array_compress;
+}
+
+#if HKU_ENABLE_HTTP_CLIENT_ZIP
+// 按字节重排（各元素的第 n 个字节连续存放），使价格等数据的高位字节聚集，便于压缩
+static void shuffle_bytes(const char* src, size_t bytes, size_t elem_size, char* dst) {
+    size_t count = bytes / elem_size;
+    for (size_t i = 0; i < count; i++) {
+        for (size_t b = 0; b < elem_size; b++) {
+            dst[b * count + i] = src[i * elem_size + b];
+        }
+    }
+}
+
+static void unshuffle_bytes(const char* src, size_t bytes, size_t elem_size, char* dst) {
+    size_t count = bytes / elem_size;
+    for (size_t i = 0; i < count; i++) {
+        for (size_t b = 0; b < elem_size; b++) {
+            dst[i * elem_size + b] = src[b * count + i];
+        }
+    }
+}
+#endif
+
+bool HKU_API encodeBinaryArray(const char* src, size_t bytes, size_t elem_size, string& out) {
+    out.clear();
+#if HKU_ENABLE_HTTP_CLIENT_ZIP
+    // 数据量过小时压缩无收益
+    HKU_IF_RETURN(!g_binary_array_compress || bytes < 256 || elem_size == 0, false);
+    string shuffled(bytes, '\0');
+    shuffle_bytes(src, bytes, elem_size, &shuffled[0]);
+    gzip::Compressor comp(Z_DEFAULT_COMPRESSION);
+    comp.compress(out, shuffled.data(), shuffled.size());
+    if (out.size() >= bytes) {
+        out.clear();
+        return false;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+void HKU_API decodeBinaryArray(const char* src, size_t len, size_t elem_size, char* dst,
+                               size_t bytes) {
+#if HKU_ENABLE_HTTP_CLIENT_ZIP
+    string shuffled = gzip::decompress(src, len);
+    HKU_CHECK(shuffled.size() == bytes && elem_size > 0,
+              "Invalid compressed binary array! expect bytes: {}, actual: {}", bytes,
+              shuffled.size());
+    unshuffle_bytes(shuffled.data(), bytes, elem_size, dst);
+#else
+    HKU_THROW("The compressed binary array is not supported, please enable http_client_zip!");
+#endif
+}
+
+}  // namespace hku
+
+#endif /* HKU_SUPPORT_SERIALIZATION */
@@ -0,0 +1,479 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-16
+ *      Author: fasiondog
+ */
+
+#include <sstream>
+#include <algorithm>
+#include "FastStatsTradeManager.h"
+
+namespace hku {
+
+FastStatsTradeManager::FastStatsTradeManager(const Datetime& datetime, price_t initcash,
+                                             const TradeCostPtr& costfunc, const string& name)
+: TradeManagerBase(name, costfunc), m_init_datetime(datetime) {
+    m_init_cash = roundEx(initcash, 2);
+    _reset();
+}
+
+void FastStatsTradeManager::_reset() {
+    m_first_datetime = Null<Datetime>();
+    m_last_datetime = m_init_datetime;
+    m_last_update_datetime = m_init_datetime;
+    m_cash = m_init_cash;
+    m_checkin_cash = m_init_cash;
+    m_checkout_cash = 0.0;
+
+    m_position.clear();
+    m_position_history.clear();
+    m_cash_dates.clear();
+    m_cash_values.clear();
+    m_base_cash_values.clear();
+    m_holds.clear();
+
+    m_total_bonus = 0.0;
+    m_buy_number = 0;
+    m_max_buy_percent = 0.0;
+    m_sum_buy_percent = 0.0;
+
+    _addCashStep(m_init_datetime);
+}
+
+shared_ptr<TradeManagerBase> FastStatsTradeManager::_clone() {
+    auto p = make_shared<FastStatsTradeManager>(m_init_datetime, m_init_cash, m_costfunc, m_name);
+    p->m_first_datetime = m_first_datetime;
+    p->m_last_datetime = m_last_datetime;
+    p->m_last_update_datetime = m_last_update_datetime;
+    p->m_cash = m_cash;
+    p->m_checkin_cash = m_checkin_cash;
+    p->m_checkout_cash = m_checkout_cash;
+    p->m_position = m_position;
+    p->m_position_history = m_position_history;
+    p->m_cash_dates = m_cash_dates;
+    p->m_cash_values = m_cash_values;
+    p->m_base_cash_values = m_base_cash_values;
+    p->m_holds = m_holds;
+    p->m_total_bonus = m_total_bonus;
+    p->m_buy_number = m_buy_number;
+    p->m_max_buy_percent = m_max_buy_percent;
+    p->m_sum_buy_percent = m_sum_buy_percent;
+    return p;
+}
+
+const PositionRecord* FastStatsTradeManager::_findPosition(const Stock& stock) const {
+    for (const auto& position : m_position) {
+        if (position.stock == stock) {
+            return &position;
+        }
+    }
+    return nullptr;
+}
+
+PositionRecord* FastStatsTradeManager::_findPosition(const Stock& stock) {
+    for (auto& position : m_position) {
+        if (position.stock == stock) {
+            return &position;
+        }
+    }
+    return nullptr;
+}
+
+void FastStatsTradeManager::_addCashStep(const Datetime& datetime) {
+    m_cash_dates.push_back(datetime);
+    m_cash_values.push_back(m_cash);
+    m_base_cash_values.push_back(m_checkin_cash - m_checkout_cash);
+}
+
+void FastStatsTradeManager::_addHoldStep(const Datetime& datetime, const Stock& stock,
+                                         double number) {
+    HoldSteps* hold = nullptr;
+    for (auto& item : m_holds) {
+        if (item.stock == stock) {
+            hold = &item;
+            break;
+        }
+    }
+    if (!hold) {
+        m_holds.emplace_back();
+        hold = &m_holds.back();
+        hold->stock = stock;
+    }
+    hold->dates.push_back(datetime);
+    hold->numbers.push_back(number);
+}
+
+double FastStatsTradeManager::_holdNumber(const Datetime& datetime, const Stock& stock) const {
+    for (const auto& hold : m_holds) {
+        if (hold.stock == stock) {
+            auto iter = std::upper_bound(hold.dates.cbegin(), hold.dates.cend(), datetime);
+            return iter == hold.dates.cbegin() ? 0.0
+                                               : hold.numbers[iter - hold.dates.cbegin() - 1];
+        }
+    }
+    return 0.0;
+}
+
+price_t FastStatsTradeManager::cash(const Datetime& datetime, KQuery::KType ktype) {
+    if (datetime > m_last_update_datetime) {
+        updateWithWeight(datetime);
+        return m_cash;
+    }
+    HKU_IF_RETURN(datetime == m_last_update_datetime, m_cash);
+    return getFunds(datetime, ktype).cash;
+}
+
+double FastStatsTradeManager::getHoldNumber(const Datetime& datetime, const Stock& stock) {
+    HKU_IF_RETURN(datetime < m_init_datetime, 0.0);
+    updateWithWeight(datetime);
+    if (datetime >= m_last_datetime) {
+        const PositionRecord* position = _findPosition(stock);
+        return position ? position->number : 0.0;
+    }
+    return _holdNumber(datetime, stock);
+}
+
+PositionRecord FastStatsTradeManager::getPosition(const Datetime& datetime, const Stock& stock) {
+    PositionRecord result;
+    HKU_IF_RETURN(stock.isNull() || datetime < m_init_datetime, result);
+    updateWithWeight(datetime);
+
+    const PositionRecord* position = _findPosition(stock);
+    if (datetime >= m_last_datetime) {
+        return position ? *position : result;
+    }
+
+    double number = _holdNumber(datetime, stock);
+    HKU_IF_RETURN(0.0 == number, result);
+
+    if (position && position->takeDatetime <= datetime) {
+        result = *position;
+    } else {
+        for (auto iter = m_position_history.rbegin(); iter != m_position_history.rend(); ++iter) {
+            if (iter->stock == stock && iter->takeDatetime <= datetime) {
+                result = *iter;
+                break;
+            }
+        }
+    }
+    result.number = number;
+    return result;
+}
+
+bool FastStatsTradeManager::checkin(const Datetime& datetime, price_t cash) {
+    HKU_ERROR_IF_RETURN(cash <= 0.0, false, "{} cash({:<.3f}) must be > 0! ", datetime, cash);
+    HKU_ERROR_IF_RETURN(datetime < m_last_datetime, false,
+                        "{} datetime must be >= lastDatetime({})!", datetime, m_last_datetime);
+    updateWithWeight(datetime);
+
+    int precision = getParam<int>("precision");
+    price_t in_cash = roundEx(cash, precision);
+    m_cash = roundEx(m_cash + in_cash, precision);
+    m_checkin_cash = roundEx(m_checkin_cash + in_cash, precision);
+    m_last_datetime = datetime;
+    _addCashStep(datetime);
+    return true;
+}
+
+bool FastStatsTradeManager::checkout(const Datetime& datetime, price_t cash) {
+    HKU_ERROR_IF_RETURN(cash <= 0.0, false, "{} cash({:<.4f}) must be > 0! ", datetime, cash);
+    HKU_ERROR_IF_RETURN(datetime < m_last_datetime, false,
+                        "{} datetime must be >= lastDatetime({})!", datetime, m_last_datetime);
+    updateWithWeight(datetime);
+
+    int precision = getParam<int>("precision");
+    price_t out_cash = roundEx(cash, precision);
+    price_t tmp_cash = roundEx(m_cash - out_cash, precision);
+    HKU_ERROR_IF_RETURN(tmp_cash < 0.0, false, "{} cash({:<.4f}) must be <= current cash({:<.4f})!",
+                        datetime, cash, m_cash);
+
+    m_cash = tmp_cash;
+    m_checkout_cash = roundEx(m_checkout_cash + out_cash, precision);
+    m_last_datetime = datetime;
+    _addCashStep(datetime);
+    return true;
+}
+
+TradeRecord FastStatsTradeManager::buy(const Datetime& datetime, const Stock& stock,
+                                       price_t realPrice, double number, price_t stoploss,
+                                       price_t goalPrice, price_t planPrice, SystemPart from,
+                                       const string& remark) {
+    TradeRecord result;
+    result.business = BUSINESS_INVALID;
+
+    HKU_ERROR_IF_RETURN(stock.isNull(), result, "{} Stock is Null!", datetime);
+    HKU_ERROR_IF_RETURN(datetime < m_last_datetime, result,
+                        "{} {} datetime must be >= lastDatetime({})!", datetime,
+                        stock.market_code(), m_last_datetime);
+    HKU_ERROR_IF_RETURN(number == 0.0, result, "{} {} numer is zero!", datetime,
+                        stock.market_code());
+    HKU_ERROR_IF_RETURN(number < stock.minTradeNumber(), result,
+                        "{} {} Buy number({}) must be >= minTradeNumber({})!", datetime,
+                        stock.market_code(), number, stock.minTradeNumber());
+    HKU_ERROR_IF_RETURN(number > stock.maxTradeNumber(), result,
+                        "{} {} Buy number({}) must be <= maxTradeNumber({})!", datetime,
+                        stock.market_code(), number, stock.maxTradeNumber());
+
+    updateWithWeight(datetime);
+
+    CostRecord cost = getBuyCost(datetime, stock, realPrice, number);
+    int precision = getParam<int>("precision");
+    price_t money = roundEx(realPrice * number * stock.unit(), precision);
+    HKU_WARN_IF_RETURN(m_cash < roundEx(money + cost.total, precision), result,
+                       "{} {} Can't buy, need cash({:<.4f}) > current cash({:<.4f})!", datetime,
+                       stock.market_code(), roundEx(money + cost.total, precision), m_cash);
+
+    m_cash = roundEx(m_cash - money - cost.total, precision);
+    if (m_first_datetime.isNull()) {
+        m_first_datetime = datetime;
+    }
+    m_last_datetime = datetime;
+
+    // 与 Performance 中按买入交易记录统计占用现金比例的算法保持一致
+    price_t hold_cash = roundEx(realPrice * number + cost.total, precision);
+    price_t total_cash = roundEx(hold_cash + m_cash, precision);
+    double percent = (total_cash != 0.0) ? hold_cash / total_cash : 0.0;
+    m_buy_number++;
+    m_sum_buy_percent += percent;
+    if (percent > m_max_buy_percent) {
+        m_max_buy_percent = percent;
+    }
+
+    double hold_number = number;
+    PositionRecord* position = _findPosition(stock);
+    if (!position) {
+        m_position.emplace_back(
+          stock, datetime, Null<Datetime>(), number, stoploss, goalPrice, number, money, cost.total,
+          roundEx((realPrice - stoploss) * number * stock.unit(), precision), 0.0);
+    } else {
+        position->number += number;
+        position->stoploss = stoploss;
+        position->goalPrice = goalPrice;
+        position->totalNumber += number;
+        position->buyMoney = roundEx(money + position->buyMoney, precision);
+        position->totalCost = roundEx(cost.total + position->totalCost, precision);
+        position->totalRisk =
+          roundEx(position->totalRisk + (realPrice - stoploss) * number * stock.unit(), precision);
+        hold_number = position->number;
+    }
+
+    _addCashStep(datetime);
+    _addHoldStep(datetime, stock, hold_number);
+
+    return TradeRecord(stock, datetime, BUSINESS_BUY, planPrice, realPrice, goalPrice, number,
+                       cost, stoploss, m_cash, from, remark);
+}
+
+TradeRecord FastStatsTradeManager::sell(const Datetime& datetime, const Stock& stock,
+                                        price_t realPrice, double number, price_t stoploss,
+                                        price_t goalPrice, price_t planPrice, SystemPart from,
+                                        const string& remark) {
+    HKU_CHECK(!std::isnan(number), "sell number should be a valid double!");
+    TradeRecord result;
+
+    HKU_ERROR_IF_RETURN(stock.isNull(), result, "{} Stock is Null!", datetime);
+    HKU_ERROR_IF_RETURN(datetime < m_last_datetime, result,
+                        "{} {} datetime must be >= lastDatetime({})!", datetime,
+                        stock.market_code(), m_last_datetime);
+    HKU_ERROR_IF_RETURN(number == 0.0, result, "{} {} number is zero!", datetime,
+                        stock.market_code());
+    HKU_ERROR_IF_RETURN(number < stock.minTradeNumber(), result,
+                        "{} {} Sell number({}) must be >= minTradeNumber({})!", datetime,
+                        stock.market_code(), number, stock.minTradeNumber());
+    HKU_ERROR_IF_RETURN(number != MAX_DOUBLE && number > stock.maxTradeNumber(), result,
+                        "{} {} Sell number({}) must be <= maxTradeNumber({})!", datetime,
+                        stock.market_code(), number, stock.maxTradeNumber());
+    HKU_TRACE_IF_RETURN(!_findPosition(stock), result,
+                        "{} {} This stock was not bought never! ({}, {:<.4f}, {}, {})", datetime,
+                        stock.market_code(), datetime, realPrice, number, getSystemPartName(from));
+
+    updateWithWeight(datetime);
+
+    auto pos_iter = m_position.begin();
+    for (; pos_iter != m_position.end(); ++pos_iter) {
+        if (pos_iter->stock == stock) {
+            break;
+        }
+    }
+    PositionRecord& position = *pos_iter;
+
+    double real_number = number == MAX_DOUBLE ? position.number : number;
+    HKU_ERROR_IF_RETURN(position.number < real_number, result,
+                        "{} {} Try to sell number({}) > number of position({})!", datetime,
+                        stock.market_code(), real_number, position.number);
+
+    CostRecord cost = getSellCost(datetime, stock, realPrice, real_number);
+    int precision = getParam<int>("precision");
+    price_t money = roundEx(realPrice * real_number * stock.unit(), precision);
+
+    m_cash = roundEx(m_cash + money - cost.total, precision);
+    m_last_datetime = datetime;
+
+    position.number -= real_number;
+    position.stoploss = stoploss;
+    position.goalPrice = goalPrice;
+    position.totalCost = roundEx(position.totalCost + cost.total, precision);
+    position.sellMoney = roundEx(position.sellMoney + money, precision);
+
+    _addCashStep(datetime);
+    _addHoldStep(datetime, stock, position.number);
+
+    if (position.number == 0) {
+        position.cleanDatetime = datetime;
+        m_position_history.push_back(position);
+        m_position.erase(pos_iter);
+    }
+
+    return TradeRecord(stock, datetime, BUSINESS_SELL, planPrice, realPrice, goalPrice,
+                       real_number, cost, stoploss, m_cash, from, remark);
+}
+
+FundsRecord FastStatsTradeManager::getFunds(KQuery::KType inktype) const {
+    FundsRecord funds;
+    int precision = getParam<int>("precision");
+    string ktype(inktype);
+    to_upper(ktype);
+
+    price_t value = 0.0;
+    for (const auto& record : m_position) {
+        auto price = record.stock.getMarketValue(m_last_datetime, ktype);
+        value = roundEx((value + record.number * price * record.stock.unit()), precision);
+    }
+
+    funds.cash = m_cash;
+    funds.market_value = value;
+    funds.base_cash = m_checkin_cash - m_checkout_cash;
+    return funds;
+}
+
+FundsRecord FastStatsTradeManager::getFunds(const Datetime& indatetime, KQuery::KType ktype) {
+    FundsRecord funds;
+    int precision = getParam<int>("precision");
+
+    Datetime datetime(indatetime.year(), indatetime.month(), indatetime.day(), 23, 59);
+    if (datetime > m_last_datetime) {
+        updateWithWeight(datetime);
+        price_t market_value = 0.0;
+        for (const auto& record : m_position) {
+            price_t price = record.stock.getMarketValue(datetime, ktype);
+            market_value =
+              roundEx(market_value + price * record.number * record.stock.unit(), precision);
+        }
+        funds.cash = m_cash;
+        funds.market_value = market_value;
+        funds.base_cash = m_checkin_cash - m_checkout_cash;
+        return funds;
+    }
+
+    // 历史时刻，二分查找当时的现金及各证券持仓数量
+    auto iter = std::upper_bound(m_cash_dates.cbegin(), m_cash_dates.cend(), datetime);
+    if (iter == m_cash_dates.cbegin()) {
+        funds.cash = m_init_cash;
+        return funds;
+    }
+
+    size_t pos = iter - m_cash_dates.cbegin() - 1;
+    funds.cash = m_cash_values[pos];
+    funds.base_cash = m_base_cash_values[pos];
+
+    price_t market_value = 0.0;
+    for (const auto& hold : m_holds) {
+        double number = _holdNumber(datetime, hold.stock);
+        if (number == 0.0) {
+            continue;
+        }
+        price_t price = hold.stock.getMarketValue(datetime, ktype);
+        market_value = roundEx(market_value + price * number * hold.stock.unit(), precision);
+    }
+    funds.market_value = market_value;
+    return funds;
+}
+
+void FastStatsTradeManager::updateWithWeight(const Datetime& datetime) {
+    HKU_IF_RETURN(datetime <= m_last_update_datetime, void());
+
+    // 权息处理规则同 TradeManager::updateWithWeight
+    Datetime start_date(m_last_datetime.date() + bd::days(1));
+    Datetime end_date(datetime.date() + bd::days(1));
+    int precision = getParam<int>("precision");
+
+    struct Event {
+        Datetime datetime;
+        Stock stock;
+        price_t bonus;
+        double addcount;
+    };
+    vector<Event> events;
+
+    for (auto& position : m_position) {
+        StockWeightList weights = position.stock.getWeight(start_date, end_date);
+        for (const auto& weight : weights) {
+            if (0.0 == weight.bonus() && 0.0 == weight.countAsGift() &&
+                0.0 == weight.increasement()) {
+                continue;
+            }
+
+            if (weight.bonus() != 0.0) {
+                price_t bonus = roundEx(position.number * weight.bonus() * 0.1, precision);
+                position.sellMoney += bonus;
+                m_total_bonus += bonus;
+                events.push_back({weight.datetime(), position.stock, bonus, 0.0});
+            }
+
+            double addcount =
+              (position.number / 10.0) * (weight.countAsGift() + weight.increasement());
+            if (addcount != 0.0) {
+                position.number += addcount;
+                position.totalNumber += addcount;
+                events.push_back({weight.datetime(), position.stock, 0.0, addcount});
+            }
+        }
+    }
+
+    std::stable_sort(events.begin(), events.end(), [](const Event& a, const Event& b) {
+        return a.datetime < b.datetime;
+    });
+
+    for (const auto& event : events) {
+        m_cash += event.bonus;
+        _addCashStep(event.datetime);
+        if (event.addcount != 0.0) {
+            _addHoldStep(event.datetime, event.stock,
+                         _holdNumber(event.datetime, event.stock) + event.addcount);
+        }
+        m_last_datetime = event.datetime;
+    }
+
+    m_last_update_datetime = datetime;
+}
+
+string FastStatsTradeManager::str() const {
+    std::stringstream os;
+    os << std::fixed;
+    os.precision(2);
+
+    FundsRecord funds = getFunds();
+    string strip(",\n");
+    os << "FastStatsTradeManager {\n"
+       << "  params: " << getParameter() << strip << "  name: " << name() << strip
+       << "  init_date: " << initDatetime() << strip << "  init_cash: " << initCash() << strip
+       << "  firstDatetime: " << firstDatetime() << strip << "  lastDatetime: " << lastDatetime()
+       << strip << "  TradeCostFunc: " << costFunc() << strip
+       << "  current total funds: " << funds.cash + funds.market_value << strip
+       << "  current cash: " << currentCash() << strip
+       << "  current market_value: " << funds.market_value << strip
+       << "  current base_cash: " << funds.base_cash << strip
+       << "  closed positions: " << m_position_history.size() << strip << "  Position: \n";
+    for (const auto& position : m_position) {
+        os << "    " << position.stock.market_code() << " " << position.stock.name() << " "
+           << position.takeDatetime << " " << position.number << "\n";
+    }
+    os << "}";
+
+    os.unsetf(std::ostream::floatfield);
+    os.precision();
+    return os.str();
+}
+
+} /* namespace hku */
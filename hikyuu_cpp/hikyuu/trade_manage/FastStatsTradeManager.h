@@ -0,0 +1,230 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-16
+ *      Author: fasiondog
+ */
+
+#pragma once
+#ifndef TRADE_MANAGE_FASTSTATSTRADEMANAGER_H_
+#define TRADE_MANAGE_FASTSTATSTRADEMANAGER_H_
+
+#include "TradeManagerBase.h"
+
+namespace hku {
+
+/**
+ * 快速统计模式的回测账户，只保留资金曲线及绩效统计所需的数据
+ * @details
+ * <pre>
+ * 与 TradeManager 采用相同的交易、成本及权息处理规则，由 System 照常驱动，交易决策完全相同，
+ * 但不生成交易记录列表及交易动作脚本，资金与持仓变化以按时间递增的扁平数组保存，
+ * 历史资产查询通过二分查找完成。适用于只关注统计结果的大批量单证券回测筛选。
+ *
+ * 限制：
+ * 1) 仅支持多头交易，不支持融资融券、卖空及存取股票
+ * 2) 不支持订单代理、addTradeRecord、序列化及 tocsv
+ * 3) getTradeList 始终返回空列表，Performance 统计时直接使用其内部累计值
+ * </pre>
+ * @ingroup TradeManagerClass
+ */
+class HKU_API FastStatsTradeManager : public TradeManagerBase {
+public:
+    explicit FastStatsTradeManager(const Datetime& datetime = Datetime(199001010000LL),
+                                   price_t initcash = 100000.0,
+                                   const TradeCostPtr& costfunc = TC_Zero(),
+                                   const string& name = "SYS");
+    virtual ~FastStatsTradeManager() = default;
+
+    virtual void _reset() override;
+    virtual shared_ptr<TradeManagerBase> _clone() override;
+
+    virtual double getMarginRate(const Datetime& datetime, const Stock& stock) override {
+        return 0.0;
+    }
+
+    virtual price_t initCash() const override {
+        return m_init_cash;
+    }
+
+    virtual Datetime initDatetime() const override {
+        return m_init_datetime;
+    }
+
+    /** 第一笔买入交易发生日期，如未发生交易返回Null<Datetime>() */
+    virtual Datetime firstDatetime() const override {
+        return m_first_datetime;
+    }
+
+    /** 最后一笔交易（含权息调整）日期，如未发生交易返回账户建立日期 */
+    virtual Datetime lastDatetime() const override {
+        return m_last_datetime;
+    }
+
+    virtual void updateWithWeight(const Datetime& datetime) override;
+
+    virtual price_t currentCash() const override {
+        return m_cash;
+    }
+
+    virtual price_t cash(const Datetime& datetime, KQuery::KType ktype = KQuery::DAY) override;
+
+    virtual bool have(const Stock& stock) const override {
+        return _findPosition(stock) != nullptr;
+    }
+
+    virtual bool haveShort(const Stock& stock) const override {
+        return false;
+    }
+
+    virtual size_t getStockNumber() const override {
+        return m_position.size();
+    }
+
+    virtual size_t getShortStockNumber() const override {
+        return 0;
+    }
+
+    virtual double getHoldNumber(const Datetime& datetime, const Stock& stock) override;
+
+    virtual double getShortHoldNumber(const Datetime& datetime, const Stock& stock) override {
+        return 0.0;
+    }
+
+    virtual double getDebtNumber(const Datetime& datetime, const Stock& stock) override {
+        return 0.0;
+    }
+
+    virtual price_t getDebtCash(const Datetime& datetime) override {
+        return 0.0;
+    }
+
+    /** 不保存交易记录，始终返回空列表 */
+    virtual TradeRecordList getTradeList() const override {
+        return TradeRecordList();
+    }
+
+    /** 不保存交易记录，始终返回空列表 */
+    virtual TradeRecordList getTradeList(const Datetime& start,
+                                         const Datetime& end) const override {
+        return TradeRecordList();
+    }
+
+    virtual PositionRecordList getPositionList() const override {
+        return m_position;
+    }
+
+    virtual PositionRecordList getHistoryPositionList() const override {
+        return m_position_history;
+    }
+
+    virtual PositionRecordList getShortPositionList() const override {
+        return PositionRecordList();
+    }
+
+    virtual PositionRecordList getShortHistoryPositionList() const override {
+        return PositionRecordList();
+    }
+
+    virtual PositionRecord getPosition(const Datetime& date, const Stock& stock) override;
+
+    virtual PositionRecord getShortPosition(const Stock& stock) const override {
+        return PositionRecord();
+    }
+
+    virtual BorrowRecordList getBorrowStockList() const override {
+        return BorrowRecordList();
+    }
+
+    virtual bool checkin(const Datetime& datetime, price_t cash) override;
+    virtual bool checkout(const Datetime& datetime, price_t cash) override;
+
+    virtual TradeRecord buy(const Datetime& datetime, const Stock& stock, price_t realPrice,
+                            double number, price_t stoploss = 0.0, price_t goalPrice = 0.0,
+                            price_t planPrice = 0.0, SystemPart from = PART_INVALID,
+                            const string& remark = "") override;
+
+    virtual TradeRecord sell(const Datetime& datetime, const Stock& stock, price_t realPrice,
+                             double number = MAX_DOUBLE, price_t stoploss = 0.0,
+                             price_t goalPrice = 0.0, price_t planPrice = 0.0,
+                             SystemPart from = PART_INVALID, const string& remark = "") override;
+
+    virtual FundsRecord getFunds(KQuery::KType ktype = KQuery::DAY) const override;
+    virtual FundsRecord getFunds(const Datetime& datetime,
+                                 KQuery::KType ktype = KQuery::DAY) override;
+
+    virtual string str() const override;
+
+    //-------------------------------------------------------------
+    // 以下为 Performance 统计所需的累计值，等同于遍历 TradeManager 交易记录的结果
+    //-------------------------------------------------------------
+
+    /** 累计红利 */
+    price_t totalBonus() const {
+        return m_total_bonus;
+    }
+
+    /** 买入交易次数 */
+    size_t buyNumber() const {
+        return m_buy_number;
+    }
+
+    /** 单笔买入占用现金的最大比例 */
+    double maxBuyPercent() const {
+        return m_max_buy_percent;
+    }
+
+    /** 各笔买入占用现金比例之和 */
+    double sumBuyPercent() const {
+        return m_sum_buy_percent;
+    }
+
+private:
+    const PositionRecord* _findPosition(const Stock& stock) const;
+    PositionRecord* _findPosition(const Stock& stock);
+
+    // 记录账户现金变化
+    void _addCashStep(const Datetime& datetime);
+
+    // 记录指定证券持仓数量变化
+    void _addHoldStep(const Datetime& datetime, const Stock& stock, double number);
+
+    // 指定时刻（含）的持仓数量
+    double _holdNumber(const Datetime& datetime, const Stock& stock) const;
+
+private:
+    // 单只证券的持仓数量变化，dates 按时间递增
+    struct HoldSteps {
+        Stock stock;
+        DatetimeList dates;
+        vector<double> numbers;
+    };
+
+    Datetime m_init_datetime;         // 账户建立日期
+    price_t m_init_cash;              // 初始资金
+    Datetime m_first_datetime;        // 第一笔买入日期
+    Datetime m_last_datetime;         // 最后一笔交易（含权息调整）日期
+    Datetime m_last_update_datetime;  // 最后一次根据权息调整持仓的时刻
+
+    price_t m_cash;           // 当前现金
+    price_t m_checkin_cash;   // 累计存入资金，初始资金视为存入
+    price_t m_checkout_cash;  // 累计取出资金
+
+    PositionRecordList m_position;          // 当前持仓，单证券回测时至多一条
+    PositionRecordList m_position_history;  // 已平仓记录
+
+    // 账户现金变化，三个数组一一对应
+    DatetimeList m_cash_dates;
+    PriceList m_cash_values;
+    PriceList m_base_cash_values;  // 累计存入 - 累计取出
+
+    vector<HoldSteps> m_holds;
+
+    price_t m_total_bonus;
+    size_t m_buy_number;
+    double m_max_buy_percent;
+    double m_sum_buy_percent;
+};
+
+} /* namespace hku */
+#endif /* TRADE_MANAGE_FASTSTATSTRADEMANAGER_H_ */
@@ -7,6 +7,7 @@
 
 #include "boost/date_time/gregorian/gregorian.hpp"
 #include "boost/lexical_cast.hpp"
+#include "FastStatsTradeManager.h"
 #include "Performance.h"
 
 namespace hku {
@@ -171,13 +172,18 @@ void Performance::statistics(const TradeManagerPtr& tm, const Datetime& datetime
       funds.cash + funds.market_value - funds.borrow_cash - funds.borrow_asset;
     price_t total_money = funds.base_cash + funds.base_asset;
 
-    const TradeRecordList& trade_list = tm->getTradeList();
+    // 快速统计模式的账户不保存交易记录，直接使用其累计值
+    const FastStatsTradeManager* fast_tm = dynamic_cast<const FastStatsTradeManager*>(tm.get());
+    const TradeRecordList& trade_list = fast_tm ? TradeRecordList() : tm->getTradeList();
     TradeRecordList::const_iterator trade_iter = trade_list.begin();
     for (; trade_iter != trade_list.end(); ++trade_iter) {
         if (trade_iter->business == BUSINESS_BONUS) {
             m_result["累计红利"] += trade_iter->realPrice;
         }
     }
+    if (fast_tm) {
+        m_result["累计红利"] = fast_tm->totalBonus();
+    }
 
     struct CalData {
         CalData()
@@ -407,6 +413,12 @@ void Performance::statistics(const TradeManagerPtr& tm, const Datetime& datetime
         }
     }
 
+    if (fast_tm) {
+        trade_number = fast_tm->buyNumber();
+        max_percent = fast_tm->maxBuyPercent();
+        sum_percent = fast_tm->sumBuyPercent();
+    }
+
     m_result["单笔交易最大占用现金比例%"] = 100 * max_percent;
     if (trade_number != 0) {
         m_result["交易平均占用现金比例%"] = 100 * sum_percent / trade_number;
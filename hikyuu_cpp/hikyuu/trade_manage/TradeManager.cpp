@@ -10,6 +10,7 @@
 #include <functional>
 #include <boost/lexical_cast.hpp>
 #include <algorithm>
+#include <memory>
 #include "TradeManager.h"
 #include "../trade_sys/system/SystemPart.h"
 #include "../KData.h"
@@ -120,6 +121,7 @@ void TradeManager::_reset() {
     m_trade_list.push_back(TradeRecord(Null<Stock>(), m_init_datetime, BUSINESS_INIT, m_init_cash,
                                        m_init_cash, 0.0, 0, CostRecord(), 0.0, m_cash,
                                        PART_INVALID));
+    std::atomic_store(&m_funds_replay, std::shared_ptr<FundsReplay>());
 
     m_position.clear();
     m_position_history.clear();
@@ -1255,76 +1257,78 @@ FundsRecord TradeManager::getFunds(const Datetime& indatetime, KQuery::KType kty
         return funds;
     }  // if datetime >= lastDatetime()
 
-    // 当查询日期小于最后交易日期时，遍历交易记录，计算当日的市值和现金
-    price_t cash = m_init_cash;
-    struct Stock_Number {
-        Stock_Number() : number(0) {}
-        Stock_Number(const Stock& stock, size_t number) : stock(stock), number(number) {}
-
-        Stock stock;
-        size_t number;
-    };
-
-    price_t checkin_cash = 0.0;
-    price_t checkout_cash = 0.0;
-    price_t checkin_stock = 0.0;
-    price_t checkout_stock = 0.0;
-    map<uint64_t, Stock_Number> stock_map;
-    map<uint64_t, Stock_Number> short_stock_map;
-    map<uint64_t, Stock_Number>::iterator stock_iter;
-    map<uint64_t, Stock_Number>::iterator short_stock_iter;
-    map<uint64_t, BorrowRecord> bor_stock_map;
-    map<uint64_t, BorrowRecord>::iterator bor_stock_iter;
+    // 当查询日期小于最后交易日期时，回放交易记录计算当日的市值和现金
+    // 已回放的交易记录均不晚于查询日期时，从上次回放的位置继续，否则从头回放
+    // 回放状态取出后独占使用，并发查询的其他线程取得空状态时自行从头回放，互不干扰
+    std::shared_ptr<FundsReplay> replay =
+      std::atomic_exchange(&m_funds_replay, std::shared_ptr<FundsReplay>());
+    size_t pos = replay ? replay->pos : 0;
+    if (!replay || pos > m_trade_list.size() ||
+        (pos > 0 && m_trade_list[pos - 1].datetime > datetime)) {
+        replay = std::make_shared<FundsReplay>(m_init_cash);
+    }
 
-    TradeRecordList::const_iterator iter = m_trade_list.begin();
-    for (; iter != m_trade_list.end(); ++iter) {
-        if (iter->datetime > datetime) {
+    replay->replay(m_trade_list, datetime, precision);
+    funds = replay->funds(datetime, ktype, precision);
+    std::atomic_store(&m_funds_replay, std::move(replay));
+    return funds;
+}
+
+void TradeManager::FundsReplay::replay(const TradeRecordList& trade_list,
+                                       const Datetime& datetime, int precision) {
+    std::map<uint64_t, StockNumber>::iterator stock_iter;
+    std::map<uint64_t, StockNumber>::iterator short_stock_iter;
+    std::map<uint64_t, BorrowRecord>::iterator bor_stock_iter;
+
+    for (size_t total = trade_list.size(); pos < total; ++pos) {
+        const TradeRecord& record = trade_list[pos];
+        if (record.datetime > datetime) {
             // 如果交易记录的日期大于指定的日期则跳出循环，处理完毕
             break;
         }
 
-        cash = iter->cash;
-        switch (iter->business) {
+        cash = record.cash;
+        switch (record.business) {
             case BUSINESS_INIT:
-                checkin_cash += iter->realPrice;
+                checkin_cash += record.realPrice;
                 break;
 
             case BUSINESS_BUY:
             case BUSINESS_GIFT:
-                stock_iter = stock_map.find(iter->stock.id());
+                stock_iter = stock_map.find(record.stock.id());
                 if (stock_iter != stock_map.end()) {
-                    stock_iter->second.number += iter->number;
+                    stock_iter->second.number += record.number;
                 } else {
-                    stock_map[iter->stock.id()] = Stock_Number(iter->stock, iter->number);
+                    stock_map[record.stock.id()] = StockNumber(record.stock, record.number);
                 }
                 break;
 
             case BUSINESS_SELL:
-                stock_iter = stock_map.find(iter->stock.id());
+                stock_iter = stock_map.find(record.stock.id());
                 if (stock_iter != stock_map.end()) {
-                    stock_iter->second.number -= iter->number;
+                    stock_iter->second.number -= record.number;
                 } else {
                     HKU_WARN("{} {} Sell error in m_trade_list!", datetime,
-                             iter->stock.market_code());
+                             record.stock.market_code());
                 }
                 break;
 
             case BUSINESS_SELL_SHORT:
-                short_stock_iter = short_stock_map.find(iter->stock.id());
+                short_stock_iter = short_stock_map.find(record.stock.id());
                 if (short_stock_iter != short_stock_map.end()) {
-                    short_stock_iter->second.number += iter->number;
+                    short_stock_iter->second.number += record.number;
                 } else {
-                    short_stock_map[iter->stock.id()] = Stock_Number(iter->stock, iter->number);
+                    short_stock_map[record.stock.id()] = StockNumber(record.stock, record.number);
                 }
                 break;
 
             case BUSINESS_BUY_SHORT:
-                short_stock_iter = short_stock_map.find(iter->stock.id());
+                short_stock_iter = short_stock_map.find(record.stock.id());
                 if (short_stock_iter != short_stock_map.end()) {
-                    short_stock_iter->second.number -= iter->number;
+                    short_stock_iter->second.number -= record.number;
                 } else {
                     HKU_WARN("{} {} BuyShort Error in m_trade_list!", datetime,
-                             iter->stock.market_code());
+                             record.stock.market_code());
                 }
                 break;
 
@@ -1332,86 +1336,87 @@ FundsRecord TradeManager::getFunds(const Datetime& indatetime, KQuery::KType kty
                 break;
 
             case BUSINESS_CHECKIN:
-                checkin_cash += iter->realPrice;
+                checkin_cash += record.realPrice;
                 break;
 
             case BUSINESS_CHECKOUT:
-                checkout_cash += iter->realPrice;
+                checkout_cash += record.realPrice;
                 break;
 
             case BUSINESS_CHECKIN_STOCK:
-                stock_iter = stock_map.find(iter->stock.id());
+                stock_iter = stock_map.find(record.stock.id());
                 if (stock_iter != stock_map.end()) {
-                    stock_map[iter->stock.id()].number += iter->number;
+                    stock_iter->second.number += record.number;
                 } else {
-                    stock_map[iter->stock.id()] = Stock_Number(iter->stock, iter->number);
+                    stock_map[record.stock.id()] = StockNumber(record.stock, record.number);
                 }
                 checkin_stock = roundEx(
-                  checkin_stock + iter->realPrice * iter->number * iter->stock.unit(), precision);
+                  checkin_stock + record.realPrice * record.number * record.stock.unit(),
+                  precision);
                 break;
 
             case BUSINESS_CHECKOUT_STOCK:
-                stock_iter = stock_map.find(iter->stock.id());
+                stock_iter = stock_map.find(record.stock.id());
                 if (stock_iter != stock_map.end()) {
-                    stock_map[iter->stock.id()].number -= iter->number;
+                    stock_iter->second.number -= record.number;
                 } else {
                     HKU_WARN("{} {} CheckoutStock Error in m_trade_list!", datetime,
-                             iter->stock.market_code());
+                             record.stock.market_code());
                 }
                 checkout_stock = roundEx(
-                  checkout_stock + iter->realPrice * iter->number * iter->stock.unit(), precision);
+                  checkout_stock + record.realPrice * record.number * record.stock.unit(),
+                  precision);
                 break;
 
             case BUSINESS_BORROW_CASH:
-                funds.borrow_cash += iter->realPrice;
+                borrow_cash += record.realPrice;
                 break;
 
             case BUSINESS_RETURN_CASH:
-                funds.borrow_cash -= iter->realPrice;
+                borrow_cash -= record.realPrice;
                 break;
 
             case BUSINESS_BORROW_STOCK:
-                funds.borrow_asset =
-                  roundEx(funds.borrow_asset + iter->realPrice * iter->number * iter->stock.unit(),
-                          precision);
-                bor_stock_iter = bor_stock_map.find(iter->stock.id());
+                borrow_asset = roundEx(
+                  borrow_asset + record.realPrice * record.number * record.stock.unit(), precision);
+                bor_stock_iter = bor_stock_map.find(record.stock.id());
                 if (bor_stock_iter == bor_stock_map.end()) {
                     BorrowRecord bor;
-                    BorrowRecord::Data data(iter->datetime, iter->realPrice, iter->number);
+                    BorrowRecord::Data data(record.datetime, record.realPrice, record.number);
                     bor.record_list.push_back(data);
-                    bor_stock_map[iter->stock.id()] = bor;
+                    bor_stock_map[record.stock.id()] = bor;
                 } else {
-                    BorrowRecord::Data data(iter->datetime, iter->realPrice, iter->number);
+                    BorrowRecord::Data data(record.datetime, record.realPrice, record.number);
                     bor_stock_iter->second.record_list.push_back(data);
                 }
                 break;
 
             case BUSINESS_RETURN_STOCK:
-                bor_stock_iter = bor_stock_map.find(iter->stock.id());
+                bor_stock_iter = bor_stock_map.find(record.stock.id());
                 if (bor_stock_iter == bor_stock_map.end()) {
-                    HKU_WARN("{} {} Error return stock in m_trade_list!", iter->datetime,
-                             iter->stock.market_code());
+                    HKU_WARN("{} {} Error return stock in m_trade_list!", record.datetime,
+                             record.stock.market_code());
 
                 } else {
                     BorrowRecord& bor = bor_stock_iter->second;
-                    size_t remain_num = iter->number;
+                    double remain_num = record.number;
                     do {
                         list<BorrowRecord::Data>::iterator bor_iter = bor.record_list.begin();
                         if (remain_num == bor_iter->number) {
-                            funds.borrow_asset -=
-                              roundEx(bor_iter->price * remain_num * iter->stock.unit(), precision);
+                            borrow_asset -=
+                              roundEx(bor_iter->price * remain_num * record.stock.unit(), precision);
                             bor.record_list.pop_front();
                             break;
 
                         } else if (remain_num < bor_iter->number) {
-                            funds.borrow_asset -=
-                              roundEx(bor_iter->price * remain_num * iter->stock.unit(), precision);
+                            borrow_asset -=
+                              roundEx(bor_iter->price * remain_num * record.stock.unit(), precision);
                             bor_iter->number -= remain_num;
                             break;
 
                         } else {  // remain_num > bor_iter->number
-                            funds.borrow_asset -= roundEx(
-                              bor_iter->price * bor_iter->number * iter->stock.unit(), precision);
+                            borrow_asset -= roundEx(
+                              bor_iter->price * bor_iter->number * record.stock.unit(), precision);
                             remain_num -= bor_iter->number;
                             bor.record_list.pop_front();
                         }
@@ -1426,40 +1431,46 @@ FundsRecord TradeManager::getFunds(const Datetime& indatetime, KQuery::KType kty
 
             default:
                 HKU_WARN("{} {} Unknown business in m_trade_list!", datetime,
-                         iter->stock.market_code());
+                         record.stock.market_code());
                 break;
         }
     }
+}
 
-    stock_iter = stock_map.begin();
-    for (; stock_iter != stock_map.end(); ++stock_iter) {
-        const size_t& number = stock_iter->second.number;
-        if (number == 0) {
+FundsRecord TradeManager::FundsReplay::funds(const Datetime& datetime, KQuery::KType ktype,
+                                             int precision) const {
+    price_t market_value = 0.0;
+    for (auto iter = stock_map.begin(); iter != stock_map.end(); ++iter) {
+        double number = iter->second.number;
+        if (number == 0.0) {
             continue;
         }
 
-        price_t price = stock_iter->second.stock.getMarketValue(datetime, ktype);
+        price_t price = iter->second.stock.getMarketValue(datetime, ktype);
         market_value =
-          roundEx(market_value + price * number * stock_iter->second.stock.unit(), precision);
+          roundEx(market_value + price * number * iter->second.stock.unit(), precision);
     }
 
-    short_stock_iter = short_stock_map.begin();
-    for (; short_stock_iter != short_stock_map.end(); ++short_stock_iter) {
-        const size_t& number = short_stock_iter->second.number;
-        if (number == 0) {
+    price_t short_market_value = 0.0;
+    for (auto iter = short_stock_map.begin(); iter != short_stock_map.end(); ++iter) {
+        double number = iter->second.number;
+        if (number == 0.0) {
             continue;
         }
 
-        price_t price = short_stock_iter->second.stock.getMarketValue(datetime, ktype);
+        price_t price = iter->second.stock.getMarketValue(datetime, ktype);
         short_market_value =
-          roundEx(short_market_value + price * number * stock_iter->second.stock.unit(), precision);
+          roundEx(short_market_value + price * number * iter->second.stock.unit(), precision);
     }
 
+    FundsRecord funds;
     funds.cash = cash;
     funds.market_value = market_value;
     funds.short_market_value = short_market_value;
     funds.base_cash = checkin_cash - checkout_cash;
     funds.base_asset = checkin_stock - checkout_stock;
+    funds.borrow_cash = borrow_cash;
+    funds.borrow_asset = borrow_asset;
     return funds;
 }
 
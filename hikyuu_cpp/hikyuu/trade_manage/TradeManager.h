@@ -383,6 +383,38 @@ private:
     bool _add_sell_short_tr(const TradeRecord&);
     bool _add_buy_short_tr(const TradeRecord&);
 
+    // 历史资产查询时的交易记录回放状态，按时间顺序查询时可从上次位置继续回放，
+    // 避免每次查询都从头遍历全部交易记录
+    struct FundsReplay {
+        struct StockNumber {
+            StockNumber() = default;
+            StockNumber(const Stock& stock, double number) : stock(stock), number(number) {}
+
+            Stock stock;
+            double number{0.0};
+        };
+
+        explicit FundsReplay(price_t init_cash) : cash(init_cash) {}
+
+        /** 回放交易记录至指定时刻（含） */
+        void replay(const TradeRecordList& trade_list, const Datetime& datetime, int precision);
+
+        /** 以当前回放状态计算指定时刻的资产 */
+        FundsRecord funds(const Datetime& datetime, KQuery::KType ktype, int precision) const;
+
+        size_t pos{0};  // 已回放的交易记录数
+        price_t cash{0.0};
+        price_t checkin_cash{0.0};
+        price_t checkout_cash{0.0};
+        price_t checkin_stock{0.0};
+        price_t checkout_stock{0.0};
+        price_t borrow_cash{0.0};
+        price_t borrow_asset{0.0};
+        map<uint64_t, StockNumber> stock_map;
+        map<uint64_t, StockNumber> short_stock_map;
+        map<uint64_t, BorrowRecord> bor_stock_map;
+    };
+
 private:
     Datetime m_init_datetime;         // 账户建立日期
     price_t m_init_cash;              // 初始资金
@@ -413,6 +445,9 @@ private:
 
     list<string> m_actions;  // 记录交易动作，便于修改或校准实盘时的交易
 
+    // 历史资产查询的回放状态缓存，不参与复制与序列化，仅通过 std::atomic_exchange 等原子操作访问
+    std::shared_ptr<FundsReplay> m_funds_replay;
+
 //==================================================
 // 支持序列化
 //==================================================
@@ -15,6 +15,11 @@
 
 #include "../serialization/Datetime_serialization.h"
 #include "../serialization/Stock_serialization.h"
+#include "../serialization/BinaryArray_serialization.h"
+
+#if HKU_SUPPORT_SERIALIZATION
+#include <boost/serialization/version.hpp>
+#endif
 
 namespace hku {
 
@@ -160,4 +165,133 @@ template <>
 struct fmt::formatter<hku::TradeRecord> : ostream_formatter {};
 #endif
 
+#if HKU_SUPPORT_SERIALIZATION && HKU_SUPPORT_BINARY_ARCHIVE
+namespace boost {
+namespace serialization {
+
+// 二进制归档中的 TradeRecordList 按列整体读写，证券仅保存一次编码表（类版本 1）
+inline constexpr hku::price_t hku::TradeRecord::*g_trade_record_price_fields[] = {
+  &hku::TradeRecord::planPrice, &hku::TradeRecord::realPrice, &hku::TradeRecord::goalPrice,
+  &hku::TradeRecord::number,    &hku::TradeRecord::stoploss,  &hku::TradeRecord::cash};
+
+inline constexpr hku::price_t hku::CostRecord::*g_trade_record_cost_fields[] = {
+  &hku::CostRecord::commission, &hku::CostRecord::stamptax, &hku::CostRecord::transferfee,
+  &hku::CostRecord::others, &hku::CostRecord::total};
+
+inline void serialize(boost::archive::binary_oarchive& ar, hku::TradeRecordList& trades,
+                      const unsigned int version) {
+    size_t total = trades.size();
+    std::vector<hku::string> codes;
+    std::unordered_map<hku::string, uint32_t> code_index;
+    std::vector<uint32_t> stocks(total);
+    std::vector<hku::uint64_t> dates(total);
+    std::vector<uint8_t> parts(total * 2);
+    std::vector<hku::string> remarks(total);
+    for (size_t i = 0; i < total; i++) {
+        const auto& trade = trades[i];
+        hku::string code = trade.stock.isNull() ? hku::string() : trade.stock.market_code();
+        auto iter = code_index.find(code);
+        if (iter == code_index.end()) {
+            iter = code_index.emplace(code, static_cast<uint32_t>(codes.size())).first;
+            codes.push_back(code);
+        }
+        stocks[i] = iter->second;
+        dates[i] = trade.datetime.number();
+        parts[2 * i] = static_cast<uint8_t>(trade.business);
+        parts[2 * i + 1] = static_cast<uint8_t>(trade.from);
+        remarks[i] = trade.remark;
+    }
+
+    hku::uint64_t count = total;
+    ar << count << codes;
+    if (total > 0) {
+        ar.save_binary(stocks.data(), total * sizeof(uint32_t));
+        ar.save_binary(dates.data(), total * sizeof(hku::uint64_t));
+        ar.save_binary(parts.data(), parts.size());
+    }
+
+    hku::PriceList column(total);
+    for (auto field : g_trade_record_price_fields) {
+        for (size_t i = 0; i < total; i++) {
+            column[i] = trades[i].*field;
+        }
+        hku::saveBinaryArray(ar, column.data(), total);
+    }
+    for (auto field : g_trade_record_cost_fields) {
+        for (size_t i = 0; i < total; i++) {
+            column[i] = trades[i].cost.*field;
+        }
+        hku::saveBinaryArray(ar, column.data(), total);
+    }
+    ar << remarks;
+}
+
+inline void serialize(boost::archive::binary_iarchive& ar, hku::TradeRecordList& trades,
+                      const unsigned int version) {
+    if (version == 0) {
+        // 版本 0 为逐条记录存放的旧格式
+        boost::serialization::load(ar, trades, version);
+        return;
+    }
+
+    hku::uint64_t total = 0;
+    std::vector<hku::string> codes;
+    ar >> total >> codes;
+    std::vector<uint32_t> stocks(total);
+    std::vector<hku::uint64_t> dates(total);
+    std::vector<uint8_t> parts(total * 2);
+    if (total > 0) {
+        ar.load_binary(stocks.data(), total * sizeof(uint32_t));
+        ar.load_binary(dates.data(), total * sizeof(hku::uint64_t));
+        ar.load_binary(parts.data(), parts.size());
+    }
+
+    std::vector<hku::Stock> stock_table(codes.size());
+    for (size_t i = 0; i < codes.size(); i++) {
+        if (!codes[i].empty()) {
+            stock_table[i] = hku::getStock(codes[i]);
+        }
+    }
+
+    trades.resize(total);
+    for (size_t i = 0; i < total; i++) {
+        auto& trade = trades[i];
+        HKU_CHECK(stocks[i] < stock_table.size(), "Invalid TradeRecordList binary archive!");
+        trade.stock = stock_table[stocks[i]];
+        trade.datetime = hku::Datetime(dates[i]);
+        trade.business = static_cast<hku::BUSINESS>(parts[2 * i]);
+        trade.from = static_cast<hku::SystemPart>(parts[2 * i + 1]);
+    }
+
+    hku::PriceList column;
+    for (auto field : g_trade_record_price_fields) {
+        hku::loadBinaryArray(ar, column);
+        HKU_CHECK(column.size() == total, "Invalid TradeRecordList binary archive!");
+        for (size_t i = 0; i < total; i++) {
+            trades[i].*field = column[i];
+        }
+    }
+    for (auto field : g_trade_record_cost_fields) {
+        hku::loadBinaryArray(ar, column);
+        HKU_CHECK(column.size() == total, "Invalid TradeRecordList binary archive!");
+        for (size_t i = 0; i < total; i++) {
+            trades[i].cost.*field = column[i];
+        }
+    }
+
+    std::vector<hku::string> remarks;
+    ar >> remarks;
+    HKU_CHECK(remarks.size() == total, "Invalid TradeRecordList binary archive!");
+    for (size_t i = 0; i < total; i++) {
+        trades[i].remark = std::move(remarks[i]);
+    }
+}
+
+}  // namespace serialization
+}  // namespace boost
+
+// 版本 1: 二进制归档中的 TradeRecordList 改为按列存放
+BOOST_CLASS_VERSION(hku::TradeRecordList, 1)
+#endif /* HKU_SUPPORT_SERIALIZATION && HKU_SUPPORT_BINARY_ARCHIVE */
+
 #endif /* TRADERECORD_H_ */
@@ -14,4 +14,9 @@ TradeManagerPtr HKU_API crtTM(const Datetime& datetime, price_t initcash,
     return make_shared<TradeManager>(datetime, initcash, costfunc, name);
 }
 
+TradeManagerPtr HKU_API crtFastStatsTM(const Datetime& datetime, price_t initcash,
+                                       const TradeCostPtr& costfunc, const string& name) {
+    return make_shared<FastStatsTradeManager>(datetime, initcash, costfunc, name);
+}
+
 }  // namespace hku
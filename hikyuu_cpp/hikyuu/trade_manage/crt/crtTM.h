@@ -10,6 +10,7 @@
 #define CRTTM_H_
 
 #include "../TradeManager.h"
+#include "../FastStatsTradeManager.h"
 #include "TC_Zero.h"
 
 namespace hku {
@@ -28,6 +29,21 @@ TradeManagerPtr HKU_API crtTM(const Datetime& datetime = Datetime(199001010000LL
                               price_t initcash = 100000.0, const TradeCostPtr& costfunc = TC_Zero(),
                               const string& name = "SYS");
 
+/**
+ * 创建快速统计模式的交易管理模块，只保留资金曲线及绩效统计所需的数据，不生成交易记录
+ * @details 用于只关注统计结果的大批量单证券回测筛选，仅支持多头交易
+ * @ingroup TradeManagerClass
+ * @param datetime 账户建立日期, 默认1990-1-1
+ * @param initcash 初始现金，默认100000
+ * @param costfunc 交易成本算法,默认零成本算法
+ * @param name 账户名称，默认“SYS”
+ * @see FastStatsTradeManager
+ */
+TradeManagerPtr HKU_API crtFastStatsTM(const Datetime& datetime = Datetime(199001010000LL),
+                                       price_t initcash = 100000.0,
+                                       const TradeCostPtr& costfunc = TC_Zero(),
+                                       const string& name = "SYS");
+
 }  // namespace hku
 
 #endif /* CRTTM_H_ */
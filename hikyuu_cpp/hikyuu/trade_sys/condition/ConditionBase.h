@@ -90,6 +90,14 @@ public:
      */
     bool isValid(const Datetime& datetime);
 
+    /**
+     * 指定位置系统是否有效
+     * @param pos 在 setTO 指定的交易对象中的位置
+     */
+    bool isValidAt(size_t pos) const {
+        return pos < m_values.size() && m_values[pos] > 0.;
+    }
+
     /** 子类计算接口 */
     virtual void _calculate() = 0;
 
@@ -105,6 +105,24 @@ price_t EnvironmentBase::getValue(const Datetime& datetime) const {
     return iter == m_date_index.end() ? 0. : m_values[iter->second];
 }
 
+vector<uint8_t> EnvironmentBase::getValidList(const KData& kdata) const {
+    size_t total = kdata.size();
+    vector<uint8_t> result(total, 0);
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    auto iter = m_date_index.cbegin();
+    auto end = m_date_index.cend();
+    for (size_t i = 0; i < total && iter != end; i++) {
+        const Datetime& datetime = kdata[i].datetime;
+        while (iter != end && iter->first < datetime) {
+            ++iter;
+        }
+        if (iter != end && iter->first == datetime) {
+            result[i] = m_values[iter->second] > 0. ? 1 : 0;
+        }
+    }
+    return result;
+}
+
 Indicator EnvironmentBase::getValues() const {
     std::shared_lock<std::shared_mutex> lock(m_mutex);
     DatetimeList dates;
@@ -78,6 +78,13 @@ public:
 
     price_t getValue(const Datetime& datetime) const;
 
+    /**
+     * 按指定K线逐位置判断外部环境是否有效，结果与 kdata 等长
+     * @note 仅加锁一次并按日期顺序归并，适用于按位置遍历K线的场景
+     * @param kdata 按日期升序的K线数据
+     */
+    vector<uint8_t> getValidList(const KData& kdata) const;
+
     /**
      * 以指标的形式获取实际值，与交易对象等长，<=0表示无效，>0表示系统有效
      * @note 带日期的时间序列指标
@@ -7,7 +7,7 @@
 
 #include <cmath>
 #include "hikyuu/utilities/thread/algorithm.h"
-#include "hikyuu/indicator/crt/ALIGN.h"
+#include "hikyuu/indicator/crt/KDATA.h"
 #include "hikyuu/indicator/crt/ROCP.h"
 #include "hikyuu/indicator/crt/REF.h"
 #include "hikyuu/indicator/crt/PRICELIST.h"
@@ -15,7 +15,6 @@
 #include "hikyuu/indicator/crt/ICIR.h"
 #include "hikyuu/indicator/crt/SPEARMAN.h"
 #include "hikyuu/indicator/crt/CORR.h"
-#include "hikyuu/indicator/crt/ZSCORE.h"
 #include "MultiFactorBase.h"
 
 namespace hku {
@@ -364,8 +363,8 @@ Indicator MultiFactorBase::getIC(int ndays) {
     size_t discard = ndays;
     size_t ind_count = m_all_factors.size();
     for (size_t i = 0; i < ind_count; i++) {
-        if (all_returns[i].discard() > discard) {
-            discard = all_returns[i].discard();
+        if (all_returns->discard(i) > discard) {
+            discard = all_returns->discard(i);
         }
         if (m_all_factors[i].discard() > discard) {
             discard = m_all_factors[i].discard();
@@ -387,19 +386,21 @@ Indicator MultiFactorBase::getIC(int ndays) {
         spearman = hku::CORR;
     }
 
-    PriceList tmp(ind_count, Null<price_t>());
-    PriceList tmp_return(ind_count, Null<price_t>());
     auto* dst = result.data();
-    for (size_t i = discard; i < days_total; i++) {
-        for (size_t j = 0; j < ind_count; j++) {
-            tmp[j] = m_all_factors[j][i];
-            tmp_return[j] = all_returns[j][i];
-        }
-        auto a = PRICELIST(tmp);
-        auto b = PRICELIST(tmp_return);
-        auto ic = spearman(a, b, ind_count, true);
-        dst[i] = ic[ic.size() - 1];
-    }
+    parallel_for_index_void(
+      discard, days_total,
+      [&](size_t i) {
+          PriceList tmp(ind_count, Null<price_t>());
+          for (size_t j = 0; j < ind_count; j++) {
+              tmp[j] = m_all_factors[j][i];
+          }
+          const auto* return_row = all_returns->row(i);
+          auto a = PRICELIST(tmp);
+          auto b = PRICELIST(PriceList(return_row, return_row + ind_count));
+          auto ic = spearman(a, b, ind_count, true);
+          dst[i] = ic[ic.size() - 1];
+      },
+      0, ParallelSchedule::DYNAMIC);
 
     // 如果 ndays 和 ic_n 参数相同，缓存计算结果
     if (ic_n == ndays) {
@@ -417,22 +418,9 @@ Indicator MultiFactorBase::getICIR(int ir_n, int ic_n) {
     return x;
 }
 
-IndicatorList MultiFactorBase::_getAllReturns(int ndays) const {
-    bool fill_null = getParam<bool>("fill_null");
-#if !MF_USE_MULTI_THREAD
-    vector<Indicator> all_returns;
-    all_returns.reserve(m_stks.size());
-    for (const auto& stk : m_stks) {
-        auto k = stk.getKData(m_query);
-        all_returns.emplace_back(ALIGN(REF(ROCP(k.close(), ndays), ndays), m_ref_dates, fill_null));
-    }
-    return all_returns;
-#else
-    return parallel_for_index(0, m_stks.size(), [this, ndays, fill_null](size_t i) {
-        auto k = m_stks[i].getKData(m_query);
-        return ALIGN(REF(ROCP(k.close(), ndays), ndays), m_ref_dates, fill_null);
-    });
-#endif
+IndicatorPanelPtr MultiFactorBase::_getAllReturns(int ndays) const {
+    return IndicatorPanel::create(REF(ROCP(CLOSE(), ndays), ndays), m_stks, m_query, m_ref_dates,
+                                  getParam<bool>("fill_null"), getParam<bool>("parallel"));
 }
 
 vector<IndicatorList> MultiFactorBase::getAllSrcFactors() {
@@ -441,100 +429,36 @@ vector<IndicatorList> MultiFactorBase::getAllSrcFactors() {
     HKU_IF_RETURN(stk_count == 0, all_stk_inds);
     all_stk_inds.resize(stk_count);
 
-    size_t days_total = m_ref_dates.size();
-    auto null_ind = PRICELIST(PriceList(days_total, Null<price_t>()), m_ref_dates);
-
     bool fill_null = getParam<bool>("fill_null");
+    bool parallel = getParam<bool>("parallel");
+    bool min_max_normalize = getParam<bool>("enable_min_max_normalize");
+    bool zscore = getParam<bool>("enable_zscore");
     size_t ind_count = m_inds.size();
+    for (size_t si = 0; si < stk_count; si++) {
+        all_stk_inds[si].resize(ind_count);
+    }
 
-    bool parallel = getParam<bool>("parallel");
-    if (parallel) {
-        parallel_for_index_void(
-          0, stk_count, [this, &all_stk_inds, &null_ind, &ind_count, &fill_null](size_t i) {
-              const auto& stk = m_stks[i];
-              auto kdata = stk.getKData(m_query);
-              auto& cur_stk_inds = all_stk_inds[i];
-              cur_stk_inds.resize(ind_count);
-              for (size_t j = 0; j < ind_count; j++) {
-                  if (kdata.size() == 0) {
-                      cur_stk_inds[j] = null_ind;
-                  } else {
-                      cur_stk_inds[j] = ALIGN(m_inds[j](kdata), m_ref_dates, fill_null);
-                  }
-                  cur_stk_inds[j].name(m_inds[j].name());
-              }
-          });
+    for (size_t ii = 0; ii < ind_count; ii++) {
+        // 各因子按截面面板计算，相同因子可与 IC/ICIR 等共享计算结果
+        IndicatorPanelPtr panel =
+          IndicatorPanel::create(m_inds[ii], m_stks, m_query, m_ref_dates, fill_null, parallel);
 
-    } else {
-        for (size_t i = 0; i < stk_count; i++) {
-            const auto& stk = m_stks[i];
-            auto kdata = stk.getKData(m_query);
-            auto& cur_stk_inds = all_stk_inds[i];
-            cur_stk_inds.resize(ind_count);
-            for (size_t j = 0; j < ind_count; j++) {
-                if (kdata.size() == 0) {
-                    cur_stk_inds[j] = null_ind;
-                } else {
-                    cur_stk_inds[j] = ALIGN(m_inds[j](kdata), m_ref_dates, fill_null);
-                }
-                cur_stk_inds[j].name(m_inds[j].name());
-            }
+        // 每日截面归一化
+        if (min_max_normalize) {
+            panel = make_shared<const IndicatorPanel>(panel->normalize());
         }
-    }
 
-    // 每日截面归一化
-    if (getParam<bool>("enable_min_max_normalize")) {
-        for (size_t di = 0; di < days_total; di++) {
-            for (size_t ii = 0; ii < ind_count; ii++) {
-                Indicator::value_t min_value = std::numeric_limits<Indicator::value_t>::max();
-                Indicator::value_t max_value = std::numeric_limits<Indicator::value_t>::min();
-                for (size_t si = 0; si < stk_count; si++) {
-                    auto value = all_stk_inds[si][ii][di];
-                    if (!std::isnan(value)) {
-                        if (value > max_value) {
-                            max_value = value;
-                        } else if (value < min_value) {
-                            min_value = value;
-                        }
-                    }
-                }
-
-                if (max_value == min_value ||
-                    max_value == std::numeric_limits<Indicator::value_t>::max()) {
-                    for (size_t si = 0; si < stk_count; si++) {
-                        auto* dst = all_stk_inds[si][ii].data();
-                        dst[di] = Null<Indicator::value_t>();
-                    }
-                } else {
-                    Indicator::value_t diff = max_value - min_value;
-                    for (size_t si = 0; si < stk_count; si++) {
-                        auto* dst = all_stk_inds[si][ii].data();
-                        dst[di] = (dst[di] - min_value) / diff;
-                    }
-                }
-            }
+        // 每日截面标准化
+        if (zscore) {
+            panel = make_shared<const IndicatorPanel>(panel->zscore(
+              getParam<bool>("zscore_out_extreme"), getParam<double>("zscore_nsigma"),
+              getParam<bool>("zscore_recursive")));
         }
-    }
 
-    // 每日截面标准化
-    if (getParam<bool>("enable_zscore")) {
-        Indicator one_day = PRICELIST(PriceList(stk_count, Null<price_t>()));
-        for (size_t di = 0; di < days_total; di++) {
-            for (size_t ii = 0; ii < ind_count; ii++) {
-                auto* one_day_data = one_day.data();
-                for (size_t si = 0; si < stk_count; si++) {
-                    one_day_data[si] = all_stk_inds[si][ii][di];
-                }
-
-                auto new_value =
-                  ZSCORE(one_day, getParam<bool>("zscore_out_extreme"),
-                         getParam<double>("zscore_nsigma"), getParam<bool>("zscore_recursive"));
-
-                for (size_t si = 0; si < stk_count; si++) {
-                    auto* dst = all_stk_inds[si][ii].data();
-                    dst[di] = new_value[si];
-                }
-            }
+        const string& name = m_inds[ii].name();
+        for (size_t si = 0; si < stk_count; si++) {
+            all_stk_inds[si][ii] = panel->getIndicator(si);
+            all_stk_inds[si][ii].name(name);
         }
     }
 
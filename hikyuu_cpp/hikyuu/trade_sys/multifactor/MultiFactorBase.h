@@ -8,6 +8,7 @@
 #pragma once
 
 #include "hikyuu/KData.h"
+#include "hikyuu/indicator/IndicatorPanel.h"
 #include "ScoreRecord.h"
 
 #define MF_USE_MULTI_THREAD 1
@@ -157,7 +158,7 @@ protected:
     void _buildIndexAsc();   // 创建升序排列的索引
     void _buildIndexNone();  // build index when no index
 
-    IndicatorList _getAllReturns(int ndays) const;
+    IndicatorPanelPtr _getAllReturns(int ndays) const;
     void _checkData();
 
 protected:
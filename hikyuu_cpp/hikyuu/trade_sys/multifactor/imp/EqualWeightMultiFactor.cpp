@@ -72,42 +72,45 @@ vector<Indicator> EqualWeightMultiFactor::_calculate(
     return all_factors;
 #endif
 
-    return parallel_for_index(0, stk_count, [&](size_t si) {
-        vector<price_t> sumByDate(days_total);
-        vector<size_t> countByDate(days_total);
-
-        const auto& curStkInds = all_stk_inds[si];
-        for (size_t di = 0; di < days_total; di++) {
-            for (size_t ii = 0; ii < ind_count; ii++) {
-                const auto& value = curStkInds[ii][di];
-                if (!std::isnan(value)) {
-                    sumByDate[di] += value;
-                    countByDate[di] += 1;
-                }
-            }
-        }
-
-        // 均值权重
-        for (size_t di = 0; di < days_total; di++) {
-            sumByDate[di] =
-              (countByDate[di] == 0) ? Null<value_t>() : sumByDate[di] / countByDate[di];
-        }
-
-        Indicator ret = PRICELIST(sumByDate);
-        ret.name("IC");
-
-        // 更新 discard
-        for (size_t di = 0; di < days_total; di++) {
-            if (!std::isnan(ret[di])) {
-                ret.setDiscard(di);
-                break;
-            }
-            if (di == days_total - 1 && std::isnan(ret[di])) {
-                ret.setDiscard(di);
-            }
-        }
-        return ret;
-    });
+    return parallel_for_index(
+      0, stk_count,
+      [&](size_t si) {
+          vector<price_t> sumByDate(days_total);
+          vector<size_t> countByDate(days_total);
+
+          const auto& curStkInds = all_stk_inds[si];
+          for (size_t di = 0; di < days_total; di++) {
+              for (size_t ii = 0; ii < ind_count; ii++) {
+                  const auto& value = curStkInds[ii][di];
+                  if (!std::isnan(value)) {
+                      sumByDate[di] += value;
+                      countByDate[di] += 1;
+                  }
+              }
+          }
+
+          // 均值权重
+          for (size_t di = 0; di < days_total; di++) {
+              sumByDate[di] =
+                (countByDate[di] == 0) ? Null<value_t>() : sumByDate[di] / countByDate[di];
+          }
+
+          Indicator ret = PRICELIST(sumByDate);
+          ret.name("IC");
+
+          // 更新 discard
+          for (size_t di = 0; di < days_total; di++) {
+              if (!std::isnan(ret[di])) {
+                  ret.setDiscard(di);
+                  break;
+              }
+              if (di == days_total - 1 && std::isnan(ret[di])) {
+                  ret.setDiscard(di);
+              }
+          }
+          return ret;
+      },
+      0, ParallelSchedule::GUIDED);
 }
 
 MultiFactorPtr HKU_API MF_EqualWeight() {
@@ -56,10 +56,12 @@ IndicatorList ICMultiFactor::_calculate(const vector<IndicatorList>& all_stk_ind
         }
     }
 #else
-    IndicatorList ic =
-      parallel_for_index(0, ind_count, [this, ic_n, ic_rolling_n, spearman](size_t ii) {
+    IndicatorList ic = parallel_for_index(
+      0, ind_count,
+      [this, ic_n, ic_rolling_n, spearman](size_t ii) {
           return MA(IC(m_inds[ii], m_stks, m_query, m_ref_stk, ic_n, spearman), ic_rolling_n);
-      });
+      },
+      1, ParallelSchedule::DYNAMIC);
     size_t discard = 0;
     for (size_t ii = 0; ii < ind_count; ii++) {
         if (ic[ii].discard() > discard) {
@@ -108,40 +110,43 @@ IndicatorList ICMultiFactor::_calculate(const vector<IndicatorList>& all_stk_ind
     return all_factors;
 
 #else
-    return parallel_for_index(0, stk_count, [&, ind_count, days_total, discard](size_t si) {
-        PriceList new_values(days_total, 0.0);
-        PriceList sum_weight(days_total, 0.0);
-        for (size_t di = 0; di < discard; di++) {
-            new_values[di] = Null<price_t>();
-        }
-
-        for (size_t ii = 0; ii < ind_count; ii++) {
-            const auto* ind_data = all_stk_inds[si][ii].data();
-            const auto* ic_data = ic[ii].data();
-            for (size_t di = discard; di < days_total; di++) {
-                new_values[di] += ind_data[di] * ic_data[di];
-                sum_weight[di] += std::abs(ic_data[di]);
-            }
-        }
-
-        for (size_t di = discard; di < days_total; di++) {
-            if (!std::isnan(new_values[di]) && sum_weight[di] != 0.0) {
-                new_values[di] = new_values[di] / sum_weight[di];
-            }
-        }
-
-        Indicator ret = PRICELIST(new_values);
-        ret.name("IC");
-
-        const auto* data = ret.data();
-        for (size_t di = discard; di < days_total; di++) {
-            if (!std::isnan(data[di])) {
-                ret.setDiscard(discard);
-            }
-        }
-
-        return ret;
-    });
+    return parallel_for_index(
+      0, stk_count,
+      [&, ind_count, days_total, discard](size_t si) {
+          PriceList new_values(days_total, 0.0);
+          PriceList sum_weight(days_total, 0.0);
+          for (size_t di = 0; di < discard; di++) {
+              new_values[di] = Null<price_t>();
+          }
+
+          for (size_t ii = 0; ii < ind_count; ii++) {
+              const auto* ind_data = all_stk_inds[si][ii].data();
+              const auto* ic_data = ic[ii].data();
+              for (size_t di = discard; di < days_total; di++) {
+                  new_values[di] += ind_data[di] * ic_data[di];
+                  sum_weight[di] += std::abs(ic_data[di]);
+              }
+          }
+
+          for (size_t di = discard; di < days_total; di++) {
+              if (!std::isnan(new_values[di]) && sum_weight[di] != 0.0) {
+                  new_values[di] = new_values[di] / sum_weight[di];
+              }
+          }
+
+          Indicator ret = PRICELIST(new_values);
+          ret.name("IC");
+
+          const auto* data = ret.data();
+          for (size_t di = discard; di < days_total; di++) {
+              if (!std::isnan(data[di])) {
+                  ret.setDiscard(discard);
+              }
+          }
+
+          return ret;
+      },
+      0, ParallelSchedule::GUIDED);
 #endif
 }
 
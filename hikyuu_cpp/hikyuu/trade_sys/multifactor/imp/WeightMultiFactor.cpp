@@ -72,41 +72,44 @@ vector<Indicator> WeightMultiFactor::_calculate(const vector<vector<Indicator>>&
     return all_factors;
 #endif
 
-    return parallel_for_index(0, stk_count, [&](size_t si) {
-        vector<price_t> sumByDate(days_total);
-
-        size_t discard = 0;
-        const auto& curStkInds = all_stk_inds[si];
-        for (size_t ii = 0; ii < ind_count; ii++) {
-            if (curStkInds[ii].discard() > discard) {
-                discard = curStkInds[ii].discard();
-            }
-        }
-
-        for (size_t di = discard; di < days_total; di++) {
-            for (size_t ii = 0; ii < ind_count; ii++) {
-                const auto& value = curStkInds[ii][di];
-                if (!std::isnan(value)) {
-                    sumByDate[di] += value * m_weights[ii];
-                }
-            }
-        }
-
-        Indicator ret = PRICELIST(sumByDate);
-        ret.name("IC");
-
-        // 更新 discard
-        for (size_t di = discard; di < days_total; di++) {
-            if (!std::isnan(ret[di])) {
-                ret.setDiscard(di);
-                break;
-            }
-            if (di == days_total - 1 && std::isnan(ret[di])) {
-                ret.setDiscard(di);
-            }
-        }
-        return ret;
-    });
+    return parallel_for_index(
+      0, stk_count,
+      [&](size_t si) {
+          vector<price_t> sumByDate(days_total);
+
+          size_t discard = 0;
+          const auto& curStkInds = all_stk_inds[si];
+          for (size_t ii = 0; ii < ind_count; ii++) {
+              if (curStkInds[ii].discard() > discard) {
+                  discard = curStkInds[ii].discard();
+              }
+          }
+
+          for (size_t di = discard; di < days_total; di++) {
+              for (size_t ii = 0; ii < ind_count; ii++) {
+                  const auto& value = curStkInds[ii][di];
+                  if (!std::isnan(value)) {
+                      sumByDate[di] += value * m_weights[ii];
+                  }
+              }
+          }
+
+          Indicator ret = PRICELIST(sumByDate);
+          ret.name("IC");
+
+          // 更新 discard
+          for (size_t di = discard; di < days_total; di++) {
+              if (!std::isnan(ret[di])) {
+                  ret.setDiscard(di);
+                  break;
+              }
+              if (di == days_total - 1 && std::isnan(ret[di])) {
+                  ret.setDiscard(di);
+              }
+          }
+          return ret;
+      },
+      0, ParallelSchedule::GUIDED);
 }
 
 MultiFactorPtr HKU_API MF_Weight() {
@@ -187,7 +187,8 @@ void OptimalSelectorBase::_calculate_parallel(const vector<std::pair<size_t, siz
                                               bool trace) {
     // SPEND_TIME(OptimalSelectorBase_calculate_parallel);
     auto sys_list = parallel_for_index(
-      0, train_ranges.size(), [this, &train_ranges, &dates, query = m_query, trace](size_t i) {
+      0, train_ranges.size(),
+      [this, &train_ranges, &dates, query = m_query, trace](size_t i) {
           Datetime start_date = dates[train_ranges[i].first];
           Datetime end_date = dates[train_ranges[i].second];
           KQuery q = KQueryByDate(start_date, end_date, query.kType(), query.recoverType());
@@ -217,7 +218,8 @@ void OptimalSelectorBase::_calculate_parallel(const vector<std::pair<size_t, siz
                 [](const SystemWeight& a, const SystemWeight& b) { return a.weight > b.weight; });
           }
           return selected_sys_list;
-      });
+      },
+      1, ParallelSchedule::GUIDED);
 
     size_t dates_len = dates.size();
     for (size_t i = 0, total = train_ranges.size(); i < total; i++) {
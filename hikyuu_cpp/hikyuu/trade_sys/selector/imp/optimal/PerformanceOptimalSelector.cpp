@@ -211,7 +211,8 @@ void PerformanceOptimalSelector::_calculate_parallel(
           }
 
           return selected_sys;
-      });
+      },
+      1, ParallelSchedule::GUIDED);
 
     size_t dates_len = dates.size();
     for (size_t i = 0, total = train_ranges.size(); i < total; i++) {
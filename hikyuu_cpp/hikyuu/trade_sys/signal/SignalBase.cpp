@@ -67,6 +67,8 @@ SignalPtr SignalBase::clone() {
     p->m_hold_short = m_hold_short;
     p->m_buySig = m_buySig;
     p->m_sellSig = m_sellSig;
+    p->m_buy_values = m_buy_values;
+    p->m_sell_values = m_sell_values;
     p->m_cycle_start = m_cycle_start;
     p->m_cycle_end = m_cycle_start;
     return p;
@@ -76,6 +78,7 @@ void SignalBase::setTO(const KData& kdata) {
     HKU_IF_RETURN(m_calculated && m_kdata == kdata, void());
     m_kdata = kdata;
     m_calculated = false;
+    _rebuildPosSignal();
     HKU_IF_RETURN(kdata.empty(), void());
 
     bool cycle = getParam<bool>("cycle");
@@ -92,6 +95,8 @@ void SignalBase::reset() {
     m_kdata = Null<KData>();
     m_buySig.clear();
     m_sellSig.clear();
+    m_buy_values.clear();
+    m_sell_values.clear();
     m_hold_long = false;
     m_hold_short = false;
     m_cycle_start = Null<Datetime>();
@@ -140,9 +145,40 @@ double SignalBase::getSellValue(const Datetime& datetime) const {
     return iter != m_sellSig.end() ? iter->second : 0.0;
 }
 
+void SignalBase::_rebuildPosSignal() {
+    size_t total = m_kdata.size();
+    m_buy_values.assign(total, 0.0);
+    m_sell_values.assign(total, 0.0);
+    HKU_IF_RETURN(total == 0 || (m_buySig.empty() && m_sellSig.empty()), void());
+    for (const auto& sig : m_buySig) {
+        size_t pos = m_kdata.getPos(sig.first);
+        if (pos != Null<size_t>()) {
+            m_buy_values[pos] = sig.second;
+        }
+    }
+    for (const auto& sig : m_sellSig) {
+        size_t pos = m_kdata.getPos(sig.first);
+        if (pos != Null<size_t>()) {
+            m_sell_values[pos] = sig.second;
+        }
+    }
+}
+
+void SignalBase::_updatePosSignal(const Datetime& datetime) {
+    HKU_IF_RETURN(m_buy_values.empty(), void());
+    size_t pos = m_kdata.getPos(datetime);
+    HKU_IF_RETURN(pos == Null<size_t>() || pos >= m_buy_values.size(), void());
+    m_buy_values[pos] = getBuyValue(datetime);
+    m_sell_values[pos] = getSellValue(datetime);
+}
+
 void SignalBase::_addSignal(const Datetime& datetime, double value) {
     HKU_IF_RETURN(iszero(value) || std::isnan(value), void());
+    _addSignalToMap(datetime, value);
+    _updatePosSignal(datetime);
+}
 
+void SignalBase::_addSignalToMap(const Datetime& datetime, double value) {
     double new_value = value + getBuyValue(datetime) + getSellValue(datetime);
     HKU_IF_RETURN(iszero(new_value), void());
 
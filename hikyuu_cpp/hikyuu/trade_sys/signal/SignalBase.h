@@ -44,6 +44,24 @@ public:
      */
     bool shouldSell(const Datetime& datetime) const;
 
+    /**
+     * 指定位置是否可以买入
+     * @param pos 在 setTO 指定的交易对象中的位置
+     */
+    bool shouldBuyAt(size_t pos) const;
+
+    /**
+     * 指定位置是否可以卖出
+     * @param pos 在 setTO 指定的交易对象中的位置
+     */
+    bool shouldSellAt(size_t pos) const;
+
+    /**
+     * 按位置索引的信号表是否已与指定的K线数据逐位置对齐
+     * @note 仅当交易对象与 kdata 一致且信号表已建立时才可使用 shouldBuyAt/shouldSellAt
+     */
+    bool isPosAligned(const KData& kdata) const;
+
     /**
      * 获取指定时刻的买入信号数值，返回值小于等于0时，表示无买入信号
      * @param datetime
@@ -133,6 +151,14 @@ public:
 private:
     void initParam();
 
+    void _addSignalToMap(const Datetime& datetime, double value);
+
+    // 将指定时刻的信号同步至按位置索引的信号表
+    void _updatePosSignal(const Datetime& datetime);
+
+    // 依据当前信号重建与交易对象对齐的按位置索引的信号表
+    void _rebuildPosSignal();
+
 protected:
     string m_name;
     KData m_kdata;
@@ -147,6 +173,10 @@ protected:
     std::map<Datetime, double> m_buySig;
     std::map<Datetime, double> m_sellSig;
 
+    // 与 m_kdata 逐位置对齐的信号值（无信号时为0），供系统按位置遍历时使用
+    vector<double> m_buy_values;
+    vector<double> m_sell_values;
+
     Datetime m_cycle_start;
     Datetime m_cycle_end;
 
@@ -180,6 +210,12 @@ private:
         // m_kdata都是系统运行时临时设置，不需要序列化
         // ar & BOOST_SERIALIZATION_NVP(m_kdata);
         // ar & BOOST_SERIALIZATION_NVP(m_calculated);
+
+        // 按位置索引的信号表依赖 m_kdata，未序列化，需在下次 setTO 时重建
+        m_kdata = KData();
+        m_calculated = false;
+        m_buy_values.clear();
+        m_sell_values.clear();
     }
 
     BOOST_SERIALIZATION_SPLIT_MEMBER()
@@ -252,6 +288,21 @@ inline bool SignalBase::shouldSell(const Datetime& datetime) const {
     return m_sellSig.count(datetime) ? true : false;
 }
 
+inline bool SignalBase::shouldBuyAt(size_t pos) const {
+    return pos < m_buy_values.size() && m_buy_values[pos] != 0.0;
+}
+
+inline bool SignalBase::shouldSellAt(size_t pos) const {
+    return pos < m_sell_values.size() && m_sell_values[pos] != 0.0;
+}
+
+inline bool SignalBase::isPosAligned(const KData& kdata) const {
+    size_t total = kdata.size();
+    HKU_IF_RETURN(m_buy_values.size() != total || m_kdata.size() != total, false);
+    return total == 0 || (m_kdata[0].datetime == kdata[0].datetime &&
+                          m_kdata[total - 1].datetime == kdata[total - 1].datetime);
+}
+
 inline const Datetime& SignalBase::getCycleStart() const {
     return m_cycle_start;
 }
@@ -202,6 +202,7 @@ void System::reset() {
     m_sellRequest.clear();
     m_sellShortRequest.clear();
     m_buyShortRequest.clear();
+    _clearAlignment();
 
     _reset();
 }
@@ -245,10 +246,19 @@ void System::forceResetAll() {
     m_sellRequest.clear();
     m_sellShortRequest.clear();
     m_buyShortRequest.clear();
+    _clearAlignment();
 
     _forceResetAll();
 }
 
+// 判断两份K线数据是否逐位置对应（比较长度及首尾时间）
+static bool isSameKData(const KData& x, const KData& y) {
+    size_t total = x.size();
+    HKU_IF_RETURN(total != y.size(), false);
+    return total == 0 || (x[0].datetime == y[0].datetime &&
+                          x[total - 1].datetime == y[total - 1].datetime);
+}
+
 void System::setTO(const KData& kdata) {
     if (m_kdata != kdata) {
         m_calculated = false;
@@ -264,7 +274,11 @@ void System::setTO(const KData& kdata) {
     } else {
         KQuery no_recover_query = query;
         no_recover_query.recoverType(KQuery::NO_RECOVER);
-        m_src_kdata = m_stock.getKData(no_recover_query);
+        // 已预先指定了对应的未复权数据时直接使用，避免重复获取
+        if (m_src_kdata.getStock() != m_stock || m_src_kdata.getQuery() != no_recover_query ||
+            !isSameKData(m_src_kdata, m_kdata)) {
+            m_src_kdata = m_stock.getKData(no_recover_query);
+        }
     }
     HKU_ASSERT(m_kdata.size() == m_src_kdata.size());
 
@@ -391,6 +405,17 @@ void System::run(const Stock& stock, const KQuery& query, bool reset, bool reset
     run(kdata, reset, resetAll);
 }
 
+void System::run(const KData& kdata, const KData& src_kdata, bool reset, bool resetAll) {
+    HKU_CHECK(kdata.size() == src_kdata.size(), "The size of kdata and src_kdata is not equal!");
+    if (resetAll) {
+        this->forceResetAll();
+    } else if (reset) {
+        this->reset();
+    }
+    m_src_kdata = src_kdata;
+    run(kdata, false, false);
+}
+
 void System::run(const KData& kdata, bool reset, bool resetAll) {
     // reset必须在readyForRun之前，否则m_pre_cn_valid、m_pre_ev_valid将会被赋为错误的初值
     if (resetAll) {
@@ -418,9 +443,10 @@ void System::run(const KData& kdata, bool reset, bool resetAll) {
         tm_last_datetime = tm_last_datetime.startOfDay();
     }
 
+    _alignComponents();
     for (size_t i = 0; i < total; ++i) {
         if (ks[i].datetime >= tm_init_datetime && ks[i].datetime >= tm_last_datetime) {
-            auto tr = _runMoment(ks[i], src_ks[i]);
+            auto tr = _runMoment(i, ks[i], src_ks[i]);
             if (trace) {
                 HKU_INFO_IF(!tr.isNull(), "{}", tr);
                 PositionRecord position = m_tm->getPosition(ks[i].datetime, m_stock);
@@ -439,9 +465,26 @@ void System::run(const KData& kdata, bool reset, bool resetAll) {
             }
         }
     }
+    _clearAlignment();
     m_calculated = true;
 }
 
+void System::_alignComponents() {
+    m_ev_valid_list.clear();
+    if (m_ev) {
+        m_ev_valid_list = m_ev->getValidList(m_kdata);
+    }
+    // 组件的交易对象与系统的交易对象逐位置一致时，才可按位置访问
+    m_cn_aligned = m_cn && isSameKData(m_cn->getTO(), m_kdata);
+    m_sg_aligned = m_sg && m_sg->isPosAligned(m_kdata);
+}
+
+void System::_clearAlignment() {
+    m_ev_valid_list.clear();
+    m_cn_aligned = false;
+    m_sg_aligned = false;
+}
+
 void System::clearDelayBuyRequest() {
     m_buyRequest.clear();
 }
@@ -452,10 +495,10 @@ TradeRecord System::runMoment(const Datetime& datetime) {
 
     KRecord today = m_kdata.getKRecord(pos);
     KRecord src_today = m_src_kdata.getKRecord(pos);
-    return _runMoment(today, src_today);
+    return _runMoment(pos, today, src_today);
 }
 
-TradeRecord System::_runMoment(const KRecord& today, const KRecord& src_today) {
+TradeRecord System::_runMoment(size_t pos, const KRecord& today, const KRecord& src_today) {
     bool trace = getParam<bool>("trace");
     if (trace) {
         HKU_INFO("{} ------------------------------------------------------", today.datetime);
@@ -483,7 +526,7 @@ TradeRecord System::_runMoment(const KRecord& today, const KRecord& src_today) {
     // 处理市场环境策略
     //----------------------------------------------------------
 
-    bool current_ev_valid = _environmentIsValid(today.datetime);
+    bool current_ev_valid = _environmentIsValid(pos, today.datetime);
 
     // 如果当前环境无效
     if (!current_ev_valid) {
@@ -518,7 +561,7 @@ TradeRecord System::_runMoment(const KRecord& today, const KRecord& src_today) {
     // 处理系统有效条件判断策略
     //----------------------------------------------------------
 
-    bool current_cn_valid = _conditionIsValid(today.datetime);
+    bool current_cn_valid = _conditionIsValid(pos, today.datetime);
 
     // 如果系统当前无效
     if (!current_cn_valid) {
@@ -554,7 +597,7 @@ TradeRecord System::_runMoment(const KRecord& today, const KRecord& src_today) {
     //----------------------------------------------------------
 
     // 如果有买入信号
-    if (m_sg->shouldBuy(today.datetime)) {
+    if (_shouldBuy(pos, today.datetime)) {
         TradeRecord tr;
         if (m_tm->haveShort(m_stock)) {
             HKU_INFO_IF(trace, htr("[{}] SG to buy short"), name());
@@ -568,7 +611,7 @@ TradeRecord System::_runMoment(const KRecord& today, const KRecord& src_today) {
     }
 
     // 发出卖出信号
-    if (m_sg->shouldSell(today.datetime)) {
+    if (_shouldSell(pos, today.datetime)) {
         TradeRecord tr;
         if (m_tm->have(m_stock)) {
             HKU_INFO_IF(trace, htr("[{}] SG to sell"), name());
@@ -614,7 +657,6 @@ TradeRecord System::_runMoment(const KRecord& today, const KRecord& src_today) {
                 }
 
                 int tp_delay_n = getParam<int>("tp_delay_n");
-                size_t pos = m_kdata.getPos(today.datetime);
                 size_t position_pos = m_kdata.getPos(position.takeDatetime);
                 // 如果当前价格小于等于止盈价，且满足止盈延迟条件则卖出
                 price_t profit = position.number * src_today.closePrice - position.totalCost;
@@ -205,6 +205,15 @@ public:
      */
     virtual void run(const KData& kdata, bool reset = true, bool resetAll = false);
 
+    /**
+     * @brief 以预先准备好的复权及未复权数据运行系统，用于多个系统共享同一份K线数据
+     * @param kdata 指定的交易对象
+     * @param src_kdata 与 kdata 对应的未复权数据
+     * @param reset 执行前是否依据系统部件共享属性复位
+     * @param resetAll 强制复位所有部件
+     */
+    void run(const KData& kdata, const KData& src_kdata, bool reset = true, bool resetAll = false);
+
     /**
      * @brief 在指定的日期执行一步，仅由 PF 调用
      * @param datetime 指定的日期
@@ -266,8 +275,15 @@ public:
     virtual TradeRecord pfProcessDelayBuyRequest(const Datetime& date);
 
 private:
-    bool _environmentIsValid(const Datetime& datetime);
-    bool _conditionIsValid(const Datetime& datetime);
+    // pos 为当前K线在 m_kdata 中的位置，组件已按位置对齐时直接按位置访问，否则按日期查找
+    bool _environmentIsValid(size_t pos, const Datetime& datetime);
+    bool _conditionIsValid(size_t pos, const Datetime& datetime);
+    bool _shouldBuy(size_t pos, const Datetime& datetime);
+    bool _shouldSell(size_t pos, const Datetime& datetime);
+
+    // 在 run 主循环前，生成与 m_kdata 按位置对齐的环境判定表，并检查信号、条件是否已对齐
+    void _alignComponents();
+    void _clearAlignment();
 
     // 通知所有需要接收实际买入交易记录的部件
     void _buyNotifyAll(const TradeRecord&);
@@ -313,7 +329,7 @@ private:
 
     TradeRecord _processRequest(const KRecord& today, const KRecord& src_today);
 
-    TradeRecord _runMoment(const KRecord& record, const KRecord& src_record);
+    TradeRecord _runMoment(size_t pos, const KRecord& record, const KRecord& src_record);
 
     // Portfolio | AllocateFunds 指示立即进行强制卖出，以便对 buy_delay 的系统进行资金调整
     TradeRecord _sellForce(const Datetime& date, double num, Part from, bool on_open);
@@ -349,6 +365,11 @@ protected:
     TradeRequest m_sellShortRequest;
     TradeRequest m_buyShortRequest;
 
+    // 仅在 run 期间有效，与 m_kdata 按位置对齐
+    vector<uint8_t> m_ev_valid_list;
+    bool m_cn_aligned{false};
+    bool m_sg_aligned{false};
+
 private:
     void initParam();  // 初始化参数及其默认值
 
@@ -587,12 +608,22 @@ inline const TradeRequest& System::getBuyShortTradeRequest() const {
     return m_buyShortRequest;
 }
 
-inline bool System::_environmentIsValid(const Datetime& datetime) {
-    return m_ev ? m_ev->isValid(datetime) : true;
+inline bool System::_environmentIsValid(size_t pos, const Datetime& datetime) {
+    HKU_IF_RETURN(!m_ev, true);
+    return pos < m_ev_valid_list.size() ? m_ev_valid_list[pos] != 0 : m_ev->isValid(datetime);
+}
+
+inline bool System::_conditionIsValid(size_t pos, const Datetime& datetime) {
+    HKU_IF_RETURN(!m_cn, true);
+    return m_cn_aligned ? m_cn->isValidAt(pos) : m_cn->isValid(datetime);
+}
+
+inline bool System::_shouldBuy(size_t pos, const Datetime& datetime) {
+    return m_sg_aligned ? m_sg->shouldBuyAt(pos) : m_sg->shouldBuy(datetime);
 }
 
-inline bool System::_conditionIsValid(const Datetime& datetime) {
-    return m_cn ? m_cn->isValid(datetime) : true;
+inline bool System::_shouldSell(size_t pos, const Datetime& datetime) {
+    return m_sg_aligned ? m_sg->shouldSellAt(pos) : m_sg->shouldSell(datetime);
 }
 
 inline double System ::_getBuyNumber(const Datetime& datetime, price_t price, price_t risk,
@@ -0,0 +1,273 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-16
+ *      Author: fasiondog
+ */
+
+#pragma once
+#ifndef HKU_UTILS_COMPACT_DATETIME_H_
+#define HKU_UTILS_COMPACT_DATETIME_H_
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include "Datetime.h"
+
+namespace hku {
+
+/**
+ * 紧凑日期类型，以距 1970-01-01 00:00:00 的微秒数（int64）保存
+ * @details
+ * <pre>
+ * 供K线缓存、日期查找等热点路径内部使用：比较即整数比较，年月日等分解按整数运算完成，
+ * 均可在编译期求值。与 Datetime 可相互无损转换（精度至微秒），对外接口仍使用 Datetime。
+ * Null 值为 int64 最大值，与 Null<Datetime> 一样大于其他任何日期。
+ * </pre>
+ * @ingroup DataType
+ */
+class CompactDatetime {
+public:
+    static constexpr int64_t TICKS_PER_SECOND = 1000000LL;
+    static constexpr int64_t TICKS_PER_MINUTE = 60LL * TICKS_PER_SECOND;
+    static constexpr int64_t TICKS_PER_HOUR = 60LL * TICKS_PER_MINUTE;
+    static constexpr int64_t TICKS_PER_DAY = 24LL * TICKS_PER_HOUR;
+    static constexpr int64_t NULL_TICKS = std::numeric_limits<int64_t>::max();
+
+    /** 默认构造，Null */
+    constexpr CompactDatetime() noexcept : m_ticks(NULL_TICKS) {}
+
+    /**
+     * 按年月日时分秒构造
+     * @exception std::out_of_range 日期无效时抛出
+     */
+    constexpr CompactDatetime(long year, long month, long day, long hh = 0, long mm = 0,
+                              long sec = 0, long microsec = 0)
+    : m_ticks(0) {
+        if (year < 1400 || year > 9999 || month < 1 || month > 12 || day < 1 ||
+            day > daysInMonth(year, month) || hh < 0 || hh > 23 || mm < 0 || mm > 59 ||
+            sec < 0 || sec > 59 || microsec < 0 || microsec >= TICKS_PER_SECOND) {
+            throw std::out_of_range("Invalid CompactDatetime!");
+        }
+        m_ticks = daysFromCivil(year, month, day) * TICKS_PER_DAY + hh * TICKS_PER_HOUR +
+                  mm * TICKS_PER_MINUTE + sec * TICKS_PER_SECOND + microsec;
+    }
+
+    /** 由 Datetime 转换，Null<Datetime> 转换为 Null */
+    explicit CompactDatetime(const Datetime& d) noexcept : m_ticks(NULL_TICKS) {
+        bt::ptime t = d.ptime();
+        if (!t.is_special()) {
+            m_ticks = (t - epoch()).total_microseconds();
+        }
+    }
+
+    /** 由距 1970-01-01 00:00:00 的微秒数构造 */
+    static constexpr CompactDatetime fromTicks(int64_t ticks) noexcept {
+        CompactDatetime result;
+        result.m_ticks = ticks;
+        return result;
+    }
+
+    /**
+     * 由 YYYYMMDDhhmm 或 YYYYMMDD 格式的数字构造，与 Datetime(unsigned long long) 一致
+     * @exception std::out_of_range 日期无效时抛出
+     */
+    static constexpr CompactDatetime fromNumber(uint64_t number) {
+        if (number <= 99999999ULL) {
+            return CompactDatetime(long(number / 10000), long(number / 100 % 100),
+                                   long(number % 100));
+        }
+        if (number <= 999999999999ULL) {
+            return CompactDatetime(long(number / 100000000ULL), long(number / 1000000 % 100),
+                                   long(number / 10000 % 100), long(number / 100 % 100),
+                                   long(number % 100));
+        }
+        return CompactDatetime(long(number / 10000000000ULL), long(number / 100000000 % 100),
+                               long(number / 1000000 % 100), long(number / 10000 % 100),
+                               long(number / 100 % 100), long(number % 100));
+    }
+
+    /** 转换为 Datetime */
+    Datetime datetime() const {
+        return isNull() ? Datetime() : Datetime(epoch() + bt::microseconds(m_ticks));
+    }
+
+    /** 距 1970-01-01 00:00:00 的微秒数，与 Datetime::timestamp() 相同 */
+    constexpr int64_t ticks() const noexcept {
+        return m_ticks;
+    }
+
+    constexpr bool isNull() const noexcept {
+        return m_ticks == NULL_TICKS;
+    }
+
+    constexpr long year() const noexcept {
+        long y = 0, m = 0, d = 0;
+        civilFromDays(days(), y, m, d);
+        return y;
+    }
+
+    constexpr long month() const noexcept {
+        long y = 0, m = 0, d = 0;
+        civilFromDays(days(), y, m, d);
+        return m;
+    }
+
+    constexpr long day() const noexcept {
+        long y = 0, m = 0, d = 0;
+        civilFromDays(days(), y, m, d);
+        return d;
+    }
+
+    constexpr long hour() const noexcept {
+        return long(timeOfDay() / TICKS_PER_HOUR);
+    }
+
+    constexpr long minute() const noexcept {
+        return long(timeOfDay() / TICKS_PER_MINUTE % 60);
+    }
+
+    constexpr long second() const noexcept {
+        return long(timeOfDay() / TICKS_PER_SECOND % 60);
+    }
+
+    constexpr long microsecond() const noexcept {
+        return long(timeOfDay() % TICKS_PER_SECOND);
+    }
+
+    /** 返回如YYYYMMDD格式的数字，Null 时返回 Null<uint64_t> */
+    constexpr uint64_t ymd() const noexcept {
+        if (isNull()) {
+            return std::numeric_limits<uint64_t>::max();
+        }
+        long y = 0, m = 0, d = 0;
+        civilFromDays(days(), y, m, d);
+        return uint64_t(y) * 10000ULL + uint64_t(m) * 100ULL + uint64_t(d);
+    }
+
+    /** 返回如YYYYMMDDhhmm格式的数字，Null 时返回 Null<uint64_t> */
+    constexpr uint64_t ymdhm() const noexcept {
+        if (isNull()) {
+            return std::numeric_limits<uint64_t>::max();
+        }
+        int64_t tod = timeOfDay();
+        return ymd() * 10000ULL + uint64_t(tod / TICKS_PER_HOUR) * 100ULL +
+               uint64_t(tod / TICKS_PER_MINUTE % 60);
+    }
+
+    /** 返回如YYYYMMDDhhmmss格式的数字，Null 时返回 Null<uint64_t> */
+    constexpr uint64_t ymdhms() const noexcept {
+        if (isNull()) {
+            return std::numeric_limits<uint64_t>::max();
+        }
+        return ymdhm() * 100ULL + uint64_t(timeOfDay() / TICKS_PER_SECOND % 60);
+    }
+
+    /** 同 Datetime::number()，即 ymdhm */
+    constexpr uint64_t number() const noexcept {
+        return ymdhm();
+    }
+
+    /** 返回一周中的第几天，周日为0，周一为1 */
+    constexpr int dayOfWeek() const noexcept {
+        // 1970-01-01 为周四
+        int64_t w = (days() + 4) % 7;
+        return int(w < 0 ? w + 7 : w);
+    }
+
+    /** 当日起始日期，即0点 */
+    constexpr CompactDatetime startOfDay() const noexcept {
+        return isNull() ? *this : fromTicks(days() * TICKS_PER_DAY);
+    }
+
+    CompactDatetime operator+(TimeDelta d) const noexcept {
+        return isNull() ? *this : fromTicks(m_ticks + d.ticks());
+    }
+
+    CompactDatetime operator-(TimeDelta d) const noexcept {
+        return isNull() ? *this : fromTicks(m_ticks - d.ticks());
+    }
+
+    constexpr bool operator==(const CompactDatetime& other) const noexcept {
+        return m_ticks == other.m_ticks;
+    }
+
+    constexpr bool operator!=(const CompactDatetime& other) const noexcept {
+        return m_ticks != other.m_ticks;
+    }
+
+    constexpr bool operator<(const CompactDatetime& other) const noexcept {
+        return m_ticks < other.m_ticks;
+    }
+
+    constexpr bool operator<=(const CompactDatetime& other) const noexcept {
+        return m_ticks <= other.m_ticks;
+    }
+
+    constexpr bool operator>(const CompactDatetime& other) const noexcept {
+        return m_ticks > other.m_ticks;
+    }
+
+    constexpr bool operator>=(const CompactDatetime& other) const noexcept {
+        return m_ticks >= other.m_ticks;
+    }
+
+    /** 指定年月的天数 */
+    static constexpr long daysInMonth(long year, long month) noexcept {
+        return month == 2 ? ((year % 4 == 0 && year % 100 != 0) || year % 400 == 0 ? 29 : 28)
+                          : (month == 4 || month == 6 || month == 9 || month == 11 ? 30 : 31);
+    }
+
+    /** 公历日期距 1970-01-01 的天数 */
+    static constexpr int64_t daysFromCivil(long year, long month, long day) noexcept {
+        int64_t y = year - (month <= 2 ? 1 : 0);
+        int64_t era = (y >= 0 ? y : y - 399) / 400;
+        int64_t yoe = y - era * 400;
+        int64_t doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+        int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+        return era * 146097 + doe - 719468;
+    }
+
+    /** 距 1970-01-01 的天数转换为公历日期 */
+    static constexpr void civilFromDays(int64_t days, long& year, long& month,
+                                        long& day) noexcept {
+        days += 719468;
+        int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+        int64_t doe = days - era * 146097;
+        int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+        int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+        int64_t mp = (5 * doy + 2) / 153;
+        day = long(doy - (153 * mp + 2) / 5 + 1);
+        month = long(mp < 10 ? mp + 3 : mp - 9);
+        year = long(yoe + era * 400 + (month <= 2 ? 1 : 0));
+    }
+
+private:
+    static const bt::ptime& epoch() noexcept {
+        static const bt::ptime s_epoch(bd::date(1970, 1, 1));
+        return s_epoch;
+    }
+
+    // 向下取整的天数，1970 年以前的时刻为负数
+    constexpr int64_t days() const noexcept {
+        return m_ticks >= 0 ? m_ticks / TICKS_PER_DAY
+                            : (m_ticks - (TICKS_PER_DAY - 1)) / TICKS_PER_DAY;
+    }
+
+    constexpr int64_t timeOfDay() const noexcept {
+        return m_ticks - days() * TICKS_PER_DAY;
+    }
+
+private:
+    int64_t m_ticks;
+};
+
+/**
+ * 紧凑日期列表
+ * @ingroup DataType
+ */
+typedef std::vector<CompactDatetime> CompactDatetimeList;
+
+} /* namespace hku */
+
+#endif /* HKU_UTILS_COMPACT_DATETIME_H_ */
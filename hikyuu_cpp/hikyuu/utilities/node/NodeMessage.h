@@ -30,6 +30,8 @@ namespace hku {
  * <- res
  *  {"ret": code, "msg": str} // msg 存在错误时返回错误信息 （可选）
  *
+ * 消息体以 msgpack 编码，大批量数据可使用 json::binary 以二进制块传输（msgpack bin 类型），
+ * 避免逐项编解码
  *
  */
 
@@ -14,7 +14,8 @@
 #include <future>
 #include <thread>
 #include <vector>
-#include "ThreadSafeQueue.h"
+#include <condition_variable>
+#include "MPMCQueue.h"
 #include "WorkStealQueue.h"
 #include "InterruptFlag.h"
 #include "../cppdef.h"
@@ -116,13 +117,16 @@ public:
         typedef typename std::invoke_result<FunctionType>::type result_type;
         std::packaged_task<result_type()> task(f);
         task_handle<result_type> res(task.get_future());
-        if (m_local_work_queue) {
+        if (is_local_worker()) {
             // 本地线程任务从前部入队列（递归成栈）
             m_local_work_queue->push_front(std::move(task));
         } else {
-            m_master_work_queue.push(std::move(task));
-            m_cv.notify_one();
+            push_to_master_queue(std::move(task));
         }
+
+        // 先同步一次互斥量，避免工作线程在检查完等待条件、尚未进入等待时丢失通知
+        { std::lock_guard<std::mutex> lk(m_cv_mutex); }
+        m_cv.notify_one();
         return res;
     }
 
@@ -145,14 +149,14 @@ public:
 
         m_done = true;
 
-        // 同时加入结束任务指示，以便在dll退出时也能够终止
+        // 本地队列仅允许其所属线程插入，不再加入结束任务，工作线程通过 m_done 及中断标识退出
         for (size_t i = 0; i < m_worker_num; i++) {
             if (m_interrupt_flags[i]) {
                 m_interrupt_flags[i]->set();
             }
-            m_queues[i]->push_front(FuncWrapper());
         }
 
+        { std::lock_guard<std::mutex> lk(m_cv_mutex); }
         m_cv.notify_all();  // 唤醒所有工作线程
         for (size_t i = 0; i < m_worker_num; i++) {
             if (m_threads[i].joinable()) {
@@ -205,10 +209,11 @@ public:
         }
 
         for (size_t i = 0; i < m_worker_num; i++) {
-            m_master_work_queue.push(FuncWrapper());
+            push_to_master_queue(FuncWrapper());
         }
 
         // 唤醒所有工作线程
+        { std::lock_guard<std::mutex> lk(m_cv_mutex); }
         m_cv.notify_all();
 
         // 等待线程结束
@@ -235,7 +240,7 @@ private:
     std::mutex m_cv_mutex;         // 配合信号量的互斥量
 
     std::vector<InterruptFlag*> m_interrupt_flags;           // 工作线程状态
-    ThreadSafeQueue<task_type> m_master_work_queue;          // 主线程任务队列
+    MPMCQueue<task_type> m_master_work_queue;                // 主线程任务队列（有界无锁）
     std::vector<std::unique_ptr<WorkStealQueue> > m_queues;  // 任务队列（每个工作线程一个）
     std::vector<std::thread> m_threads;                      // 工作线程
 
@@ -281,7 +286,34 @@ private:
             task();
         } else {
             std::unique_lock<std::mutex> lk(m_cv_mutex);
-            m_cv.wait(lk, [this] { return this->m_done || !this->m_master_work_queue.empty(); });
+            // 其他工作线程本地队列中的任务（如嵌套提交的任务）同样需要唤醒空闲线程来偷取
+            m_cv.wait(lk, [this] { return this->m_done || this->has_pending_task(); });
+        }
+    }
+
+    // 当前线程是否为本线程池的工作线程（线程本地变量为全局共享，需排除其他线程池的工作线程）
+    bool is_local_worker() const {
+        return m_local_work_queue && m_index >= 0 && m_index < m_worker_num &&
+               m_queues[m_index].get() == m_local_work_queue;
+    }
+
+    bool has_pending_task() const {
+        if (!m_master_work_queue.empty()) {
+            return true;
+        }
+        for (size_t i = 0; i < m_worker_num; i++) {
+            if (!m_queues[i]->empty()) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // 主任务队列已满时，唤醒工作线程并等待其取走任务
+    void push_to_master_queue(task_type&& task) {
+        while (!m_master_work_queue.try_push(std::move(task))) {
+            m_cv.notify_all();
+            std::this_thread::yield();
         }
     }
 
@@ -0,0 +1,135 @@
+/*
+ * MPMCQueue.h
+ *
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-16
+ *      Author: fasiondog
+ */
+
+#pragma once
+#ifndef HIKYUU_UTILITIES_THREAD_MPMCQUEUE_H
+#define HIKYUU_UTILITIES_THREAD_MPMCQUEUE_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+
+namespace hku {
+
+/**
+ * 有界无锁多生产者多消费者队列（先进先出）
+ * @details
+ * <pre>
+ * 环形缓冲区中每个槽位带有序号，生产者/消费者各自通过一次 CAS 占用位置后独占读写该槽位，
+ * 不同位置的读写互不阻塞。队列满时 try_push 返回 false，由调用者决定等待或放弃。
+ * </pre>
+ */
+template <typename T>
+class MPMCQueue {
+public:
+    /**
+     * 构造函数
+     * @param capacity 队列容量，须为 2 的幂
+     */
+    explicit MPMCQueue(size_t capacity = 16384)
+    : m_mask(capacity - 1), m_cells(new Cell[capacity]), m_enqueue_pos(0), m_dequeue_pos(0) {
+        if (capacity < 2 || (capacity & (capacity - 1)) != 0) {
+            throw std::invalid_argument("MPMCQueue capacity must be a power of 2!");
+        }
+        for (size_t i = 0; i < capacity; i++) {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MPMCQueue(const MPMCQueue&) = delete;
+    MPMCQueue& operator=(const MPMCQueue&) = delete;
+
+    /** 队列容量 */
+    size_t capacity() const {
+        return m_mask + 1;
+    }
+
+    /** 尝试将元素插入队列尾部，队列已满时返回 false */
+    bool try_push(T&& item) {
+        Cell* cell;
+        size_t pos = m_enqueue_pos.load(std::memory_order_relaxed);
+        while (true) {
+            cell = &m_cells[pos & m_mask];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = intptr_t(seq) - intptr_t(pos);
+            if (diff == 0) {
+                if (m_enqueue_pos.compare_exchange_weak(pos, pos + 1,
+                                                        std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = m_enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+        cell->data = std::move(item);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /** 尝试从队列头部取出一个元素，若成功返回 true, 队列为空时返回 false */
+    bool try_pop(T& value) {
+        Cell* cell;
+        size_t pos = m_dequeue_pos.load(std::memory_order_relaxed);
+        while (true) {
+            cell = &m_cells[pos & m_mask];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = intptr_t(seq) - intptr_t(pos + 1);
+            if (diff == 0) {
+                if (m_dequeue_pos.compare_exchange_weak(pos, pos + 1,
+                                                        std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = m_dequeue_pos.load(std::memory_order_relaxed);
+            }
+        }
+        value = std::move(cell->data);
+        cell->sequence.store(pos + m_mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    /** 队列是否为空，与其他线程并发时仅为近似值 */
+    bool empty() const {
+        return size() == 0;
+    }
+
+    /** 队列大小，与其他线程并发时仅为近似值 */
+    size_t size() const {
+        size_t head = m_dequeue_pos.load(std::memory_order_relaxed);
+        size_t tail = m_enqueue_pos.load(std::memory_order_relaxed);
+        return tail > head ? tail - head : 0;
+    }
+
+    /** 清空队列 */
+    void clear() {
+        T tmp;
+        while (try_pop(tmp)) {
+        }
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T data;
+    };
+
+    size_t m_mask;
+    std::unique_ptr<Cell[]> m_cells;
+    alignas(64) std::atomic<size_t> m_enqueue_pos;
+    alignas(64) std::atomic<size_t> m_dequeue_pos;
+};
+
+} /* namespace hku */
+
+#endif /* HIKYUU_UTILITIES_THREAD_MPMCQUEUE_H */
@@ -11,91 +11,177 @@
 #ifndef HIKYUU_UTILITIES_THREAD_WORKSTEALQUEUE_H
 #define HIKYUU_UTILITIES_THREAD_WORKSTEALQUEUE_H
 
-#include <deque>
-#include <mutex>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
 #include "FuncWrapper.h"
 
 namespace hku {
 
 /**
- * 任务偷取队列
+ * 任务偷取队列（Chase-Lev 无锁双端队列）
+ * @details
+ * <pre>
+ * 队列归属于某一工作线程：push_front/try_pop 只能由该线程调用，在队列头部后进先出；
+ * 其他线程通过 try_steal 从队列尾部偷取最早加入的任务。三者均不加锁，
+ * 仅在队列剩最后一个任务时，所有者与偷取者之间通过一次 CAS 竞争。
+ * 存储空间不足时由所有者扩容，旧的存储空间保留至队列析构，以免偷取者访问已释放内存。
+ * </pre>
  */
 class WorkStealQueue {
 private:
     typedef FuncWrapper data_type;
-    std::deque<data_type> m_queue;
-    mutable std::mutex m_mutex;
+
+    struct Array {
+        explicit Array(int64_t capacity)
+        : m_capacity(capacity),
+          m_mask(capacity - 1),
+          m_items(new std::atomic<data_type*>[capacity]) {}
+
+        int64_t capacity() const {
+            return m_capacity;
+        }
+
+        data_type* get(int64_t i) const {
+            return m_items[i & m_mask].load(std::memory_order_relaxed);
+        }
+
+        void put(int64_t i, data_type* x) {
+            m_items[i & m_mask].store(x, std::memory_order_relaxed);
+        }
+
+        Array* grow(int64_t bottom, int64_t top) const {
+            Array* result = new Array(m_capacity * 2);
+            for (int64_t i = top; i < bottom; i++) {
+                result->put(i, get(i));
+            }
+            return result;
+        }
+
+    private:
+        int64_t m_capacity;
+        int64_t m_mask;
+        std::unique_ptr<std::atomic<data_type*>[]> m_items;
+    };
+
+    // 顶部（偷取端）与底部（所有者端）分属不同缓存行，避免伪共享
+    alignas(64) std::atomic<int64_t> m_top;
+    alignas(64) std::atomic<int64_t> m_bottom;
+    std::atomic<Array*> m_array;
+    std::vector<std::unique_ptr<Array>> m_arrays;  // 所有分配过的存储空间，仅所有者修改
 
 public:
-    /** 构造函数 */
-    WorkStealQueue() {}
+    /**
+     * 构造函数
+     * @param capacity 初始容量，须为 2 的幂
+     */
+    explicit WorkStealQueue(int64_t capacity = 256) : m_top(0), m_bottom(0) {
+        m_arrays.emplace_back(new Array(capacity));
+        m_array.store(m_arrays.back().get(), std::memory_order_relaxed);
+    }
+
+    ~WorkStealQueue() {
+        clear();
+    }
 
     // 禁用赋值构造和赋值重载
     WorkStealQueue(const WorkStealQueue& other) = delete;
     WorkStealQueue& operator=(const WorkStealQueue& other) = delete;
 
-    /** 将数据插入队列头部 */
+    /** 将数据插入队列头部，仅限所有者线程 */
     void push_front(data_type&& data) {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        m_queue.push_front(std::move(data));
-    }
-
-    /** 将数据插入队列尾部 */
-    void push_back(data_type&& data) {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        m_queue.push_back(std::move(data));
+        data_type* x = new data_type(std::move(data));
+        int64_t b = m_bottom.load(std::memory_order_relaxed);
+        int64_t t = m_top.load(std::memory_order_acquire);
+        Array* a = m_array.load(std::memory_order_relaxed);
+        if (b - t > a->capacity() - 1) {
+            m_arrays.emplace_back(a->grow(b, t));
+            a = m_arrays.back().get();
+            m_array.store(a, std::memory_order_release);
+        }
+        a->put(b, x);
+        m_bottom.store(b + 1, std::memory_order_release);
     }
 
-    /** 队列是否为空 */
+    /** 队列是否为空，与其他线程并发时仅为近似值 */
     bool empty() const {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        return m_queue.empty();
+        return size() == 0;
     }
 
-    /** 队列大小，！未加锁，谨慎使用 */
+    /** 队列大小，与其他线程并发时仅为近似值 */
     size_t size() const {
-        return m_queue.size();
+        int64_t b = m_bottom.load(std::memory_order_relaxed);
+        int64_t t = m_top.load(std::memory_order_relaxed);
+        return b > t ? size_t(b - t) : 0;
     }
 
+    /** 清空队列，调用时不能有其他线程同时访问 */
     void clear() {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        auto tmp = std::deque<data_type>();
-        m_queue.swap(tmp);
+        Array* a = m_array.load(std::memory_order_relaxed);
+        int64_t b = m_bottom.load(std::memory_order_relaxed);
+        for (int64_t i = m_top.load(std::memory_order_relaxed); i < b; i++) {
+            delete a->get(i);
+        }
+        m_top.store(0, std::memory_order_relaxed);
+        m_bottom.store(0, std::memory_order_relaxed);
+        if (m_arrays.size() > 1) {
+            m_arrays.erase(m_arrays.begin(), m_arrays.end() - 1);
+        }
     }
 
     /**
-     * 尝试从队列头部弹出一条数数据
+     * 尝试从队列头部弹出一条数数据，仅限所有者线程
      * @param res 存储弹出的数据
      * @return 如果原本队列为空返回 false，否则为 true
      */
     bool try_pop(data_type& res) {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        if (m_queue.empty()) {
+        int64_t b = m_bottom.load(std::memory_order_relaxed) - 1;
+        Array* a = m_array.load(std::memory_order_relaxed);
+        m_bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = m_top.load(std::memory_order_relaxed);
+        if (t > b) {
+            m_bottom.store(b + 1, std::memory_order_relaxed);
             return false;
         }
 
-        res = std::move(m_queue.front());
-        m_queue.pop_front();
+        data_type* x = a->get(b);
+        if (t == b) {
+            // 最后一个任务，与偷取者竞争
+            bool won = m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                     std::memory_order_relaxed);
+            m_bottom.store(b + 1, std::memory_order_relaxed);
+            if (!won) {
+                return false;
+            }
+        }
+        res = std::move(*x);
+        delete x;
         return true;
     }
 
     /**
-     * 尝试从队列尾部偷取一条数据
+     * 尝试从队列尾部偷取一条数据，可由任意线程调用
      * @param res 存储偷取的数据
-     * @return 如果原本队列为空返回 false，否则为 true
+     * @return 如果原本队列为空或与其他线程竞争失败返回 false，否则为 true
      */
     bool try_steal(data_type& res) {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        if (m_queue.empty()) {
+        int64_t t = m_top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t b = m_bottom.load(std::memory_order_acquire);
+        if (t >= b) {
             return false;
         }
 
-        if (m_queue.back().isNullTask()) {
+        Array* a = m_array.load(std::memory_order_acquire);
+        data_type* x = a->get(t);
+        if (!m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                           std::memory_order_relaxed)) {
             return false;
         }
-
-        res = std::move(m_queue.back());
-        m_queue.pop_back();
+        res = std::move(*x);
+        delete x;
         return true;
     }
 };
@@ -0,0 +1,39 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-16
+ *      Author: fasiondog
+ */
+
+#include "algorithm.h"
+
+namespace hku {
+
+static std::mutex g_parallel_tg_mutex;
+static GlobalStealThreadPool* g_parallel_tg = nullptr;
+static bool g_parallel_tg_released = false;
+
+GlobalStealThreadPool* getParallelThreadPool() {
+    std::lock_guard<std::mutex> lock(g_parallel_tg_mutex);
+    if (!g_parallel_tg && !g_parallel_tg_released) {
+        size_t cpu_num = std::thread::hardware_concurrency();
+        g_parallel_tg = new GlobalStealThreadPool(cpu_num > 0 ? cpu_num : 1, false);
+    }
+    return g_parallel_tg;
+}
+
+void releaseParallelThreadPool() {
+    GlobalStealThreadPool* tg = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(g_parallel_tg_mutex);
+        tg = g_parallel_tg;
+        g_parallel_tg = nullptr;
+        g_parallel_tg_released = true;
+    }
+    if (tg) {
+        tg->stop();
+        delete tg;
+    }
+}
+
+}  // namespace hku
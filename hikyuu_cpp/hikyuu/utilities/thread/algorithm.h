@@ -7,11 +7,18 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
 #include <future>
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <vector>
 #include "ThreadPool.h"
 #include "MQThreadPool.h"
+#include "GlobalStealThreadPool.h"
 
 //----------------------------------------------------------------
 // Note: 除 ThreadPool/MQThreadPool 外，其他线程池由于使用
@@ -23,6 +30,9 @@ namespace hku {
 
 typedef std::pair<size_t, size_t> range_t;
 
+/**
+ * 将 [start, end) 均分为不超过 CPU 数量的区间，余数分摊至前面的区间
+ */
 inline std::vector<range_t> parallelIndexRange(size_t start, size_t end) {
     std::vector<std::pair<size_t, size_t>> ret;
     if (start >= end) {
@@ -31,24 +41,211 @@ inline std::vector<range_t> parallelIndexRange(size_t start, size_t end) {
 
     size_t total = end - start;
     size_t cpu_num = std::thread::hardware_concurrency();
-    if (cpu_num == 1) {
+    if (cpu_num <= 1) {
         ret.emplace_back(start, end);
         return ret;
     }
 
-    size_t per_num = total / cpu_num;
-    if (per_num > 0) {
-        for (size_t i = 0; i < cpu_num; i++) {
-            size_t first = i * per_num + start;
-            ret.emplace_back(first, first + per_num);
+    size_t count = std::min(cpu_num, total);
+    size_t per_num = total / count;
+    size_t remain = total % count;
+    size_t first = start;
+    for (size_t i = 0; i < count; i++) {
+        size_t last = first + per_num + (i < remain ? 1 : 0);
+        ret.emplace_back(first, last);
+        first = last;
+    }
+
+    return ret;
+}
+
+/** 并行任务调度方式 */
+enum class ParallelSchedule {
+    DYNAMIC,  ///< 动态调度，各线程每次领取 grain 个索引
+    GUIDED,   ///< 指导调度，每次领取剩余索引数 / (2 * 线程数)，逐步递减至 grain
+};
+
+/**
+ * 获取并行算法使用的全局常驻线程池，首次调用时创建
+ * @return 线程池已释放时返回 nullptr，此时并行算法退化为在当前线程中串行执行
+ */
+HKU_UTILS_API GlobalStealThreadPool* getParallelThreadPool();
+
+/** 停止并释放并行算法使用的全局线程池，仅在程序退出时调用 */
+HKU_UTILS_API void releaseParallelThreadPool();
+
+namespace detail {
+
+/*
+ * 一次并行循环的共享状态。调用线程与线程池中的辅助任务从同一原子计数中领取区间，
+ * 调用线程只需等待已领取的区间执行完毕，尚未开始执行的辅助任务领取不到区间后直接退出，
+ * 因此可在任务中嵌套调用，而不会阻塞等待排队中的任务或额外创建线程。
+ */
+template <typename FunctionType>
+struct ParallelLoopState {
+    ParallelLoopState(size_t start, size_t end_, size_t grain_, size_t workers_,
+                      ParallelSchedule schedule_, FunctionType* f)
+    : next(start), end(end_), grain(grain_), workers(workers_), schedule(schedule_), func(f) {}
+
+    std::atomic<size_t> next;
+    std::atomic<size_t> active{0};
+    size_t end;
+    size_t grain;
+    size_t workers;
+    ParallelSchedule schedule;
+    FunctionType* func;  // 仅在领取到区间后访问，此时调用线程必然仍在等待
+    std::exception_ptr error;
+    std::mutex mutex;
+    std::condition_variable cv;
+
+    bool claim(range_t& range) {
+        size_t first = next.load(std::memory_order_relaxed);
+        while (first < end) {
+            size_t remain = end - first;
+            size_t count = grain;
+            if (schedule == ParallelSchedule::GUIDED) {
+                count = std::max(grain, remain / (2 * workers));
+            }
+            size_t last = count >= remain ? end : first + count;
+            if (next.compare_exchange_weak(first, last, std::memory_order_relaxed)) {
+                range.first = first;
+                range.second = last;
+                return true;
+            }
         }
+        return false;
     }
 
-    for (size_t i = per_num * cpu_num + start; i < end; i++) {
-        ret.emplace_back(i, i + 1);
+    void run() {
+        active.fetch_add(1);
+        range_t range;
+        while (claim(range)) {
+            try {
+                (*func)(range);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+                next.store(end);
+            }
+        }
+        if (active.fetch_sub(1) == 1) {
+            std::lock_guard<std::mutex> lock(mutex);
+            cv.notify_all();
+        }
     }
 
-    return ret;
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [this] { return active.load() == 0; });
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+};
+
+}  // namespace detail
+
+/**
+ * 在全局线程池中并行处理 [start, end) 区间
+ * @param start 起始索引
+ * @param end 结束索引（不含）
+ * @param f 函数 void(range_t range)，处理一个子区间 [range.first, range.second)
+ * @param grain 每次领取的最小索引数，为 0 时按调度方式自动选择
+ * @param schedule 调度方式，各索引计算耗时差异较大时（如不同股票的数据长度不同）建议 GUIDED
+ * @note 调用线程同样参与计算，支持嵌套调用；任务抛出的第一个异常在返回前重新抛出
+ */
+template <typename FunctionType>
+void parallel_for_each_range(size_t start, size_t end, FunctionType f, size_t grain = 0,
+                             ParallelSchedule schedule = ParallelSchedule::GUIDED) {
+    if (start >= end) {
+        return;
+    }
+
+    size_t total = end - start;
+    GlobalStealThreadPool* tg = getParallelThreadPool();
+    size_t workers = tg ? tg->worker_num() : 1;
+    if (grain == 0) {
+        grain = schedule == ParallelSchedule::GUIDED ? 1
+                                                     : std::max<size_t>(1, total / (workers * 8));
+    }
+
+    if (workers <= 1 || total <= grain) {
+        f(range_t(start, end));
+        return;
+    }
+
+    auto state = std::make_shared<detail::ParallelLoopState<FunctionType>>(start, end, grain,
+                                                                           workers, schedule, &f);
+    size_t helper_num = std::min(workers, (total + grain - 1) / grain) - 1;
+    try {
+        for (size_t i = 0; i < helper_num; i++) {
+            tg->submit([state]() { state->run(); });
+        }
+    } catch (...) {
+        // 线程池已停止，剩余部分由当前线程完成
+    }
+
+    state->run();
+    state->wait();
+}
+
+/**
+ * 在全局线程池中并行执行 f(i), i 属于 [start, end)
+ * @param start 起始索引
+ * @param end 结束索引（不含）
+ * @param f 函数 void(size_t i)
+ * @param grain 每次领取的最小索引数，为 0 时按调度方式自动选择
+ * @param schedule 调度方式
+ */
+template <typename FunctionType>
+void parallel_for(size_t start, size_t end, FunctionType f, size_t grain = 0,
+                  ParallelSchedule schedule = ParallelSchedule::GUIDED) {
+    parallel_for_each_range(
+      start, end,
+      [&f](const range_t& range) {
+          for (size_t i = range.first; i < range.second; i++) {
+              f(i);
+          }
+      },
+      grain, schedule);
+}
+
+/**
+ * 并行归约：先并行计算各子区间的部分结果，再按区间顺序依次归约
+ * @param start 起始索引
+ * @param end 结束索引（不含）
+ * @param init 初始值
+ * @param map 函数 ValueType(range_t range)，计算一个子区间的部分结果
+ * @param reduce 函数 ValueType(const ValueType&, const ValueType&)，合并两个结果
+ * @param grain 子区间长度，为 0 时自动选择
+ * @note 子区间按固定长度划分且按顺序归约，相同的 grain 下结果确定（不受线程调度影响）
+ */
+template <typename ValueType, typename MapFunction, typename ReduceFunction>
+ValueType parallel_reduce(size_t start, size_t end, ValueType init, MapFunction map,
+                          ReduceFunction reduce, size_t grain = 0) {
+    if (start >= end) {
+        return init;
+    }
+
+    std::mutex mutex;
+    std::vector<std::pair<size_t, ValueType>> parts;
+    parallel_for_each_range(
+      start, end,
+      [&](const range_t& range) {
+          ValueType value = map(range);
+          std::lock_guard<std::mutex> lock(mutex);
+          parts.emplace_back(range.first, std::move(value));
+      },
+      grain, ParallelSchedule::DYNAMIC);
+
+    std::sort(parts.begin(), parts.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+    for (auto& part : parts) {
+        init = reduce(init, part.second);
+    }
+    return init;
 }
 
 template <typename FunctionType, class TaskGroup = MQThreadPool>
@@ -66,6 +263,17 @@ void parallel_for_index_void(size_t start, size_t end, FunctionType f) {
     return;
 }
 
+/**
+ * 在全局线程池中并行执行 f(i), i 属于 [start, end)
+ * @param grain 每次领取的最小索引数，为 0 时按调度方式自动选择
+ * @param schedule 调度方式
+ */
+template <typename FunctionType>
+void parallel_for_index_void(size_t start, size_t end, FunctionType f, size_t grain,
+                             ParallelSchedule schedule = ParallelSchedule::GUIDED) {
+    parallel_for(start, end, std::move(f), grain, schedule);
+}
+
 template <typename FunctionType, class TaskGroup = MQThreadPool>
 auto parallel_for_index(size_t start, size_t end, FunctionType f) {
     auto ranges = parallelIndexRange(start, end);
@@ -93,6 +301,44 @@ auto parallel_for_index(size_t start, size_t end, FunctionType f) {
     return ret;
 }
 
+/**
+ * 在全局线程池中并行执行 f(i), i 属于 [start, end)
+ * @param grain 每次领取的最小索引数，为 0 时按调度方式自动选择
+ * @param schedule 调度方式
+ * @return 按索引顺序排列的各次调用结果
+ */
+template <typename FunctionType>
+auto parallel_for_index(size_t start, size_t end, FunctionType f, size_t grain,
+                        ParallelSchedule schedule = ParallelSchedule::GUIDED) {
+    typedef typename std::invoke_result<FunctionType, size_t>::type value_type;
+    std::mutex mutex;
+    std::vector<std::pair<size_t, std::vector<value_type>>> parts;
+    parallel_for_each_range(
+      start, end,
+      [&](const range_t& range) {
+          std::vector<value_type> one_ret;
+          one_ret.reserve(range.second - range.first);
+          for (size_t ix = range.first; ix < range.second; ix++) {
+              one_ret.emplace_back(f(ix));
+          }
+          std::lock_guard<std::mutex> lock(mutex);
+          parts.emplace_back(range.first, std::move(one_ret));
+      },
+      grain, schedule);
+
+    std::sort(parts.begin(), parts.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+    std::vector<value_type> ret;
+    ret.reserve(end > start ? end - start : 0);
+    for (auto& part : parts) {
+        for (auto&& value : part.second) {
+            ret.emplace_back(std::move(value));
+        }
+    }
+
+    return ret;
+}
+
 template <typename FunctionType, class TaskGroup = MQThreadPool>
 auto parallel_for_range(size_t start, size_t end, FunctionType f) {
     auto ranges = parallelIndexRange(start, end);
@@ -113,4 +359,37 @@ auto parallel_for_range(size_t start, size_t end, FunctionType f) {
     return ret;
 }
 
-}  // namespace hku
\ No newline at end of file
+/**
+ * 在全局线程池中并行执行 f(range)，range 为按调度方式领取的子区间
+ * @param grain 每次领取的最小索引数，为 0 时按调度方式自动选择
+ * @param schedule 调度方式
+ * @return 按区间顺序合并的各次调用结果，f 的返回值须为 vector 类容器
+ */
+template <typename FunctionType>
+auto parallel_for_range(size_t start, size_t end, FunctionType f, size_t grain,
+                        ParallelSchedule schedule = ParallelSchedule::GUIDED) {
+    typedef typename std::invoke_result<FunctionType, range_t>::type result_type;
+    std::mutex mutex;
+    std::vector<std::pair<size_t, result_type>> parts;
+    parallel_for_each_range(
+      start, end,
+      [&](const range_t& range) {
+          result_type one = f(range);
+          std::lock_guard<std::mutex> lock(mutex);
+          parts.emplace_back(range.first, std::move(one));
+      },
+      grain, schedule);
+
+    std::sort(parts.begin(), parts.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+    result_type ret;
+    for (auto& part : parts) {
+        for (auto&& value : part.second) {
+            ret.emplace_back(std::move(value));
+        }
+    }
+
+    return ret;
+}
+
+}  // namespace hku
@@ -0,0 +1,227 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-16
+ *      Author: fasiondog
+ */
+
+#include "../test_config.h"
+
+#include <hikyuu/analysis/sweep.h>
+#include <hikyuu/analysis/analysis_sys.h>
+#include <hikyuu/indicator/IndicatorSharedCache.h>
+#include <hikyuu/indicator/crt/CORR.h>
+#include <hikyuu/indicator/crt/MA.h>
+#include <hikyuu/indicator/crt/KDATA.h>
+#include <hikyuu/indicator/crt/NOT.h>
+#include <hikyuu/trade_manage/crt/crtTM.h>
+#include <hikyuu/trade_sys/signal/crt/SG_Bool.h>
+#include <hikyuu/trade_sys/moneymanager/crt/MM_FixedCount.h>
+#include <hikyuu/trade_sys/system/crt/SYS_Simple.h>
+
+using namespace hku;
+
+/**
+ * @defgroup test_hikyuu_sweep test_hikyuu_sweep
+ * @ingroup test_hikyuu_analysis_suite
+ * @{
+ */
+
+static SYSPtr create_sweep_test_sys(int fast_n, int slow_n) {
+    auto ind = MA(CLOSE(), fast_n) > MA(CLOSE(), slow_n);
+    auto sg = SG_Bool(ind, NOT(ind));
+    auto tm = crtTM(Datetime(199001010000LL), 1000000);
+    return SYS_Simple(tm, MM_FixedCount(100), EnvironmentPtr(), ConditionPtr(), sg);
+}
+
+/** @par 检测点 */
+TEST_CASE("test_IndicatorSharedCache") {
+    KData kdata = getStock("sh000001").getKData(KQueryByIndex(-500));
+    Indicator expect = MA(CLOSE(), 5) - MA(CLOSE(), 20);
+
+    /** @arg 未启用时不使用缓存 */
+    IndicatorSharedCache cache;
+    CHECK_UNARY(IndicatorSharedCache::current() == nullptr);
+    Indicator x = (MA(CLOSE(), 5) - MA(CLOSE(), 20))(kdata);
+    CHECK_EQ(cache.size(), 0);
+
+    /** @arg 启用后，等效的子指标只计算一次，结果与直接计算一致 */
+    {
+        IndicatorSharedCache::Guard guard(cache);
+        CHECK_UNARY(IndicatorSharedCache::current() == &cache);
+        Indicator a = (MA(CLOSE(), 5) - MA(CLOSE(), 20))(kdata);
+        CHECK_GT(cache.size(), 0);
+
+        Indicator b = (MA(CLOSE(), 5) - MA(CLOSE(), 10))(kdata);
+        CHECK_GT(cache.hits(), 0);
+
+        Indicator c = (MA(CLOSE(), 5) - MA(CLOSE(), 20))(kdata);
+        x = expect(kdata);
+        CHECK_EQ(a.size(), kdata.size());
+        CHECK_EQ(a.discard(), x.discard());
+        CHECK_EQ(c.discard(), x.discard());
+        for (size_t i = x.discard(); i < x.size(); i++) {
+            CHECK_EQ(a[i], doctest::Approx(x[i]));
+            CHECK_EQ(c[i], doctest::Approx(x[i]));
+        }
+
+        /** @arg 不同上下文的结果互不干扰 */
+        KData other = getStock("sz000001").getKData(KQueryByIndex(-500));
+        Indicator d = (MA(CLOSE(), 5) - MA(CLOSE(), 20))(other);
+        Indicator expect_d = expect(other);
+        CHECK_EQ(d.size(), expect_d.size());
+        for (size_t i = expect_d.discard(); i < expect_d.size(); i++) {
+            CHECK_EQ(d[i], doctest::Approx(expect_d[i]));
+        }
+    }
+    CHECK_UNARY(IndicatorSharedCache::current() == nullptr);
+
+    /** @arg 节点从缓存加载后，与其他父节点共享的子节点仍可正常计算 */
+    Indicator expect_shared = (MA(MA(CLOSE(), 10), 5) + MA(CLOSE(), 10))(kdata);
+    {
+        IndicatorSharedCache::Guard guard(cache);
+        Indicator a = MA(MA(CLOSE(), 10), 5)(kdata);
+        size_t hits = cache.hits();
+        Indicator b = (MA(MA(CLOSE(), 10), 5) + MA(CLOSE(), 10))(kdata);
+        CHECK_GT(cache.hits(), hits);
+        REQUIRE(b.size() == expect_shared.size());
+        CHECK_EQ(b.discard(), expect_shared.discard());
+        for (size_t i = expect_shared.discard(); i < expect_shared.size(); i++) {
+            CHECK_EQ(b[i], doctest::Approx(expect_shared[i]));
+        }
+    }
+
+    /** @arg 参考指标不同的节点不共享结果 */
+    Indicator expect_corr1 = CORR(CLOSE(), MA(CLOSE(), 5), 10)(kdata);
+    Indicator expect_corr2 = CORR(CLOSE(), MA(CLOSE(), 20), 10)(kdata);
+    {
+        IndicatorSharedCache::Guard guard(cache);
+        Indicator a = CORR(CLOSE(), MA(CLOSE(), 5), 10)(kdata);
+        Indicator b = CORR(CLOSE(), MA(CLOSE(), 20), 10)(kdata);
+        REQUIRE(a.size() == expect_corr1.size());
+        REQUIRE(b.size() == expect_corr2.size());
+        for (size_t i = expect_corr2.discard(); i < expect_corr2.size(); i++) {
+            CHECK_EQ(a[i], doctest::Approx(expect_corr1[i]));
+            CHECK_EQ(b[i], doctest::Approx(expect_corr2[i]));
+        }
+    }
+
+    cache.clear();
+    CHECK_EQ(cache.size(), 0);
+    CHECK_EQ(cache.hits(), 0);
+}
+
+/** @par 检测点 */
+TEST_CASE("test_combinateParameter") {
+    /** @arg 空网格 */
+    CHECK_UNARY(combinateParameter({}).empty());
+
+    /** @arg 存在无候选值的参数 */
+    CHECK_UNARY(combinateParameter({{"MM.n", {}}, {"SYS.buy_delay", {true}}}).empty());
+
+    /** @arg 笛卡尔积 */
+    auto params = combinateParameter(
+      {{"MM.n", {100.0, 200.0, 300.0}}, {"SYS.buy_delay", {true, false}}});
+    CHECK_EQ(params.size(), 6);
+    CHECK_EQ(params[0].get<double>("MM.n"), 100.0);
+    CHECK_EQ(params[0].get<bool>("SYS.buy_delay"), true);
+    CHECK_EQ(params[1].get<double>("MM.n"), 100.0);
+    CHECK_EQ(params[1].get<bool>("SYS.buy_delay"), false);
+    CHECK_EQ(params[5].get<double>("MM.n"), 300.0);
+    CHECK_EQ(params[5].get<bool>("SYS.buy_delay"), false);
+}
+
+/** @par 检测点 */
+TEST_CASE("test_sweepSystem") {
+    SYSPtr proto = create_sweep_test_sys(5, 20);
+    auto params =
+      combinateParameter({{"MM.n", {100.0, 200.0}}, {"SYS.buy_delay", {true, false}}});
+
+    /** @arg 非法的参数名称或部件 */
+    Parameter bad;
+    bad.set<double>("n", 100.0);
+    CHECK_THROWS(createSweepSystems(proto, {bad}));
+    bad = Parameter();
+    bad.set<double>("PF.n", 100.0);
+    CHECK_THROWS(createSweepSystems(proto, {bad}));
+    bad = Parameter();
+    bad.set<double>("CN.n", 100.0);
+    CHECK_THROWS(createSweepSystems(proto, {bad}));
+
+    /** @arg 候选系统相互独立，且参数已生效 */
+    auto candidates = createSweepSystems(proto, params);
+    CHECK_EQ(candidates.size(), params.size());
+    for (size_t i = 0; i < candidates.size(); i++) {
+        CHECK_NE(candidates[i].get(), proto.get());
+        CHECK_NE(candidates[i]->getTM().get(), proto->getTM().get());
+        CHECK_NE(candidates[i]->getSG().get(), proto->getSG().get());
+        CHECK_EQ(candidates[i]->getMM()->getParam<double>("n"),
+                 params[i].get<double>("MM.n"));
+        CHECK_EQ(candidates[i]->getParam<bool>("buy_delay"),
+                 params[i].get<bool>("SYS.buy_delay"));
+    }
+
+    /** @arg 与逐个独立执行的结果一致 */
+    StockList stks{getStock("sh600000"), getStock("sz000001"), Null<Stock>()};
+    KQuery query = KQueryByIndex(-300);
+    auto result = sweepSystem(proto, params, stks, query);
+    CHECK_EQ(result.size(), params.size() * 2);
+
+    for (size_t s = 0; s < 2; s++) {
+        SystemList sys_list;
+        StockList stk_list;
+        for (size_t i = 0; i < params.size(); i++) {
+            auto sys = create_sweep_test_sys(5, 20);
+            sys->getMM()->setParam<double>("n", params[i].get<double>("MM.n"));
+            sys->setParam<bool>("buy_delay", params[i].get<bool>("SYS.buy_delay"));
+            sys_list.emplace_back(sys);
+            stk_list.emplace_back(stks[s]);
+        }
+        auto expect = analysisSystemList(sys_list, stk_list, query);
+        for (size_t i = 0; i < params.size(); i++) {
+            const auto& out = result[s * params.size() + i];
+            CHECK_EQ(out.index, i);
+            CHECK_EQ(out.market_code, stks[s].market_code());
+            CHECK_EQ(out.values.size(), expect[i].values.size());
+            for (size_t j = 0; j < out.values.size(); j++) {
+                if (std::isnan(expect[i].values[j])) {
+                    CHECK_UNARY(std::isnan(out.values[j]));
+                } else {
+                    CHECK_EQ(out.values[j], doctest::Approx(expect[i].values[j]));
+                }
+            }
+        }
+    }
+}
+
+#if ENABLE_BENCHMARK_TEST
+TEST_CASE("test_sweepSystem_benchmark") {
+    StockList stks{getStock("sh600000"), getStock("sz000001")};
+    KQuery query = KQueryByIndex(-1000);
+    int cycle = 5;
+
+    SystemList sys_list;
+    for (int fast_n = 2; fast_n < 12; fast_n++) {
+        for (int slow_n = 20; slow_n < 40; slow_n += 2) {
+            sys_list.emplace_back(create_sweep_test_sys(fast_n, slow_n));
+        }
+    }
+
+    {
+        BENCHMARK_TIME_MSG(test_analysisSystemList, cycle, "analysisSystemList 100 x 2");
+        for (int i = 0; i < cycle; i++) {
+            for (const auto& stk : stks) {
+                auto result = analysisSystemList(sys_list, stk, query);
+            }
+        }
+    }
+    {
+        BENCHMARK_TIME_MSG(test_sweepSystem, cycle, "sweepSystem 100 x 2");
+        for (int i = 0; i < cycle; i++) {
+            auto result = sweepSystem(sys_list, stks, query);
+        }
+    }
+}
+#endif
+
+/** @} */
@@ -0,0 +1,290 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-17
+ *      Author: fasiondog
+ */
+
+#include "../test_config.h"
+#include <hikyuu/StockManager.h>
+#include <hikyuu/data_driver/kdata/hdf5/H5KDataDriver.h>
+
+using namespace hku;
+
+/**
+ * @defgroup test_hikyuu_H5KDataDriver test_hikyuu_H5KDataDriver
+ * @ingroup test_hikyuu_base_suite
+ * @{
+ */
+
+namespace {
+
+// 日线记录数超过日期采样数（8192），按日期查找时需在采样区间内读取数据块
+const size_t g_day_total = 20000;
+const size_t g_week_total = g_day_total / 5;
+
+// 自 1950-01-02（周一）起，仅周一至周五有记录，每 5 条日线为一周
+Datetime dayDate(size_t i) {
+    return Datetime(1950, 1, 2) + Days(int64_t(i / 5 * 7 + i % 5));
+}
+
+// 与数据导入工具一致，周线索引日期为当周周五
+Datetime weekDate(size_t i) {
+    return dayDate(i * 5 + 4);
+}
+
+H5Record makeH5Record(size_t i) {
+    H5Record record;
+    record.datetime = dayDate(i).number();
+    record.openPrice = uint32_t(10000 + i);
+    record.highPrice = uint32_t(10500 + i + i % 3);
+    record.lowPrice = uint32_t(9500 + i - i % 4);
+    record.closePrice = uint32_t(10100 + i);
+    record.transAmount = 10 * i;
+    record.transCount = i;
+    return record;
+}
+
+KRecord expectDayRecord(size_t i) {
+    H5Record h5 = makeH5Record(i);
+    return KRecord(dayDate(i), h5.openPrice * 0.001, h5.highPrice * 0.001, h5.lowPrice * 0.001,
+                   h5.closePrice * 0.001, h5.transAmount * 0.1, price_t(h5.transCount));
+}
+
+KRecord expectWeekRecord(size_t i) {
+    KRecord result = expectDayRecord(i * 5);
+    result.datetime = weekDate(i);
+    for (size_t j = i * 5 + 1; j < i * 5 + 5; j++) {
+        KRecord day = expectDayRecord(j);
+        result.highPrice = std::max(result.highPrice, day.highPrice);
+        result.lowPrice = std::min(result.lowPrice, day.lowPrice);
+        result.closePrice = day.closePrice;
+        result.transAmount += day.transAmount;
+        result.transCount += day.transCount;
+    }
+    return result;
+}
+
+void checkKRecord(const KRecord& result, const KRecord& expect) {
+    CHECK_EQ(result.datetime, expect.datetime);
+    CHECK_EQ(result.openPrice, doctest::Approx(expect.openPrice));
+    CHECK_EQ(result.highPrice, doctest::Approx(expect.highPrice));
+    CHECK_EQ(result.lowPrice, doctest::Approx(expect.lowPrice));
+    CHECK_EQ(result.closePrice, doctest::Approx(expect.closePrice));
+    CHECK_EQ(result.transAmount, doctest::Approx(expect.transAmount));
+    CHECK_EQ(result.transCount, doctest::Approx(expect.transCount));
+}
+
+// 以分块压缩方式写入日线数据及周线索引，与数据导入工具生成的格式一致
+string writeTestH5File() {
+    string filename = fmt::format("{}/test_h5_sh_day.h5", StockManager::instance().tmpdir());
+
+    H5::CompType data_type(sizeof(H5Record));
+    data_type.insertMember("datetime", HOFFSET(H5Record, datetime), H5::PredType::NATIVE_UINT64);
+    data_type.insertMember("openPrice", HOFFSET(H5Record, openPrice), H5::PredType::NATIVE_UINT);
+    data_type.insertMember("highPrice", HOFFSET(H5Record, highPrice), H5::PredType::NATIVE_UINT);
+    data_type.insertMember("lowPrice", HOFFSET(H5Record, lowPrice), H5::PredType::NATIVE_UINT);
+    data_type.insertMember("closePrice", HOFFSET(H5Record, closePrice),
+                           H5::PredType::NATIVE_UINT);
+    data_type.insertMember("transAmount", HOFFSET(H5Record, transAmount),
+                           H5::PredType::NATIVE_UINT64);
+    data_type.insertMember("transCount", HOFFSET(H5Record, transCount),
+                           H5::PredType::NATIVE_UINT64);
+
+    H5::CompType index_type(sizeof(H5IndexRecord));
+    index_type.insertMember("datetime", HOFFSET(H5IndexRecord, datetime),
+                            H5::PredType::NATIVE_UINT64);
+    index_type.insertMember("start", HOFFSET(H5IndexRecord, start), H5::PredType::NATIVE_UINT64);
+
+    std::vector<H5Record> days(g_day_total);
+    for (size_t i = 0; i < g_day_total; i++) {
+        days[i] = makeH5Record(i);
+    }
+
+    std::vector<H5IndexRecord> weeks(g_week_total);
+    for (size_t i = 0; i < g_week_total; i++) {
+        weeks[i].datetime = weekDate(i).number();
+        weeks[i].start = i * 5;
+    }
+
+    H5::H5File h5file(filename, H5F_ACC_TRUNC);
+    H5::Group data_group = h5file.createGroup("data");
+    H5::Group week_group = h5file.createGroup("week");
+
+    hsize_t chunk[1] = {1024};
+    H5::DSetCreatPropList plist;
+    plist.setChunk(1, chunk);
+    if (H5Zfilter_avail(H5Z_FILTER_DEFLATE)) {
+        plist.setDeflate(6);
+    }
+
+    hsize_t day_dims[1] = {g_day_total};
+    H5::DataSpace day_space(1, day_dims);
+    H5::DataSet day_dataset = data_group.createDataSet("SH000001", data_type, day_space, plist);
+    day_dataset.write(days.data(), data_type);
+
+    hsize_t week_dims[1] = {g_week_total};
+    H5::DataSpace week_space(1, week_dims);
+    H5::DataSet week_dataset =
+      week_group.createDataSet("SH000001", index_type, week_space, plist);
+    week_dataset.write(weeks.data(), index_type);
+
+    h5file.close();
+    return filename;
+}
+
+// 依次为：默认缓存；不缓存已打开的数据集，每次查询重新打开；
+// 块缓存总大小仅容纳一个数据集，周线查询时日线与索引数据集交替淘汰
+const std::pair<int, int> g_cache_params[] = {{512, 64 * 1024 * 1024}, {0, 64 * 1024 * 1024},
+                                              {512, 1024 * 1024}};
+
+KDataDriverPtr createTestH5Driver(const string& filename, const std::pair<int, int>& cache_param) {
+    Parameter param;
+    param.set<string>("type", "hdf5");
+    param.set<string>("sh_day", filename);
+    param.set<int>("dataset_cache_size", cache_param.first);
+    param.set<int>("max_chunk_cache_size", cache_param.second);
+    KDataDriverPtr driver = std::make_shared<H5KDataDriver>();
+    REQUIRE(driver->init(param));
+    return driver;
+}
+
+}  // namespace
+
+/** @par 检测点 */
+TEST_CASE("test_H5KDataDriver_getKRecordList") {
+    string filename = writeTestH5File();
+
+    for (const auto& cache_param : g_cache_params) {
+        KDataDriverPtr driver = createTestH5Driver(filename, cache_param);
+        CHECK_EQ(driver->getCount("SH", "000001", KQuery::DAY), g_day_total);
+        CHECK_EQ(driver->getCount("SH", "000001", KQuery::WEEK), g_week_total);
+        CHECK_EQ(driver->getCount("SH", "000002", KQuery::DAY), 0);
+
+        /** @arg 日线按索引读取 */
+        KRecordList result = driver->getKRecordList("SH", "000001", KQuery(8190, 8200));
+        REQUIRE(result.size() == 10);
+        for (size_t i = 0; i < result.size(); i++) {
+            checkKRecord(result[i], expectDayRecord(8190 + i));
+        }
+
+        result = driver->getKRecordList("SH", "000001", KQuery(g_day_total - 2, g_day_total + 10));
+        REQUIRE(result.size() == 2);
+        checkKRecord(result[1], expectDayRecord(g_day_total - 1));
+
+        result = driver->getKRecordList("SH", "000001", KQuery(g_day_total, g_day_total + 10));
+        CHECK_UNARY(result.empty());
+
+        /** @arg 日线按日期读取，结束日期落在周末 */
+        result = driver->getKRecordList(
+          "SH", "000001", KQueryByDate(dayDate(12345), dayDate(12349) + Days(1)));
+        REQUIRE(result.size() == 5);
+        for (size_t i = 0; i < result.size(); i++) {
+            checkKRecord(result[i], expectDayRecord(12345 + i));
+        }
+
+        result = driver->getKRecordList("SH", "000001", KQueryByDate(dayDate(g_day_total - 3)));
+        REQUIRE(result.size() == 3);
+        checkKRecord(result[2], expectDayRecord(g_day_total - 1));
+
+        /** @arg 周线按索引读取，由日线汇总 */
+        result = driver->getKRecordList("SH", "000001", KQuery(100, 104, KQuery::WEEK));
+        REQUIRE(result.size() == 4);
+        for (size_t i = 0; i < result.size(); i++) {
+            checkKRecord(result[i], expectWeekRecord(100 + i));
+        }
+
+        result = driver->getKRecordList(
+          "SH", "000001", KQuery(g_week_total - 1, g_week_total + 5, KQuery::WEEK));
+        REQUIRE(result.size() == 1);
+        checkKRecord(result[0], expectWeekRecord(g_week_total - 1));
+
+        /** @arg 周线按日期读取 */
+        result = driver->getKRecordList(
+          "SH", "000001", KQueryByDate(dayDate(3000), weekDate(603), KQuery::WEEK));
+        REQUIRE(result.size() == 3);
+        for (size_t i = 0; i < result.size(); i++) {
+            checkKRecord(result[i], expectWeekRecord(600 + i));
+        }
+    }
+}
+
+/** @par 检测点 */
+TEST_CASE("test_H5KDataDriver_getIndexRangeByDate") {
+    string filename = writeTestH5File();
+    for (const auto& cache_param : g_cache_params) {
+        KDataDriverPtr driver = createTestH5Driver(filename, cache_param);
+        size_t start = 0, end = 0;
+
+        /** @arg 日线逐条检查，覆盖采样点及采样区间内的各个位置 */
+        for (size_t i = 0; i < g_day_total; i += 37) {
+            REQUIRE(driver->getIndexRangeByDate(
+              "SH", "000001", KQueryByDate(dayDate(i), dayDate(i) + Minutes(1)), start, end));
+            CHECK_EQ(start, i);
+            CHECK_EQ(end, i + 1);
+        }
+
+        for (size_t i : {size_t(0), size_t(1), size_t(2), size_t(3), size_t(8191), size_t(8192),
+                         size_t(8193), g_day_total - 2}) {
+            REQUIRE(driver->getIndexRangeByDate(
+              "SH", "000001", KQueryByDate(dayDate(i) + Minutes(1)), start, end));
+            CHECK_EQ(start, i + 1);
+            CHECK_EQ(end, g_day_total);
+        }
+
+        /** @arg 日线起止日期落在周末 */
+        CHECK_UNARY(driver->getIndexRangeByDate(
+          "SH", "000001", KQueryByDate(dayDate(9004) + Days(1), dayDate(9009) + Days(2)), start,
+          end));
+        CHECK_EQ(start, 9005);
+        CHECK_EQ(end, 9010);
+
+        /** @arg 日线起始日期早于第一条记录，结束日期为 Null */
+        CHECK_UNARY(driver->getIndexRangeByDate("SH", "000001",
+                                                KQueryByDate(Datetime(1949, 1, 1)), start, end));
+        CHECK_EQ(start, 0);
+        CHECK_EQ(end, g_day_total);
+
+        /** @arg 日线区间内无记录 */
+        CHECK_UNARY(!driver->getIndexRangeByDate(
+          "SH", "000001", KQueryByDate(dayDate(4) + Days(1), dayDate(5)), start, end));
+        CHECK_EQ(start, 0);
+        CHECK_EQ(end, 0);
+        CHECK_UNARY(!driver->getIndexRangeByDate(
+          "SH", "000001", KQueryByDate(dayDate(g_day_total - 1) + Days(1)), start, end));
+        CHECK_UNARY(!driver->getIndexRangeByDate(
+          "SH", "000001", KQueryByDate(dayDate(100), dayDate(50)), start, end));
+
+        /** @arg 周线按索引表中的日期（周五）查找 */
+        for (size_t i = 0; i < g_week_total; i += 7) {
+            REQUIRE(driver->getIndexRangeByDate(
+              "SH", "000001", KQueryByDate(weekDate(i), weekDate(i) + Minutes(1), KQuery::WEEK),
+              start, end));
+            CHECK_EQ(start, i);
+            CHECK_EQ(end, i + 1);
+        }
+
+        /** @arg 周线起止日期落在周中 */
+        CHECK_UNARY(driver->getIndexRangeByDate(
+          "SH", "000001", KQueryByDate(dayDate(1000), dayDate(1052), KQuery::WEEK), start, end));
+        CHECK_EQ(start, 200);
+        CHECK_EQ(end, 210);
+
+        /** @arg 周线区间超出记录范围 */
+        CHECK_UNARY(driver->getIndexRangeByDate(
+          "SH", "000001", KQueryByDate(weekDate(g_week_total - 2), Null<Datetime>(), KQuery::WEEK),
+          start, end));
+        CHECK_EQ(start, g_week_total - 2);
+        CHECK_EQ(end, g_week_total);
+        CHECK_UNARY(!driver->getIndexRangeByDate(
+          "SH", "000001",
+          KQueryByDate(weekDate(g_week_total - 1) + Days(1), Null<Datetime>(), KQuery::WEEK),
+          start, end));
+
+        /** @arg 证券不存在 */
+        CHECK_UNARY(!driver->getIndexRangeByDate("SH", "000002", KQueryByDate(dayDate(0)), start,
+                                                 end));
+    }
+}
+
+/** @} */
@@ -0,0 +1,202 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-17
+ *      Author: fasiondog
+ */
+
+#include "../test_config.h"
+#include <fstream>
+#include <hikyuu/StockManager.h>
+#include <hikyuu/utilities/os.h>
+#include <hikyuu/data_driver/kdata/tdx/TdxKDataDriver.h>
+#include <hikyuu/data_driver/kdata/tdx/TdxMappedFile.h>
+
+#if HKU_OS_LINUX
+#include <dirent.h>
+#endif
+
+using namespace hku;
+
+/**
+ * @defgroup test_hikyuu_TdxKDataDriver test_hikyuu_TdxKDataDriver
+ * @ingroup test_hikyuu_base_suite
+ * @{
+ */
+
+namespace {
+
+// 与通达信 .day 文件记录格式一致
+struct TestTdxDayData {
+    uint32_t date;
+    uint32_t open;
+    uint32_t high;
+    uint32_t low;
+    uint32_t close;
+    float amount;
+    uint32_t vol;
+    uint32_t other;
+};
+
+// 20200102 起每 2 天一条记录（含跨月），共 10 条
+const uint32_t g_test_dates[] = {20200102, 20200104, 20200106, 20200108, 20200110,
+                                 20200112, 20200114, 20200116, 20200118, 20200120};
+
+string writeTestDayFile() {
+    string dirname = fmt::format("{}/tdx", StockManager::instance().tmpdir());
+    createDir(dirname);
+#if HKU_OS_WINDOWS
+    createDir(dirname + "\\sh");
+    createDir(dirname + "\\sh\\lday");
+#endif
+    // 与 TdxKDataDriver::_getFileName 拼接方式一致
+    string filename = dirname + "\\sh\\lday\\sh000001.day";
+    std::ofstream file(filename.c_str(), std::ios::binary | std::ios::out | std::ios::trunc);
+    for (size_t i = 0; i < 10; i++) {
+        TestTdxDayData data;
+        data.date = g_test_dates[i];
+        data.open = 1000 + i;
+        data.high = 1100 + i;
+        data.low = 900 + i;
+        data.close = 1050 + i;
+        data.amount = 10000.0f * (i + 1);
+        data.vol = 100 * (i + 1);
+        data.other = 0;
+        file.write((const char*)&data, sizeof(TestTdxDayData));
+    }
+    file.close();
+    TdxMappedFile::clearCache();
+    return dirname;
+}
+
+KDataDriverPtr createTestTdxDriver(const string& dirname, bool use_mmap) {
+    Parameter param;
+    param.set<string>("type", "tdx");
+    param.set<string>("dir", dirname);
+    param.set<bool>("mmap", use_mmap);
+    KDataDriverPtr driver = std::make_shared<TdxKDataDriver>();
+    REQUIRE(driver->init(param));
+    return driver;
+}
+
+}  // namespace
+
+/** @par 检测点 */
+TEST_CASE("test_TdxKDataDriver_getKRecordList") {
+    string dirname = writeTestDayFile();
+    for (bool use_mmap : {true, false}) {
+        KDataDriverPtr driver = createTestTdxDriver(dirname, use_mmap);
+        CHECK_EQ(driver->getCount("sh", "000001", KQuery::DAY), 10);
+
+        /** @arg 按索引读取，内存映射与文件流读取结果一致 */
+        KRecordList result = driver->getKRecordList("sh", "000001", KQuery(2, 5));
+        REQUIRE(result.size() == 3);
+        CHECK_EQ(result[0].datetime, Datetime(2020, 1, 6));
+        CHECK_EQ(result[0].openPrice, doctest::Approx(10.02));
+        CHECK_EQ(result[0].highPrice, doctest::Approx(11.02));
+        CHECK_EQ(result[0].lowPrice, doctest::Approx(9.02));
+        CHECK_EQ(result[0].closePrice, doctest::Approx(10.52));
+        CHECK_EQ(result[0].transAmount, doctest::Approx(3.0));
+        CHECK_EQ(result[0].transCount, doctest::Approx(300.0));
+        CHECK_EQ(result[2].datetime, Datetime(2020, 1, 10));
+
+        /** @arg 结束位置超出记录数 */
+        result = driver->getKRecordList("sh", "000001", KQuery(8, 100));
+        REQUIRE(result.size() == 2);
+        CHECK_EQ(result[1].datetime, Datetime(2020, 1, 20));
+
+        /** @arg 起始位置超出记录数 */
+        result = driver->getKRecordList("sh", "000001", KQuery(10, 20));
+        CHECK_UNARY(result.empty());
+
+        /** @arg 结束位置小于起始位置 */
+        result = driver->getKRecordList("sh", "000001", KQuery(5, 2));
+        CHECK_UNARY(result.empty());
+        result = driver->getKRecordList("sh", "000001", KQuery(10, 5));
+        CHECK_UNARY(result.empty());
+
+        /** @arg 文件不存在 */
+        result = driver->getKRecordList("sh", "000002", KQuery(0, 5));
+        CHECK_UNARY(result.empty());
+    }
+}
+
+/** @par 检测点 */
+TEST_CASE("test_TdxKDataDriver_getIndexRangeByDate") {
+    string dirname = writeTestDayFile();
+    for (bool use_mmap : {true, false}) {
+        KDataDriverPtr driver = createTestTdxDriver(dirname, use_mmap);
+        size_t start = 0, end = 0;
+
+        /** @arg 起止日期恰好命中记录 */
+        CHECK_UNARY(driver->getIndexRangeByDate(
+          "sh", "000001", KQueryByDate(Datetime(2020, 1, 6), Datetime(2020, 1, 12)), start, end));
+        CHECK_EQ(start, 2);
+        CHECK_EQ(end, 5);
+
+        /** @arg 起止日期落在记录间隙中 */
+        CHECK_UNARY(driver->getIndexRangeByDate(
+          "sh", "000001", KQueryByDate(Datetime(2020, 1, 5), Datetime(2020, 1, 13)), start, end));
+        CHECK_EQ(start, 2);
+        CHECK_EQ(end, 6);
+
+        /** @arg 起始日期早于第一条记录，结束日期晚于最后一条记录 */
+        CHECK_UNARY(driver->getIndexRangeByDate(
+          "sh", "000001", KQueryByDate(Datetime(2019, 1, 1), Datetime(2021, 1, 1)), start, end));
+        CHECK_EQ(start, 0);
+        CHECK_EQ(end, 10);
+
+        /** @arg 结束日期为 Null，取至最后一条记录 */
+        CHECK_UNARY(driver->getIndexRangeByDate(
+          "sh", "000001", KQueryByDate(Datetime(2020, 1, 19)), start, end));
+        CHECK_EQ(start, 9);
+        CHECK_EQ(end, 10);
+
+        /** @arg 起始日期晚于最后一条记录 */
+        CHECK_UNARY(!driver->getIndexRangeByDate(
+          "sh", "000001", KQueryByDate(Datetime(2020, 1, 21), Datetime(2021, 1, 1)), start, end));
+
+        /** @arg 区间内无记录 */
+        CHECK_UNARY(!driver->getIndexRangeByDate(
+          "sh", "000001", KQueryByDate(Datetime(2020, 1, 7), Datetime(2020, 1, 8)), start, end));
+
+        /** @arg 结束日期早于起始日期 */
+        CHECK_UNARY(!driver->getIndexRangeByDate(
+          "sh", "000001", KQueryByDate(Datetime(2020, 1, 12), Datetime(2020, 1, 6)), start, end));
+        CHECK_EQ(start, 0);
+        CHECK_EQ(end, 0);
+    }
+}
+
+#if HKU_OS_LINUX
+// 当前进程打开的文件描述符数量
+static size_t openFdCount() {
+    size_t count = 0;
+    DIR* dir = opendir("/proc/self/fd");
+    if (dir) {
+        while (readdir(dir)) {
+            count++;
+        }
+        closedir(dir);
+    }
+    return count;
+}
+
+/** @par 检测点 */
+TEST_CASE("test_TdxMappedFile_no_fd") {
+    string dirname = writeTestDayFile();
+    string filename = dirname + "\\sh\\lday\\sh000001.day";
+
+    /** @arg 缓存的文件映射不占用文件描述符 */
+    size_t fd_count = openFdCount();
+    TdxMappedFilePtr file = TdxMappedFile::get(filename);
+    REQUIRE(file);
+    CHECK_EQ(openFdCount(), fd_count);
+    CHECK_EQ(file->count<TestTdxDayData>(), 10);
+    CHECK_EQ(file->records<TestTdxDayData>()[9].date, g_test_dates[9]);
+    CHECK_EQ(TdxMappedFile::get(filename), file);
+    TdxMappedFile::clearCache();
+}
+#endif
+
+/** @} */
@@ -0,0 +1,100 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-16
+ *      Author: fasiondog
+ */
+
+#include "../test_config.h"
+#include <hikyuu/plugin/DataServerCodec.h>
+
+using namespace hku;
+
+/**
+ * @defgroup test_hikyuu_DataServerCodec test_hikyuu_DataServerCodec
+ * @ingroup test_hikyuu_base_suite
+ * @{
+ */
+
+/** @par 检测点 */
+TEST_CASE("test_DataServerCodec_KRecord") {
+    MarketKRecordList data;
+    data.emplace_back("SH600000",
+                      KRecordList{KRecord(Datetime(202401100935), 10.1, 10.5, 10.0, 10.2, 100., 20.),
+                                  KRecord(Datetime(202401100940), 10.2, 10.3, 10.1, 10.3, 50., 10.)});
+    data.emplace_back("SZ000001", KRecordList());
+    data.emplace_back("BJ430047", KRecordList{KRecord(Datetime(20240110), 1., 2., 0.5, 1.5, 3., 4.)});
+
+    /** @arg 编码后解码与原数据一致 */
+    vector<uint8_t> buf;
+    encodeKRecordBlock(data, buf);
+    MarketKRecordList result;
+    decodeKRecordBlock(buf.data(), buf.size(), result);
+    CHECK_EQ(result, data);
+
+    /** @arg 与主机字节序无关，固定为小端字节序 */
+    REQUIRE(buf.size() > 16);
+    CHECK_EQ(string((const char*)buf.data(), 4), "HKUK");
+    CHECK_EQ(buf[4], 1);
+    CHECK_EQ(buf[5], 0);
+    CHECK_EQ(buf[8], 3);
+    CHECK_EQ(buf[9], 0);
+    CHECK_EQ(buf[12], 8);
+    CHECK_EQ(buf[13], 0);
+
+    /** @arg 数据块长度不足或格式错误 */
+    CHECK_THROWS(decodeKRecordBlock(buf.data(), buf.size() - 1, result));
+    buf[0] = 0;
+    CHECK_THROWS(decodeKRecordBlock(buf.data(), buf.size(), result));
+}
+
+/** @par 检测点 */
+TEST_CASE("test_DataServerCodec_Spot") {
+    vector<SpotRecord> spots(2);
+    for (size_t i = 0; i < spots.size(); i++) {
+        SpotRecord& spot = spots[i];
+        spot.market = "SH";
+        spot.code = "600000";
+        spot.datetime = Datetime(202401100930) + Minutes(i);
+        spot.yesterday_close = 10.0;
+        spot.open = 10.1;
+        spot.high = 10.5 + i;
+        spot.low = 9.9;
+        spot.close = 10.2 + i;
+        spot.amount = 1000.0 * (i + 1);
+        spot.volume = 100.0 * (i + 1);
+    }
+    spots[0].bid = {10.1, 10.0};
+    spots[0].bid_amount = {100., 200.};
+    spots[1].ask = {10.3};
+    spots[1].ask_amount = {300.};
+
+    /** @arg 编码后解码与原数据一致，委买/委卖档数可不同 */
+    vector<uint8_t> buf;
+    encodeSpotBlock(spots, buf);
+    vector<SpotRecord> result;
+    decodeSpotBlock(buf.data(), buf.size(), "SH", "600000", result);
+    REQUIRE(result.size() == spots.size());
+    for (size_t i = 0; i < spots.size(); i++) {
+        CHECK_EQ(result[i].market, spots[i].market);
+        CHECK_EQ(result[i].code, spots[i].code);
+        CHECK_EQ(result[i].datetime, spots[i].datetime);
+        CHECK_EQ(result[i].yesterday_close, spots[i].yesterday_close);
+        CHECK_EQ(result[i].open, spots[i].open);
+        CHECK_EQ(result[i].high, spots[i].high);
+        CHECK_EQ(result[i].low, spots[i].low);
+        CHECK_EQ(result[i].close, spots[i].close);
+        CHECK_EQ(result[i].amount, spots[i].amount);
+        CHECK_EQ(result[i].volume, spots[i].volume);
+        CHECK_EQ(result[i].bid, spots[i].bid);
+        CHECK_EQ(result[i].bid_amount, spots[i].bid_amount);
+        CHECK_EQ(result[i].ask, spots[i].ask);
+        CHECK_EQ(result[i].ask_amount, spots[i].ask_amount);
+    }
+
+    /** @arg 委买价与委买量档数不一致 */
+    spots[0].bid_amount.pop_back();
+    CHECK_THROWS(encodeSpotBlock(spots, buf));
+}
+
+/** @} */
@@ -0,0 +1,71 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-16
+ *      Author: fasiondog
+ */
+
+#include "../test_config.h"
+#include <cmath>
+#include <hikyuu/HistoryFinanceColumns.h>
+
+using namespace hku;
+
+/**
+ * @defgroup test_hikyuu_HistoryFinanceColumns test_hikyuu_HistoryFinanceColumns
+ * @ingroup test_hikyuu_base_suite
+ * @{
+ */
+
+/** @par 检测点 */
+TEST_CASE("test_HistoryFinanceColumns") {
+    vector<HistoryFinanceInfo> finances(3);
+    finances[0].fileDate = Datetime(20231231);
+    finances[0].reportDate = Datetime(20240410);
+    finances[0].values = {1.0f, 2.0f};
+    finances[1].fileDate = Datetime(20240331);
+    finances[1].reportDate = Datetime(20240425);
+    finances[1].values = {3.0f, 4.0f, 5.0f};
+    finances[2].fileDate = Datetime(20240630);
+    finances[2].reportDate = Datetime(20240820);
+    finances[2].values = {6.0f, 7.0f, 8.0f};
+
+    /** @arg 按字段连续存放，字段数不足的报告以 Null 填充 */
+    HistoryFinanceColumns columns(finances);
+    CHECK_EQ(columns.size(), 3);
+    CHECK_EQ(columns.fieldCount(), 3);
+    const float* field0 = columns.field(0);
+    REQUIRE(field0 != nullptr);
+    CHECK_EQ(field0[0], 1.0f);
+    CHECK_EQ(field0[1], 3.0f);
+    CHECK_EQ(field0[2], 6.0f);
+    CHECK_UNARY(std::isnan(columns.get(0, 2)));
+    CHECK_EQ(columns.get(2, 2), 8.0f);
+    CHECK_UNARY(columns.field(3) == nullptr);
+
+    /** @arg 按时点查询已发布的最近一期报告 */
+    CHECK_EQ(columns.getPos(Datetime(20240409)), Null<size_t>());
+    CHECK_EQ(columns.getPos(Datetime(20240410)), 0);
+    CHECK_EQ(columns.getPos(Datetime(20240601)), 1);
+    CHECK_EQ(columns.getPos(Datetime(20250101)), 2);
+
+    HistoryFinanceInfo info = columns.getHistoryFinanceInfo(1);
+    CHECK_EQ(info.fileDate, finances[1].fileDate);
+    CHECK_EQ(info.reportDate, finances[1].reportDate);
+    CHECK_EQ(info.values, finances[1].values);
+
+    /** @arg 逐期追加与构造结果一致 */
+    HistoryFinanceColumns appended;
+    for (const auto& finance : finances) {
+        appended.push_back(finance.fileDate, finance.reportDate, finance.values.data(),
+                           finance.values.size());
+    }
+    CHECK_EQ(appended.fileDates(), columns.fileDates());
+    CHECK_EQ(appended.reportDates(), columns.reportDates());
+    CHECK_UNARY(std::isnan(appended.get(0, 2)));
+    auto list = appended.toHistoryFinanceList();
+    REQUIRE(list.size() == 3);
+    CHECK_EQ(list[2].values, finances[2].values);
+}
+
+/** @} */
@@ -11,6 +11,7 @@
 #include <hikyuu/KQuery.h>
 #include <hikyuu/KData.h>
 #include <hikyuu/Stock.h>
+#include <hikyuu/indicator/crt/KDATA.h>
 
 using namespace hku;
 
@@ -1657,4 +1658,232 @@ TEST_CASE("test_getKRecord_By_Date") {
     CHECK_EQ(result, Null<KRecord>());
 }
 
+/** @par 检测点 */
+TEST_CASE("test_KData_columnar") {
+    StockManager& sm = StockManager::instance();
+    KRecordList ks = sm.getStock("sh600000").getKRecordList(KQuery(0, 20, KQuery::DAY));
+    REQUIRE(ks.size() == 20);
+
+    Stock stk("SH", "TEST01", "columnar test");
+    stk.setKRecordColumns(KRecordColumns(ks), KQuery::DAY);
+    CHECK_UNARY(stk.isBuffer(KQuery::DAY));
+    CHECK_UNARY(stk.isColumnarBuffer(KQuery::DAY));
+    CHECK_EQ(stk.getCount(KQuery::DAY), ks.size());
+    CHECK_EQ(stk.getKRecord(5, KQuery::DAY), ks[5]);
+    CHECK_EQ(stk.getKRecord(ks[7].datetime, KQuery::DAY), ks[7]);
+
+    /** @arg 按日期及索引查询与 KRecordList 结果一致 */
+    KRecordList result = stk.getKRecordList(KQueryByDate(ks[3].datetime, ks[9].datetime));
+    REQUIRE(result.size() == 6);
+    for (size_t i = 0; i < result.size(); i++) {
+        CHECK_EQ(result[i], ks[i + 3]);
+    }
+
+    KData kdata = stk.getKData(KQuery(-10));
+    REQUIRE(kdata.columns() != nullptr);
+    CHECK_EQ(kdata.size(), 10);
+    CHECK_EQ(kdata.columns()->size(), 10);
+    CHECK_EQ(kdata.columns()->start(), 10);
+    CHECK_EQ(kdata.getPos(ks[12].datetime), 2);
+    CHECK_EQ(kdata.getDatetimeList(), stk.getDatetimeList(KQuery(-10)));
+    for (size_t i = 0; i < kdata.size(); i++) {
+        CHECK_EQ(kdata.getKRecordValue(i), ks[i + 10]);
+    }
+
+    /** @arg 按引用访问时生成 KRecord 副本，多次访问返回相同的引用 */
+    for (size_t i = 0; i < kdata.size(); i++) {
+        CHECK_EQ(kdata[i], ks[i + 10]);
+        CHECK_EQ(&kdata[i], &kdata.getKRecord(i));
+    }
+    CHECK_EQ(&kdata[ks[12].datetime], &kdata[2]);
+    CHECK_EQ(kdata.getKRecord(ks[0].datetime), KRecord());
+    REQUIRE(kdata.columns() != nullptr);
+
+    /** @arg 直接引用证券缓存中的列数据，不复制 */
+    KData all = stk.getKData(KQuery(0));
+    REQUIRE(all.columns() != nullptr);
+    CHECK_EQ(all.columns()->columns(), kdata.columns()->columns());
+    for (size_t f = 0; f < KRecordColumns::FIELD_COUNT; f++) {
+        auto field = KRecordColumns::Field(f);
+        CHECK_EQ(kdata.columns()->data(field), all.columns()->data(field) + 10);
+    }
+    CHECK_EQ(kdata.columns()->date(2), CompactDatetime(ks[12].datetime));
+    CHECK_EQ(kdata.columns()->lowerBound(ks[12].datetime), 2);
+    CHECK_EQ(kdata.columns()->lowerBound(ks[0].datetime), 0);
+    CHECK_EQ(kdata.columns()->lowerBound(ks.back().datetime + Days(1)), 10);
+    CHECK_UNARY(kdata.columns()->toKRecordList() == KRecordList(ks.begin() + 10, ks.end()));
+
+    /** @arg 价格指标直接读取列数据 */
+    Indicator c = CLOSE(kdata);
+    Indicator k = KDATA(kdata);
+    REQUIRE(c.size() == kdata.size());
+    for (size_t i = 0; i < kdata.size(); i++) {
+        CHECK_EQ(c[i], doctest::Approx(ks[i + 10].closePrice));
+        CHECK_EQ(k.get(i, 4), doctest::Approx(ks[i + 10].transAmount));
+    }
+
+    /** @arg 复权查询不使用列式存储 */
+    kdata = stk.getKData(KQuery(-10, Null<int64_t>(), KQuery::DAY, KQuery::FORWARD));
+    CHECK_UNARY(kdata.columns() == nullptr);
+    CHECK_EQ(kdata.size(), 10);
+
+    /** @arg 实时更新，已创建的 KData 保持不变 */
+    kdata = stk.getKData(KQuery(-10));
+    const price_t* old_close = kdata.columns()->data(KRecordColumns::CLOSE);
+    KRecord last = ks.back();
+    last.closePrice += 1.0;
+    last.highPrice += 2.0;
+    stk.realtimeUpdate(last, KQuery::DAY);
+    CHECK_EQ(stk.getCount(KQuery::DAY), ks.size());
+    CHECK_EQ(stk.getKRecord(ks.size() - 1, KQuery::DAY), last);
+    CHECK_EQ(kdata[9], ks.back());
+    CHECK_EQ(kdata.columns()->data(KRecordColumns::CLOSE), old_close);
+    CHECK_EQ(stk.getKData(KQuery(-10))[9], last);
+
+    /** @arg 不再被引用时原地更新 */
+    c = Indicator();
+    k = Indicator();
+    kdata = KData();
+    all = KData();
+    const price_t* cur_close = stk.getKData(KQuery(0)).columns()->data(KRecordColumns::CLOSE);
+    last.closePrice += 1.0;
+    stk.realtimeUpdate(last, KQuery::DAY);
+    kdata = stk.getKData(KQuery(0));
+    CHECK_EQ(kdata.columns()->data(KRecordColumns::CLOSE), cur_close);
+    CHECK_EQ(kdata[ks.size() - 1], last);
+
+    /** @arg 释放缓存不影响已创建的 KData */
+    CHECK_UNARY(stk.isColumnarBuffer("day"));
+    stk.releaseKDataBuffer(KQuery::DAY);
+    CHECK_UNARY(!stk.isColumnarBuffer(KQuery::DAY));
+    CHECK_EQ(kdata.size(), ks.size());
+    CHECK_EQ(kdata[0], ks[0]);
+    CHECK_EQ(kdata[ks.size() - 1], last);
+    stk.releaseKDataBuffer("INVALID");
+    stk.setKRecordColumns(KRecordColumns(ks), KQuery::DAY);
+    CHECK_UNARY(stk.isColumnarBuffer(KQuery::DAY));
+
+    /** @arg 改为 KRecordList 存储 */
+    stk.setKRecordList(ks, KQuery::DAY);
+    CHECK_UNARY(!stk.isColumnarBuffer(KQuery::DAY));
+    CHECK_UNARY(stk.getKData(KQuery(0)).columns() == nullptr);
+}
+
+/** @par 检测点 */
+TEST_CASE("test_KData_snapshot") {
+    StockManager& sm = StockManager::instance();
+    KRecordList ks = sm.getStock("sh600000").getKRecordList(KQuery(0, 20, KQuery::DAY));
+    REQUIRE(ks.size() == 20);
+
+    Stock stk("SH", "TEST02", "snapshot test");
+    stk.setKRecordList(ks, KQuery::DAY);
+
+    /** @arg 不复权时直接引用缓存快照 */
+    size_t start = 0, end = 0;
+    REQUIRE(stk.getKRecordSnapshot(KQuery(-10), start, end));
+    CHECK_EQ(start, 10);
+    CHECK_EQ(end, 20);
+
+    KData kdata = stk.getKData(KQuery(-10));
+    CHECK_EQ(kdata.size(), 10);
+    CHECK_EQ(kdata.startPos(), 10);
+    CHECK_EQ(kdata.getPos(ks[12].datetime), 2);
+    CHECK_EQ(kdata.getDatetimeList(), stk.getDatetimeList(KQuery(-10)));
+    for (size_t i = 0; i < kdata.size(); i++) {
+        CHECK_EQ(kdata[i], ks[i + 10]);
+        CHECK_EQ(kdata.data()[i], ks[i + 10]);
+    }
+
+    KData by_date = stk.getKData(KQueryByDate(ks[3].datetime, ks[9].datetime));
+    REQUIRE(by_date.size() == 6);
+    CHECK_EQ(by_date[0], ks[3]);
+    CHECK_EQ(by_date[5], ks[8]);
+
+    /** @arg 实时更新发布新版本，已创建的 KData 保持不变 */
+    KRecord last = ks.back();
+    last.closePrice += 1.0;
+    last.highPrice += 2.0;
+    stk.realtimeUpdate(last, KQuery::DAY);
+    CHECK_EQ(kdata[9], ks.back());
+    CHECK_EQ(stk.getCount(KQuery::DAY), ks.size());
+    CHECK_EQ(stk.getKRecord(ks.size() - 1, KQuery::DAY), last);
+
+    KData updated = stk.getKData(KQuery(-10));
+    CHECK_EQ(updated[9], last);
+    CHECK_EQ(updated.data()[9], last);
+    CHECK_EQ(updated.cbegin()->datetime, ks[10].datetime);
+
+    KRecord next = last;
+    next.datetime = last.datetime + Days(1);
+    size_t added = 0;
+    for (int i = 0; i < 100; i++) {
+        stk.realtimeUpdate(next, KQuery::DAY);
+        if (!sm.isHoliday(next.datetime)) {
+            added++;
+        }
+        next.datetime = next.datetime + Days(1);
+    }
+    CHECK_EQ(stk.getCount(KQuery::DAY), ks.size() + added);
+    CHECK_EQ(kdata.size(), 10);
+    CHECK_EQ(updated.size(), 10);
+    CHECK_EQ(updated[9], last);
+    CHECK_EQ(stk.getKRecord(ks.size() - 1, KQuery::DAY), last);
+
+    /** @arg 修改数据时复制，不影响缓存 */
+    KData modified = stk.getKData(KQuery(0, 5));
+    modified.data()[0].closePrice = 0.0;
+    CHECK_EQ(modified[0].closePrice, 0.0);
+    CHECK_EQ(stk.getKRecord(0, KQuery::DAY), ks[0]);
+}
+
+/** @par 检测点 */
+TEST_CASE("test_Stock_realtimeUpdate_batch") {
+    StockManager& sm = StockManager::instance();
+    KRecordList ks = sm.getStock("sh600000").getKRecordList(KQuery(0, 100, KQuery::DAY));
+    REQUIRE(ks.size() == 100);
+
+    // 缓存前 20 条，批量数据中前 2 条早于最后一条记录，第 3 条与最后一条记录日期相同
+    KRecordList init(ks.begin(), ks.begin() + 20);
+    KRecordList batch(ks.begin() + 17, ks.end());
+    batch[2].closePrice += 1.0;
+    batch[2].highPrice = ks[19].highPrice + 2.0;
+    KRecord merged = ks[19];
+    merged.closePrice = batch[2].closePrice;
+    merged.highPrice = batch[2].highPrice;
+
+    /** @arg 行式缓存 */
+    Stock stk("SH", "TEST04", "batch update test");
+    stk.setKRecordList(init, KQuery::DAY);
+    KData kdata = stk.getKData(KQuery(0));
+    stk.realtimeUpdate(batch, KQuery::DAY);
+    CHECK_EQ(kdata.size(), 20);
+    CHECK_EQ(kdata[19], ks[19]);
+    REQUIRE(stk.getCount(KQuery::DAY) == ks.size());
+    CHECK_EQ(stk.getKRecord(19, KQuery::DAY), merged);
+    for (size_t i = 20; i < ks.size(); i++) {
+        CHECK_EQ(stk.getKRecord(i, KQuery::DAY), ks[i]);
+    }
+    CHECK_EQ(stk.getKData(KQueryByDate(ks[50].datetime)).size(), 50);
+
+    /** @arg 列式缓存 */
+    Stock col_stk("SH", "TEST05", "batch update columnar test");
+    col_stk.setKRecordColumns(KRecordColumns(init), KQuery::DAY);
+    KData col_kdata = col_stk.getKData(KQuery(0));
+    col_stk.realtimeUpdate(batch, KQuery::DAY);
+    CHECK_EQ(col_kdata.size(), 20);
+    CHECK_EQ(col_kdata[19], ks[19]);
+    REQUIRE(col_stk.getCount(KQuery::DAY) == ks.size());
+    CHECK_EQ(col_stk.getKRecord(19, KQuery::DAY), merged);
+    CHECK_EQ(col_stk.getKRecord(ks.size() - 1, KQuery::DAY), ks.back());
+
+    /** @arg 乱序、重复及空日期记录被剔除或合并 */
+    KRecord next = ks.back();
+    next.datetime = Null<Datetime>();
+    KRecord dup = ks.back();
+    dup.closePrice += 1.0;
+    stk.realtimeUpdate(KRecordList{next, ks[10], dup}, KQuery::DAY);
+    CHECK_EQ(stk.getCount(KQuery::DAY), ks.size());
+    CHECK_EQ(stk.getKRecord(ks.size() - 1, KQuery::DAY).closePrice, dup.closePrice);
+}
+
 /** @} */
@@ -0,0 +1,98 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-16
+ *      Author: fasiondog
+ */
+
+#include "../test_config.h"
+#include <hikyuu/StockManager.h>
+#include <hikyuu/global/KDataLoader.h>
+
+using namespace hku;
+
+/**
+ * @defgroup test_hikyuu_KDataLoader test_hikyuu_KDataLoader
+ * @ingroup test_hikyuu_base_suite
+ * @{
+ */
+
+/** @par 检测点 */
+TEST_CASE("test_KDataLoader") {
+    Stock stk = getStock("sh600000");
+    Stock stk2 = getStock("sh000001");
+    KQuery query(-300, Null<int64_t>(), KQuery::MIN5);
+    KRecordList expect = stk.getKRecordList(query);
+    REQUIRE(expect.size() == 300);
+
+    startKDataLoader(1024 * 1024, 1);
+    KDataLoaderPtr loader = getGlobalKDataLoader();
+    REQUIRE(loader);
+
+    /** @arg 首次加载未命中，再次查询命中，结果一致 */
+    KRecordList result = stk.getKRecordList(query);
+    CHECK_EQ(loader->misses(), 1);
+    CHECK_EQ(loader->hits(), 0);
+    result = stk.getKRecordList(query);
+    CHECK_EQ(loader->hits(), 1);
+    CHECK_UNARY(result == expect);
+
+    /** @arg 包含于已加载区间内的查询（含按日期查询）直接命中 */
+    result = stk.getKRecordList(
+      KQueryByDate(expect[100].datetime, expect[200].datetime, KQuery::MIN5));
+    CHECK_EQ(loader->hits(), 2);
+    REQUIRE(result.size() == 100);
+    CHECK_EQ(result[0], expect[100]);
+    CHECK_EQ(result[99], expect[199]);
+
+    KData kdata = stk.getKData(KQuery(-100, Null<int64_t>(), KQuery::MIN5));
+    CHECK_EQ(loader->hits(), 3);
+    REQUIRE(kdata.size() == 100);
+    CHECK_EQ(kdata[99], expect[299]);
+
+    /** @arg 相邻区间加载后合并 */
+    KRecordList prev = stk.getKRecordList(KQuery(-500, -300, KQuery::MIN5));
+    CHECK_EQ(loader->misses(), 2);
+    result = stk.getKRecordList(KQuery(-500, Null<int64_t>(), KQuery::MIN5));
+    CHECK_EQ(loader->hits(), 4);
+    REQUIRE(result.size() == 500);
+    CHECK_EQ(result[0], prev[0]);
+    CHECK_EQ(result[200], expect[0]);
+
+    /** @arg 超出内存限制时淘汰最近最少使用的区间 */
+    loader->setMaxBytes(loader->getUsedBytes());
+    CHECK_EQ(loader->evictions(), 0);
+    stk2.getKRecordList(query);
+    CHECK_EQ(loader->evictions(), 1);
+    CHECK_LE(loader->getUsedBytes(), loader->getMaxBytes());
+    stk.getKRecordList(query);
+    CHECK_EQ(loader->misses(), 4);
+
+    /**
+     * @arg 预加载及异步获取，单个工作线程时按提交顺序执行；
+     *      数据驱动不支持并行加载时不预加载，异步获取在当前线程中加载
+     */
+    loader->clear();
+    loader->setMaxBytes(64 * 1024 * 1024);
+    loader->prefetch(StockList{stk, stk2}, query);
+    kdata = loader->getKDataAsync(stk, query).get();
+    if (stk.getKDataDirver()->getPrototype()->canParallelLoad()) {
+        CHECK_EQ(loader->misses(), 2);
+        CHECK_EQ(loader->hits(), 1);
+    } else {
+        CHECK_EQ(loader->misses(), 1);
+        CHECK_EQ(loader->hits(), 0);
+    }
+    REQUIRE(kdata.size() == expect.size());
+    CHECK_EQ(kdata[0], expect[0]);
+
+    /** @arg 停止后直接从数据驱动加载 */
+    size_t hits = loader->hits();
+    stopKDataLoader();
+    CHECK_UNARY(!getGlobalKDataLoader());
+    result = stk.getKRecordList(query);
+    CHECK_UNARY(result == expect);
+    CHECK_EQ(loader->hits(), hits);
+}
+
+/** @} */
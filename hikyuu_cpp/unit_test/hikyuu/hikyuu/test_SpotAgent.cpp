@@ -0,0 +1,128 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-17
+ *      Author: fasiondog
+ */
+
+#include "../test_config.h"
+#include <cstring>
+#include <hikyuu/global/agent/SpotAgent.h>
+
+using namespace hku;
+
+/**
+ * @defgroup test_hikyuu_SpotAgent test_hikyuu_SpotAgent
+ * @ingroup test_hikyuu_base_suite
+ * @{
+ */
+
+static Datetime parseSpot(const char* s) {
+    return parseSpotDatetime(s, strlen(s));
+}
+
+/** @par 检测点 */
+TEST_CASE("test_parseSpotDatetime") {
+    /** @arg 无小数秒 */
+    CHECK_EQ(parseSpot("2024-01-02 09:30:05"), Datetime(2024, 1, 2, 9, 30, 5));
+    CHECK_EQ(parseSpot("1999-12-31 23:59:59"), Datetime(1999, 12, 31, 23, 59, 59));
+
+    /** @arg 1~6 位小数秒，不足 6 位时按微秒补齐 */
+    CHECK_EQ(parseSpot("2024-01-02 09:30:05.1"), Datetime(2024, 1, 2, 9, 30, 5, 100));
+    CHECK_EQ(parseSpot("2024-01-02 09:30:05.12"), Datetime(2024, 1, 2, 9, 30, 5, 120));
+    CHECK_EQ(parseSpot("2024-01-02 09:30:05.123"), Datetime(2024, 1, 2, 9, 30, 5, 123));
+    CHECK_EQ(parseSpot("2024-01-02 09:30:05.1234"),
+             Datetime(2024, 1, 2, 9, 30, 5, 123, 400));
+    CHECK_EQ(parseSpot("2024-01-02 09:30:05.12345"),
+             Datetime(2024, 1, 2, 9, 30, 5, 123, 450));
+    CHECK_EQ(parseSpot("2024-01-02 09:30:05.123456"),
+             Datetime(2024, 1, 2, 9, 30, 5, 123, 456));
+    CHECK_EQ(parseSpot("2024-01-02 09:30:05.000001"),
+             Datetime(2024, 1, 2, 9, 30, 5, 0, 1));
+
+    /** @arg 无需以 '\0' 结尾，仅解析指定长度 */
+    const char* buf = "2024-01-02 09:30:05.123456789";
+    CHECK_EQ(parseSpotDatetime(buf, 19), Datetime(2024, 1, 2, 9, 30, 5));
+    CHECK_EQ(parseSpotDatetime(buf, 23), Datetime(2024, 1, 2, 9, 30, 5, 123));
+
+    /** @arg 超过 6 位小数秒、末尾为 '.' 时按 Datetime(string) 解析 */
+    CHECK_EQ(parseSpot("2024-01-02 09:30:05.1234567"),
+             Datetime("2024-01-02 09:30:05.1234567"));
+    CHECK_EQ(parseSpot("2024-01-02 09:30:05."), Datetime(2024, 1, 2, 9, 30, 5));
+
+    /** @arg 含非数字字符时按 Datetime(string) 解析，非法时抛出异常 */
+    CHECK_THROWS(parseSpot("2024-01-02 09:3A:05"));
+    CHECK_THROWS(parseSpot("2024-01-02 09:30:05.12a"));
+    CHECK_THROWS(parseSpot("2024-01-0x 09:30:05"));
+
+    /** @arg 其他格式按 Datetime(string) 解析 */
+    CHECK_EQ(parseSpot("2024/01/02 09:30:05"), Datetime(2024, 1, 2, 9, 30, 5));
+    CHECK_EQ(parseSpot("2024-01-02 09:30"), Datetime(2024, 1, 2, 9, 30));
+    CHECK_EQ(parseSpot("20240102T093005"), Datetime(2024, 1, 2, 9, 30, 5));
+    CHECK_EQ(parseSpot("20240102"), Datetime(2024, 1, 2));
+}
+
+/** @par 检测点 */
+TEST_CASE("test_dispatchSpotShards") {
+    vector<string> codes{"sh600000", "sz000001", "sh600000", "sz000002", "sz000001",
+                         "sh600004", "sh600000", "sz000002", "sh600004", "sz000001"};
+    auto code_at = [&codes](size_t i) { return std::string_view(codes[i]); };
+
+    /** @arg 同一证券代码总是对应同一分片 */
+    for (size_t shard_num : {1, 2, 3, 8}) {
+        for (const auto& code : codes) {
+            size_t n = getSpotShardIndex(code, shard_num);
+            CHECK_LT(n, shard_num);
+            CHECK_EQ(n, getSpotShardIndex(string(code), shard_num));
+        }
+    }
+    CHECK_EQ(getSpotShardIndex("sh600000", 1), 0);
+    CHECK_EQ(getSpotShardIndex("sh600000", 0), 0);
+
+    /** @arg 分配后各分片按接收顺序排列，同一证券的 spot 均在同一分片 */
+    for (size_t shard_num : {1, 2, 3, 8}) {
+        vector<vector<uint32_t>> shards(shard_num);
+        shards[0].push_back(100);  // 原有内容被清除
+        dispatchSpotShards(codes.size(), code_at, shards);
+
+        size_t total = 0;
+        std::map<string, size_t> code_shard;
+        for (size_t n = 0; n < shard_num; n++) {
+            total += shards[n].size();
+            for (size_t i = 0; i < shards[n].size(); i++) {
+                uint32_t pos = shards[n][i];
+                REQUIRE(pos < codes.size());
+                if (i > 0) {
+                    CHECK_LT(shards[n][i - 1], pos);
+                }
+                CHECK_EQ(n, getSpotShardIndex(codes[pos], shard_num));
+                auto iter = code_shard.find(codes[pos]);
+                if (iter == code_shard.end()) {
+                    code_shard[codes[pos]] = n;
+                } else {
+                    CHECK_EQ(iter->second, n);
+                }
+            }
+        }
+        CHECK_EQ(total, codes.size());
+    }
+
+    /** @arg 同一证券在其分片内按接收顺序依次出现 */
+    vector<vector<uint32_t>> shards(3);
+    dispatchSpotShards(codes.size(), code_at, shards);
+    const auto& shard = shards[getSpotShardIndex("sh600000", 3)];
+    vector<uint32_t> sh600000;
+    for (auto pos : shard) {
+        if (codes[pos] == "sh600000") {
+            sh600000.push_back(pos);
+        }
+    }
+    CHECK_UNARY(sh600000 == vector<uint32_t>({0, 2, 6}));
+
+    /** @arg 无分片时不分配 */
+    vector<vector<uint32_t>> empty_shards;
+    dispatchSpotShards(codes.size(), code_at, empty_shards);
+    CHECK_UNARY(empty_shards.empty());
+}
+
+/** @} */
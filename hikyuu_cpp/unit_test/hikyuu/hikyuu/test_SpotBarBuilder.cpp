@@ -0,0 +1,97 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-16
+ *      Author: fasiondog
+ */
+
+#include "../test_config.h"
+#include <hikyuu/StockManager.h>
+#include <hikyuu/global/SpotBarBuilder.h>
+
+using namespace hku;
+
+/**
+ * @defgroup test_hikyuu_SpotBarBuilder test_hikyuu_SpotBarBuilder
+ * @ingroup test_hikyuu_base_suite
+ * @{
+ */
+
+static SpotRecord makeSpot(const Datetime& d, price_t close, price_t amount, price_t volume) {
+    SpotRecord spot;
+    spot.market = "SH";
+    spot.code = "TEST03";
+    spot.datetime = d;
+    spot.open = 10.2;
+    spot.high = 11.0;
+    spot.low = 10.0;
+    spot.close = close;
+    spot.amount = amount;
+    spot.volume = volume;
+    return spot;
+}
+
+/** @par 检测点 */
+TEST_CASE("test_SpotBarBuilder") {
+    /** @arg 不支持的K线类型 */
+    CHECK_THROWS(SpotBarBuilder({KQuery::DAY3}));
+
+    Stock stk("SH", "TEST03", "spot bar test");
+    stk.setKRecordList(
+      KRecordList{KRecord(Datetime(202401091500), 10.0, 10.0, 10.0, 10.0, 500.0, 1000.0)},
+      KQuery::MIN5);
+    stk.setKRecordList(
+      KRecordList{KRecord(Datetime(20240112), 10.0, 12.0, 9.0, 10.0, 1000.0, 50.0)},
+      KQuery::WEEK);
+
+    SpotBarBuilder builder({KQuery::MIN5, KQuery::WEEK, KQuery::DAY});
+    SpotBarBuilder::BarList bars;
+
+    /** @arg 首个 spot，未缓存的K线类型（DAY）不输出，周线在缓存当期K线基础上累积 */
+    builder.build(stk, makeSpot(Datetime(202401100931), 10.5, 100.0, 2.0), bars);
+    REQUIRE(bars.size() == 2);
+    CHECK_EQ(bars[0].first, KQuery::MIN5);
+    CHECK_EQ(bars[0].second,
+             KRecord(Datetime(202401100935), 10.5, 10.5, 10.5, 10.5, 100.0, 200.0));
+    CHECK_EQ(bars[1].first, KQuery::WEEK);
+    CHECK_EQ(bars[1].second, KRecord(Datetime(20240112), 10.0, 12.0, 9.0, 10.5, 1100.0, 52.0));
+
+    /** @arg 同一分钟K线内更新最高、最低、收盘价及成交金额、成交量 */
+    builder.build(stk, makeSpot(Datetime(202401100933), 10.8, 150.0, 3.0), bars);
+    REQUIRE(bars.size() == 2);
+    CHECK_EQ(bars[0].second,
+             KRecord(Datetime(202401100935), 10.5, 10.8, 10.5, 10.8, 150.0, 300.0));
+
+    /** @arg 新的分钟K线，扣除之前K线的累积成交金额、成交量 */
+    builder.build(stk, makeSpot(Datetime(202401100936), 10.7, 200.0, 4.0), bars);
+    REQUIRE(bars.size() == 2);
+    CHECK_EQ(bars[0].second,
+             KRecord(Datetime(202401100940), 10.7, 10.7, 10.7, 10.7, 50.0, 100.0));
+    CHECK_EQ(bars[1].second, KRecord(Datetime(20240112), 10.0, 12.0, 9.0, 10.7, 1200.0, 54.0));
+
+    /** @arg 延迟到达的 spot 不更新已完结的分钟K线 */
+    builder.build(stk, makeSpot(Datetime(202401100934), 10.6, 200.0, 4.0), bars);
+    REQUIRE(bars.size() == 1);
+    CHECK_EQ(bars[0].first, KQuery::WEEK);
+
+    /** @arg 新交易日，分钟K线重新累积，周线计入上一交易日的成交 */
+    builder.build(stk, makeSpot(Datetime(202401110931), 10.9, 30.0, 1.0), bars);
+    REQUIRE(bars.size() == 2);
+    CHECK_EQ(bars[0].second,
+             KRecord(Datetime(202401110935), 10.9, 10.9, 10.9, 10.9, 30.0, 100.0));
+    CHECK_EQ(bars[1].second, KRecord(Datetime(20240112), 10.0, 12.0, 9.0, 10.9, 1230.0, 55.0));
+
+    /** @arg 新的一周 */
+    builder.build(stk, makeSpot(Datetime(202401150931), 10.9, 30.0, 1.0), bars);
+    REQUIRE(bars.size() == 2);
+    CHECK_EQ(bars[1].second, KRecord(Datetime(20240119), 10.2, 11.0, 10.0, 10.9, 30.0, 1.0));
+
+    /** @arg 批量写入缓存 */
+    stk.realtimeUpdate(bars);
+    CHECK_EQ(stk.getCount(KQuery::MIN5), 2);
+    CHECK_EQ(stk.getKRecord(1, KQuery::MIN5), bars[0].second);
+    CHECK_EQ(stk.getCount(KQuery::WEEK), 2);
+    CHECK_EQ(stk.getKRecord(1, KQuery::WEEK), bars[1].second);
+}
+
+/** @} */
@@ -253,4 +253,51 @@ TEST_CASE("test_StockManager_getZhBond10") {
     CHECK_EQ(result[5535].value, doctest::Approx(2.3375));
 }
 
+/** @par 检测点 */
+TEST_CASE("test_StockManager_preloadKData") {
+    StockManager& sm = StockManager::instance();
+    auto driver = sm.getStock("sh000001").getKDataDirver();
+    REQUIRE(driver);
+
+    vector<std::pair<string, string>> market_codes{
+      {"SH", "000001"}, {"SH", "600000"}, {"SZ", "000001"}, {"SZ", "999999"}, {"SH", "600004"}};
+
+    /** @arg 批量读取结果与逐只读取最后 max_num 条记录一致，无数据的证券返回空列表 */
+    for (const auto& ktype : {KQuery::DAY, KQuery::WEEK, KQuery::MIN}) {
+        for (size_t max_num : {0, 1, 100, 100000}) {
+            vector<KRecordList> result(market_codes.size());
+            vector<size_t> called;
+            driver->getConnect()->getLastKRecordLists(
+              market_codes, ktype, max_num, [&](size_t i, KRecordList&& ks) {
+                  called.push_back(i);
+                  result[i] = std::move(ks);
+              });
+            CHECK_EQ(called.size(), market_codes.size());
+            for (size_t i = 0; i < market_codes.size(); i++) {
+                CHECK_EQ(called[i], i);
+                const auto& [market, code] = market_codes[i];
+                auto conn = driver->getConnect();
+                size_t total = conn->getCount(market, code, ktype);
+                KRecordList expect;
+                if (total > 0 && max_num > 0) {
+                    int64_t start = total <= max_num ? 0 : total - max_num;
+                    expect = conn->getKRecordList(market, code,
+                                                  KQuery(start, Null<int64_t>(), ktype));
+                }
+                CHECK_EQ(result[i].size(), expect.size());
+                for (size_t j = 0; j < expect.size(); j++) {
+                    CHECK_EQ(result[i][j], expect[j]);
+                }
+            }
+        }
+    }
+
+    /** @arg 已缓存的证券不会被覆盖 */
+    Stock stk = sm.getStock("sh000001");
+    REQUIRE(stk.isBuffer(KQuery::DAY));
+    size_t count = stk.getCount(KQuery::DAY);
+    CHECK_UNARY_FALSE(stk.setPreloadKRecordList(KQuery::DAY, KRecordList(), false));
+    CHECK_EQ(stk.getCount(KQuery::DAY), count);
+}
+
 /** @} */
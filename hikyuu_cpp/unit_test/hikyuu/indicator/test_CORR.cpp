@@ -95,6 +95,27 @@ TEST_CASE("test_CORR") {
     }
 }
 
+/** @par 检测点 */
+TEST_CASE("test_CORR_nan") {
+    price_t nan = Null<price_t>();
+    Indicator x = PRICELIST(PriceList{1, 2, 3, nan, 5, 6, 7, 8});
+    Indicator y = PRICELIST(PriceList{2, 4, 6, 8, 10, 12, 14, 16});
+
+    /** @arg 窗口内有 NaN 时结果为 NaN，NaN 移出窗口后恢复计算 */
+    Indicator result = CORR(x, y, 3);
+    CHECK_EQ(result.discard(), 2);
+    REQUIRE(result.size() == 8);
+    Indicator cov = result.getResult(1);
+    for (size_t i = 3; i < 6; i++) {
+        CHECK_UNARY(std::isnan(result[i]));
+        CHECK_UNARY(std::isnan(cov[i]));
+    }
+    for (size_t i : {2, 6, 7}) {
+        CHECK_EQ(result[i], doctest::Approx(1.0));
+        CHECK_EQ(cov[i], doctest::Approx(2.0));
+    }
+}
+
 //-----------------------------------------------------------------------------
 // benchmark
 //-----------------------------------------------------------------------------
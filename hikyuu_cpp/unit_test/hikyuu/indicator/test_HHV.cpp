@@ -5,7 +5,7 @@
  *      Author: fasiondog
  */
 
-#include "doctest/doctest.h"
+#include "../test_config.h"
 #include <fstream>
 #include <hikyuu/StockManager.h>
 #include <hikyuu/indicator/crt/CVAL.h>
@@ -133,6 +133,23 @@ TEST_CASE("test_HHV_dyn") {
     }
 }
 
+/** @par 检测点 */
+TEST_CASE("test_HHV_nan") {
+    price_t nan = Null<price_t>();
+    PriceList a{1, 3, nan, 2, nan, nan, nan, 0, 5, 4};
+    Indicator data = PRICELIST(a);
+
+    /** @arg NaN 不参与比较，窗口内全为 NaN 时结果为 NaN */
+    PriceList expect{1, 3, 3, 3, 2, 2, nan, 0, 5, 5};
+    Indicator result = HHV(data, 3);
+    check_indicator(result, expect);
+
+    /** @arg 动态参数与固定参数结果一致 */
+    for (const auto& dyn : {HHV(data, CVAL(data, 3)), HHV(data, IndParam(CVAL(data, 3)))}) {
+        check_indicator(dyn, expect);
+    }
+}
+
 //-----------------------------------------------------------------------------
 // test export
 //-----------------------------------------------------------------------------
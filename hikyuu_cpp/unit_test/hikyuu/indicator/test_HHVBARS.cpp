@@ -185,6 +185,24 @@ TEST_CASE("test_HHVBARS_dyn2") {
     check_indicator(result, expect);
 }
 
+/** @par 检测点 */
+TEST_CASE("test_HHVBARS_nan") {
+    price_t nan = Null<price_t>();
+    PriceList a{1, 3, nan, 3, nan, nan, nan, 0, 5, 5};
+    Indicator data = PRICELIST(a);
+
+    /** @arg NaN 不参与比较，最大值相同时取最近的位置，窗口内全为 NaN 时结果为 NaN */
+    PriceList expect{0, 0, 1, 0, 1, 2, nan, 0, 0, 0};
+    Indicator result = HHVBARS(data, 3);
+    check_indicator(result, expect);
+
+    /** @arg 动态参数与固定参数结果一致 */
+    for (const auto& dyn :
+         {HHVBARS(data, CVAL(data, 3)), HHVBARS(data, IndParam(CVAL(data, 3)))}) {
+        check_indicator(dyn, expect);
+    }
+}
+
 //-----------------------------------------------------------------------------
 // test export
 //-----------------------------------------------------------------------------
@@ -9,6 +9,13 @@
 #include <hikyuu/indicator/Indicator.h>
 #include <hikyuu/indicator/crt/PRICELIST.h>
 #include <hikyuu/indicator/crt/KDATA.h>
+#include <hikyuu/indicator/crt/EMA.h>
+#include <hikyuu/indicator/crt/HHV.h>
+#include <hikyuu/indicator/crt/LLV.h>
+#include <hikyuu/indicator/crt/MA.h>
+#include <hikyuu/indicator/crt/REF.h>
+#include <hikyuu/indicator/crt/STDEV.h>
+#include <hikyuu/indicator/crt/SUM.h>
 #include <hikyuu/StockManager.h>
 
 /**
@@ -874,4 +881,111 @@ TEST_CASE("test_LOGIC_OR") {
     CHECK_EQ(result.size(), 0);
 }
 
+/** @par 检测点 */
+TEST_CASE("test_indicator_fused_calculate") {
+    StockManager& sm = StockManager::instance();
+    Stock stk = sm.getStock("sh000001");
+    KData k = stk.getKData(KQuery(-200));
+    REQUIRE(k.size() == 200);
+
+    Indicator c = CLOSE();
+    Indicator v = VOL();
+    PriceList short_data(50);
+    for (size_t i = 0; i < short_data.size(); i++) {
+        short_data[i] = i % 3;
+    }
+    Indicator x = PRICELIST(short_data);
+
+    std::vector<Indicator> formulas{
+      (c > MA(c, 5)) & (v > MA(v, 10) * 1.5),
+      (c - REF(c, 1)) / REF(c, 1) * 100.0 + 1.0,
+      IF(c > OPEN(), HIGH() - c, c - LOW()) + (v % 7.0),
+      ((c >= MA(c, 20)) | (c <= MA(c, 60))) != (c < MA(c, 10)),
+      IF(x > 0.0, c + x, c - x) * 2.0,
+      (x + c) - (MA(c, 3) == c),
+    };
+
+    for (auto& formula : formulas) {
+        IndicatorImp::setFusedCalculate(false);
+        Indicator expect = formula(k);
+        IndicatorImp::setFusedCalculate(true);
+        Indicator result = formula(k);
+        CHECK_EQ(result.size(), expect.size());
+        CHECK_EQ(result.discard(), expect.discard());
+        CHECK_EQ(result.getResultNumber(), expect.getResultNumber());
+        for (size_t i = 0; i < expect.size(); i++) {
+            if (std::isnan(expect[i])) {
+                CHECK_UNARY(std::isnan(result[i]));
+            } else {
+                CHECK_EQ(result[i], expect[i]);
+            }
+        }
+
+        /** @arg 融合计算后再次计算结果不变 */
+        Indicator again = result(k);
+        CHECK_EQ(again.size(), expect.size());
+        if (expect.size() > 0) {
+            CHECK_EQ(again[expect.size() - 1], result[expect.size() - 1]);
+        }
+    }
+}
+
+/** @par 检测点 */
+TEST_CASE("test_indicator_update_context") {
+    StockManager& sm = StockManager::instance();
+    KRecordList ks = sm.getStock("sh000001").getKRecordList(KQuery(0, 220, KQuery::DAY));
+    REQUIRE(ks.size() == 220);
+
+    Indicator c = CLOSE();
+    Indicator v = VOL();
+    std::vector<Indicator> formulas{
+      MA(c, 5) + EMA(c, 10),
+      (c > MA(c, 20)) & (v > MA(v, 10) * 1.5),
+      IF(c > REF(c, 1), HHV(HIGH(), 10), LLV(LOW(), 10)) - SUM(c, 5) / 5.0,
+      (c - MA(c, 0)) * SUM(c, 0) + HHV(c, 0) - LLV(c, 0),
+      STDEV(c, 10) + c,
+      KDATA(),
+    };
+
+    for (auto& formula : formulas) {
+        for (const KQuery& query : {KQuery(0), KQuery(-100)}) {
+            Stock stk("SH", "TEST02", "update context test");
+            stk.setKRecordList(KRecordList(ks.begin(), ks.begin() + 200), KQuery::DAY);
+            Indicator result = formula.clone();
+            result.updateContext(stk.getKData(query));
+
+            for (size_t i = 200; i < ks.size(); i++) {
+                /** @arg 修改最后一根K线 */
+                KRecord last = stk.getKRecord(stk.getCount() - 1);
+                last.closePrice += 1.0;
+                last.highPrice += 2.0;
+                stk.realtimeUpdate(last, KQuery::DAY);
+                result.updateContext(stk.getKData(query));
+
+                Indicator expect = formula(stk.getKData(query));
+                REQUIRE(result.size() == expect.size());
+                CHECK_EQ(result.discard(), expect.discard());
+                for (size_t r = 0; r < expect.getResultNumber(); r++) {
+                    for (size_t j = expect.discard(); j < expect.size(); j++) {
+                        CHECK_EQ(result.get(j, r), doctest::Approx(expect.get(j, r)));
+                    }
+                }
+
+                /** @arg 追加新的K线 */
+                stk.realtimeUpdate(ks[i], KQuery::DAY);
+                result.updateContext(stk.getKData(query));
+
+                expect = formula(stk.getKData(query));
+                REQUIRE(result.size() == expect.size());
+                CHECK_EQ(result.discard(), expect.discard());
+                for (size_t r = 0; r < expect.getResultNumber(); r++) {
+                    for (size_t j = expect.discard(); j < expect.size(); j++) {
+                        CHECK_EQ(result.get(j, r), doctest::Approx(expect.get(j, r)));
+                    }
+                }
+            }
+        }
+    }
+}
+
 /** @} */
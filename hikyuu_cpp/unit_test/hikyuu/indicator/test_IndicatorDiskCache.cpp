@@ -0,0 +1,125 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-16
+ *      Author: fasiondog
+ */
+
+#include "../test_config.h"
+#include <hikyuu/StockManager.h>
+#include <hikyuu/utilities/os.h>
+#include <hikyuu/version.h>
+#include <hikyuu/indicator/IndicatorDiskCache.h>
+#include <hikyuu/indicator/crt/IC.h>
+#include <hikyuu/indicator/crt/KDATA.h>
+#include <hikyuu/indicator/crt/MA.h>
+#include <hikyuu/indicator/crt/MACD.h>
+#include <hikyuu/indicator/crt/SPEARMAN.h>
+
+using namespace hku;
+
+/**
+ * @defgroup test_indicator_IndicatorDiskCache test_indicator_IndicatorDiskCache
+ * @ingroup test_hikyuu_indicator_suite
+ * @{
+ */
+
+/** @par 检测点 */
+TEST_CASE("test_IndicatorDiskCache") {
+    StockManager& sm = StockManager::instance();
+    KData k = sm["sh600000"].getKData(KQuery(-300));
+    KData k2 = sm["sz000001"].getKData(KQuery(-300));
+    string path = sm.tmpdir() + "/test_indicator_disk_cache";
+
+    /** @arg 未启用时不使用磁盘缓存 */
+    CHECK_UNARY(IndicatorDiskCache::setPath(""));
+    CHECK_UNARY(!IndicatorDiskCache::enabled());
+    Indicator expect = SPEARMAN(CLOSE(), MA(CLOSE(), 10), 20)(k);
+    Indicator expect_macd = MACD(CLOSE())(k);
+
+    REQUIRE(IndicatorDiskCache::setPath(path));
+    IndicatorDiskCache::clear();
+    CHECK_UNARY(IndicatorDiskCache::enabled());
+    CHECK_EQ(IndicatorDiskCache::getPath(), path);
+    CHECK_EQ(IndicatorDiskCache::hits(), 0);
+
+    /** @arg 首次计算写入缓存，之后直接从磁盘加载，结果一致（含多结果集） */
+    Indicator x = SPEARMAN(CLOSE(), MA(CLOSE(), 10), 20)(k);
+    Indicator macd = MACD(CLOSE())(k);
+    CHECK_EQ(IndicatorDiskCache::hits(), 0);
+
+    Indicator y = SPEARMAN(CLOSE(), MA(CLOSE(), 10), 20)(k);
+    Indicator macd2 = MACD(CLOSE())(k);
+    CHECK_EQ(IndicatorDiskCache::hits(), 2);
+    for (const auto& pair : {std::make_pair(x, expect), std::make_pair(y, expect),
+                             std::make_pair(macd2, expect_macd)}) {
+        const Indicator& result = pair.first;
+        const Indicator& target = pair.second;
+        REQUIRE(result.size() == target.size());
+        CHECK_EQ(result.discard(), target.discard());
+        CHECK_EQ(result.getResultNumber(), target.getResultNumber());
+        for (size_t r = 0; r < target.getResultNumber(); r++) {
+            for (size_t i = target.discard(); i < target.size(); i++) {
+                CHECK_EQ(result.get(i, r), doctest::Approx(target.get(i, r)));
+            }
+        }
+    }
+
+    /** @arg 参数或上下文不同时不命中 */
+    size_t hits = IndicatorDiskCache::hits();
+    Indicator z = SPEARMAN(CLOSE(), MA(CLOSE(), 5), 20)(k);
+    z = SPEARMAN(CLOSE(), MA(CLOSE(), 10), 20)(k2);
+    z = SPEARMAN(CLOSE(), MA(CLOSE(), 10), 20)(sm["sh600000"].getKData(KQuery(-200)));
+    CHECK_EQ(IndicatorDiskCache::hits(), hits);
+
+    /** @arg K线数据不同时数据指纹不同 */
+    CHECK_EQ(IndicatorDiskCache::getDataStamp(k), IndicatorDiskCache::getDataStamp(k));
+    CHECK_NE(IndicatorDiskCache::getDataStamp(k), IndicatorDiskCache::getDataStamp(k2));
+
+    /** @arg 键值包含库版本、算法版本及参考指标 */
+    string key, key2;
+    CHECK_UNARY(IndicatorDiskCache::getKey(*x.getImp(), key));
+    CHECK_NE(key.find(HKU_VERSION), string::npos);
+    CHECK_UNARY(
+      IndicatorDiskCache::getKey(*SPEARMAN(CLOSE(), MA(CLOSE(), 5), 20)(k).getImp(), key2));
+    CHECK_NE(key, key2);
+
+    /** @arg 依赖其他证券数据的指标不缓存 */
+    StockList stks{sm["sh600000"], sm["sz000001"], sm["sz000002"]};
+    Indicator ic = IC(MA(CLOSE()), stks, KQuery(-100), sm["sh000001"], 1);
+    ic = ic(k);
+    CHECK_UNARY(!IndicatorDiskCache::getKey(*ic.getImp(), key));
+    CHECK_UNARY(!IndicatorDiskCache::getKey(*MA(CLOSE(), 10).getImp(), key));
+
+    /** @arg 清除缓存后重新计算 */
+    IndicatorDiskCache::clear();
+    CHECK_EQ(IndicatorDiskCache::hits(), 0);
+    CHECK_EQ(IndicatorDiskCache::usedBytes(), 0);
+    z = SPEARMAN(CLOSE(), MA(CLOSE(), 10), 20)(k);
+    CHECK_EQ(IndicatorDiskCache::hits(), 0);
+    CHECK_GT(IndicatorDiskCache::usedBytes(), k.size() * sizeof(Indicator::value_t));
+
+    /** @arg 超出缓存大小上限时删除最久未使用的缓存文件 */
+    IndicatorDiskCache::clear();
+    uint64_t max_bytes = IndicatorDiskCache::getMaxBytes();
+    uint64_t file_bytes = k.size() * sizeof(Indicator::value_t);
+    IndicatorDiskCache::setMaxBytes(file_bytes * 4);
+    CHECK_EQ(IndicatorDiskCache::getMaxBytes(), file_bytes * 4);
+    for (int n = 2; n < 10; n++) {
+        z = SPEARMAN(CLOSE(), MA(CLOSE(), n), 20)(k);
+        CHECK_LE(IndicatorDiskCache::usedBytes(), IndicatorDiskCache::getMaxBytes());
+    }
+    CHECK_GT(IndicatorDiskCache::usedBytes(), 0);
+    for (int n = 2; n < 10; n++) {
+        z = SPEARMAN(CLOSE(), MA(CLOSE(), n), 20)(k);
+    }
+    CHECK_LT(IndicatorDiskCache::hits(), 8);
+    IndicatorDiskCache::setMaxBytes(max_bytes);
+
+    IndicatorDiskCache::clear();
+    IndicatorDiskCache::setPath("");
+    removeDir(path);
+    CHECK_UNARY(!IndicatorDiskCache::enabled());
+}
+
+/** @} */
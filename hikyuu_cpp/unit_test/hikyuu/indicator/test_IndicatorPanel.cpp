@@ -0,0 +1,238 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-16
+ *      Author: fasiondog
+ */
+
+#include "../test_config.h"
+#include <hikyuu/StockManager.h>
+#include <hikyuu/indicator/IndicatorPanel.h>
+#include <hikyuu/indicator/crt/ALIGN.h>
+#include <hikyuu/indicator/crt/INSUM.h>
+#include <hikyuu/indicator/crt/KDATA.h>
+#include <hikyuu/indicator/crt/MA.h>
+#include <hikyuu/indicator/crt/ZSCORE.h>
+#include <hikyuu/indicator/crt/PRICELIST.h>
+
+using namespace hku;
+
+/**
+ * @defgroup test_indicator_IndicatorPanel test_indicator_IndicatorPanel
+ * @ingroup test_hikyuu_indicator_suite
+ * @{
+ */
+
+static void check_panel_value(IndicatorPanel::value_t result, IndicatorPanel::value_t expect) {
+    if (std::isnan(expect)) {
+        CHECK_UNARY(std::isnan(result));
+    } else {
+        CHECK_EQ(result, doctest::Approx(expect));
+    }
+}
+
+/** @par 检测点 */
+TEST_CASE("test_IndicatorPanel_create") {
+    StockManager& sm = StockManager::instance();
+    StockList stks{sm["sh600000"], sm["sh600004"], sm["sz000001"], sm["sz000002"], Null<Stock>()};
+    KQuery query = KQuery(-200);
+    DatetimeList dates = sm["sh000001"].getDatetimeList(query);
+    Indicator ind = MA(CLOSE(), 10);
+    IndicatorPanel::clearCache();
+
+    /** @arg 与逐个证券对齐计算的结果一致，按日期连续存放 */
+    auto panel = IndicatorPanel::create(ind, stks, query, dates, false);
+    REQUIRE(panel->dateCount() == dates.size());
+    REQUIRE(panel->stockCount() == stks.size());
+    for (size_t si = 0; si < stks.size() - 1; si++) {
+        Indicator expect = ALIGN(ind, dates, false)(stks[si].getKData(query));
+        CHECK_EQ(panel->discard(si), expect.discard());
+        PriceList column = panel->getColumn(si);
+        for (size_t di = 0; di < dates.size(); di++) {
+            check_panel_value(panel->get(di, si), expect[di]);
+            check_panel_value(panel->row(di)[si], expect[di]);
+            check_panel_value(column[di], expect[di]);
+        }
+    }
+
+    /** @arg 无数据的证券全部为 Null */
+    size_t null_pos = stks.size() - 1;
+    CHECK_EQ(panel->discard(null_pos), dates.size());
+    for (size_t di = 0; di < dates.size(); di++) {
+        CHECK_UNARY(std::isnan(panel->get(di, null_pos)));
+    }
+
+    /** @arg 相同公式（忽略上下文）、证券、查询条件及日期时复用缓存 */
+    CHECK_EQ(IndicatorPanel::cacheSize(), 1);
+    auto panel2 = IndicatorPanel::create(MA(CLOSE(), 10)(stks[0].getKData(query)), stks, query,
+                                         dates, false);
+    CHECK_EQ(panel2.get(), panel.get());
+    CHECK_EQ(IndicatorPanel::cacheSize(), 1);
+
+    /** @arg 参数或对齐方式不同时重新计算 */
+    auto panel3 = IndicatorPanel::create(MA(CLOSE(), 20), stks, query, dates, false);
+    CHECK_NE(panel3.get(), panel.get());
+    auto panel4 = IndicatorPanel::create(ind, stks, query, dates, true);
+    CHECK_NE(panel4.get(), panel.get());
+    CHECK_EQ(IndicatorPanel::cacheSize(), 3);
+
+    /** @arg 超出缓存容量时淘汰最久未使用的面板 */
+    IndicatorPanel::setCacheCapacity(2);
+    CHECK_EQ(IndicatorPanel::cacheSize(), 2);
+    auto panel5 = IndicatorPanel::create(ind, stks, query, dates, false);
+    CHECK_NE(panel5.get(), panel.get());
+    IndicatorPanel::setCacheCapacity(8);
+
+    /** @arg 释放并重新加载K线缓存后数据版本变化，重新计算 */
+    auto panel6 = IndicatorPanel::create(ind, stks, query, dates, false);
+    CHECK_EQ(IndicatorPanel::create(ind, stks, query, dates, false).get(), panel6.get());
+    Stock stk = stks[0];
+    stk.releaseKDataBuffer(KQuery::DAY);
+    stk.loadKDataToBuffer(KQuery::DAY);
+    CHECK_NE(IndicatorPanel::create(ind, stks, query, dates, false).get(), panel6.get());
+
+    /** @arg 未缓存K线数据的类型不缓存面板 */
+    IndicatorPanel::clearCache();
+    KQuery min_query = KQuery(-100, Null<int64_t>(), KQuery::MIN);
+    DatetimeList min_dates = sm["sh000001"].getDatetimeList(min_query);
+    IndicatorPanel::create(ind, stks, min_query, min_dates, false);
+    CHECK_EQ(IndicatorPanel::cacheSize(), 0);
+
+    IndicatorPanel::clearCache();
+    CHECK_EQ(IndicatorPanel::cacheSize(), 0);
+}
+
+/** @par 检测点 */
+TEST_CASE("test_IndicatorPanel_cross_section") {
+    StockList stks(4);
+    DatetimeList dates{Datetime(202001010000L), Datetime(202001020000L), Datetime(202001030000L)};
+    IndicatorPanel panel(dates, stks);
+    const IndicatorPanel::value_t null_value = Null<IndicatorPanel::value_t>();
+    const vector<PriceList> values{
+      {3.0, 1.0, null_value, 2.0}, {5.0, 5.0, 1.0, 2.0}, {null_value, 4.0, null_value, null_value}};
+    for (size_t di = 0; di < dates.size(); di++) {
+        std::copy(values[di].begin(), values[di].end(), panel.row(di));
+    }
+
+    /** @arg 每日截面统计 */
+    PriceList sum = panel.sum();
+    PriceList mean = panel.mean();
+    CHECK_EQ(sum[0], 6.0);
+    CHECK_EQ(sum[1], 13.0);
+    CHECK_EQ(sum[2], 4.0);
+    CHECK_EQ(mean[0], 2.0);
+    CHECK_EQ(mean[1], 3.25);
+    CHECK_EQ(panel.max()[1], 5.0);
+    CHECK_EQ(panel.min()[1], 1.0);
+
+    /** @arg 排名，值相同时排名相同 */
+    IndicatorPanel rank = panel.rank();
+    CHECK_EQ(rank.get(0, 0), 1.0);
+    CHECK_EQ(rank.get(0, 1), 3.0);
+    CHECK_UNARY(std::isnan(rank.get(0, 2)));
+    CHECK_EQ(rank.get(0, 3), 2.0);
+    CHECK_EQ(rank.get(1, 0), 1.0);
+    CHECK_EQ(rank.get(1, 1), 1.0);
+    CHECK_EQ(rank.get(1, 2), 4.0);
+    rank = panel.rank(true);
+    CHECK_EQ(rank.get(1, 0), 3.0);
+    CHECK_EQ(rank.get(1, 2), 1.0);
+    CHECK_EQ(panel.rankOf(1, 3.0), 3.0);
+    CHECK_EQ(panel.rankOf(1, 3.0, true), 3.0);
+    CHECK_EQ(panel.rankOf(1, null_value), 1.0);
+
+    /** @arg 标准化，与 ZSCORE 的结果一致 */
+    IndicatorPanel zscore = panel.zscore();
+    for (size_t di = 0; di < dates.size(); di++) {
+        Indicator expect = ZSCORE(PRICELIST(values[di]));
+        for (size_t si = 0; si < stks.size(); si++) {
+            check_panel_value(zscore.get(di, si), expect[si]);
+        }
+    }
+
+    /** @arg 最小最大值归一化，最大值等于最小值时为 Null */
+    IndicatorPanel normalize = panel.normalize();
+    CHECK_EQ(normalize.get(0, 0), 1.0);
+    CHECK_EQ(normalize.get(0, 1), 0.0);
+    CHECK_EQ(normalize.get(0, 3), 0.5);
+    CHECK_EQ(normalize.get(1, 3), 0.25);
+    CHECK_UNARY(std::isnan(normalize.get(2, 1)));
+
+    /** @arg 分组 */
+    IndicatorPanel quantile = panel.quantile(2);
+    CHECK_EQ(quantile.get(1, 2), 0.0);
+    CHECK_EQ(quantile.get(1, 3), 0.0);
+    CHECK_EQ(quantile.get(1, 0), 1.0);
+    CHECK_EQ(quantile.get(1, 1), 1.0);
+    CHECK_UNARY(std::isnan(quantile.get(0, 2)));
+}
+
+/** @par 检测点 */
+TEST_CASE("test_IndicatorPanel_INSUM") {
+    StockManager& sm = StockManager::instance();
+    Block blk("test", "panel");
+    for (const char* code : {"sh600000", "sh600004", "sz000001", "sz000002"}) {
+        blk.add(sm[code]);
+    }
+    StockList stks = blk.getStockList();
+    KQuery query = KQuery(-100);
+    KData k = sm["sh600000"].getKData(query);
+    DatetimeList dates = k.getDatetimeList();
+    Indicator ind = MA(CLOSE(), 5);
+
+    vector<Indicator> all;
+    for (const auto& stk : stks) {
+        all.emplace_back(ALIGN(ind, dates, false)(stk.getKData(query)));
+    }
+
+    /** @arg 基于截面面板的 INSUM 与逐个证券直接计算的结果一致 */
+    Indicator sum = INSUM(blk, ind, 0)(k);
+    Indicator rank = INSUM(blk, ind, 4)(k);
+    Indicator self = ALIGN(ind, dates, false)(k);
+    for (size_t di = sum.discard(); di < dates.size(); di++) {
+        price_t expect_sum = Null<price_t>();
+        price_t expect_rank = 1.0;
+        for (const auto& x : all) {
+            if (!std::isnan(x[di])) {
+                expect_sum = std::isnan(expect_sum) ? x[di] : expect_sum + x[di];
+                if (x[di] > self[di]) {
+                    expect_rank += 1.0;
+                }
+            }
+        }
+        check_panel_value(sum[di], expect_sum);
+        if (di >= rank.discard()) {
+            CHECK_EQ(rank[di], expect_rank);
+        }
+    }
+    IndicatorPanel::clearCache();
+}
+
+#if ENABLE_BENCHMARK_TEST
+TEST_CASE("test_IndicatorPanel_benchmark") {
+    StockManager& sm = StockManager::instance();
+    StockList stks = sm.getStockList();
+    if (stks.size() > 1000) {
+        stks.resize(1000);
+    }
+    Block all_blk("test", "panel");
+    for (const auto& stk : stks) {
+        all_blk.add(stk);
+    }
+    KQuery query = KQuery(-250);
+    int cycle = 10;
+
+    {
+        BENCHMARK_TIME_MSG(test_IndicatorPanel_INSUM, cycle, "INSUM rank {} stocks", stks.size());
+        for (int i = 0; i < cycle; i++) {
+            IndicatorPanel::clearCache();
+            for (size_t si = 0; si < 20; si++) {
+                Indicator x = INSUM(all_blk, MA(CLOSE(), 5), 4)(stks[si].getKData(query));
+            }
+        }
+    }
+    IndicatorPanel::clearCache();
+}
+#endif
+
+/** @} */
@@ -5,7 +5,7 @@
  *      Author: fasiondog
  */
 
-#include "doctest/doctest.h"
+#include "../test_config.h"
 #include <fstream>
 #include <hikyuu/StockManager.h>
 #include <hikyuu/indicator/crt/LLV.h>
@@ -115,6 +115,23 @@ TEST_CASE("test_LLV_dyn") {
     }
 }
 
+/** @par 检测点 */
+TEST_CASE("test_LLV_nan") {
+    price_t nan = Null<price_t>();
+    PriceList a{5, 3, nan, 4, nan, nan, nan, 6, 1, 2};
+    Indicator data = PRICELIST(a);
+
+    /** @arg NaN 不参与比较，窗口内全为 NaN 时结果为 NaN */
+    PriceList expect{5, 3, 3, 3, 4, 4, nan, 6, 1, 1};
+    Indicator result = LLV(data, 3);
+    check_indicator(result, expect);
+
+    /** @arg 动态参数与固定参数结果一致 */
+    for (const auto& dyn : {LLV(data, CVAL(data, 3)), LLV(data, IndParam(CVAL(data, 3)))}) {
+        check_indicator(dyn, expect);
+    }
+}
+
 //-----------------------------------------------------------------------------
 // test export
 //-----------------------------------------------------------------------------
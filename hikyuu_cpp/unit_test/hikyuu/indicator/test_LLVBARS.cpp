@@ -7,7 +7,7 @@
  *      Author: fasiondog
  */
 
-#include "doctest/doctest.h"
+#include "../test_config.h"
 #include <fstream>
 #include <hikyuu/StockManager.h>
 #include <hikyuu/indicator/crt/CVAL.h>
@@ -171,6 +171,24 @@ TEST_CASE("test_HHVBARS_dyn") {
     }
 }
 
+/** @par 检测点 */
+TEST_CASE("test_LLVBARS_nan") {
+    price_t nan = Null<price_t>();
+    PriceList a{5, 3, nan, 3, nan, nan, nan, 6, 1, 1};
+    Indicator data = PRICELIST(a);
+
+    /** @arg NaN 不参与比较，最小值相同时取最近的位置，窗口内全为 NaN 时结果为 NaN */
+    PriceList expect{0, 0, 1, 0, 1, 2, nan, 0, 0, 0};
+    Indicator result = LLVBARS(data, 3);
+    check_indicator(result, expect);
+
+    /** @arg 动态参数与固定参数结果一致 */
+    for (const auto& dyn :
+         {LLVBARS(data, CVAL(data, 3)), LLVBARS(data, IndParam(CVAL(data, 3)))}) {
+        check_indicator(dyn, expect);
+    }
+}
+
 //-----------------------------------------------------------------------------
 // test export
 //-----------------------------------------------------------------------------
@@ -4,7 +4,7 @@
  *  Created on: 2013-2-12
  *      Author: fasiondog
  */
-#include "doctest/doctest.h"
+#include "../test_config.h"
 #include <fstream>
 #include <hikyuu/StockManager.h>
 #include <hikyuu/indicator/crt/SLOPE.h>
@@ -110,6 +110,23 @@ TEST_CASE("test_SLOPE_dyn") {
     }
 }
 
+/** @par 检测点 */
+TEST_CASE("test_SLOPE_nan") {
+    price_t nan = Null<price_t>();
+    PriceList a{1, 2, 3, nan, 5, 6, 7, 8};
+    Indicator data = PRICELIST(a);
+
+    /** @arg 窗口内有 NaN 时结果为 NaN，NaN 移出窗口后恢复计算 */
+    PriceList expect{nan, 1, 1, nan, nan, nan, 1, 1};
+    Indicator result = SLOPE(data, 3);
+    check_indicator(result, expect);
+
+    /** @arg 动态参数 */
+    for (const auto& dyn : {SLOPE(data, CVAL(data, 3)), SLOPE(data, IndParam(CVAL(data, 3)))}) {
+        check_indicator(dyn, expect);
+    }
+}
+
 //-----------------------------------------------------------------------------
 // test export
 //-----------------------------------------------------------------------------
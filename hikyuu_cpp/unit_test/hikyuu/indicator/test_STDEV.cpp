@@ -5,7 +5,7 @@
  *      Author: fasiondog
  */
 
-#include "doctest/doctest.h"
+#include "../test_config.h"
 #include <fstream>
 #include <hikyuu/StockManager.h>
 #include <hikyuu/indicator/crt/KDATA.h>
@@ -86,6 +86,24 @@ TEST_CASE("test_STDEV_dyn") {
     }
 }
 
+/** @par 检测点 */
+TEST_CASE("test_STDEV_nan") {
+    price_t nan = Null<price_t>();
+    PriceList a{1, 2, 3, nan, 5, 6, 7, 8};
+    Indicator data = PRICELIST(a);
+
+    /** @arg 窗口内的 NaN 不参与计算，NaN 所在位置结果为 NaN */
+    PriceList expect{0, 0.707107, 1, nan, 1.414214, 0.707107, 1, 1};
+    Indicator result = STDEV(data, 3);
+    check_indicator(result, expect, 1);
+
+    /** @arg 动态参数时，窗口内有 NaN 时结果为 NaN，NaN 移出窗口后恢复计算 */
+    expect = {0, 0.707107, 1, nan, nan, nan, 1, 1};
+    for (const auto& dyn : {STDEV(data, CVAL(data, 3)), STDEV(data, IndParam(CVAL(data, 3)))}) {
+        check_indicator(dyn, expect, 1);
+    }
+}
+
 //-----------------------------------------------------------------------------
 // test export
 //-----------------------------------------------------------------------------
@@ -119,6 +119,54 @@ TEST_CASE("test_VAR_dyn") {
     }
 }
 
+/** @par 检测点 */
+TEST_CASE("test_VAR_nan") {
+    price_t nan = Null<price_t>();
+    PriceList a{1, 2, 3, nan, 5, 6, 7, 8};
+    Indicator data = PRICELIST(a);
+
+    /** @arg 窗口内有 NaN 时结果为 NaN，NaN 移出窗口后恢复计算 */
+    PriceList expect{nan, nan, 1, nan, nan, nan, 1, 1};
+    Indicator result = VAR(data, 3);
+    check_indicator(result, expect);
+
+    /** @arg 动态参数 */
+    for (const auto& dyn : {VAR(data, CVAL(data, 3)), VAR(data, IndParam(CVAL(data, 3)))}) {
+        check_indicator(dyn, expect);
+    }
+}
+
+/** @par 检测点 */
+TEST_CASE("test_VAR_precision") {
+    /** @arg 长序列、数值较大时，滑动窗口结果与逐窗口两遍计算结果一致 */
+    /** @arg STDEV/STDP/VARP 与 VAR 使用相同的滑动累计，仅在此检测 */
+    const size_t total = 200000;
+    const size_t n = 20;
+    PriceList a(total);
+    for (size_t i = 0; i < total; i++) {
+        a[i] = 1.0e8 + 1000.0 * std::sin(i * 0.001) + std::sin(i * 1.7);
+    }
+    Indicator data = PRICELIST(a);
+    Indicator result = VAR(data, n);
+    Indicator dyn = VAR(data, IndParam(CVAL(data, n)));
+    REQUIRE(result.size() == total);
+    REQUIRE(dyn.size() == total);
+    for (size_t i = n - 1; i < total; i += 97) {
+        long double mean = 0.0;
+        for (size_t j = i + 1 - n; j <= i; j++) {
+            mean += a[j];
+        }
+        mean /= n;
+        long double m2 = 0.0;
+        for (size_t j = i + 1 - n; j <= i; j++) {
+            m2 += (a[j] - mean) * (a[j] - mean);
+        }
+        double expect = double(m2 / (n - 1));
+        CHECK_EQ(result[i], doctest::Approx(expect).epsilon(1e-6));
+        CHECK_EQ(dyn[i], doctest::Approx(expect).epsilon(1e-6));
+    }
+}
+
 //-----------------------------------------------------------------------------
 // test export
 //-----------------------------------------------------------------------------
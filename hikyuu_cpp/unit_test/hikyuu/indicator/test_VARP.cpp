@@ -7,7 +7,7 @@
  *      Author: fasiondog
  */
 
-#include "doctest/doctest.h"
+#include "../test_config.h"
 #include <fstream>
 #include <hikyuu/StockManager.h>
 #include <hikyuu/indicator/crt/KDATA.h>
@@ -98,6 +98,23 @@ TEST_CASE("test_VARP_dyn") {
     }
 }
 
+/** @par 检测点 */
+TEST_CASE("test_VARP_nan") {
+    price_t nan = Null<price_t>();
+    PriceList a{1, 2, 3, nan, 5, 6, 7, 8};
+    Indicator data = PRICELIST(a);
+
+    /** @arg 窗口内有 NaN 时结果为 NaN，NaN 移出窗口后恢复计算 */
+    PriceList expect{nan, nan, 0.666667, nan, nan, nan, 0.666667, 0.666667};
+    Indicator result = VARP(data, 3);
+    check_indicator(result, expect);
+
+    /** @arg 动态参数 */
+    for (const auto& dyn : {VARP(data, CVAL(data, 3)), VARP(data, IndParam(CVAL(data, 3)))}) {
+        check_indicator(dyn, expect);
+    }
+}
+
 //-----------------------------------------------------------------------------
 // test export
 //-----------------------------------------------------------------------------
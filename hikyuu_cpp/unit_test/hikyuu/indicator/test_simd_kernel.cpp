@@ -0,0 +1,159 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-16
+ *      Author: fasiondog
+ */
+
+#include "../test_config.h"
+#include <cstring>
+#include <random>
+#include <hikyuu/indicator/simd_kernel.h>
+#include <hikyuu/indicator/crt/ABS.h>
+#include <hikyuu/indicator/crt/PRICELIST.h>
+#include <hikyuu/indicator/crt/SQRT.h>
+
+/**
+ * @defgroup test_indicator_simd_kernel test_indicator_simd_kernel
+ * @ingroup test_hikyuu_indicator_suite
+ * @{
+ */
+
+typedef simd::value_t simd_value_t;
+typedef void (*simd_binary_func)(const simd_value_t*, const simd_value_t*, simd_value_t*, size_t);
+typedef void (*simd_unary_func)(const simd_value_t*, simd_value_t*, size_t);
+
+static std::vector<simd_value_t> make_simd_test_data(size_t n, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> dist(-10.0, 10.0);
+    std::vector<simd_value_t> result(n);
+    for (size_t i = 0; i < n; i++) {
+        result[i] = dist(gen);
+        if (i % 7 == 0) {
+            result[i] = Null<simd_value_t>();
+        } else if (i % 11 == 0) {
+            result[i] = 0.0;
+        } else if (i % 13 == 0) {
+            result[i] = -0.0;
+        }
+    }
+    return result;
+}
+
+/** @par 检测点 */
+TEST_CASE("test_simd_kernel") {
+    HKU_INFO("simd instruction set: {}", simd::instructionSet());
+
+    // 非向量宽度整数倍的长度，覆盖尾部处理
+    size_t n = 1031;
+    auto a = make_simd_test_data(n, 1);
+    auto b = make_simd_test_data(n, 2);
+    auto c = make_simd_test_data(n, 3);
+    for (size_t i = 0; i < n; i += 17) {
+        b[i] = a[i];
+    }
+
+    std::vector<simd_value_t> expect(n), result(n);
+
+    /** @arg 二元运算与标量实现结果完全一致 */
+    simd_binary_func binary_funcs[] = {simd::add, simd::sub,       simd::mul,     simd::div,
+                                       simd::eq,  simd::ne,        simd::gt,      simd::lt,
+                                       simd::ge,  simd::le,        simd::logic_and, simd::logic_or};
+    for (auto func : binary_funcs) {
+        for (size_t offset = 0; offset < 3; offset++) {
+            simd::setEnable(false);
+            func(a.data() + offset, b.data(), expect.data(), n - offset);
+            simd::setEnable(true);
+            func(a.data() + offset, b.data(), result.data(), n - offset);
+            CHECK_EQ(memcmp(expect.data(), result.data(), n * sizeof(simd_value_t)), 0);
+        }
+    }
+
+    /** @arg 一元运算与标量实现结果完全一致 */
+    simd_unary_func unary_funcs[] = {simd::abs, simd::sqrt, simd::floor, simd::ceil, simd::neg};
+    for (auto func : unary_funcs) {
+        simd::setEnable(false);
+        func(a.data(), expect.data(), n);
+        simd::setEnable(true);
+        func(a.data(), result.data(), n);
+        CHECK_EQ(memcmp(expect.data(), result.data(), n * sizeof(simd_value_t)), 0);
+    }
+
+    /** @arg IF 选择与标量实现结果完全一致 */
+    simd::setEnable(false);
+    simd::select(c.data(), a.data(), b.data(), expect.data(), n);
+    simd::setEnable(true);
+    simd::select(c.data(), a.data(), b.data(), result.data(), n);
+    CHECK_EQ(memcmp(expect.data(), result.data(), n * sizeof(simd_value_t)), 0);
+
+    /** @arg 指标运算保持 discard 语义 */
+    PriceList d1, d2;
+    for (size_t i = 0; i < 100; i++) {
+        d1.push_back(i < 5 ? Null<price_t>() : i - 50.0);
+        d2.push_back(i + 1.0);
+    }
+    Indicator x = PRICELIST(d1, 5);
+    Indicator y = PRICELIST(d2);
+    Indicator ret = ABS(x) + SQRT(y) * (x > y);
+    CHECK_EQ(ret.size(), 100);
+    CHECK_EQ(ret.discard(), 5);
+    for (size_t i = 5; i < 100; i++) {
+        CHECK_EQ(ret[i], std::abs(d1[i]) + std::sqrt(d2[i]) * (d1[i] > d2[i] ? 1.0 : 0.0));
+    }
+}
+
+#if ENABLE_BENCHMARK_TEST
+TEST_CASE("test_simd_kernel_benchmark") {
+    // 模拟 5000 只股票，每只 5000 根 K 线
+    size_t stock_num = 5000;
+    size_t bar_num = 5000;
+    auto a = make_simd_test_data(bar_num, 1);
+    auto b = make_simd_test_data(bar_num, 2);
+    auto c = make_simd_test_data(bar_num, 3);
+    std::vector<simd_value_t> dst(bar_num);
+
+    for (bool enable : {false, true}) {
+        simd::setEnable(enable);
+        const char* name = simd::instructionSet();
+        {
+            BENCHMARK_TIME_MSG(simd_add, stock_num, "add {}", name);
+            for (size_t i = 0; i < stock_num; i++) {
+                simd::add(a.data(), b.data(), dst.data(), bar_num);
+            }
+        }
+        {
+            BENCHMARK_TIME_MSG(simd_div, stock_num, "div {}", name);
+            for (size_t i = 0; i < stock_num; i++) {
+                simd::div(a.data(), b.data(), dst.data(), bar_num);
+            }
+        }
+        {
+            BENCHMARK_TIME_MSG(simd_gt, stock_num, "gt {}", name);
+            for (size_t i = 0; i < stock_num; i++) {
+                simd::gt(a.data(), b.data(), dst.data(), bar_num);
+            }
+        }
+        {
+            BENCHMARK_TIME_MSG(simd_and, stock_num, "and {}", name);
+            for (size_t i = 0; i < stock_num; i++) {
+                simd::logic_and(a.data(), b.data(), dst.data(), bar_num);
+            }
+        }
+        {
+            BENCHMARK_TIME_MSG(simd_select, stock_num, "select {}", name);
+            for (size_t i = 0; i < stock_num; i++) {
+                simd::select(c.data(), a.data(), b.data(), dst.data(), bar_num);
+            }
+        }
+        {
+            BENCHMARK_TIME_MSG(simd_sqrt, stock_num, "sqrt {}", name);
+            for (size_t i = 0; i < stock_num; i++) {
+                simd::sqrt(a.data(), dst.data(), bar_num);
+            }
+        }
+    }
+    simd::setEnable(true);
+}
+#endif
+
+/** @} */
@@ -0,0 +1,207 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-16
+ *      Author: fasiondog
+ */
+
+#include "../test_config.h"
+#include <random>
+#include <hikyuu/indicator/sliding_window.h>
+#include <hikyuu/indicator/crt/HHV.h>
+#include <hikyuu/indicator/crt/HHVBARS.h>
+#include <hikyuu/indicator/crt/PRICELIST.h>
+#include <hikyuu/indicator/crt/STDEV.h>
+#include <hikyuu/indicator/crt/SUM.h>
+
+/**
+ * @defgroup test_indicator_sliding_window test_indicator_sliding_window
+ * @ingroup test_hikyuu_indicator_suite
+ * @{
+ */
+
+static vector<double> make_sliding_test_data(size_t n) {
+    std::mt19937 gen(1);
+    std::uniform_real_distribution<double> dist(-5.0, 5.0);
+    vector<double> result(n);
+    for (size_t i = 0; i < n; i++) {
+        // 取 0.5 的整数倍，制造相等的值
+        result[i] = std::round(dist(gen) * 2.0) / 2.0;
+        if (i % 37 == 0) {
+            result[i] = Null<double>();
+        }
+    }
+    return result;
+}
+
+/** @par 检测点 */
+TEST_CASE("test_sliding_window") {
+    size_t total = 2000;
+    auto x = make_sliding_test_data(total);
+
+    /** @arg 单调队列与逐窗口扫描结果一致，相同值取最后出现的位置 */
+    for (size_t n : {0, 1, 2, 5, 250}) {
+        rolling_extremum<MaxQueue<double>>(
+          x.data(), 3, total, n, [&](size_t i, const MaxQueue<double>& queue) {
+              size_t start = (n == 0 || i + 1 < 3 + n) ? 3 : i + 1 - n;
+              double expect = Null<double>();
+              size_t expect_pos = 0;
+              for (size_t j = start; j <= i; j++) {
+                  if (!std::isnan(x[j]) && (std::isnan(expect) || x[j] >= expect)) {
+                      expect = x[j];
+                      expect_pos = j;
+                  }
+              }
+              CHECK_EQ(queue.empty(), std::isnan(expect));
+              if (!queue.empty()) {
+                  CHECK_EQ(queue.value(), expect);
+                  CHECK_EQ(queue.pos(), expect_pos);
+              }
+          });
+    }
+
+    /** @arg 可变窗口（含窗口后退）下累加器与逐窗口计算结果一致 */
+    std::mt19937 gen(2);
+    vector<size_t> steps(total);
+    for (size_t i = 0; i < total; i++) {
+        steps[i] = 1 + gen() % 300;
+    }
+    auto window_start = [&](size_t i, size_t& start) {
+        start = i + 1 >= steps[i] ? i + 1 - steps[i] : 0;
+        return true;
+    };
+
+    dyn_rolling_accumulate<RollingMoments>(
+      x.data(), 0, total, window_start, [&](size_t i, const RollingMoments& m) {
+          size_t start = i + 1 >= steps[i] ? i + 1 - steps[i] : 0;
+          size_t count = 0, nan_count = 0;
+          double sum = 0.0;
+          for (size_t j = start; j <= i; j++) {
+              if (std::isnan(x[j])) {
+                  nan_count++;
+              } else {
+                  sum += x[j];
+                  count++;
+              }
+          }
+          double mean = count > 0 ? sum / count : 0.0;
+          double m2 = 0.0;
+          for (size_t j = start; j <= i; j++) {
+              if (!std::isnan(x[j])) {
+                  m2 += (x[j] - mean) * (x[j] - mean);
+              }
+          }
+          CHECK_EQ(m.count(), count);
+          CHECK_EQ(m.nanCount(), nan_count);
+          CHECK_EQ(m.mean(), doctest::Approx(mean));
+          CHECK_EQ(m.m2(), doctest::Approx(m2));
+      });
+
+    dyn_rolling_accumulate<RollingSum>(
+      x.data(), 0, total, window_start, [&](size_t i, const RollingSum& sum) {
+          size_t start = i + 1 >= steps[i] ? i + 1 - steps[i] : 0;
+          double expect = 0.0;
+          for (size_t j = start; j <= i; j++) {
+              expect += x[j];
+          }
+          if (std::isnan(expect)) {
+              CHECK_UNARY(std::isnan(sum.value()));
+          } else {
+              CHECK_EQ(sum.value(), doctest::Approx(expect));
+          }
+      });
+
+    /** @arg 协方差累加器求斜率 */
+    RollingCovariance cov;
+    SlidingWindow window(true);
+    for (size_t i = 1; i < total; i++) {
+        size_t start = i + 1 >= steps[i] ? i + 1 - steps[i] : 0;
+        window.moveTo(
+          start, i + 1, [&](size_t pos) { cov.add(pos, pos * 0.1 + std::sin(pos)); },
+          [&](size_t pos) { cov.remove(pos, pos * 0.1 + std::sin(pos)); }, [&]() { cov.clear(); });
+        if (i == start) {
+            continue;
+        }
+        double n = i - start + 1, xsum = 0.0, ysum = 0.0, xysum = 0.0, x2sum = 0.0;
+        for (size_t j = start; j <= i; j++) {
+            double y = j * 0.1 + std::sin(j);
+            xsum += j;
+            ysum += y;
+            xysum += j * y;
+            x2sum += double(j) * j;
+        }
+        CHECK_EQ(cov.slope(),
+                 doctest::Approx((n * xysum - xsum * ysum) / (n * x2sum - xsum * xsum)));
+    }
+}
+
+/** @par 检测点 */
+TEST_CASE("test_sliding_window_indicator_dyn") {
+    size_t total = 600;
+    PriceList data, steps;
+    std::mt19937 gen(3);
+    for (size_t i = 0; i < total; i++) {
+        data.push_back(std::sin(i * 0.1) * 10.0 + i * 0.01);
+        steps.push_back(2 + gen() % 250);
+    }
+    Indicator x = PRICELIST(data);
+    IndParam n(PRICELIST(steps));
+
+    /** @arg 动态参数的增量计算与逐位置计算结果一致 */
+    Indicator hhv = HHV(x, n);
+    Indicator hhvbars = HHVBARS(x, n);
+    Indicator sum = SUM(x, n);
+    Indicator stdev = STDEV(x, n);
+    for (size_t i = 0; i < total; i++) {
+        size_t start = i + 1 >= steps[i] ? i + 1 - size_t(steps[i]) : 0;
+        double max_value = data[start], sum_value = 0.0;
+        size_t max_pos = start;
+        for (size_t j = start; j <= i; j++) {
+            if (data[j] >= max_value) {
+                max_value = data[j];
+                max_pos = j;
+            }
+            sum_value += data[j];
+        }
+        CHECK_EQ(hhv[i], doctest::Approx(max_value));
+        CHECK_EQ(hhvbars[i], i - max_pos);
+        CHECK_EQ(sum[i], doctest::Approx(sum_value));
+        if (i > start) {
+            CHECK_EQ(stdev[i], doctest::Approx(STDEV(x, int(i - start + 1))[i]));
+        }
+    }
+}
+
+#if ENABLE_BENCHMARK_TEST
+TEST_CASE("test_sliding_window_benchmark") {
+    // 模拟一年的 1 分钟线，长窗口
+    size_t total = 240 * 250;
+    PriceList data;
+    for (size_t i = 0; i < total; i++) {
+        data.push_back(std::sin(i * 0.01) * 10.0 + i * 0.001);
+    }
+    Indicator x = PRICELIST(data);
+    IndParam n(PRICELIST(PriceList(total, 500.0)));
+    int cycle = 10;
+    {
+        BENCHMARK_TIME_MSG(test_HHV_500, cycle, "HHV(x, 500)");
+        for (int i = 0; i < cycle; i++) {
+            Indicator result = HHV(x, 500);
+        }
+    }
+    {
+        BENCHMARK_TIME_MSG(test_HHV_dyn_500, cycle, "HHV(x, IndParam 500)");
+        for (int i = 0; i < cycle; i++) {
+            Indicator result = HHV(x, n);
+        }
+    }
+    {
+        BENCHMARK_TIME_MSG(test_STDEV_dyn_500, cycle, "STDEV(x, IndParam 500)");
+        for (int i = 0; i < cycle; i++) {
+            Indicator result = STDEV(x, n);
+        }
+    }
+}
+#endif
+
+/** @} */
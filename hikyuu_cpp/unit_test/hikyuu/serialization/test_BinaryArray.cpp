@@ -0,0 +1,269 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-16
+ *      Author: fasiondog
+ */
+
+#include "../test_config.h"
+#include <sstream>
+#include <hikyuu/StockManager.h>
+#include <hikyuu/serialization/all.h>
+#include <hikyuu/indicator/crt/KDATA.h>
+#include <hikyuu/indicator/crt/MACD.h>
+#include <hikyuu/trade_manage/TradeRecord.h>
+
+using namespace hku;
+
+#if HKU_SUPPORT_SERIALIZATION && HKU_SUPPORT_BINARY_ARCHIVE
+
+/**
+ * @defgroup test_BinaryArray_serialize test_BinaryArray_serialize
+ * @ingroup test_hikyuu_serialize_suite
+ * @{
+ */
+
+template <typename T>
+static string binary_save(const T& value) {
+    std::ostringstream os;
+    boost::archive::binary_oarchive oa(os);
+    oa << value;
+    return os.str();
+}
+
+template <typename T>
+static void binary_load(const string& data, T& value) {
+    std::istringstream is(data);
+    boost::archive::binary_iarchive ia(is);
+    ia >> value;
+}
+
+template <typename T>
+static string xml_save(const T& value) {
+    std::ostringstream os;
+    boost::archive::xml_oarchive oa(os);
+    oa << BOOST_SERIALIZATION_NVP(value);
+    return os.str();
+}
+
+template <typename T>
+static void xml_load(const string& data, T& value) {
+    std::istringstream is(data);
+    boost::archive::xml_iarchive ia(is);
+    ia >> BOOST_SERIALIZATION_NVP(value);
+}
+
+// 按旧版本格式（类版本 0，逐条记录存放）写入 vector
+template <typename T>
+struct LegacyVector {
+    const vector<T>& values;
+
+    template <class Archive>
+    void serialize(Archive& ar, const unsigned int version) {
+        boost::serialization::save(ar, values, 0);
+    }
+};
+
+static void check_same_value(price_t result, price_t expect) {
+    if (std::isnan(expect)) {
+        CHECK_UNARY(std::isnan(result));
+    } else {
+        CHECK_EQ(result, expect);
+    }
+}
+
+/** @par 检测点 */
+TEST_CASE("test_PriceList_binary_serialize") {
+    /** @arg 空数组 */
+    PriceList empty, result{1.0};
+    binary_load(binary_save(make_binary_array(empty)), make_binary_array(result));
+    CHECK_UNARY(result.empty());
+
+    /** @arg 含空值及 inf，空值仅记录在位图中 */
+    const price_t null_value = Null<price_t>();
+    const price_t inf = std::numeric_limits<price_t>::infinity();
+    PriceList x{null_value, null_value, 1.0, -2.5, inf, null_value, 3.0, -inf, 0.0};
+    binary_load(binary_save(make_binary_array(x)), make_binary_array(result));
+    REQUIRE(result.size() == x.size());
+    for (size_t i = 0; i < x.size(); i++) {
+        check_same_value(result[i], x[i]);
+    }
+
+    /** @arg 全部为空值 */
+    PriceList nulls(100, Null<price_t>());
+    binary_load(binary_save(make_binary_array(nulls)), make_binary_array(result));
+    REQUIRE(result.size() == nulls.size());
+    for (size_t i = 0; i < nulls.size(); i++) {
+        CHECK_UNARY(std::isnan(result[i]));
+    }
+
+    /** @arg 非二进制归档按原有方式读写 */
+    PriceList from_xml;
+    xml_load(xml_save(make_binary_array(x)), make_binary_array(from_xml));
+    REQUIRE(from_xml.size() == x.size());
+    for (size_t i = 0; i < x.size(); i++) {
+        check_same_value(from_xml[i], x[i]);
+    }
+
+    /** @arg 启用压缩时结果一致（未启用 zip 支持时忽略压缩） */
+    PriceList y(1000);
+    for (size_t i = 0; i < y.size(); i++) {
+        y[i] = i % 7 == 0 ? Null<price_t>() : 10.0 + 0.01 * (i % 50);
+    }
+    setBinaryArrayCompress(true);
+    string compressed = binary_save(make_binary_array(y));
+    setBinaryArrayCompress(false);
+    string raw = binary_save(make_binary_array(y));
+    CHECK_LE(compressed.size(), raw.size());
+    for (const string& data : {compressed, raw}) {
+        binary_load(data, make_binary_array(result));
+        REQUIRE(result.size() == y.size());
+        for (size_t i = 0; i < y.size(); i++) {
+            check_same_value(result[i], y[i]);
+        }
+    }
+}
+
+/** @par 检测点 */
+TEST_CASE("test_KRecordList_binary_serialize") {
+    KData kdata = getStock("sh600000").getKData(KQuery(-500));
+    KRecordList records;
+    for (size_t i = 0; i < kdata.size(); i++) {
+        records.push_back(kdata[i]);
+    }
+    records.push_back(KRecord());
+
+    /** @arg 按列存放 */
+    KRecordList result;
+    binary_load(binary_save(records), result);
+    REQUIRE(result.size() == records.size());
+    for (size_t i = 0; i < records.size(); i++) {
+        CHECK_EQ(result[i], records[i]);
+    }
+
+    /** @arg 读取旧版本（逐条记录存放）的归档 */
+    result.clear();
+    binary_load(binary_save(LegacyVector<KRecord>{records}), result);
+    REQUIRE(result.size() == records.size());
+    for (size_t i = 0; i < records.size(); i++) {
+        CHECK_EQ(result[i], records[i]);
+    }
+
+    /** @arg 空列表 */
+    KRecordList empty;
+    binary_load(binary_save(empty), result);
+    CHECK_UNARY(result.empty());
+}
+
+/** @par 检测点 */
+TEST_CASE("test_TradeRecordList_binary_serialize") {
+    Stock stk = getStock("sh600000");
+    TradeRecordList trades;
+    trades.emplace_back(Null<Stock>(), Datetime(200101010000L), BUSINESS_INIT, 0.0, 0.0, 0.0, 0.0,
+                        CostRecord(), 0.0, 100000.0, PART_INVALID);
+    trades.emplace_back(stk, Datetime(200101020000L), BUSINESS_BUY, 10.0, 10.01,
+                        Null<price_t>(), 1000, CostRecord(5.0, 0.0, 1.0, 0.0, 6.0), 9.5,
+                        89984.0, PART_SIGNAL, "buy");
+    trades.emplace_back(stk, Datetime(200101050000L), BUSINESS_SELL, 11.0, 10.99,
+                        Null<price_t>(), 1000, CostRecord(5.0, 11.0, 1.0, 0.0, 17.0),
+                        Null<price_t>(), 100957.0, PART_STOPLOSS);
+
+    /** @arg 按列存放，以及读取旧版本（逐条记录存放）的归档 */
+    string packed = binary_save(trades);
+    string legacy = binary_save(LegacyVector<TradeRecord>{trades});
+    for (const string& data : {packed, legacy}) {
+        TradeRecordList result;
+        binary_load(data, result);
+        REQUIRE(result.size() == trades.size());
+        for (size_t i = 0; i < trades.size(); i++) {
+            CHECK_EQ(result[i].stock, trades[i].stock);
+            CHECK_EQ(result[i].datetime, trades[i].datetime);
+            CHECK_EQ(result[i].business, trades[i].business);
+            CHECK_EQ(result[i].from, trades[i].from);
+            CHECK_EQ(result[i].remark, trades[i].remark);
+            CHECK_EQ(result[i].cost, trades[i].cost);
+            check_same_value(result[i].planPrice, trades[i].planPrice);
+            check_same_value(result[i].realPrice, trades[i].realPrice);
+            check_same_value(result[i].goalPrice, trades[i].goalPrice);
+            check_same_value(result[i].number, trades[i].number);
+            check_same_value(result[i].stoploss, trades[i].stoploss);
+            check_same_value(result[i].cash, trades[i].cash);
+        }
+    }
+}
+
+/** @par 检测点 */
+TEST_CASE("test_Indicator_binary_serialize") {
+    KData kdata = getStock("sh000001").getKData(KQuery(-200));
+
+    /** @arg 多结果集，与 XML 归档的结果一致 */
+    Indicator x = MACD(CLOSE(kdata));
+    Indicator from_binary, from_xml;
+    string binary = binary_save(x);
+    string xml = xml_save(x);
+    binary_load(binary, from_binary);
+    xml_load(xml, from_xml);
+    CHECK_LT(binary.size(), xml.size());
+
+    CHECK_EQ(from_binary.name(), x.name());
+    REQUIRE(from_binary.size() == x.size());
+    CHECK_EQ(from_binary.discard(), x.discard());
+    REQUIRE(from_binary.getResultNumber() == x.getResultNumber());
+    for (size_t r = 0; r < x.getResultNumber(); r++) {
+        for (size_t i = 0; i < x.size(); i++) {
+            check_same_value(from_binary.get(i, r), x.get(i, r));
+            if (i >= x.discard()) {
+                CHECK_EQ(from_binary.get(i, r), doctest::Approx(from_xml.get(i, r)));
+            }
+        }
+    }
+}
+
+#if ENABLE_BENCHMARK_TEST
+TEST_CASE("test_binary_serialize_benchmark") {
+    KData kdata = getStock("sh000001").getKData(KQuery());
+    Indicator ind = MACD(CLOSE(kdata));
+    KRecordList records;
+    for (size_t i = 0; i < kdata.size(); i++) {
+        records.push_back(kdata[i]);
+    }
+    int cycle = 10;
+
+    {
+        BENCHMARK_TIME_MSG(test_Indicator_xml_serialize, cycle, "xml size: {}",
+                           xml_save(ind).size());
+        for (int i = 0; i < cycle; i++) {
+            Indicator result;
+            xml_load(xml_save(ind), result);
+        }
+    }
+    {
+        BENCHMARK_TIME_MSG(test_Indicator_binary_serialize, cycle, "binary size: {}",
+                           binary_save(ind).size());
+        for (int i = 0; i < cycle; i++) {
+            Indicator result;
+            binary_load(binary_save(ind), result);
+        }
+    }
+    {
+        BENCHMARK_TIME_MSG(test_KRecordList_xml_serialize, cycle, "xml size: {}",
+                           xml_save(records).size());
+        for (int i = 0; i < cycle; i++) {
+            KRecordList result;
+            xml_load(xml_save(records), result);
+        }
+    }
+    {
+        BENCHMARK_TIME_MSG(test_KRecordList_binary_serialize, cycle, "binary size: {}",
+                           binary_save(records).size());
+        for (int i = 0; i < cycle; i++) {
+            KRecordList result;
+            binary_load(binary_save(records), result);
+        }
+    }
+}
+#endif
+
+/** @} */
+
+#endif /* HKU_SUPPORT_SERIALIZATION && HKU_SUPPORT_BINARY_ARCHIVE */
@@ -26,6 +26,18 @@ inline void check_indicator(const Indicator& result, const Indicator& expect) {
     }
 }
 
+/** 从 start 位置起逐个比较指标结果，期望值为 NaN 时结果也须为 NaN */
+inline void check_indicator(const Indicator& result, const PriceList& expect, size_t start = 0) {
+    REQUIRE(result.size() == expect.size());
+    for (size_t i = start, total = expect.size(); i < total; ++i) {
+        if (std::isnan(expect[i])) {
+            CHECK_UNARY(std::isnan(result[i]));
+        } else {
+            CHECK_EQ(result[i], doctest::Approx(expect[i]));
+        }
+    }
+}
+
 inline void print_indicator(const Indicator& result) {
     HKU_INFO("Indicator: {}", result);
     for (size_t i = 0, total = result.size(); i < total; ++i) {
@@ -0,0 +1,184 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-16
+ *      Author: fasiondog
+ */
+
+#include "../test_config.h"
+#include <hikyuu/StockManager.h>
+#include <hikyuu/trade_manage/Performance.h>
+#include <hikyuu/trade_manage/crt/crtTM.h>
+#include <hikyuu/trade_manage/crt/TC_FixedA.h>
+#include <hikyuu/indicator/crt/MA.h>
+#include <hikyuu/indicator/crt/KDATA.h>
+#include <hikyuu/indicator/crt/NOT.h>
+#include <hikyuu/trade_sys/signal/crt/SG_Bool.h>
+#include <hikyuu/trade_sys/moneymanager/crt/MM_FixedCount.h>
+#include <hikyuu/trade_sys/system/crt/SYS_Simple.h>
+
+using namespace hku;
+
+/**
+ * @defgroup test_FastStatsTradeManager test_FastStatsTradeManager
+ * @ingroup test_hikyuu_trade_manage_suite
+ * @{
+ */
+
+static SYSPtr create_fast_stats_test_sys(const TMPtr& tm) {
+    auto ind = MA(CLOSE(), 5) > MA(CLOSE(), 20);
+    return SYS_Simple(tm, MM_FixedCount(100), EnvironmentPtr(), ConditionPtr(),
+                      SG_Bool(ind, NOT(ind)));
+}
+
+/** @par 检测点 */
+TEST_CASE("test_FastStatsTradeManager_trade") {
+    StockManager& sm = StockManager::instance();
+    Stock stk = sm.getStock("sz000001");
+    KData kdata = stk.getKData(KQueryByDate(Datetime(201101010000L), Datetime(201201010000L)));
+    REQUIRE(kdata.size() > 100);
+
+    /** @arg 初始状态 */
+    TMPtr tm = crtFastStatsTM(Datetime(201001010000L), 1000000, TC_Zero(), "TEST");
+    CHECK_EQ(tm->name(), "TEST");
+    CHECK_EQ(tm->initCash(), 1000000.0);
+    CHECK_EQ(tm->currentCash(), 1000000.0);
+    CHECK_EQ(tm->firstDatetime(), Null<Datetime>());
+    CHECK_EQ(tm->lastDatetime(), Datetime(201001010000L));
+    CHECK_EQ(tm->have(stk), false);
+    CHECK_UNARY(tm->getTradeList().empty());
+
+    /** @arg 未持仓时卖出失败，现金不足时买入失败 */
+    CHECK_UNARY(tm->sell(kdata[0].datetime, stk, kdata[0].closePrice, 100).isNull());
+    CHECK_UNARY(tm->buy(kdata[0].datetime, stk, kdata[0].closePrice, 10000000).isNull());
+
+    /** @arg 与 TradeManager 执行相同的交易，持仓及各时刻资产一致 */
+    TMPtr expect_tm = crtTM(Datetime(201001010000L), 1000000);
+    tm = crtFastStatsTM(Datetime(201001010000L), 1000000);
+    for (const auto& t : {expect_tm, tm}) {
+        for (size_t i = 0, total = kdata.size(); i < total; i++) {
+            if (i % 10 == 0) {
+                t->buy(kdata[i].datetime, stk, kdata[i].closePrice, 100);
+            } else if (i % 10 == 5) {
+                t->sell(kdata[i].datetime, stk, kdata[i].closePrice, 100);
+            } else if (i == 52) {
+                t->checkin(kdata[i].datetime, 1000);
+            } else if (i == 83) {
+                t->checkout(kdata[i].datetime, 500);
+            }
+        }
+    }
+
+    CHECK_EQ(tm->firstDatetime(), expect_tm->firstDatetime());
+    CHECK_EQ(tm->lastDatetime(), expect_tm->lastDatetime());
+    CHECK_EQ(tm->currentCash(), expect_tm->currentCash());
+    CHECK_EQ(tm->getHistoryPositionList().size(), expect_tm->getHistoryPositionList().size());
+    CHECK_UNARY(tm->getTradeList().empty());
+
+    DatetimeList dates = kdata.getDatetimeList();
+    for (size_t i = 0, total = dates.size(); i < total; i++) {
+        CHECK_EQ(tm->getHoldNumber(dates[i], stk), expect_tm->getHoldNumber(dates[i], stk));
+        CHECK_EQ(tm->getPosition(dates[i], stk).number,
+                 expect_tm->getPosition(dates[i], stk).number);
+    }
+
+    FundsList funds = tm->getFundsList(dates);
+    FundsList expect_funds = expect_tm->getFundsList(dates);
+    for (size_t i = 0, total = dates.size(); i < total; i++) {
+        CHECK_EQ(funds[i], expect_funds[i]);
+    }
+
+    /** @arg 复位 */
+    tm->reset();
+    CHECK_EQ(tm->currentCash(), 1000000.0);
+    CHECK_EQ(tm->lastDatetime(), Datetime(201001010000L));
+    CHECK_EQ(tm->getStockNumber(), 0);
+    CHECK_UNARY(tm->getHistoryPositionList().empty());
+}
+
+/** @par 检测点 */
+TEST_CASE("test_FastStatsTradeManager_system") {
+    StockManager& sm = StockManager::instance();
+    KQuery query = KQueryByIndex(-1000);
+    TradeCostPtr cost = TC_FixedA(0.0018, 5, 0.001, 0.001, 1.0);
+
+    /** @arg 同一系统分别使用 TradeManager 与快速统计账户，绩效统计结果一致（含分红送股） */
+    for (const char* code : {"sh600000", "sz000001", "sh000001"}) {
+        Stock stk = sm.getStock(code);
+        KData kdata = stk.getKData(query);
+        REQUIRE(kdata.size() > 0);
+
+        auto expect_sys = create_fast_stats_test_sys(crtTM(Datetime(199001010000L), 1000000, cost));
+        auto sys =
+          create_fast_stats_test_sys(crtFastStatsTM(Datetime(199001010000L), 1000000, cost));
+        expect_sys->run(kdata);
+        sys->run(kdata);
+
+        TMPtr expect_tm = expect_sys->getTM();
+        TMPtr tm = sys->getTM();
+        REQUIRE(expect_tm->getHistoryPositionList().size() > 0);
+        CHECK_UNARY(tm->getTradeList().empty());
+        CHECK_EQ(tm->lastDatetime(), expect_tm->lastDatetime());
+        CHECK_EQ(tm->currentCash(), doctest::Approx(expect_tm->currentCash()));
+
+        Datetime last_datetime = kdata[kdata.size() - 1].datetime;
+        Performance expect_per, per;
+        expect_per.statistics(expect_tm, last_datetime);
+        per.statistics(tm, last_datetime);
+        PriceList expect_values = expect_per.values();
+        PriceList values = per.values();
+        REQUIRE(values.size() == expect_values.size());
+        for (size_t i = 0, total = values.size(); i < total; i++) {
+            if (std::isnan(expect_values[i])) {
+                CHECK_UNARY(std::isnan(values[i]));
+            } else {
+                CHECK_EQ(values[i], doctest::Approx(expect_values[i]));
+            }
+        }
+
+        DatetimeList dates = kdata.getDatetimeList();
+        for (size_t i = 0, total = dates.size(); i < total; i++) {
+            CHECK_EQ(tm->getHoldNumber(dates[i], stk), expect_tm->getHoldNumber(dates[i], stk));
+        }
+
+        // 指数无权息，资金曲线逐日一致；存在分红时 TradeManager 历史分红记录中的现金另有累计
+        if (stk.type() == STOCKTYPE_INDEX) {
+            PriceList curve = tm->getFundsCurve(dates);
+            PriceList expect_curve = expect_tm->getFundsCurve(dates);
+            for (size_t i = 0, total = dates.size(); i < total; i++) {
+                CHECK_EQ(curve[i], doctest::Approx(expect_curve[i]));
+            }
+        }
+    }
+}
+
+#if ENABLE_BENCHMARK_TEST
+TEST_CASE("test_FastStatsTradeManager_benchmark") {
+    StockManager& sm = StockManager::instance();
+    Stock stk = sm.getStock("sz000001");
+    KData kdata = stk.getKData(KQuery(-2500));
+    int cycle = 20;
+
+    {
+        auto sys = create_fast_stats_test_sys(crtTM(Datetime(199001010000L), 1000000));
+        BENCHMARK_TIME_MSG(test_TradeManager_system, cycle, "TradeManager {} bars", kdata.size());
+        for (int i = 0; i < cycle; i++) {
+            sys->run(kdata);
+            Performance per;
+            per.statistics(sys->getTM(), kdata[kdata.size() - 1].datetime);
+        }
+    }
+    {
+        auto sys = create_fast_stats_test_sys(crtFastStatsTM(Datetime(199001010000L), 1000000));
+        BENCHMARK_TIME_MSG(test_FastStatsTradeManager_system, cycle,
+                           "FastStatsTradeManager {} bars", kdata.size());
+        for (int i = 0; i < cycle; i++) {
+            sys->run(kdata);
+            Performance per;
+            per.statistics(sys->getTM(), kdata[kdata.size() - 1].datetime);
+        }
+    }
+}
+#endif
+
+/** @} */
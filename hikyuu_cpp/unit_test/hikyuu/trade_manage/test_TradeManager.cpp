@@ -5,13 +5,14 @@
  *      Author: fasiondog
  */
 
-#include "doctest/doctest.h"
+#include "../test_config.h"
 #include <hikyuu/StockManager.h>
 #include <hikyuu/trade_manage/crt/TC_TestStub.h>
 #include <hikyuu/trade_manage/crt/TC_FixedA.h>
 #include <hikyuu/trade_manage/crt/crtTM.h>
 
 #include <fstream>
+#include <thread>
 #include <boost/archive/xml_oarchive.hpp>
 #include <boost/archive/xml_iarchive.hpp>
 
@@ -802,4 +803,119 @@ TEST_CASE("test_TradeManager_addTradeRecord") {
                                      cost, 0, 90142.50, PART_INVALID));
 }
 
+/** @par 检测点, 测试按日期顺序查询历史资产 */
+TEST_CASE("test_TradeManager_getFundsList") {
+    StockManager& sm = StockManager::instance();
+    Stock stk = sm.getStock("sz000001");
+    KData kdata = stk.getKData(KQueryByDate(Datetime(201101010000L), Datetime(201201010000L)));
+    REQUIRE(kdata.size() > 100);
+
+    TradeManagerPtr tm = crtTM(Datetime(201001010000L), 1000000);
+    for (size_t i = 0, total = kdata.size(); i < total; i++) {
+        if (i % 10 == 0) {
+            tm->buy(kdata[i].datetime, stk, kdata[i].closePrice, 100);
+        } else if (i % 10 == 5) {
+            tm->sell(kdata[i].datetime, stk, kdata[i].closePrice, 100);
+        } else if (i == 52) {
+            tm->checkin(kdata[i].datetime, 1000);
+        }
+    }
+
+    // 零成本下按交易规则逐日独立计算现金、市值及累计投入资金
+    size_t total = kdata.size();
+    PriceList expect_cash(total), expect_value(total), expect_base(total);
+    price_t cash = 1000000.0, base_cash = 1000000.0;
+    double number = 0.0;
+    for (size_t i = 0; i < total; i++) {
+        if (i % 10 == 0) {
+            cash -= kdata[i].closePrice * 100;
+            number += 100;
+        } else if (i % 10 == 5) {
+            cash += kdata[i].closePrice * 100;
+            number -= 100;
+        } else if (i == 52) {
+            cash += 1000;
+            base_cash += 1000;
+        }
+        expect_cash[i] = cash;
+        expect_value[i] = number * kdata[i].closePrice;
+        expect_base[i] = base_cash;
+    }
+
+    auto check_funds = [&](const FundsRecord& funds, size_t i) {
+        CHECK_EQ(funds.cash, doctest::Approx(expect_cash[i]));
+        CHECK_EQ(funds.market_value, doctest::Approx(expect_value[i]));
+        CHECK_EQ(funds.base_cash, doctest::Approx(expect_base[i]));
+    };
+
+    /** @arg 顺序批量查询 */
+    DatetimeList dates = kdata.getDatetimeList();
+    FundsList result = tm->getFundsList(dates);
+    REQUIRE(result.size() == total);
+    for (size_t i = 0; i < total; i++) {
+        check_funds(result[i], i);
+    }
+
+    /** @arg 逆序逐日查询（每次都需从头回放） */
+    for (size_t i = total; i > 0; i--) {
+        check_funds(tm->getFunds(dates[i - 1]), i - 1);
+    }
+
+    /** @arg 多线程同时查询 */
+    vector<FundsList> thread_results(4);
+    vector<std::thread> threads;
+    for (size_t t = 0; t < thread_results.size(); t++) {
+        threads.emplace_back([&, t]() {
+            auto& funds_list = thread_results[t];
+            funds_list.resize(total);
+            for (size_t i = 0; i < total; i++) {
+                size_t pos = t % 2 == 0 ? i : total - 1 - i;
+                funds_list[pos] = tm->getFunds(dates[pos]);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (const auto& funds_list : thread_results) {
+        for (size_t i = 0; i < total; i++) {
+            check_funds(funds_list[i], i);
+        }
+    }
+
+    /** @arg 查询后继续交易，历史资产不变 */
+    tm->buy(Datetime(201201100000L), stk, kdata[total - 1].closePrice, 100);
+    check_funds(tm->getFunds(dates[10]), 10);
+    check_funds(tm->getFunds(dates[100]), 100);
+    check_funds(tm->getFunds(dates[20]), 20);
+}
+
+#if ENABLE_BENCHMARK_TEST
+TEST_CASE("test_TradeManager_getFundsCurve_benchmark") {
+    StockManager& sm = StockManager::instance();
+    Stock stk = sm.getStock("sz000001");
+    KData kdata = stk.getKData(KQuery(-2500));
+
+    // 模拟高换手的多年账户：隔日买卖
+    TradeManagerPtr tm = crtTM(kdata[0].datetime, 100000000);
+    for (size_t i = 0, total = kdata.size(); i < total; i++) {
+        if (i % 2 == 0) {
+            tm->buy(kdata[i].datetime, stk, kdata[i].closePrice, 100);
+        } else {
+            tm->sell(kdata[i].datetime, stk, kdata[i].closePrice, 100);
+        }
+    }
+
+    DatetimeList dates = kdata.getDatetimeList();
+    int cycle = 10;
+    {
+        BENCHMARK_TIME_MSG(test_TradeManager_getFundsCurve, cycle, "getFundsCurve {} days",
+                           dates.size());
+        for (int i = 0; i < cycle; i++) {
+            PriceList curve = tm->getFundsCurve(dates);
+        }
+    }
+}
+#endif
+
 /** @} */
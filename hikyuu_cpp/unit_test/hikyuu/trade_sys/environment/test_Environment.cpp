@@ -47,6 +47,16 @@ TEST_CASE("test_Environment") {
     CHECK_EQ(p->isValid(Datetime(200001020000)), false);
     CHECK_EQ(p->getParam<int>("n"), 10);
 
+    /** @arg 按K线位置对齐的有效列表 */
+    KData kdata = StockManager::instance().getStock("sh000001").getKData(
+      KQueryByDate(Datetime(199912280000LL), Datetime(200001200000LL)));
+    REQUIRE(!kdata.empty());
+    vector<uint8_t> valid_list = p->getValidList(kdata);
+    REQUIRE(valid_list.size() == kdata.size());
+    for (size_t i = 0; i < kdata.size(); i++) {
+        CHECK_EQ(valid_list[i] != 0, p->isValid(kdata[i].datetime));
+    }
+
     /** @arg 克隆操作 */
     p->setParam<int>("n", 20);
     EnvironmentPtr p_clone = p->clone();
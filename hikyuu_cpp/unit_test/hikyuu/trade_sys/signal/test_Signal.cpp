@@ -160,6 +160,34 @@ TEST_CASE("test_Signal") {
         CHECK_EQ(p->shouldSell(Datetime(200101010000)), false);
         CHECK_EQ(p->shouldSell(Datetime(200101040000)), true);
     }
+
+    SUBCASE("Position signal") {
+        /** @arg 按位置访问的信号与按日期访问一致 */
+        KData kdata = stock.getKData(KQuery(0, 20));
+        REQUIRE(kdata.size() == 20);
+        CHECK_UNARY(!p->shouldBuyAt(0));
+        p->setTO(kdata);
+        p->_addBuySignal(kdata[3].datetime);
+        p->_addSellSignal(kdata[8].datetime);
+        p->_addBuySignal(Datetime(200101010000));
+        for (size_t i = 0; i < kdata.size(); i++) {
+            CHECK_EQ(p->shouldBuyAt(i), p->shouldBuy(kdata[i].datetime));
+            CHECK_EQ(p->shouldSellAt(i), p->shouldSell(kdata[i].datetime));
+        }
+        CHECK_UNARY(p->shouldBuyAt(3));
+        CHECK_UNARY(p->shouldSellAt(8));
+        CHECK_UNARY(!p->shouldBuyAt(20));
+
+        /** @arg 克隆后保持一致 */
+        SignalPtr p_clone = p->clone();
+        CHECK_UNARY(p_clone->shouldBuyAt(3));
+        CHECK_UNARY(p_clone->shouldSellAt(8));
+
+        /** @arg 复位后清除 */
+        p->reset();
+        CHECK_UNARY(!p->shouldBuyAt(3));
+        CHECK_UNARY(!p->shouldSellAt(8));
+    }
 }
 
 /** @} */
@@ -49,6 +49,25 @@ TEST_CASE("test_SG_AMA_export") {
 
     CHECK_EQ(sg1->name(), sg2->name());
     CHECK_UNARY(sg2->getTO().empty());
+
+    /** @arg 按位置索引的信号表未序列化，载入后不可按位置访问，按日期访问结果一致 */
+    CHECK_UNARY(sg1->isPosAligned(k));
+    CHECK_UNARY(!sg2->isPosAligned(k));
+    CHECK_UNARY(sg2->isPosAligned(KData()));
+    CHECK_UNARY(sg1->getBuySignal() == sg2->getBuySignal());
+    CHECK_UNARY(sg1->getSellSignal() == sg2->getSellSignal());
+    for (size_t i = 0; i < k.size(); i++) {
+        CHECK_EQ(sg2->shouldBuy(k[i].datetime), sg1->shouldBuyAt(i));
+        CHECK_EQ(sg2->shouldSell(k[i].datetime), sg1->shouldSellAt(i));
+    }
+
+    /** @arg 重新指定交易对象后恢复按位置访问 */
+    sg2->setTO(k);
+    CHECK_UNARY(sg2->isPosAligned(k));
+    for (size_t i = 0; i < k.size(); i++) {
+        CHECK_EQ(sg2->shouldBuyAt(i), sg1->shouldBuyAt(i));
+        CHECK_EQ(sg2->shouldSellAt(i), sg1->shouldSellAt(i));
+    }
 }
 
 /** @} */
@@ -0,0 +1,165 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-16
+ *      Author: fasiondog
+ */
+
+#include "../../test_config.h"
+#include <hikyuu/utilities/datetime/CompactDatetime.h>
+
+using namespace hku;
+
+/**
+ * @defgroup test_hikyuu_CompactDatetime test_hikyuu_CompactDatetime
+ * @ingroup test_hikyuu_datetime_suite
+ * @{
+ */
+
+static_assert(CompactDatetime(2024, 2, 29, 9, 31).ymdhm() == 202402290931ULL,
+              "CompactDatetime must be constexpr");
+static_assert(CompactDatetime(2024, 1, 1) < CompactDatetime(), "Null must be the maximum");
+
+/** @par 检测点 */
+TEST_CASE("test_CompactDatetime") {
+    /** @arg 默认构造为 Null，且与 Null<Datetime> 相互转换 */
+    CompactDatetime d;
+    CHECK(d.isNull());
+    CHECK(CompactDatetime(Null<Datetime>()).isNull());
+    CHECK(d.datetime() == Null<Datetime>());
+    CHECK_EQ(d.number(), Null<uint64_t>());
+    CHECK(CompactDatetime(2024, 1, 1) < d);
+
+    /** @arg 非法日期 */
+    CHECK_THROWS_AS(CompactDatetime(2023, 2, 29), std::out_of_range);
+    CHECK_THROWS_AS(CompactDatetime(2023, 13, 1), std::out_of_range);
+    CHECK_THROWS_AS(CompactDatetime(2023, 1, 1, 24), std::out_of_range);
+    CHECK_THROWS_AS(CompactDatetime::fromNumber(202313010000ULL), std::out_of_range);
+
+    /** @arg 年月日时分秒分解 */
+    d = CompactDatetime(2024, 2, 29, 14, 35, 12, 123456);
+    CHECK_EQ(d.year(), 2024);
+    CHECK_EQ(d.month(), 2);
+    CHECK_EQ(d.day(), 29);
+    CHECK_EQ(d.hour(), 14);
+    CHECK_EQ(d.minute(), 35);
+    CHECK_EQ(d.second(), 12);
+    CHECK_EQ(d.microsecond(), 123456);
+    CHECK_EQ(d.ymd(), 20240229ULL);
+    CHECK_EQ(d.ymdhm(), 202402291435ULL);
+    CHECK_EQ(d.ymdhms(), 20240229143512ULL);
+    CHECK_EQ(d.dayOfWeek(), 4);
+    CHECK(d.startOfDay() == CompactDatetime(2024, 2, 29));
+
+    /** @arg 1970 年以前的日期 */
+    d = CompactDatetime(1969, 12, 31, 23, 59);
+    CHECK(d.ticks() < 0);
+    CHECK_EQ(d.ymdhm(), 196912312359ULL);
+    CHECK_EQ(d.dayOfWeek(), 3);
+
+    /** @arg fromNumber 与 Datetime(unsigned long long) 一致 */
+    CHECK(CompactDatetime::fromNumber(20240229ULL) == CompactDatetime(Datetime(20240229ULL)));
+    CHECK(CompactDatetime::fromNumber(202402291435ULL) ==
+          CompactDatetime(Datetime(202402291435ULL)));
+    CHECK(CompactDatetime::fromNumber(20240229143512ULL) ==
+          CompactDatetime(Datetime(20240229143512ULL)));
+
+    /** @arg 与 Datetime 相互转换，结果与 Datetime 的计算一致 */
+    Datetime start(14000101ULL), end(99991231ULL);
+    for (Datetime x : {start, Datetime(18991231235959ULL), Datetime(197001010000ULL),
+                       Datetime(2001, 1, 1, 9, 30, 0, 1, 1), Datetime(202402291435ULL), end}) {
+        CompactDatetime c(x);
+        CHECK(c.datetime() == x);
+        CHECK_EQ(c.ticks(), x.timestamp());
+        CHECK_EQ(c.year(), x.year());
+        CHECK_EQ(c.month(), x.month());
+        CHECK_EQ(c.day(), x.day());
+        CHECK_EQ(c.hour(), x.hour());
+        CHECK_EQ(c.minute(), x.minute());
+        CHECK_EQ(c.second(), x.second());
+        CHECK_EQ(c.number(), x.number());
+        CHECK_EQ(c.ymdhms(), x.ymdhms());
+        CHECK_EQ(c.dayOfWeek(), x.dayOfWeek());
+    }
+
+    /** @arg 比较及加减 TimeDelta 与 Datetime 一致 */
+    Datetime d1(202401020930ULL), d2(202401020931ULL);
+    CHECK(CompactDatetime(d1) < CompactDatetime(d2));
+    CHECK(CompactDatetime(d1) != CompactDatetime(d2));
+    CHECK(CompactDatetime(d1) + Minutes(1) == CompactDatetime(d2));
+    CHECK(CompactDatetime(d2) - Minutes(1) == CompactDatetime(d1));
+    CHECK((CompactDatetime(d1) + Days(60)).datetime() == d1 + Days(60));
+}
+
+#if ENABLE_BENCHMARK_TEST
+TEST_CASE("test_CompactDatetime_benchmark") {
+    // 模拟约 10 年的 1 分钟线（每日 240 根）
+    size_t total = 240 * 250 * 10;
+    DatetimeList dates;
+    CompactDatetimeList cdates;
+    dates.reserve(total);
+    cdates.reserve(total);
+    Datetime day(20100104ULL);
+    while (dates.size() < total) {
+        if (day.dayOfWeek() != 0 && day.dayOfWeek() != 6) {
+            Datetime d = day + Hours(9) + Minutes(30);
+            for (int i = 0; i < 240 && dates.size() < total; i++) {
+                d = (i == 120) ? day + Hours(13) + Minutes(1) : d + Minutes(1);
+                dates.push_back(d);
+                cdates.push_back(CompactDatetime(d));
+            }
+        }
+        day = day + Days(1);
+    }
+
+    size_t search_count = 100000;
+    DatetimeList targets;
+    targets.reserve(search_count);
+    for (size_t i = 0; i < search_count; i++) {
+        targets.push_back(dates[(i * 7919) % total]);
+    }
+
+    int cycle = 10;
+    size_t found = 0;
+    {
+        BENCHMARK_TIME_MSG(test_Datetime_lower_bound, cycle, "Datetime lower_bound");
+        for (int c = 0; c < cycle; c++) {
+            for (const auto& t : targets) {
+                found += std::lower_bound(dates.begin(), dates.end(), t) - dates.begin();
+            }
+        }
+    }
+    {
+        BENCHMARK_TIME_MSG(test_CompactDatetime_lower_bound, cycle,
+                           "CompactDatetime lower_bound");
+        for (int c = 0; c < cycle; c++) {
+            for (const auto& t : targets) {
+                found += std::lower_bound(cdates.begin(), cdates.end(), CompactDatetime(t)) -
+                         cdates.begin();
+            }
+        }
+    }
+
+    uint64_t sum = 0;
+    {
+        BENCHMARK_TIME_MSG(test_Datetime_number, cycle, "Datetime number");
+        for (int c = 0; c < cycle; c++) {
+            for (const auto& d : dates) {
+                sum += d.number();
+            }
+        }
+    }
+    {
+        BENCHMARK_TIME_MSG(test_CompactDatetime_number, cycle, "CompactDatetime number");
+        for (int c = 0; c < cycle; c++) {
+            for (const auto& d : cdates) {
+                sum += d.number();
+            }
+        }
+    }
+    CHECK(found > 0);
+    CHECK(sum > 0);
+}
+#endif
+
+/** @} */
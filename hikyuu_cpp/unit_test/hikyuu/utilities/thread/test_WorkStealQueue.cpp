@@ -0,0 +1,220 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-16
+ *      Author: fasiondog
+ */
+
+#include "../../test_config.h"
+#include <atomic>
+#include <hikyuu/utilities/thread/thread.h>
+#include <hikyuu/utilities/thread/MPMCQueue.h>
+
+using namespace hku;
+
+/**
+ * @defgroup test_hikyuu_WorkStealQueue test_hikyuu_WorkStealQueue
+ * @ingroup test_hikyuu_utilities
+ * @{
+ */
+
+/** @par 检测点 */
+TEST_CASE("test_WorkStealQueue") {
+    /** @arg 所有者后进先出，偷取者取最早加入的任务，超过初始容量时自动扩容 */
+    WorkStealQueue queue(4);
+    std::vector<int> result;
+    for (int i = 0; i < 10; i++) {
+        queue.push_front([&result, i]() { result.push_back(i); });
+    }
+    CHECK_EQ(queue.size(), 10);
+
+    FuncWrapper task;
+    CHECK(queue.try_steal(task));
+    task();
+    CHECK(queue.try_pop(task));
+    task();
+    CHECK_EQ(result, std::vector<int>{0, 9});
+    CHECK_EQ(queue.size(), 8);
+
+    queue.clear();
+    CHECK(queue.empty());
+    CHECK_FALSE(queue.try_pop(task));
+    CHECK_FALSE(queue.try_steal(task));
+
+    /** @arg 所有者与多个偷取者并发，每个任务恰好执行一次 */
+    std::atomic<int> count{0};
+    std::atomic<bool> finished{false};
+    std::vector<std::thread> thieves;
+    for (int i = 0; i < 3; i++) {
+        thieves.emplace_back([&]() {
+            FuncWrapper stolen;
+            while (!finished) {
+                if (queue.try_steal(stolen)) {
+                    stolen();
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    int total = 20000;
+    for (int i = 0; i < total; i++) {
+        queue.push_front([&count]() { count++; });
+        if (i % 3 == 0 && queue.try_pop(task)) {
+            task();
+        }
+    }
+    while (queue.try_pop(task)) {
+        task();
+    }
+    while (!queue.empty()) {
+        std::this_thread::yield();
+    }
+    finished = true;
+    for (auto& t : thieves) {
+        t.join();
+    }
+    CHECK_EQ(count, total);
+}
+
+/** @par 检测点 */
+TEST_CASE("test_MPMCQueue") {
+    /** @arg 容量须为 2 的幂 */
+    CHECK_THROWS_AS(MPMCQueue<int>(3), std::invalid_argument);
+
+    /** @arg 先进先出，队列满时插入失败 */
+    MPMCQueue<int> queue(4);
+    for (int i = 0; i < 4; i++) {
+        CHECK(queue.try_push(int(i)));
+    }
+    CHECK_FALSE(queue.try_push(4));
+    CHECK_EQ(queue.size(), 4);
+    int x = -1;
+    CHECK(queue.try_pop(x));
+    CHECK_EQ(x, 0);
+    CHECK(queue.try_push(4));
+    for (int i = 1; i <= 4; i++) {
+        CHECK(queue.try_pop(x));
+        CHECK_EQ(x, i);
+    }
+    CHECK_FALSE(queue.try_pop(x));
+    CHECK(queue.empty());
+
+    /** @arg 多生产者多消费者并发 */
+    MPMCQueue<int64_t> mq(64);
+    int64_t per_producer = 10000;
+    std::atomic<int> producer_done{0};
+    std::atomic<int64_t> sum{0};
+    std::vector<std::thread> threads;
+    for (int p = 0; p < 3; p++) {
+        threads.emplace_back([&]() {
+            for (int64_t i = 1; i <= per_producer; i++) {
+                while (!mq.try_push(int64_t(i))) {
+                    std::this_thread::yield();
+                }
+            }
+            producer_done++;
+        });
+    }
+    for (int c = 0; c < 3; c++) {
+        threads.emplace_back([&]() {
+            int64_t value = 0;
+            while (producer_done < 3 || !mq.empty()) {
+                if (mq.try_pop(value)) {
+                    sum += value;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    CHECK_EQ(sum, 3 * per_producer * (per_producer + 1) / 2);
+}
+
+/** @par 检测点 */
+TEST_CASE("test_GlobalStealThreadPool_nested") {
+    /** @arg 外部提交与任务内嵌套提交的任务均被执行 */
+    GlobalStealThreadPool tg(4, false);
+    std::atomic<int> count{0};
+    std::vector<std::future<void>> outer;
+    for (int i = 0; i < 100; i++) {
+        outer.emplace_back(tg.submit([&]() {
+            std::vector<std::future<void>> inner;
+            for (int j = 0; j < 10; j++) {
+                inner.emplace_back(tg.submit([&count]() { count++; }));
+            }
+            count++;
+        }));
+    }
+    for (auto& f : outer) {
+        f.get();
+    }
+    while (count < 1100) {
+        std::this_thread::yield();
+    }
+    tg.stop();
+    CHECK_EQ(count, 1100);
+}
+
+#if ENABLE_BENCHMARK_TEST
+TEST_CASE("test_WorkStealQueue_benchmark") {
+    // 模拟按股票拆分的细粒度任务，每个任务计算量很小，主要开销在任务队列
+    size_t total = 200000;
+    auto func = [](size_t i) {
+        double sum = 0.0;
+        for (size_t j = 0; j < 50; j++) {
+            sum += std::sqrt(double(i + j));
+        }
+        return sum;
+    };
+
+    int cycle = 5;
+    {
+        BENCHMARK_TIME_MSG(test_GlobalMQStealThreadPool, cycle,
+                           "GlobalMQStealThreadPool {} tasks (locked queues)", total);
+        for (int c = 0; c < cycle; c++) {
+            GlobalMQStealThreadPool tg;
+            for (size_t i = 0; i < total; i++) {
+                tg.submit([=]() { func(i); });
+            }
+            tg.join();
+        }
+    }
+    {
+        BENCHMARK_TIME_MSG(test_GlobalStealThreadPool, cycle,
+                           "GlobalStealThreadPool {} tasks (master queue)", total);
+        for (int c = 0; c < cycle; c++) {
+            GlobalStealThreadPool tg;
+            for (size_t i = 0; i < total; i++) {
+                tg.submit([=]() { func(i); });
+            }
+            tg.join();
+        }
+    }
+    {
+        BENCHMARK_TIME_MSG(test_GlobalStealThreadPool_local, cycle,
+                           "GlobalStealThreadPool {} tasks (local queue + steal)", total);
+        for (int c = 0; c < cycle; c++) {
+            GlobalStealThreadPool tg;
+            size_t n = tg.worker_num();
+            std::vector<std::future<void>> outer;
+            for (size_t w = 0; w < n; w++) {
+                outer.emplace_back(tg.submit([&, w]() {
+                    for (size_t i = w; i < total; i += n) {
+                        tg.submit([=]() { func(i); });
+                    }
+                }));
+            }
+            for (auto& f : outer) {
+                f.get();
+            }
+            tg.join();
+        }
+    }
+}
+#endif
+
+/** @} */
@@ -146,11 +146,10 @@ TEST_CASE("test_parallelIndexRange2") {
     size_t cpu_num = std::thread::hardware_concurrency();
     if (cpu_num == 32) {
         result = parallelIndexRange(0, 100);
-        expect = {{0, 3},   {3, 6},   {6, 9},   {9, 12},  {12, 15}, {15, 18}, {18, 21}, {21, 24},
-                  {24, 27}, {27, 30}, {30, 33}, {33, 36}, {36, 39}, {39, 42}, {42, 45}, {45, 48},
-                  {48, 51}, {51, 54}, {54, 57}, {57, 60}, {60, 63}, {63, 66}, {66, 69}, {69, 72},
-                  {72, 75}, {75, 78}, {78, 81}, {81, 84}, {84, 87}, {87, 90}, {90, 93}, {93, 96},
-                  {96, 97}, {97, 98}, {98, 99}, {99, 100}};
+        expect = {{0, 4},   {4, 8},   {8, 12},  {12, 16}, {16, 19}, {19, 22}, {22, 25}, {25, 28},
+                  {28, 31}, {31, 34}, {34, 37}, {37, 40}, {40, 43}, {43, 46}, {46, 49}, {49, 52},
+                  {52, 55}, {55, 58}, {58, 61}, {61, 64}, {64, 67}, {67, 70}, {70, 73}, {73, 76},
+                  {76, 79}, {79, 82}, {82, 85}, {85, 88}, {88, 91}, {91, 94}, {94, 97}, {97, 100}};
         CHECK_EQ(result.size(), expect.size());
         for (size_t i = 0, len = expect.size(); i < len; i++) {
             CHECK_EQ(result[i].first, expect[i].first);
@@ -159,8 +158,7 @@ TEST_CASE("test_parallelIndexRange2") {
 
     } else if (cpu_num == 8) {
         result = parallelIndexRange(0, 35);
-        expect = {{0, 4},   {4, 8},   {8, 12},  {12, 16}, {16, 20}, {20, 24},
-                  {24, 28}, {28, 32}, {32, 33}, {33, 34}, {34, 35}};
+        expect = {{0, 5}, {5, 10}, {10, 15}, {15, 19}, {19, 23}, {23, 27}, {27, 31}, {31, 35}};
         CHECK_EQ(result.size(), expect.size());
         for (size_t i = 0, len = expect.size(); i < len; i++) {
             CHECK_EQ(result[i].first, expect[i].first);
@@ -187,4 +185,198 @@ TEST_CASE("test_parallel_for_index") {
     }
 }
 
+/** @par 检测点 */
+TEST_CASE("test_parallel_for_index_schedule") {
+    /** @arg 指定线程池类型 */
+    auto result = parallel_for_index<std::function<size_t(size_t)>, ThreadPool>(
+      0, 100, [](size_t i) { return i * 3; });
+    CHECK_EQ(result.size(), 100);
+    for (size_t i = 0; i < result.size(); i++) {
+        CHECK_EQ(result[i], i * 3);
+    }
+
+    std::vector<std::atomic<int>> counts(100);
+    parallel_for_index_void<std::function<void(size_t)>, ThreadPool>(
+      10, counts.size(), [&](size_t i) { counts[i]++; });
+    for (size_t i = 0; i < counts.size(); i++) {
+        CHECK_EQ(counts[i].load(), i < 10 ? 0 : 1);
+    }
+
+    /** @arg 全局线程池中按各调度方式及 grain 执行，结果按索引顺序排列 */
+    for (auto schedule : {ParallelSchedule::DYNAMIC, ParallelSchedule::GUIDED}) {
+        for (size_t grain : {0, 1, 7, 1000}) {
+            result = parallel_for_index(
+              5, 1000, [](size_t i) { return i + 1; }, grain, schedule);
+            CHECK_EQ(result.size(), 995);
+            for (size_t i = 0; i < result.size(); i++) {
+                CHECK_EQ(result[i], i + 6);
+            }
+
+            std::vector<std::atomic<int>> counts(1000);
+            parallel_for_index_void(
+              5, counts.size(), [&](size_t i) { counts[i]++; }, grain, schedule);
+            for (size_t i = 0; i < counts.size(); i++) {
+                CHECK_EQ(counts[i].load(), i < 5 ? 0 : 1);
+            }
+
+            auto ranges = parallel_for_range(
+              0, 1000,
+              [](const range_t& r) {
+                  std::vector<size_t> ret;
+                  for (size_t i = r.first; i < r.second; i++) {
+                      ret.push_back(i * 2);
+                  }
+                  return ret;
+              },
+              grain, schedule);
+            CHECK_EQ(ranges.size(), 1000);
+            for (size_t i = 0; i < ranges.size(); i++) {
+                CHECK_EQ(ranges[i], i * 2);
+            }
+        }
+    }
+
+    /** @arg 空区间 */
+    result = parallel_for_index(
+      5, 5, [](size_t i) { return i; }, 1, ParallelSchedule::GUIDED);
+    CHECK_UNARY(result.empty());
+}
+
+/** @par 检测点 */
+TEST_CASE("test_parallel_for") {
+    /** @arg 空区间 */
+    parallel_for(5, 5, [](size_t i) { CHECK_UNARY(false); });
+
+    /** @arg 各调度方式及 grain 下每个索引恰好执行一次 */
+    for (auto schedule : {ParallelSchedule::DYNAMIC, ParallelSchedule::GUIDED}) {
+        for (size_t grain : {0, 1, 7, 1000}) {
+            std::vector<std::atomic<int>> counts(1000);
+            parallel_for(
+              3, counts.size(), [&](size_t i) { counts[i]++; }, grain, schedule);
+            for (size_t i = 0; i < counts.size(); i++) {
+                CHECK_EQ(counts[i].load(), i < 3 ? 0 : 1);
+            }
+        }
+    }
+
+    /** @arg 嵌套调用 */
+    std::vector<std::vector<int>> values(50, std::vector<int>(200, 0));
+    parallel_for(0, values.size(), [&](size_t i) {
+        parallel_for(0, values[i].size(), [&](size_t j) { values[i][j] = int(i * j); });
+    });
+    for (size_t i = 0; i < values.size(); i++) {
+        for (size_t j = 0; j < values[i].size(); j++) {
+            CHECK_EQ(values[i][j], int(i * j));
+        }
+    }
+
+    auto result = parallel_for_index(
+      0, 100,
+      [](size_t i) {
+          return parallel_reduce(
+            0, i, size_t(0),
+            [](const range_t& r) { return (r.first + r.second - 1) * (r.second - r.first) / 2; },
+            [](size_t a, size_t b) { return a + b; });
+      },
+      0, ParallelSchedule::GUIDED);
+    CHECK_EQ(result.size(), 100);
+    for (size_t i = 0; i < result.size(); i++) {
+        CHECK_EQ(result[i], i * (i - 1) / 2);
+    }
+
+    /** @arg 任务中抛出的异常在调用线程中重新抛出 */
+    CHECK_THROWS_AS(parallel_for(0, 1000,
+                                 [](size_t i) {
+                                     if (i == 500) {
+                                         throw std::runtime_error("test");
+                                     }
+                                 }),
+                    std::runtime_error);
+}
+
+/** @par 检测点 */
+TEST_CASE("test_parallel_reduce") {
+    /** @arg 空区间返回初始值 */
+    CHECK_EQ(parallel_reduce(
+               3, 3, 10, [](const range_t& r) { return 1; }, [](int a, int b) { return a + b; }),
+             10);
+
+    /** @arg 按区间顺序归约 */
+    std::string expect;
+    for (size_t i = 0; i < 500; i++) {
+        expect += char('a' + i % 26);
+    }
+    auto result = parallel_reduce(
+      0, 500, std::string(),
+      [](const range_t& r) {
+          std::string s;
+          for (size_t i = r.first; i < r.second; i++) {
+              s += char('a' + i % 26);
+          }
+          return s;
+      },
+      [](const std::string& a, const std::string& b) { return a + b; }, 3);
+    CHECK_EQ(result, expect);
+}
+
+/** @par 检测点 */
+TEST_CASE("test_parallel_for_range") {
+    auto result = parallel_for_range(0, 100, [](const range_t& r) {
+        std::vector<size_t> ret;
+        for (size_t i = r.first; i < r.second; i++) {
+            ret.push_back(i * 2);
+        }
+        return ret;
+    });
+    CHECK_EQ(result.size(), 100);
+    for (size_t i = 0; i < result.size(); i++) {
+        CHECK_EQ(result[i], i * 2);
+    }
+}
+
+#if ENABLE_BENCHMARK_TEST
+TEST_CASE("test_parallel_for_benchmark") {
+    // 模拟 5000 只股票，计算量差异较大（部分股票上市时间短）
+    size_t total = 5000;
+    std::vector<double> values(total);
+    auto func = [&values](size_t i) {
+        size_t n = (i % 10 == 0) ? 20000 : 2000;
+        double sum = 0.0;
+        for (size_t j = 0; j < n; j++) {
+            sum += std::sqrt(double(i + j));
+        }
+        values[i] = sum;
+    };
+
+    int cycle = 20;
+    {
+        BENCHMARK_TIME_MSG(test_parallel_for_new_pool, cycle, "MQThreadPool per call");
+        for (int c = 0; c < cycle; c++) {
+            auto ranges = parallelIndexRange(0, total);
+            MQThreadPool tg;
+            for (const auto& range : ranges) {
+                tg.submit([=]() {
+                    for (size_t i = range.first; i < range.second; i++) {
+                        func(i);
+                    }
+                });
+            }
+            tg.join();
+        }
+    }
+    {
+        BENCHMARK_TIME_MSG(test_parallel_for_dynamic, cycle, "parallel_for dynamic");
+        for (int c = 0; c < cycle; c++) {
+            parallel_for(0, total, func, 0, ParallelSchedule::DYNAMIC);
+        }
+    }
+    {
+        BENCHMARK_TIME_MSG(test_parallel_for_guided, cycle, "parallel_for guided");
+        for (int c = 0; c < cycle; c++) {
+            parallel_for(0, total, func, 0, ParallelSchedule::GUIDED);
+        }
+    }
+}
+#endif
+
 /** @} */
\ No newline at end of file
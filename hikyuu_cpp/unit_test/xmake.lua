@@ -67,6 +67,9 @@ target("unit-test")
     end
 
     add_packages("boost", "fmt", "spdlog", "doctest", "sqlite3")
+    if get_config("hdf5") then
+        add_packages("hdf5")
+    end
     if get_config("mysql") then
         add_packages("mysql")
     end
@@ -156,7 +156,8 @@ void export_Stock(py::module& m) {
 
         :rtype: Parameter)")
 
-      .def("realtime_update", &Stock::realtimeUpdate, py::arg("krecord"),
+      .def("realtime_update", py::overload_cast<KRecord, KQuery::KType>(&Stock::realtimeUpdate),
+           py::arg("krecord"),
            py::arg("ktype") = KQuery::DAY,
            R"(realtime_update(self, krecord)
 
@@ -7,6 +7,7 @@
 
 #include <hikyuu/analysis/combinate.h>
 #include <hikyuu/analysis/analysis_sys.h>
+#include <hikyuu/analysis/sweep.h>
 #include "../pybind_utils.h"
 
 using namespace hku;
@@ -182,6 +183,68 @@ static py::dict analysis_sys_list(const py::object& pystk_list, const KQuery& qu
     return result;
 }
 
+static py::dict sweep_sys(SystemPtr sys_proto, const py::sequence& pyparams,
+                          const py::object& pystk_list, const KQuery& query) {
+    HKU_CHECK(sys_proto, "sys_proto is null!");
+
+    vector<Parameter> params;
+    for (const auto& obj : pyparams) {
+        params.emplace_back(obj.cast<Parameter>());
+    }
+
+    StockList stk_list;
+    if (py::isinstance<Block>(pystk_list)) {
+        const auto& blk = pystk_list.cast<Block&>();
+        for (const auto& stk : blk) {
+            stk_list.emplace_back(stk);
+        }
+    } else if (py::isinstance<StockManager>(pystk_list)) {
+        const auto& blk = pystk_list.cast<StockManager&>();
+        for (const auto& stk : blk) {
+            stk_list.emplace_back(stk);
+        }
+    } else if (py::isinstance<py::sequence>(pystk_list)) {
+        auto pyseq = pystk_list.cast<py::sequence>();
+        for (const auto& obj : pyseq) {
+            stk_list.emplace_back(obj.cast<Stock&>());
+        }
+    }
+
+    vector<SweepSystemOutput> records;
+    {
+        OStreamToPython guard(false);
+        py::gil_scoped_release release;
+        records = sweepSystem(sys_proto, params, stk_list, query);
+    }
+
+    Performance per;
+    auto keys = per.names();
+    std::vector<py::list> tmp(keys.size() + 3);
+    for (size_t i = 0, total = records.size(); i < total; i++) {
+        const auto& record = records[i];
+        if (record.values.size() != keys.size()) {
+            continue;
+        }
+        tmp[0].append(record.index);
+        tmp[1].append(record.market_code);
+        tmp[2].append(record.name);
+        for (size_t j = 0, len = keys.size(); j < len; j++) {
+            tmp[j + 3].append(record.values[j]);
+        }
+    }
+
+    py::dict result;
+    result["参数序号"] = tmp[0];
+    result["证券代码"] = tmp[1];
+    result["证券名称"] = tmp[2];
+    for (size_t i = 0, total = keys.size(); i < total; i++) {
+        if (!tmp[i + 3].empty()) {
+            result[keys[i].c_str()] = tmp[i + 3];
+        }
+    }
+    return result;
+}
+
 void export_analysis(py::module& m) {
     m.def("combinate_index", combinate_index, R"(combinate_index(seq)
 
@@ -207,6 +270,19 @@ void export_analysis(py::module& m) {
 
     m.def("inner_analysis_sys_list", analysis_sys_list);
 
+    m.def("sweep_sys", sweep_sys, py::arg("sys_proto"), py::arg("params"), py::arg("stks"),
+          py::arg("query"), R"(sweep_sys(sys_proto, params, stks, query)
+
+    参数扫描。以原型系统及参数组合生成候选系统，对每只证券执行全部候选系统。同一证券的K线数据
+    及等效的指标计算结果由全部候选系统共享，候选系统并行执行。
+
+    :param System sys_proto: 原型系统，须已指定交易管理
+    :param list params: Parameter 列表，参数名称形如 "部件.参数名"，如 "SG.alternate"、"SYS.buy_delay"
+    :param stks: 证券列表，可为 Block、sm 或 Stock 序列
+    :param Query query: 查询条件
+    :return: 各参数组合在各证券上的统计结果
+    :rtype: dict)");
+
     m.def("find_optimal_system", findOptimalSystem, py::arg("sys_list"), py::arg("stock"),
           py::arg("query"), py::arg("sort_key") = string(), py::arg("sort_mode") = 0);
     m.def("find_optimal_system_multi", findOptimalSystemMulti, py::arg("sys_list"),
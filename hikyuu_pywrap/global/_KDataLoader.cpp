@@ -0,0 +1,55 @@
+/*
+ *  Copyright (c) 2026 hikyuu.org
+ *
+ *  Created on: 2026-10-16
+ *      Author: fasiondog
+ */
+
+#include <hikyuu/global/KDataLoader.h>
+#include "../pybind_utils.h"
+
+using namespace hku;
+namespace py = pybind11;
+
+void export_KDataLoader(py::module& m) {
+    py::class_<KDataLoader, KDataLoaderPtr>(m, "KDataLoader",
+                                            "未预加载K线数据的异步加载服务及其内存缓存")
+      .def_property("prefetch_next", &KDataLoader::getPrefetchNext,
+                    &KDataLoader::setPrefetchNext, "未命中时是否在后台预先加载紧随其后的区间")
+      .def_property("max_bytes", &KDataLoader::getMaxBytes, &KDataLoader::setMaxBytes,
+                    "缓存的最大字节数")
+      .def_property_readonly("used_bytes", &KDataLoader::getUsedBytes, "当前缓存占用的字节数")
+      .def_property_readonly("hits", &KDataLoader::hits, "命中次数")
+      .def_property_readonly("misses", &KDataLoader::misses, "未命中次数")
+      .def_property_readonly("evictions", &KDataLoader::evictions, "淘汰的区间数")
+
+      .def(
+        "prefetch",
+        [](KDataLoader& self, const py::object& stks, const KQuery& query) {
+            if (py::isinstance<Block>(stks)) {
+                self.prefetch(stks.cast<Block>(), query);
+            } else if (py::isinstance<Stock>(stks)) {
+                self.prefetch(stks.cast<Stock>(), query);
+            } else {
+                self.prefetch(python_list_to_vector<Stock>(stks), query);
+            }
+        },
+        py::arg("stks"), py::arg("query"), R"(prefetch(self, stks, query)
+
+    在后台线程中预先加载K线数据，数据驱动不支持并行加载时不执行
+
+    :param stks: Stock、Block 或 Stock 列表
+    :param KQuery query: 查询条件)")
+
+      .def("clear", &KDataLoader::clear, "清除全部缓存及统计");
+
+    m.def("start_kdata_loader", startKDataLoader, py::arg("max_bytes") = 1024 * 1024 * 1024,
+          py::arg("worker_num") = 2, R"(start_kdata_loader([max_bytes=1G, worker_num=2])
+
+    启用K线数据异步加载服务，未预加载的K线数据经由其内存缓存加载
+
+    :param int max_bytes: 缓存的最大字节数
+    :param int worker_num: 后台加载线程数)");
+    m.def("stop_kdata_loader", stopKDataLoader);
+    m.def("get_kdata_loader", getGlobalKDataLoader, "获取当前的K线数据异步加载服务，未启用时返回 None");
+}
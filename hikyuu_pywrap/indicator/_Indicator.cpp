@@ -179,6 +179,13 @@ set_context(self, stock, query)
     :param Stock stock: 指定的 Stock
     :param Query query: 指定的查询条件)")
 
+      .def("update_context", &Indicator::updateContext, R"(update_context(self, kdata)
+
+    增量更新上下文。新的上下文仅在原上下文尾部追加了K线或修改了最后一根K线时（如实时行情更新），
+    支持增量计算的指标只计算尾部数据，否则进行完整计算。
+
+    :param KData kdata: 关联的上下文K线)")
+
       .def("get_context", &Indicator::getContext, R"(get_context(self)
 
     获取上下文
@@ -31,8 +31,9 @@ void export_indicator_main(py::module& m) {
           py::list ret;
           HKU_IF_RETURN(len(inds) == 0, ret);
           IndicatorList cinds = python_list_to_vector<Indicator>(inds);
-          ret = vector_to_python_list(
-            parallel_for_index(0, cinds.size(), [&](size_t i) { return cinds[i](kdata); }));
+          ret = vector_to_python_list(parallel_for_index(
+            0, cinds.size(), [&](size_t i) { return cinds[i](kdata); }, 0,
+            ParallelSchedule::GUIDED));
           return ret;
       },
       R"(batch_calculate_inds(inds, kdata) -> list)
@@ -25,6 +25,20 @@ void export_build_in(py::module& m) {
     :param string name:        账户名称
     :rtype: TradeManager)");
 
+    m.def(
+      "crtFastStatsTM", crtFastStatsTM, py::arg("date") = Datetime(199001010000LL),
+      py::arg("init_cash") = 100000, py::arg("cost_func") = TC_Zero(), py::arg("name") = "SYS",
+      R"(crtFastStatsTM([date = Datetime(199001010000), init_cash = 100000, cost_func = TC_Zero(), name = "SYS"])
+
+    创建快速统计模式的交易管理模块，只保留资金曲线及绩效统计所需的数据，不生成交易记录。
+    用于只关注统计结果的大批量单证券回测筛选，仅支持多头交易。
+
+    :param Datetime date:  账户建立日期
+    :param float init_cash:    初始资金
+    :param TradeCost cost_func: 交易成本算法
+    :param string name:        账户名称
+    :rtype: TradeManager)");
+
     m.def("TC_TestStub", TC_TestStub, "仅用于测试");
 
     m.def(